@@ -4,12 +4,17 @@
 #include <string>
 #include <cassert>
 #include <cstdio>
+#include <cstdlib>
 #include <filesystem>
+#include <fstream>
 #include <chrono>
 #include <ranges>
 #include <variant>
 #include <thread>
-#include <ranges>
+#include <span>
+#include <optional>
+#include <cstring>
+#include <unordered_map>
 #include <boost/dll/shared_library.hpp>
 #include <boost/dll/library_info.hpp>
 #include "docopt.h"
@@ -18,8 +23,14 @@
 #include "ecsact/runtime/core.hh"
 #include "ecsact/runtime/serialize.h"
 #include "ecsact/runtime/async.h"
-#include "ecsactsi_wasm.h"
+#include "ecsact/si/wasm.h"
 #include "magic_enum.hpp"
+#include "ecsact/cli/commands/benchmark/alloc_counter.hh"
+#include "ecsact/cli/commands/benchmark/growth_detection.hh"
+#include "ecsact/cli/commands/benchmark/latency_report.hh"
+#include "ecsact/cli/commands/benchmark/latency_stats.hh"
+#include "ecsact/cli/commands/benchmark/process_memory.hh"
+#include "ecsact/cli/commands/benchmark/sampling_profiler.hh"
 
 using std::chrono::duration;
 using std::chrono::duration_cast;
@@ -27,6 +38,18 @@ using std::chrono::nanoseconds;
 
 namespace fs = std::filesystem;
 using benchmark_clock_t = std::chrono::high_resolution_clock;
+using ecsact::cli::detail::alloc_counts;
+using ecsact::cli::detail::begin_profile_scope;
+using ecsact::cli::detail::compute_latency_stats;
+using ecsact::cli::detail::count_library_allocs;
+using ecsact::cli::detail::current_alloc_counts;
+using ecsact::cli::detail::current_rss_bytes;
+using ecsact::cli::detail::end_profile_scope;
+using ecsact::cli::detail::is_counting_allocs;
+using ecsact::cli::detail::is_monotonic_growth;
+using ecsact::cli::detail::latency_report_item;
+using ecsact::cli::detail::latency_stats;
+using ecsact::cli::detail::to_latency_report;
 
 constexpr auto USAGE = R"(Ecsact Benchmark Command
 
@@ -35,6 +58,12 @@ Usage:
 	ecsact benchmark <system_impl>... --runtime=<path> --seed=<path>
 		[--async=<connect_string>] [--events=summary]
 		[--iterations=<count>] [--iteration_report_interval=<count>]
+		[--profile=<file>] [--profraw=<file>]
+	ecsact benchmark --mode=<mode> [<system_impl>...] --runtime=<path>
+		[--seed=<path>] [--async=<connect_string>] [--events=summary]
+		[--iterations=<count>] [--iteration_report_interval=<count>]
+		[--profile=<file>] [--window=<count>] [--rate=<steps>]
+		[--step_duration=<seconds>] [--deadline=<ms>] [--profraw=<file>]
 )";
 
 constexpr auto OPTIONS = R"(
@@ -50,19 +79,106 @@ Options:
 	--seed=<path>
 		Path to file containing entity seed data from an ecsact_dump_entities
 		call. The format must be compatible with the runtime because
-		ecsact_restore_entities will be called with said data.
+		ecsact_restore_entities will be called with said data. Required in all
+		modes except wasm-reload.
+	--mode=<mode>  [default: execute]
+		What is being measured. Available modes:
+			execute    time ecsact_execute_systems (or async ticks)
+			serialize  time ecsact_dump_entities and ecsact_restore_entities of the
+			           seed entities as well as ecsact_serialize_component and
+			           ecsact_deserialize_component for each component type. Per
+			           component measurements use at most 100 iterations.
+			wasm-reload
+			           time loading each <system_impl> once per module and once
+			           per export, then repeatedly unload and reload each module
+			           reporting reload latency and memory growth. Reading the
+			           file is reported separately from ecsact_si_wasm_load which
+			           covers both compiling and instantiating the module. No
+			           seed is required in this mode.
+			soak       execute like the execute mode but report latency
+			           percentiles, RSS, allocation counts and event counts for
+			           every --window ticks and flag latency or memory that
+			           keeps growing across windows. The first window is
+			           treated as warm up and ignored when looking for growth.
+	Allocation counts only include allocations made by the runtime and are
+	null on platforms where they can't be measured (anything but Linux.)
+			async-load open loop load on an async runtime. Empty execution
+			           options are enqueued at a fixed wall clock rate for each
+			           --rate step regardless of how fast ticks complete. Each
+			           step reports the queueing latency (time from when a
+			           request was scheduled until the runtime reports it done)
+			           and missed deadlines. Ramping stops at the first saturated
+			           step, where more than 1% of requests miss the deadline or
+			           the p99 queueing latency exceeds it.
 	--async=<connect_string>
 		Connect to an async runtime via <connect_string> instead of executing.
+		Required in async-load mode.
 	--events=summary
 		End of benchmark will give a report of how many of each event occurred
 		during the benchmark.
 	--iterations=<count>  [default: 10000]
 		Number of times ecsact_execute_systems is called or in the case of async
-		number of ticks that pass until disconnect.
+		number of ticks that pass until disconnect. In serialize mode the number
+		of times the seed entities are dumped and restored. In wasm-reload mode
+		the number of times each <system_impl> is reloaded.
 	--iteration_report_interval=<count>  [default: 100]
 		How often an iteration progress is reported.
+	--profile=<file>
+		Sample the CPU while inside ecsact_execute_systems and write the samples
+		to <file> as folded stacks (flamegraph.pl, speedscope, inferno.) Only
+		available in execute mode without --async and on platforms that support
+		SIGPROF.
+	--profraw=<file>
+		Where a runtime built with `ecsact build --pgo=instrument` writes its
+		profile (LLVM_PROFILE_FILE, %p and %m patterns are allowed.) The profile
+		is written when the runtime is unloaded. Pass the file(s) to
+		`ecsact build --pgo=use=<path>` to build an optimized runtime.
+	--window=<count>  [default: 10000]
+		Number of ticks in each soak mode window.
+	--rate=<steps>  [default: 30,60,120,240,480,960]
+		Comma separated enqueue rates (per second) async-load mode ramps through.
+	--step_duration=<seconds>  [default: 10]
+		How long each async-load rate step lasts.
+	--deadline=<ms>  [default: 100]
+		Queueing latency after which an async-load request counts as a missed
+		deadline.
 )";
 
+/**
+ * CPU time between profile samples when --profile is used
+ */
+constexpr auto profile_sample_interval = std::chrono::microseconds{1000};
+
+/**
+ * Samples past this count are dropped to keep the profiler allocation free
+ * while sampling
+ */
+constexpr auto profile_max_samples = std::size_t{50'000};
+
+NLOHMANN_JSON_NAMESPACE_BEGIN
+/**
+ * Measurements that aren't available on this platform are reported as null
+ */
+template<typename T>
+struct adl_serializer<std::optional<T>> {
+	static void to_json(json& j, const std::optional<T>& value) {
+		if(value) {
+			j = *value;
+		} else {
+			j = nullptr;
+		}
+	}
+
+	static void from_json(const json& j, std::optional<T>& value) {
+		if(j.is_null()) {
+			value = std::nullopt;
+		} else {
+			value = j.template get<T>();
+		}
+	}
+};
+NLOHMANN_JSON_NAMESPACE_END
+
 struct info_message {
 	static constexpr auto type = "info";
 	std::string           content;
@@ -95,6 +211,22 @@ struct benchmark_progress_message {
 	NLOHMANN_DEFINE_TYPE_INTRUSIVE(benchmark_progress_message, progress);
 };
 
+struct profile_message {
+	static constexpr auto type = "profile";
+	std::string           path;
+	uint64_t              sample_count;
+	uint64_t              dropped_sample_count;
+	float                 sample_interval_ms;
+
+	NLOHMANN_DEFINE_TYPE_INTRUSIVE(
+		profile_message,
+		path,
+		sample_count,
+		dropped_sample_count,
+		sample_interval_ms
+	);
+};
+
 struct benchmark_result_message {
 	static constexpr auto type = "result";
 	float                 total_duration_ms;
@@ -107,6 +239,139 @@ struct benchmark_result_message {
 	);
 };
 
+struct serialize_throughput_report_item {
+	float         total_duration_ms = 0.f;
+	float         megabytes_per_second = 0.f;
+	float         nanoseconds_per_entity = 0.f;
+
+	std::optional<std::uint64_t> allocations;
+	std::optional<std::uint64_t> allocated_bytes;
+
+	NLOHMANN_DEFINE_TYPE_INTRUSIVE(
+		serialize_throughput_report_item,
+		total_duration_ms,
+		megabytes_per_second,
+		nanoseconds_per_entity,
+		allocations,
+		allocated_bytes
+	);
+};
+
+struct component_serialize_report_item {
+	ecsact_component_id component_id = {};
+	int32_t             serialized_size = 0;
+	int64_t             count = 0;
+	float               serialize_megabytes_per_second = 0.f;
+	float               serialize_nanoseconds_per_op = 0.f;
+	float               deserialize_megabytes_per_second = 0.f;
+	float               deserialize_nanoseconds_per_op = 0.f;
+
+	NLOHMANN_DEFINE_TYPE_INTRUSIVE(
+		component_serialize_report_item,
+		component_id,
+		serialized_size,
+		count,
+		serialize_megabytes_per_second,
+		serialize_nanoseconds_per_op,
+		deserialize_megabytes_per_second,
+		deserialize_nanoseconds_per_op
+	);
+};
+
+struct serialize_result_message {
+	static constexpr auto type = "serialize_result";
+
+	int32_t                          entity_count = 0;
+	int64_t                          dump_size_bytes = 0;
+	serialize_throughput_report_item dump;
+	serialize_throughput_report_item restore;
+
+	std::vector<component_serialize_report_item> components;
+
+	NLOHMANN_DEFINE_TYPE_INTRUSIVE(
+		serialize_result_message,
+		entity_count,
+		dump_size_bytes,
+		dump,
+		restore,
+		components
+	);
+};
+
+struct wasm_export_load_report_item {
+	std::string           export_name;
+	ecsact_system_like_id system_id = {};
+	float                 load_duration_ms = 0.f;
+
+	NLOHMANN_DEFINE_TYPE_INTRUSIVE(
+		wasm_export_load_report_item,
+		export_name,
+		system_id,
+		load_duration_ms
+	);
+};
+
+struct wasm_load_message {
+	static constexpr auto type = "wasm_load";
+
+	std::string path;
+	int64_t     file_size_bytes = 0;
+
+	/**
+	 * Time spent reading the wasm file. 0 when the runtime reads the file itself
+	 * through ecsact_si_wasm_load_file.
+	 */
+	float read_duration_ms = 0.f;
+
+	/**
+	 * Time spent compiling and instantiating the wasm module for all exports
+	 */
+	float load_duration_ms = 0.f;
+
+	/**
+	 * Load time of each export loaded on its own. Only available in wasm-reload
+	 * mode when export names and system IDs are given.
+	 */
+	std::vector<wasm_export_load_report_item> exports;
+
+	NLOHMANN_DEFINE_TYPE_INTRUSIVE(
+		wasm_load_message,
+		path,
+		file_size_bytes,
+		read_duration_ms,
+		load_duration_ms,
+		exports
+	);
+};
+
+struct wasm_reload_result_message {
+	static constexpr auto type = "wasm_reload_result";
+
+	std::string         path;
+	long                iterations = 0;
+	float               total_duration_ms = 0.f;
+	latency_report_item reload_latency;
+	std::uint64_t       rss_before_bytes = 0;
+	std::uint64_t       rss_after_bytes = 0;
+	int64_t             rss_growth_bytes = 0;
+
+	std::optional<std::uint64_t> allocations;
+	std::optional<std::uint64_t> deallocations;
+
+	NLOHMANN_DEFINE_TYPE_INTRUSIVE(
+		wasm_reload_result_message,
+		path,
+		iterations,
+		total_duration_ms,
+		reload_latency,
+		rss_before_bytes,
+		rss_after_bytes,
+		rss_growth_bytes,
+		allocations,
+		deallocations
+	);
+};
+
 struct component_event_report_item {
 	ecsact_event        event = {};
 	ecsact_component_id component_id = {};
@@ -161,6 +426,16 @@ struct event_summary_report_message {
 		return result;
 	}
 
+	inline auto merge(const event_summary_report_message& other) -> void {
+		for(auto& entry : other.component_events) {
+			component_report(entry.event, entry.component_id).count += entry.count;
+		}
+
+		for(auto& entry : other.entity_events) {
+			entity_report(entry.event).count += entry.count;
+		}
+	}
+
 	NLOHMANN_DEFINE_TYPE_INTRUSIVE(
 		event_summary_report_message,
 		component_events,
@@ -168,12 +443,129 @@ struct event_summary_report_message {
 	);
 };
 
+struct async_load_step_message {
+	static constexpr auto type = "async_load_step";
+
+	float               rate_per_second = 0.f;
+	float               duration_ms = 0.f;
+	long                enqueued = 0;
+	long                completed = 0;
+	long                missed_deadlines = 0;
+	long                ticks = 0;
+	latency_report_item queueing_latency;
+	bool                saturated = false;
+
+	NLOHMANN_DEFINE_TYPE_INTRUSIVE(
+		async_load_step_message,
+		rate_per_second,
+		duration_ms,
+		enqueued,
+		completed,
+		missed_deadlines,
+		ticks,
+		queueing_latency,
+		saturated
+	);
+};
+
+struct async_load_result_message {
+	static constexpr auto type = "async_load_result";
+
+	long  steps = 0;
+	float deadline_ms = 0.f;
+
+	/**
+	 * Rate of the first saturated step. 0 if no step saturated.
+	 */
+	float saturation_rate_per_second = 0.f;
+
+	/**
+	 * Highest rate that did not saturate. 0 if the first step saturated.
+	 */
+	float max_sustained_rate_per_second = 0.f;
+
+	NLOHMANN_DEFINE_TYPE_INTRUSIVE(
+		async_load_result_message,
+		steps,
+		deadline_ms,
+		saturation_rate_per_second,
+		max_sustained_rate_per_second
+	);
+};
+
+struct soak_window_message {
+	static constexpr auto type = "soak_window";
+
+	long                window = 0;
+	long                start_tick = 0;
+	long                ticks = 0;
+	latency_report_item latency;
+	std::uint64_t       rss_bytes = 0;
+
+	std::optional<std::uint64_t> allocations;
+	std::optional<std::uint64_t> deallocations;
+	std::optional<std::uint64_t> allocated_bytes;
+
+	/**
+	 * Allocations not yet freed since the soak started
+	 */
+	std::optional<int64_t> live_allocations;
+
+	std::vector<component_event_report_item> component_events;
+	std::vector<entity_event_report_item>    entity_events;
+
+	NLOHMANN_DEFINE_TYPE_INTRUSIVE(
+		soak_window_message,
+		window,
+		start_tick,
+		ticks,
+		latency,
+		rss_bytes,
+		allocations,
+		deallocations,
+		allocated_bytes,
+		live_allocations,
+		component_events,
+		entity_events
+	);
+};
+
+struct soak_result_message {
+	static constexpr auto type = "soak_result";
+
+	long  windows = 0;
+	long  ticks = 0;
+	float total_duration_ms = 0.f;
+	bool  latency_growth = false;
+	bool  rss_growth = false;
+
+	std::optional<bool> live_allocation_growth;
+
+	NLOHMANN_DEFINE_TYPE_INTRUSIVE(
+		soak_result_message,
+		windows,
+		ticks,
+		total_duration_ms,
+		latency_growth,
+		rss_growth,
+		live_allocation_growth
+	);
+};
+
 using benchmark_message_variant_t = std::variant<
 	info_message,
 	warning_message,
 	error_message,
 	benchmark_progress_message,
 	benchmark_result_message,
+	serialize_result_message,
+	wasm_load_message,
+	wasm_reload_result_message,
+	profile_message,
+	soak_window_message,
+	soak_result_message,
+	async_load_step_message,
+	async_load_result_message,
 	event_summary_report_message>;
 
 class stdout_json_benchmark_reporter {
@@ -250,28 +642,28 @@ static auto print_last_error_if_available(
 	boost::dll::shared_library&     runtime,
 	stdout_json_benchmark_reporter& reporter
 ) -> bool {
-	if(!runtime.has("ecsactsi_wasm_last_error_message")) {
+	if(!runtime.has("ecsact_si_wasm_last_error_message")) {
 		reporter.report(warning_message{
 			"Cannot get wasm error message because "
-			"'ecsactsi_wasm_last_error_message' is missing",
+			"'ecsact_si_wasm_last_error_message' is missing",
 		});
 		return false;
 	}
-	if(!runtime.has("ecsactsi_wasm_last_error_message_length")) {
+	if(!runtime.has("ecsact_si_wasm_last_error_message_length")) {
 		reporter.report(warning_message{
 			"Cannot get wasm error message because "
-			"'ecsactsi_wasm_last_error_message_length' is missing",
+			"'ecsact_si_wasm_last_error_message_length' is missing",
 		});
 		return false;
 	}
 
 	auto get_last_error_message_fn =
-		runtime.get<decltype(ecsactsi_wasm_last_error_message)>(
-			"ecsactsi_wasm_last_error_message"
+		runtime.get<decltype(ecsact_si_wasm_last_error_message)>(
+			"ecsact_si_wasm_last_error_message"
 		);
 	auto get_last_error_message_length_fn =
-		runtime.get<decltype(ecsactsi_wasm_last_error_message_length)>(
-			"ecsactsi_wasm_last_error_message_length"
+		runtime.get<decltype(ecsact_si_wasm_last_error_message_length)>(
+			"ecsact_si_wasm_last_error_message_length"
 		);
 
 	auto err_msg = std::string{};
@@ -353,15 +745,14 @@ auto start_async_benchmark(
 
 	auto result_message = benchmark_result_message{};
 
-	const auto async_connect_fn = get_or_exit<decltype(ecsact_async_connect)>(
+	const auto async_start_fn = get_or_exit<decltype(ecsact_async_start)>(
 		options.runtime,
-		"ecsact_async_connect"
+		"ecsact_async_start"
+	);
+	const auto async_stop_fn = get_or_exit<decltype(ecsact_async_stop)>(
+		options.runtime,
+		"ecsact_async_stop"
 	);
-	const auto async_disconnect_fn =
-		get_or_exit<decltype(ecsact_async_disconnect)>(
-			options.runtime,
-			"ecsact_async_disconnect"
-		);
 	const auto async_flush_fn = get_or_exit<decltype(ecsact_async_flush_events)>(
 		options.runtime,
 		"ecsact_async_flush_events"
@@ -386,25 +777,32 @@ auto start_async_benchmark(
 	options.reporter.report(info_message{"Async Connect: " + connect_string});
 
 	struct {
-		ecsact_async_request_id                 connect_req_id;
+		ecsact_async_session_id                 session_id;
 		decltype(options.reporter)&             reporter;
 		bool                                    done;
 		bool                                    connected;
-		decltype(async_enqueue_exec_options_fn) async_enqueue_exec_options_fn;
+		decltype(async_enqueue_exec_options_fn) enqueue_fn;
 		ecsact_async_request_id                 restore_enqueue_req_id;
 	} vars{
-		.connect_req_id = async_connect_fn(connect_string.c_str()),
+		.session_id = async_start_fn(
+			connect_string.data(),
+			static_cast<int32_t>(connect_string.size())
+		),
 		.reporter = options.reporter,
 		.done = false,
 		.connected = false,
-		.async_enqueue_exec_options_fn = async_enqueue_exec_options_fn,
+		.enqueue_fn = async_enqueue_exec_options_fn,
 		.restore_enqueue_req_id = {},
 	};
 
 	auto async_evc = ecsact_async_events_collector{};
 	async_evc.system_error_callback_user_data = &vars;
 	async_evc.system_error_callback = //
-		[](ecsact_execute_systems_error err, void* user_data) {
+		[](
+			ecsact_async_session_id      session_id,
+			ecsact_execute_systems_error err,
+			void*                        user_data
+		) {
 			auto vars_ptr = static_cast<decltype(&vars)>(user_data);
 			vars_ptr->reporter.report(error_message{
 				"System Execution Error: " + std::string(magic_enum::enum_name(err)),
@@ -414,55 +812,56 @@ auto start_async_benchmark(
 	async_evc.async_error_callback_user_data = &vars;
 	async_evc.async_error_callback = //
 		[](
+			ecsact_async_session_id  session_id,
 			ecsact_async_error       err,
-			int32_t                  req_ids_count,
+			int                      req_ids_count,
 			ecsact_async_request_id* req_ids_raw,
 			void*                    user_data
 		) {
 			auto vars_ptr = static_cast<decltype(&vars)>(user_data);
 			auto req_ids = std::span{req_ids_raw, static_cast<size_t>(req_ids_count)};
 
+			if(!vars_ptr->connected) {
+				vars_ptr->reporter.report(error_message{
+					"Async connect failed: "s + std::string(magic_enum::enum_name(err)),
+				});
+			}
+
 			for(auto& req_id : req_ids) {
-				if(req_id == vars_ptr->connect_req_id) {
-					vars_ptr->reporter.report(error_message{
-						"Async connect failed: "s + std::string(magic_enum::enum_name(err)),
-					});
-				} else {
-					vars_ptr->reporter.report(error_message{
-						"Async error (req="s + std::to_string(static_cast<int>(req_id)) +
-							"): "s + std::string(magic_enum::enum_name(err)),
-					});
-				}
+				vars_ptr->reporter.report(error_message{
+					"Async error (req="s + std::to_string(static_cast<int>(req_id)) +
+						"): "s + std::string(magic_enum::enum_name(err)),
+				});
 			}
 
 			vars_ptr->done = true;
 		};
-	async_evc.async_request_done_callback_user_data = &vars;
-	async_evc.async_request_done_callback = //
+
+	async_evc.async_session_event_callback_user_data = &vars;
+	async_evc.async_session_event_callback = //
 		[](
-			int32_t                  req_ids_count,
-			ecsact_async_request_id* req_ids_raw,
-			void*                    user_data
+			ecsact_async_session_id    session_id,
+			ecsact_async_session_event event,
+			void*                      user_data
 		) {
 			auto vars_ptr = static_cast<decltype(&vars)>(user_data);
-			auto req_ids = std::span{req_ids_raw, static_cast<size_t>(req_ids_count)};
-
-			for(auto req_id : req_ids) {
-				if(req_id == vars_ptr->connect_req_id) {
-					vars_ptr->connected = true;
-					vars_ptr->reporter.report(info_message{
-						"Async successfully connected",
-					});
-				}
+			if(event == ECSACT_ASYNC_SESSION_START) {
+				vars_ptr->connected = true;
+				vars_ptr->reporter.report(info_message{
+					"Async successfully connected",
+				});
+			} else if(event == ECSACT_ASYNC_SESSION_STOP) {
+				vars_ptr->done = true;
 			}
 		};
 
-	while(!vars.connected) {
+	while(!vars.connected && !vars.done) {
 		std::this_thread::yield();
-		async_flush_fn(&options.evc, &async_evc);
+		async_flush_fn(vars.session_id, &options.evc, &async_evc);
 	}
 
 	if(vars.done) {
+		async_stop_fn(vars.session_id);
 		return {};
 	}
 
@@ -475,7 +874,7 @@ auto start_async_benchmark(
 			auto vars_ptr = static_cast<decltype(&vars)>(ud);
 
 			vars_ptr->restore_enqueue_req_id =
-				vars_ptr->async_enqueue_exec_options_fn(exec_options);
+				vars_ptr->enqueue_fn(vars_ptr->session_id, exec_options);
 		},
 		&vars
 	);
@@ -484,6 +883,7 @@ auto start_async_benchmark(
 		std::cerr //
 			<< "Seed entities failed to restore: "
 			<< magic_enum::enum_name(restore_err) << "\n";
+		async_stop_fn(vars.session_id);
 		return {};
 	}
 
@@ -493,8 +893,8 @@ auto start_async_benchmark(
 	while(!vars.done) {
 		std::this_thread::yield();
 
-		async_flush_fn(&options.evc, &async_evc);
-		auto tick = async_get_current_tick();
+		async_flush_fn(vars.session_id, &options.evc, &async_evc);
+		auto tick = async_get_current_tick(vars.session_id);
 
 		if(tick % options.iteration_report_interval == 0) {
 			progress_message.progress =
@@ -516,61 +916,397 @@ auto start_async_benchmark(
 
 	result_message.total_duration_ms = total_duration.count();
 
-	async_disconnect_fn();
+	async_stop_fn(vars.session_id);
 
 	return result_message;
 }
 
-auto start_core_benchmark(const common_benchmark_options& options)
-	-> std::optional<benchmark_result_message> {
-	auto result_message = benchmark_result_message{};
+struct async_load_options {
+	std::vector<double>       rates;
+	std::chrono::milliseconds step_duration;
+	std::chrono::milliseconds deadline;
+};
 
-	const auto create_reg_fn = get_or_exit<decltype(ecsact_create_registry)>(
+/**
+ * Fraction of requests in a step that may miss the deadline before the step
+ * is considered saturated
+ */
+constexpr auto async_load_max_missed_fraction = 0.01;
+
+static auto parse_rate_steps(const std::string& str)
+	-> std::optional<std::vector<double>> {
+	auto rates = std::vector<double>{};
+	auto start = std::size_t{};
+
+	while(start <= str.size()) {
+		auto comma = str.find(',', start);
+		auto rate_str = str.substr(start, comma - start);
+
+		try {
+			auto rate = std::stod(rate_str);
+			if(rate <= 0.0) {
+				return {};
+			}
+			rates.push_back(rate);
+		} catch(const std::logic_error&) {
+			return {};
+		}
+
+		if(comma == std::string::npos) {
+			break;
+		}
+		start = comma + 1;
+	}
+
+	return rates;
+}
+
+auto start_async_load_benchmark(
+	std::string                     connect_string,
+	const common_benchmark_options& options,
+	const async_load_options&       load_options
+) -> std::optional<async_load_result_message> {
+	using namespace std::string_literals;
+
+	auto result_message = async_load_result_message{};
+	result_message.deadline_ms =
+		duration_cast<duration<float, std::milli>>(load_options.deadline).count();
+
+	const auto async_start_fn = get_or_exit<decltype(ecsact_async_start)>(
 		options.runtime,
-		"ecsact_create_registry"
+		"ecsact_async_start"
 	);
-	const auto exec_systems_fn = get_or_exit<decltype(ecsact_execute_systems)>(
+	const auto async_stop_fn = get_or_exit<decltype(ecsact_async_stop)>(
 		options.runtime,
-		"ecsact_execute_systems"
+		"ecsact_async_stop"
 	);
-	const auto restore_fn = get_or_exit<decltype(ecsact_restore_entities)>(
+	const auto async_flush_fn = get_or_exit<decltype(ecsact_async_flush_events)>(
 		options.runtime,
-		"ecsact_restore_entities"
+		"ecsact_async_flush_events"
 	);
+	const auto async_enqueue_fn =
+		get_or_exit<decltype(ecsact_async_enqueue_execution_options)>(
+			options.runtime,
+			"ecsact_async_enqueue_execution_options"
+		);
+	const auto async_get_current_tick =
+		get_or_exit<decltype(ecsact_async_get_current_tick)>(
+			options.runtime,
+			"ecsact_async_get_current_tick"
+		);
+	const auto restore_as_exec_options_fn =
+		get_or_exit<decltype(ecsact_restore_as_execution_options)>(
+			options.runtime,
+			"ecsact_restore_as_execution_options"
+		);
 
-	auto reg_id = create_reg_fn("BenchmarkRegistry");
+	options.reporter.report(info_message{"Async Connect: " + connect_string});
 
-	auto restore_err = restore_fn(
-		reg_id,
+	struct {
+		ecsact_async_session_id                           session_id;
+		decltype(options.reporter)&                       reporter;
+		bool                                              done;
+		bool                                              connected;
+		decltype(&ecsact_async_enqueue_execution_options) enqueue_fn;
+		std::vector<nanoseconds>                          queueing_latencies;
+		std::chrono::milliseconds                         deadline;
+		long                                              completed;
+		long                                              missed_deadlines;
+
+		/**
+		 * Scheduled enqueue time of each request that has not completed yet
+		 */
+		std::unordered_map<ecsact_async_request_id, benchmark_clock_t::time_point>
+			pending;
+	} vars{
+		.session_id = async_start_fn(
+			connect_string.data(),
+			static_cast<int32_t>(connect_string.size())
+		),
+		.reporter = options.reporter,
+		.done = false,
+		.connected = false,
+		.enqueue_fn = async_enqueue_fn,
+		.queueing_latencies = {},
+		.deadline = load_options.deadline,
+		.completed = 0,
+		.missed_deadlines = 0,
+		.pending = {},
+	};
+
+	auto async_evc = ecsact_async_events_collector{};
+	async_evc.system_error_callback_user_data = &vars;
+	async_evc.system_error_callback = //
+		[](
+			ecsact_async_session_id      session_id,
+			ecsact_execute_systems_error err,
+			void*                        user_data
+		) {
+			auto vars_ptr = static_cast<decltype(&vars)>(user_data);
+			vars_ptr->reporter.report(error_message{
+				"System Execution Error: " + std::string(magic_enum::enum_name(err)),
+			});
+		};
+
+	async_evc.async_error_callback_user_data = &vars;
+	async_evc.async_error_callback = //
+		[](
+			ecsact_async_session_id  session_id,
+			ecsact_async_error       err,
+			int                      req_ids_count,
+			ecsact_async_request_id* req_ids_raw,
+			void*                    user_data
+		) {
+			auto vars_ptr = static_cast<decltype(&vars)>(user_data);
+			auto req_ids = std::span{req_ids_raw, static_cast<size_t>(req_ids_count)};
+
+			for(auto& req_id : req_ids) {
+				vars_ptr->reporter.report(error_message{
+					"Async error (req="s + std::to_string(static_cast<int>(req_id)) +
+						"): "s + std::string(magic_enum::enum_name(err)),
+				});
+			}
+
+			vars_ptr->done = true;
+		};
+
+	async_evc.async_request_done_callback_user_data = &vars;
+	async_evc.async_request_done_callback = //
+		[](
+			ecsact_async_session_id  session_id,
+			int                      req_ids_count,
+			ecsact_async_request_id* req_ids_raw,
+			void*                    user_data
+		) {
+			auto vars_ptr = static_cast<decltype(&vars)>(user_data);
+			auto req_ids = std::span{req_ids_raw, static_cast<size_t>(req_ids_count)};
+			auto now = benchmark_clock_t::now();
+
+			for(auto req_id : req_ids) {
+				auto itr = vars_ptr->pending.find(req_id);
+				if(itr == vars_ptr->pending.end()) {
+					continue;
+				}
+
+				auto latency = duration_cast<nanoseconds>(now - itr->second);
+				vars_ptr->pending.erase(itr);
+				vars_ptr->queueing_latencies.push_back(latency);
+				vars_ptr->completed += 1;
+				if(latency > vars_ptr->deadline) {
+					vars_ptr->missed_deadlines += 1;
+				}
+			}
+		};
+
+	async_evc.async_session_event_callback_user_data = &vars;
+	async_evc.async_session_event_callback = //
+		[](
+			ecsact_async_session_id    session_id,
+			ecsact_async_session_event event,
+			void*                      user_data
+		) {
+			auto vars_ptr = static_cast<decltype(&vars)>(user_data);
+			if(event == ECSACT_ASYNC_SESSION_START) {
+				vars_ptr->connected = true;
+				vars_ptr->reporter.report(info_message{
+					"Async successfully connected",
+				});
+			} else if(event == ECSACT_ASYNC_SESSION_STOP) {
+				vars_ptr->done = true;
+			}
+		};
+
+	while(!vars.connected && !vars.done) {
+		std::this_thread::yield();
+		async_flush_fn(vars.session_id, &options.evc, &async_evc);
+	}
+
+	if(vars.done) {
+		async_stop_fn(vars.session_id);
+		return {};
+	}
+
+	auto restore_err = restore_as_exec_options_fn(
 		[](void* out_data, int32_t data_max_length, void* ud) -> int32_t {
 			return std::fread(out_data, 1, data_max_length, static_cast<FILE*>(ud));
 		},
-		nullptr,
-		options.seed_file
+		options.seed_file,
+		[](ecsact_execution_options exec_options, void* ud) {
+			auto vars_ptr = static_cast<decltype(&vars)>(ud);
+			vars_ptr->enqueue_fn(vars_ptr->session_id, exec_options);
+		},
+		&vars
 	);
 
 	if(restore_err != ECSACT_RESTORE_OK) {
 		std::cerr //
 			<< "Seed entities failed to restore: "
 			<< magic_enum::enum_name(restore_err) << "\n";
+		async_stop_fn(vars.session_id);
 		return {};
 	}
 
-	auto progress_message = benchmark_progress_message{};
-	auto exec_durations = std::vector<std::chrono::nanoseconds>{};
-	exec_durations.resize(options.iterations);
+	for(auto rate : load_options.rates) {
+		auto step_message = async_load_step_message{};
+		step_message.rate_per_second = static_cast<float>(rate);
 
-	for(auto i = 0; options.iterations > i; ++i) {
-		auto before = benchmark_clock_t::now();
-		exec_systems_fn(reg_id, 1, nullptr, &options.evc);
-		auto after = benchmark_clock_t::now();
+		vars.queueing_latencies.clear();
+		vars.completed = 0;
+		vars.missed_deadlines = 0;
 
-		auto exec_duration = duration_cast<nanoseconds>(after - before);
+		const auto period = duration_cast<benchmark_clock_t::duration>(
+			duration<double>{1.0 / rate}
+		);
+		const auto step_start = benchmark_clock_t::now();
+		const auto step_end = step_start + load_options.step_duration;
+		const auto tick_start = async_get_current_tick(vars.session_id);
+		auto next_enqueue = step_start;
+
+		// Open loop: requests are enqueued on their schedule no matter how many
+		// are still pending. Falling behind results in a burst of enqueues that
+		// are all measured from their scheduled time.
+		while(!vars.done) {
+			auto now = benchmark_clock_t::now();
+			if(now >= step_end) {
+				break;
+			}
 
-		exec_durations[i] = exec_duration;
+			while(next_enqueue <= now && next_enqueue < step_end) {
+				auto req_id =
+					async_enqueue_fn(vars.session_id, ecsact_execution_options{});
+				vars.pending[req_id] = next_enqueue;
+				next_enqueue += period;
+				step_message.enqueued += 1;
+			}
 
-		result_message.total_duration_ms +=
-			duration_cast<duration<float, std::milli>>(exec_duration).count();
+			async_flush_fn(vars.session_id, &options.evc, &async_evc);
+			std::this_thread::yield();
+		}
+
+		// Give outstanding requests until the deadline to complete so each step
+		// is measured on its own
+		const auto drain_end = benchmark_clock_t::now() + load_options.deadline;
+		while(!vars.done && !vars.pending.empty()) {
+			if(benchmark_clock_t::now() >= drain_end) {
+				break;
+			}
+			async_flush_fn(vars.session_id, &options.evc, &async_evc);
+			std::this_thread::yield();
+		}
+
+		if(vars.done) {
+			async_stop_fn(vars.session_id);
+			return {};
+		}
+
+		auto step_duration = duration_cast<duration<float, std::milli>>(
+			benchmark_clock_t::now() - step_start
+		);
+
+		step_message.duration_ms = step_duration.count();
+		step_message.completed = vars.completed;
+		step_message.missed_deadlines =
+			vars.missed_deadlines + static_cast<long>(vars.pending.size());
+		step_message.ticks = async_get_current_tick(vars.session_id) - tick_start;
+		step_message.queueing_latency =
+			to_latency_report(compute_latency_stats(vars.queueing_latencies));
+
+		auto max_missed = static_cast<long>(
+			static_cast<double>(step_message.enqueued) *
+			async_load_max_missed_fraction
+		);
+		auto deadline_ms = result_message.deadline_ms;
+		step_message.saturated = step_message.missed_deadlines > max_missed ||
+			step_message.queueing_latency.p99_ms > deadline_ms;
+
+		// Requests that missed the drain are not counted again in the next step
+		vars.pending.clear();
+
+		options.reporter.report(step_message);
+		result_message.steps += 1;
+
+		if(step_message.saturated) {
+			result_message.saturation_rate_per_second = step_message.rate_per_second;
+			break;
+		}
+
+		result_message.max_sustained_rate_per_second =
+			step_message.rate_per_second;
+	}
+
+	async_stop_fn(vars.session_id);
+
+	return result_message;
+}
+
+/**
+ * Restores the seed file entities into @p reg_id
+ * @returns `false` if restore failed
+ */
+static auto restore_seed_entities(
+	const common_benchmark_options& options,
+	ecsact_registry_id              reg_id
+) -> bool {
+	const auto restore_fn = get_or_exit<decltype(ecsact_restore_entities)>(
+		options.runtime,
+		"ecsact_restore_entities"
+	);
+
+	auto restore_err = restore_fn(
+		reg_id,
+		[](void* out_data, int32_t data_max_length, void* ud) -> int32_t {
+			return std::fread(out_data, 1, data_max_length, static_cast<FILE*>(ud));
+		},
+		nullptr,
+		options.seed_file
+	);
+
+	if(restore_err != ECSACT_RESTORE_OK) {
+		std::cerr //
+			<< "Seed entities failed to restore: "
+			<< magic_enum::enum_name(restore_err) << "\n";
+		return false;
+	}
+
+	return true;
+}
+
+auto start_core_benchmark(const common_benchmark_options& options)
+	-> std::optional<benchmark_result_message> {
+	auto result_message = benchmark_result_message{};
+
+	const auto create_reg_fn = get_or_exit<decltype(ecsact_create_registry)>(
+		options.runtime,
+		"ecsact_create_registry"
+	);
+	const auto exec_systems_fn = get_or_exit<decltype(ecsact_execute_systems)>(
+		options.runtime,
+		"ecsact_execute_systems"
+	);
+
+	auto reg_id = create_reg_fn("BenchmarkRegistry");
+
+	if(!restore_seed_entities(options, reg_id)) {
+		return {};
+	}
+
+	auto progress_message = benchmark_progress_message{};
+	auto exec_durations = std::vector<std::chrono::nanoseconds>{};
+	exec_durations.resize(options.iterations);
+
+	for(auto i = 0; options.iterations > i; ++i) {
+		begin_profile_scope();
+		auto before = benchmark_clock_t::now();
+		exec_systems_fn(reg_id, 1, nullptr, &options.evc);
+		auto after = benchmark_clock_t::now();
+		end_profile_scope();
+
+		auto exec_duration = duration_cast<nanoseconds>(after - before);
+
+		exec_durations[i] = exec_duration;
+
+		result_message.total_duration_ms +=
+			duration_cast<duration<float, std::milli>>(exec_duration).count();
 		if(i % options.iteration_report_interval == 0) {
 			progress_message.progress =
 				static_cast<float>(i) / static_cast<float>(options.iterations);
@@ -581,49 +1317,506 @@ auto start_core_benchmark(const common_benchmark_options& options)
 	return result_message;
 }
 
-int ecsact::cli::detail::benchmark_command(int argc, char* argv[]) {
-	using namespace std::string_literals;
-	using namespace std::chrono_literals;
+static auto to_throughput_report(
+	nanoseconds  total_duration,
+	int64_t      total_bytes,
+	int64_t      total_entities,
+	alloc_counts allocs
+) -> serialize_throughput_report_item {
+	auto result = serialize_throughput_report_item{};
+	auto total_seconds = duration_cast<duration<double>>(total_duration).count();
+
+	result.total_duration_ms =
+		duration_cast<duration<float, std::milli>>(total_duration).count();
+
+	if(is_counting_allocs()) {
+		result.allocations = allocs.allocations;
+		result.allocated_bytes = allocs.allocated_bytes;
+	}
 
-	auto args = docopt::docopt(USAGE, {argv + 1, argv + argc}, false);
+	if(total_seconds > 0.0) {
+		auto total_megabytes = static_cast<double>(total_bytes) / 1e6;
+		result.megabytes_per_second =
+			static_cast<float>(total_megabytes / total_seconds);
+	}
 
-	if(args["--help"] && args["--help"].asBool()) {
-		std::cout << USAGE << OPTIONS;
-		return 0;
+	if(total_entities > 0) {
+		result.nanoseconds_per_entity = static_cast<float>(
+			static_cast<double>(total_duration.count()) /
+			static_cast<double>(total_entities)
+		);
 	}
 
-	auto async = //
-		args["--async"] ? std::optional(args["--async"].asString()) : std::nullopt;
-	auto iterations = expect_docopt_value_long(args, "--iterations", 10000L);
-	auto iteration_report_interval =
-		expect_docopt_value_long(args, "--iteration_report_interval", 100L);
-	auto runtime_path = args["--runtime"].asString();
-	auto seed_path = args["--seed"].asString();
-	auto system_impl_binaries =
-		args["<system_impl>"].asStringList() |
-		std::views::transform( //
-			[](auto& str) { return system_impl_binary_arg::parse(str); }
+	return result;
+}
+
+/**
+ * Number of times each component is serialized/deserialized per visit so that
+ * the clock overhead doesn't dominate tiny components.
+ */
+constexpr auto component_serialize_batch_size = 16;
+constexpr auto max_component_serialize_passes = 100L;
+
+struct component_serialize_stats {
+	ecsact_component_id component_id = {};
+	int32_t             serialized_size = 0;
+	int64_t             count = 0;
+	nanoseconds         serialize_duration = {};
+	nanoseconds         deserialize_duration = {};
+};
+
+struct component_serialize_context {
+	decltype(&ecsact_serialize_component_size) serialize_size_fn;
+	decltype(&ecsact_serialize_component)      serialize_fn;
+	decltype(&ecsact_deserialize_component)    deserialize_fn;
+
+	std::vector<uint8_t>          serialized_buffer;
+	std::vector<std::max_align_t> deserialized_buffer;
+
+	std::vector<component_serialize_stats> stats;
+
+	inline auto component_stats(ecsact_component_id comp_id)
+		-> component_serialize_stats& {
+		for(auto& entry : stats) {
+			if(entry.component_id == comp_id) {
+				return entry;
+			}
+		}
+
+		auto& result = stats.emplace_back();
+		result.component_id = comp_id;
+		result.serialized_size = serialize_size_fn(comp_id);
+
+		auto size = static_cast<size_t>(result.serialized_size);
+		if(serialized_buffer.size() < size) {
+			serialized_buffer.resize(size);
+		}
+
+		// The in-memory component is deserialized into this buffer. No API
+		// reports its size and nothing guarantees it matches the serialized size
+		// so the buffer gets plenty of headroom. Counted in whole max_align_t
+		// elements to keep it suitably aligned.
+		auto deserialized_bytes = size * 2 + 16 * sizeof(std::max_align_t);
+		auto deserialized_count =
+			(deserialized_bytes + sizeof(std::max_align_t) - 1) /
+			sizeof(std::max_align_t);
+		if(deserialized_buffer.size() < deserialized_count) {
+			deserialized_buffer.resize(deserialized_count);
+		}
+
+		return result;
+	}
+};
+
+static auto measure_component_serialize(
+	const common_benchmark_options& options,
+	ecsact_registry_id              reg_id
+) -> std::vector<component_serialize_report_item> {
+	const auto count_entities_fn = get_or_exit<decltype(ecsact_count_entities)>(
+		options.runtime,
+		"ecsact_count_entities"
+	);
+	const auto get_entities_fn = get_or_exit<decltype(ecsact_get_entities)>(
+		options.runtime,
+		"ecsact_get_entities"
+	);
+	const auto each_component_fn = get_or_exit<decltype(ecsact_each_component)>(
+		options.runtime,
+		"ecsact_each_component"
+	);
+
+	auto& serialize_size_fn =
+		get_or_exit<decltype(ecsact_serialize_component_size)>(
+			options.runtime,
+			"ecsact_serialize_component_size"
 		);
-	auto reporter = stdout_json_benchmark_reporter{};
+	auto& serialize_fn = get_or_exit<decltype(ecsact_serialize_component)>(
+		options.runtime,
+		"ecsact_serialize_component"
+	);
+	auto& deserialize_fn = get_or_exit<decltype(ecsact_deserialize_component)>(
+		options.runtime,
+		"ecsact_deserialize_component"
+	);
 
-	auto ec = std::error_code{};
-	auto runtime = boost::dll::shared_library();
+	auto ctx = component_serialize_context{
+		.serialize_size_fn = &serialize_size_fn,
+		.serialize_fn = &serialize_fn,
+		.deserialize_fn = &deserialize_fn,
+		.serialized_buffer = {},
+		.deserialized_buffer = {},
+		.stats = {},
+	};
 
-	exists_or_exit(runtime_path);
-	exists_or_exit(seed_path);
+	auto entities = std::vector<ecsact_entity_id>{};
+	entities.resize(count_entities_fn(reg_id));
+	get_entities_fn(
+		reg_id,
+		static_cast<int32_t>(entities.size()),
+		entities.data(),
+		nullptr
+	);
 
-	runtime.load(runtime_path, ec);
-	if(ec) {
-		std::cerr //
-			<< "Failed to load runtime " << runtime_path << ": " << ec.message()
-			<< "\n";
-		return ec.value();
+	auto passes = std::min(options.iterations, max_component_serialize_passes);
+	for(auto pass = 0L; passes > pass; ++pass) {
+		for(auto entity : entities) {
+			each_component_fn(
+				reg_id,
+				entity,
+				[](ecsact_component_id comp_id, const void* comp_data, void* ud) {
+					auto  ctx = static_cast<component_serialize_context*>(ud);
+					auto& stats = ctx->component_stats(comp_id);
+					auto  out_bytes = ctx->serialized_buffer.data();
+					auto  out_data = ctx->deserialized_buffer.data();
+
+					auto before = benchmark_clock_t::now();
+					for(auto i = 0; component_serialize_batch_size > i; ++i) {
+						ctx->serialize_fn(comp_id, comp_data, out_bytes);
+					}
+					auto between = benchmark_clock_t::now();
+					for(auto i = 0; component_serialize_batch_size > i; ++i) {
+						ctx->deserialize_fn(comp_id, out_bytes, out_data);
+					}
+					auto after = benchmark_clock_t::now();
+
+					stats.count += component_serialize_batch_size;
+					stats.serialize_duration +=
+						duration_cast<nanoseconds>(between - before);
+					stats.deserialize_duration +=
+						duration_cast<nanoseconds>(after - between);
+				},
+				&ctx
+			);
+		}
 	}
 
-	const auto wasm_load_file_fn = get_or_exit<decltype(ecsactsi_wasm_load_file)>(
-		runtime,
-		"ecsactsi_wasm_load_file"
+	auto result = std::vector<component_serialize_report_item>{};
+	result.reserve(ctx.stats.size());
+
+	for(auto& stats : ctx.stats) {
+		auto& item = result.emplace_back();
+		auto  total_bytes = stats.count * stats.serialized_size;
+		item.component_id = stats.component_id;
+		item.serialized_size = stats.serialized_size;
+		item.count = stats.count;
+
+		auto serialize_report = to_throughput_report(
+			stats.serialize_duration,
+			total_bytes,
+			stats.count,
+			{}
+		);
+		item.serialize_megabytes_per_second =
+			serialize_report.megabytes_per_second;
+		item.serialize_nanoseconds_per_op =
+			serialize_report.nanoseconds_per_entity;
+
+		auto deserialize_report = to_throughput_report(
+			stats.deserialize_duration,
+			total_bytes,
+			stats.count,
+			{}
+		);
+		item.deserialize_megabytes_per_second =
+			deserialize_report.megabytes_per_second;
+		item.deserialize_nanoseconds_per_op =
+			deserialize_report.nanoseconds_per_entity;
+	}
+
+	return result;
+}
+
+auto start_serialize_benchmark(const common_benchmark_options& options)
+	-> std::optional<serialize_result_message> {
+	auto result_message = serialize_result_message{};
+
+	const auto create_reg_fn = get_or_exit<decltype(ecsact_create_registry)>(
+		options.runtime,
+		"ecsact_create_registry"
+	);
+	const auto clear_reg_fn = get_or_exit<decltype(ecsact_clear_registry)>(
+		options.runtime,
+		"ecsact_clear_registry"
 	);
+	const auto count_entities_fn = get_or_exit<decltype(ecsact_count_entities)>(
+		options.runtime,
+		"ecsact_count_entities"
+	);
+	const auto dump_fn = get_or_exit<decltype(ecsact_dump_entities)>(
+		options.runtime,
+		"ecsact_dump_entities"
+	);
+	const auto restore_fn = get_or_exit<decltype(ecsact_restore_entities)>(
+		options.runtime,
+		"ecsact_restore_entities"
+	);
+
+	auto reg_id = create_reg_fn("BenchmarkRegistry");
+	auto restore_reg_id = create_reg_fn("BenchmarkRestoreRegistry");
+
+	if(!restore_seed_entities(options, reg_id)) {
+		return {};
+	}
+
+	result_message.entity_count = count_entities_fn(reg_id);
+
+	auto dump_buffer = std::vector<std::byte>{};
+	auto dump_to_buffer = [](const void* data, int32_t data_length, void* ud) {
+		auto buffer = static_cast<std::vector<std::byte>*>(ud);
+		auto bytes = static_cast<const std::byte*>(data);
+		buffer->insert(buffer->end(), bytes, bytes + data_length);
+	};
+
+	// Initial dump outside of measurement so the dump buffer has its final
+	// capacity before anything is timed.
+	dump_fn(reg_id, dump_to_buffer, &dump_buffer);
+	result_message.dump_size_bytes = static_cast<int64_t>(dump_buffer.size());
+
+	struct dump_reader {
+		std::span<const std::byte> data;
+		size_t                     offset;
+	};
+
+	auto read_from_dump = [](void* out_data, int32_t max_length, void* ud) {
+		auto reader = static_cast<dump_reader*>(ud);
+		auto length = std::min(
+			static_cast<size_t>(max_length),
+			reader->data.size() - reader->offset
+		);
+		std::memcpy(out_data, reader->data.data() + reader->offset, length);
+		reader->offset += length;
+		return static_cast<int32_t>(length);
+	};
+
+	auto progress_message = benchmark_progress_message{};
+	auto dump_duration = nanoseconds{};
+	auto dump_allocs = alloc_counts{};
+	auto restore_duration = nanoseconds{};
+	auto restore_allocs = alloc_counts{};
+
+	for(auto i = 0; options.iterations > i; ++i) {
+		dump_buffer.clear();
+
+		auto dump_allocs_before = current_alloc_counts();
+		auto dump_before = benchmark_clock_t::now();
+		dump_fn(reg_id, dump_to_buffer, &dump_buffer);
+		auto dump_after = benchmark_clock_t::now();
+		dump_allocs += current_alloc_counts() - dump_allocs_before;
+		dump_duration += duration_cast<nanoseconds>(dump_after - dump_before);
+
+		clear_reg_fn(restore_reg_id);
+
+		auto reader = dump_reader{
+			.data = std::span{dump_buffer.data(), dump_buffer.size()},
+			.offset = 0,
+		};
+		auto restore_allocs_before = current_alloc_counts();
+		auto restore_before = benchmark_clock_t::now();
+		auto restore_err =
+			restore_fn(restore_reg_id, read_from_dump, nullptr, &reader);
+		auto restore_after = benchmark_clock_t::now();
+		restore_allocs += current_alloc_counts() - restore_allocs_before;
+		restore_duration +=
+			duration_cast<nanoseconds>(restore_after - restore_before);
+
+		if(restore_err != ECSACT_RESTORE_OK) {
+			std::cerr //
+				<< "Dumped entities failed to restore: "
+				<< magic_enum::enum_name(restore_err) << "\n";
+			return {};
+		}
+
+		if(i % options.iteration_report_interval == 0) {
+			progress_message.progress =
+				static_cast<float>(i) / static_cast<float>(options.iterations);
+			options.reporter.report(progress_message);
+		}
+	}
+
+	auto total_bytes = result_message.dump_size_bytes * options.iterations;
+	auto total_entities =
+		static_cast<int64_t>(result_message.entity_count) * options.iterations;
+
+	result_message.dump = to_throughput_report(
+		dump_duration,
+		total_bytes,
+		total_entities,
+		dump_allocs
+	);
+	result_message.restore = to_throughput_report(
+		restore_duration,
+		total_bytes,
+		total_entities,
+		restore_allocs
+	);
+	result_message.components = measure_component_serialize(options, reg_id);
+
+	return result_message;
+}
+
+/**
+ * Relative change across soak windows that is still considered noise
+ */
+constexpr auto soak_latency_growth_tolerance = 0.05;
+constexpr auto soak_memory_growth_tolerance = 0.01;
+
+auto start_soak_benchmark(
+	const common_benchmark_options& options,
+	long                            window_ticks,
+	event_summary_report_message&   events
+) -> std::optional<soak_result_message> {
+	auto result_message = soak_result_message{};
+
+	const auto create_reg_fn = get_or_exit<decltype(ecsact_create_registry)>(
+		options.runtime,
+		"ecsact_create_registry"
+	);
+	const auto exec_systems_fn = get_or_exit<decltype(ecsact_execute_systems)>(
+		options.runtime,
+		"ecsact_execute_systems"
+	);
+
+	auto reg_id = create_reg_fn("BenchmarkRegistry");
+
+	if(!restore_seed_entities(options, reg_id)) {
+		return {};
+	}
+
+	auto progress_message = benchmark_progress_message{};
+	auto total_events = event_summary_report_message{};
+	auto window_durations = std::vector<nanoseconds>{};
+	window_durations.reserve(window_ticks);
+
+	// Reserved up front so the soak's own bookkeeping never shows up as RSS
+	// growing between windows
+	auto window_count = (options.iterations + window_ticks - 1) / window_ticks;
+	auto window_p50_ms = std::vector<double>{};
+	auto window_rss = std::vector<double>{};
+	auto window_live_allocations = std::vector<double>{};
+	window_p50_ms.reserve(window_count);
+	window_rss.reserve(window_count);
+	window_live_allocations.reserve(window_count);
+
+	auto soak_allocs_before = current_alloc_counts();
+	auto window_allocs_before = soak_allocs_before;
+	auto total_duration = nanoseconds{};
+
+	auto report_window = [&](long tick) {
+		auto allocs_after = current_alloc_counts();
+		auto window_allocs = allocs_after - window_allocs_before;
+		auto soak_allocs = allocs_after - soak_allocs_before;
+		window_allocs_before = allocs_after;
+
+		auto window_events = std::exchange(events, {});
+		total_events.merge(window_events);
+
+		auto window_message = soak_window_message{
+			.window = result_message.windows,
+			.start_tick = tick - static_cast<long>(window_durations.size()),
+			.ticks = static_cast<long>(window_durations.size()),
+			.latency = to_latency_report(compute_latency_stats(window_durations)),
+			.rss_bytes = current_rss_bytes(),
+			.component_events = std::move(window_events.component_events),
+			.entity_events = std::move(window_events.entity_events),
+		};
+
+		if(is_counting_allocs()) {
+			window_message.allocations = window_allocs.allocations;
+			window_message.deallocations = window_allocs.deallocations;
+			window_message.allocated_bytes = window_allocs.allocated_bytes;
+			window_message.live_allocations =
+				static_cast<int64_t>(soak_allocs.allocations) -
+				static_cast<int64_t>(soak_allocs.deallocations);
+		}
+
+		// The first window includes warm up (caches, allocator pools, component
+		// storage reserving) so it is left out of growth detection
+		if(result_message.windows > 0) {
+			window_p50_ms.push_back(window_message.latency.p50_ms);
+			window_rss.push_back(static_cast<double>(window_message.rss_bytes));
+			if(window_message.live_allocations) {
+				window_live_allocations.push_back(
+					static_cast<double>(*window_message.live_allocations)
+				);
+			}
+		}
+
+		options.reporter.report(window_message);
+		result_message.windows += 1;
+		window_durations.clear();
+	};
+
+	for(auto i = 0L; options.iterations > i; ++i) {
+		auto before = benchmark_clock_t::now();
+		exec_systems_fn(reg_id, 1, nullptr, &options.evc);
+		auto after = benchmark_clock_t::now();
+
+		auto exec_duration = duration_cast<nanoseconds>(after - before);
+		window_durations.push_back(exec_duration);
+		total_duration += exec_duration;
+
+		if(static_cast<long>(window_durations.size()) == window_ticks) {
+			report_window(i + 1);
+		}
+
+		if(i % options.iteration_report_interval == 0) {
+			progress_message.progress =
+				static_cast<float>(i) / static_cast<float>(options.iterations);
+			options.reporter.report(progress_message);
+		}
+	}
+
+	if(!window_durations.empty()) {
+		report_window(options.iterations);
+	}
+
+	events = std::move(total_events);
+
+	result_message.ticks = options.iterations;
+	result_message.total_duration_ms =
+		duration_cast<duration<float, std::milli>>(total_duration).count();
+	result_message.latency_growth =
+		is_monotonic_growth(window_p50_ms, soak_latency_growth_tolerance);
+	result_message.rss_growth =
+		is_monotonic_growth(window_rss, soak_memory_growth_tolerance);
+	if(is_counting_allocs()) {
+		result_message.live_allocation_growth = is_monotonic_growth(
+			window_live_allocations,
+			soak_memory_growth_tolerance
+		);
+	}
+
+	if(result_message.latency_growth) {
+		options.reporter.report(warning_message{
+			"Median tick latency kept growing across soak windows",
+		});
+	}
+
+	if(result_message.rss_growth) {
+		options.reporter.report(warning_message{
+			"Resident memory kept growing across soak windows",
+		});
+	}
+
+	if(result_message.live_allocation_growth.value_or(false)) {
+		options.reporter.report(warning_message{
+			"Live allocations kept growing across soak windows",
+		});
+	}
+
+	return result_message;
+}
+
+static auto load_system_impls(
+	boost::dll::shared_library&     runtime,
+	stdout_json_benchmark_reporter& reporter,
+	auto&&                          system_impl_binaries
+) -> int {
+	const auto wasm_load_file_fn =
+		get_or_exit<decltype(ecsact_si_wasm_load_file)>(
+			runtime,
+			"ecsact_si_wasm_load_file"
+		);
 
 	for(auto system_impl_binary : system_impl_binaries) {
 		exists_or_exit(system_impl_binary.path);
@@ -640,25 +1833,376 @@ int ecsact::cli::detail::benchmark_command(int argc, char* argv[]) {
 
 		auto system_impl_binary_path_str = system_impl_binary.path.string();
 
+		auto load_before = benchmark_clock_t::now();
 		auto err = wasm_load_file_fn(
 			system_impl_binary_path_str.c_str(),
 			static_cast<int32_t>(system_ids.size()),
 			system_ids.data(),
 			export_names_c.data()
 		);
+		auto load_after = benchmark_clock_t::now();
 
-		if(err != ECSACTSI_WASM_OK) {
+		if(err != ECSACT_SI_WASM_OK) {
 			std::cerr //
 				<< "Failed to load Wasm File: " << magic_enum::enum_name(err) << "\n";
 			print_last_error_if_available(runtime, reporter);
 			return 1;
 		}
+
+		auto load_duration =
+			duration_cast<duration<float, std::milli>>(load_after - load_before);
+
+		reporter.report(wasm_load_message{
+			.path = system_impl_binary_path_str,
+			.file_size_bytes =
+				static_cast<int64_t>(fs::file_size(system_impl_binary.path)),
+			.load_duration_ms = load_duration.count(),
+		});
+	}
+
+	return 0;
+}
+
+static auto read_wasm_file(const fs::path& path) -> std::vector<char> {
+	auto file = std::ifstream{path, std::ios_base::binary};
+	auto size = fs::file_size(path);
+	auto bytes = std::vector<char>{};
+	bytes.resize(size);
+	file.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+	return bytes;
+}
+
+auto start_wasm_reload_benchmark(
+	boost::dll::shared_library&     runtime,
+	stdout_json_benchmark_reporter& reporter,
+	auto&&                          system_impl_binaries,
+	long                            iterations,
+	long                            iteration_report_interval
+) -> int {
+	const auto wasm_load_fn = get_or_exit<decltype(ecsact_si_wasm_load)>(
+		runtime,
+		"ecsact_si_wasm_load"
+	);
+	const auto wasm_unload_fn = get_or_exit<decltype(ecsact_si_wasm_unload)>(
+		runtime,
+		"ecsact_si_wasm_unload"
+	);
+	const auto wasm_reset_fn = get_or_exit<decltype(ecsact_si_wasm_reset)>(
+		runtime,
+		"ecsact_si_wasm_reset"
+	);
+
+	auto to_ms = [](auto d) {
+		return duration_cast<duration<float, std::milli>>(d).count();
+	};
+
+	for(auto system_impl_binary : system_impl_binaries) {
+		exists_or_exit(system_impl_binary.path);
+
+		auto& system_ids = system_impl_binary.system_ids;
+		auto& export_names = system_impl_binary.export_names;
+		auto  path_str = system_impl_binary.path.string();
+
+		auto export_names_c = std::vector<const char*>{};
+		export_names_c.reserve(export_names.size());
+		for(auto& export_name : export_names) {
+			export_names_c.push_back(export_name.c_str());
+		}
+
+		// Without system IDs we don't know what to unload so the whole wasm state
+		// is reset instead.
+		auto unload = [&] {
+			if(system_ids.empty()) {
+				wasm_reset_fn();
+			} else {
+				wasm_unload_fn(
+					static_cast<int32_t>(system_ids.size()),
+					system_ids.data()
+				);
+			}
+		};
+
+		auto load = [&](
+									std::vector<char>&     wasm_bytes,
+									int32_t                count,
+									ecsact_system_like_id* ids,
+									const char**           names
+								) -> bool {
+			auto err = wasm_load_fn(
+				wasm_bytes.data(),
+				static_cast<int32_t>(wasm_bytes.size()),
+				count,
+				ids,
+				names
+			);
+
+			if(err != ECSACT_SI_WASM_OK) {
+				std::cerr //
+					<< "Failed to load Wasm File " << path_str << ": "
+					<< magic_enum::enum_name(err) << "\n";
+				print_last_error_if_available(runtime, reporter);
+				return false;
+			}
+
+			return true;
+		};
+
+		auto load_message = wasm_load_message{};
+		load_message.path = path_str;
+
+		auto read_before = benchmark_clock_t::now();
+		auto wasm_bytes = read_wasm_file(system_impl_binary.path);
+		auto read_after = benchmark_clock_t::now();
+
+		load_message.file_size_bytes = static_cast<int64_t>(wasm_bytes.size());
+		load_message.read_duration_ms = to_ms(read_after - read_before);
+
+		auto load_before = benchmark_clock_t::now();
+		auto loaded = load(
+			wasm_bytes,
+			static_cast<int32_t>(system_ids.size()),
+			system_ids.data(),
+			export_names_c.data()
+		);
+		auto load_after = benchmark_clock_t::now();
+
+		if(!loaded) {
+			return 1;
+		}
+
+		load_message.load_duration_ms = to_ms(load_after - load_before);
+
+		if(system_ids.empty()) {
+			reporter.report(warning_message{
+				"Per export load times for " + path_str +
+					" require export names and system IDs in the <system_impl> "
+					"argument",
+			});
+		}
+
+		for(auto i = 0; system_ids.size() > i; ++i) {
+			unload();
+
+			auto export_before = benchmark_clock_t::now();
+			loaded = load(wasm_bytes, 1, &system_ids[i], &export_names_c[i]);
+			auto export_after = benchmark_clock_t::now();
+
+			if(!loaded) {
+				return 1;
+			}
+
+			load_message.exports.push_back(wasm_export_load_report_item{
+				.export_name = export_names[i],
+				.system_id = system_ids[i],
+				.load_duration_ms = to_ms(export_after - export_before),
+			});
+		}
+
+		reporter.report(load_message);
+
+		auto result_message = wasm_reload_result_message{};
+		result_message.path = path_str;
+		result_message.iterations = iterations;
+
+		auto progress_message = benchmark_progress_message{};
+		auto reload_durations = std::vector<nanoseconds>{};
+		reload_durations.resize(iterations);
+
+		result_message.rss_before_bytes = current_rss_bytes();
+		auto allocs_before = current_alloc_counts();
+
+		for(auto i = 0; iterations > i; ++i) {
+			auto before = benchmark_clock_t::now();
+			unload();
+			loaded = load(
+				wasm_bytes,
+				static_cast<int32_t>(system_ids.size()),
+				system_ids.data(),
+				export_names_c.data()
+			);
+			auto after = benchmark_clock_t::now();
+
+			if(!loaded) {
+				return 1;
+			}
+
+			reload_durations[i] = duration_cast<nanoseconds>(after - before);
+
+			if(i % iteration_report_interval == 0) {
+				progress_message.progress =
+					static_cast<float>(i) / static_cast<float>(iterations);
+				reporter.report(progress_message);
+			}
+		}
+
+		auto allocs = current_alloc_counts() - allocs_before;
+		result_message.rss_after_bytes = current_rss_bytes();
+		result_message.rss_growth_bytes =
+			static_cast<int64_t>(result_message.rss_after_bytes) -
+			static_cast<int64_t>(result_message.rss_before_bytes);
+		if(is_counting_allocs()) {
+			result_message.allocations = allocs.allocations;
+			result_message.deallocations = allocs.deallocations;
+		}
+
+		auto total_duration = nanoseconds{};
+		for(auto d : reload_durations) {
+			total_duration += d;
+		}
+
+		result_message.total_duration_ms = to_ms(total_duration);
+		result_message.reload_latency =
+			to_latency_report(compute_latency_stats(reload_durations));
+
+		reporter.report(result_message);
+	}
+
+	return 0;
+}
+
+int ecsact::cli::detail::benchmark_command(int argc, const char* argv[]) {
+	using namespace std::string_literals;
+	using namespace std::chrono_literals;
+
+	auto args = docopt::docopt(USAGE, {argv + 1, argv + argc}, false);
+
+	if(args["--help"] && args["--help"].asBool()) {
+		std::cout << USAGE << OPTIONS;
+		return 0;
+	}
+
+	auto mode = args["--mode"] ? args["--mode"].asString() : "execute"s;
+	auto async = //
+		args["--async"] ? std::optional(args["--async"].asString()) : std::nullopt;
+	auto iterations = expect_docopt_value_long(args, "--iterations", 10000L);
+	auto iteration_report_interval =
+		expect_docopt_value_long(args, "--iteration_report_interval", 100L);
+	auto runtime_path = args["--runtime"].asString();
+	auto seed_path = args["--seed"] ? args["--seed"].asString() : ""s;
+	auto window_ticks = expect_docopt_value_long(args, "--window", 10000L);
+	auto step_duration_seconds =
+		expect_docopt_value_long(args, "--step_duration", 10L);
+	auto deadline_ms = expect_docopt_value_long(args, "--deadline", 100L);
+	auto rate_steps = parse_rate_steps(
+		args["--rate"] ? args["--rate"].asString() : "30,60,120,240,480,960"s
+	);
+	auto profile_path = args["--profile"] //
+		? std::optional(fs::path{args["--profile"].asString()})
+		: std::nullopt;
+	auto profraw_path = args["--profraw"] //
+		? std::optional(fs::path{args["--profraw"].asString()})
+		: std::nullopt;
+	auto system_impl_binaries =
+		args["<system_impl>"].asStringList() |
+		std::views::transform( //
+			[](auto& str) { return system_impl_binary_arg::parse(str); }
+		);
+	auto reporter = stdout_json_benchmark_reporter{};
+
+	if(mode != "execute" && mode != "serialize" && mode != "wasm-reload" &&
+		 mode != "soak" && mode != "async-load") {
+		std::cerr //
+			<< "[ERROR] Invalid --mode value: " << mode << "\n"
+			<< "For details run:\tecsact benchmark --help\n";
+		return 1;
+	}
+
+	if(mode != "serialize" && system_impl_binaries.empty()) {
+		std::cerr //
+			<< "[ERROR] At least one <system_impl> is required in " << mode
+			<< " mode\n";
+		return 1;
+	}
+
+	if(mode != "execute" && mode != "async-load" && async) {
+		std::cerr //
+			<< "[ERROR] --async may only be used in execute and async-load mode\n";
+		return 1;
+	}
+
+	if(mode == "async-load" && !async) {
+		std::cerr << "[ERROR] --async is required in async-load mode\n";
+		return 1;
+	}
+
+	if(!rate_steps || rate_steps->empty()) {
+		std::cerr //
+			<< "[ERROR] --rate must be a comma separated list of positive rates\n";
+		return 1;
+	}
+
+	if(step_duration_seconds <= 0 || deadline_ms <= 0) {
+		std::cerr //
+			<< "[ERROR] --step_duration and --deadline must be greater than 0\n";
+		return 1;
+	}
+
+	if(window_ticks <= 0) {
+		std::cerr << "[ERROR] --window must be greater than 0\n";
+		return 1;
+	}
+
+	if(profile_path && (mode != "execute" || async)) {
+		std::cerr //
+			<< "[ERROR] --profile may only be used in execute mode without "
+			<< "--async\n";
+		return 1;
+	}
+
+	if(mode != "wasm-reload" && seed_path.empty()) {
+		std::cerr << "[ERROR] --seed is required in " << mode << " mode\n";
+		return 1;
+	}
+
+	auto ec = std::error_code{};
+	auto runtime = boost::dll::shared_library();
+
+	exists_or_exit(runtime_path);
+
+	// Read by the profile runtime of an instrumented runtime when it is loaded
+	if(profraw_path) {
+		auto profraw_str = fs::absolute(*profraw_path).string();
+#ifdef _WIN32
+		_putenv_s("LLVM_PROFILE_FILE", profraw_str.c_str());
+#else
+		setenv("LLVM_PROFILE_FILE", profraw_str.c_str(), 1);
+#endif
+	}
+
+	runtime.load(runtime_path, ec);
+	if(ec) {
+		std::cerr //
+			<< "Failed to load runtime " << runtime_path << ": " << ec.message()
+			<< "\n";
+		return ec.value();
+	}
+
+	// Only the runtime's allocations are counted, not the benchmark's own
+	count_library_allocs(runtime.native());
+
+	if(mode == "wasm-reload") {
+		return start_wasm_reload_benchmark(
+			runtime,
+			reporter,
+			system_impl_binaries,
+			iterations,
+			iteration_report_interval
+		);
+	}
+
+	exists_or_exit(seed_path);
+
+	auto load_exit_code =
+		load_system_impls(runtime, reporter, system_impl_binaries);
+	if(load_exit_code != 0) {
+		return load_exit_code;
 	}
 
 	auto evc = ecsact_execution_events_collector{};
 	auto event_summary = std::optional<event_summary_report_message>{};
 
-	if(args["--events"]) {
+	// soak mode always counts events to report them per window
+	if(args["--events"] || mode == "soak") {
 		auto event_summary_ptr = &event_summary.emplace();
 		evc.init_callback = &report_component_event_summary;
 		evc.init_callback_user_data = event_summary_ptr;
@@ -691,10 +2235,93 @@ int ecsact::cli::detail::benchmark_command(int argc, char* argv[]) {
 		.iteration_report_interval = iteration_report_interval,
 	};
 
+	if(mode == "serialize") {
+		auto serialize_result = start_serialize_benchmark(benchmark_options);
+		if(!serialize_result) {
+			return 1;
+		}
+
+		reporter.report(*serialize_result);
+		return 0;
+	}
+
+	if(mode == "async-load") {
+		auto load_result = start_async_load_benchmark(
+			async.value(),
+			benchmark_options,
+			async_load_options{
+				.rates = std::move(*rate_steps),
+				.step_duration = std::chrono::seconds{step_duration_seconds},
+				.deadline = std::chrono::milliseconds{deadline_ms},
+			}
+		);
+		if(!load_result) {
+			return 1;
+		}
+
+		if(event_summary.has_value()) {
+			reporter.report(event_summary.value());
+		}
+
+		reporter.report(*load_result);
+		return 0;
+	}
+
+	if(mode == "soak") {
+		auto soak_result = start_soak_benchmark(
+			benchmark_options,
+			window_ticks,
+			event_summary.value()
+		);
+		if(!soak_result) {
+			return 1;
+		}
+
+		if(args["--events"]) {
+			reporter.report(event_summary.value());
+		}
+
+		reporter.report(*soak_result);
+		return 0;
+	}
+
 	auto result_message = std::optional<benchmark_result_message>{};
 
 	if(async) {
 		result_message = start_async_benchmark(async.value(), benchmark_options);
+	} else if(profile_path) {
+		auto profiling = ecsact::cli::detail::start_sampling_profiler(
+			profile_sample_interval,
+			profile_max_samples
+		);
+		if(!profiling) {
+			reporter.report(warning_message{
+				"CPU sampling is not available on this platform. --profile ignored",
+			});
+		}
+
+		result_message = start_core_benchmark(benchmark_options);
+
+		if(profiling) {
+			auto samples = ecsact::cli::detail::stop_sampling_profiler();
+			auto profile_file = std::ofstream{*profile_path};
+			if(!profile_file) {
+				std::cerr << "Failed to open profile path: " << *profile_path << "\n";
+				return 1;
+			}
+
+			ecsact::cli::detail::write_folded_stacks(samples, profile_file);
+
+			auto sample_interval =
+				duration_cast<duration<float, std::milli>>(profile_sample_interval);
+
+			reporter.report(profile_message{
+				.path = profile_path->string(),
+				.sample_count = samples.stacks.size(),
+				.dropped_sample_count = samples.dropped_sample_count,
+				.sample_interval_ms = sample_interval.count(),
+			});
+		}
 	} else {
 		result_message = start_core_benchmark(benchmark_options);
 	}
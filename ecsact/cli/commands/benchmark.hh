@@ -6,7 +6,7 @@
 
 namespace ecsact::cli::detail {
 
-int benchmark_command(int argc, char* argv[]);
+int benchmark_command(int argc, const char* argv[]);
 static_assert(std::is_same_v<command_fn_t, decltype(&benchmark_command)>);
 
 } // namespace ecsact::cli::detail
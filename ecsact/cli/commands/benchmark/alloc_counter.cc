@@ -0,0 +1,384 @@
+#include "ecsact/cli/commands/benchmark/alloc_counter.hh"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <span>
+#include <string_view>
+
+#if defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__))
+#	define ECSACT_CLI_ELF_ALLOC_HOOKS
+#	include <dlfcn.h>
+#	include <link.h>
+#	include <malloc.h>
+#	include <sys/mman.h>
+#	include <unistd.h>
+#endif
+
+static auto _allocations = std::atomic_uint64_t{};
+static auto _deallocations = std::atomic_uint64_t{};
+static auto _allocated_bytes = std::atomic_uint64_t{};
+static auto _counting = std::atomic_bool{};
+
+static auto count_alloc(std::size_t size) -> void {
+	_allocations.fetch_add(1, std::memory_order_relaxed);
+	_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+static auto count_dealloc() -> void {
+	_deallocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+auto ecsact::cli::detail::is_counting_allocs() -> bool {
+	return _counting.load(std::memory_order_relaxed);
+}
+
+auto ecsact::cli::detail::current_alloc_counts() -> alloc_counts {
+	return {
+		.allocations = _allocations.load(std::memory_order_relaxed),
+		.deallocations = _deallocations.load(std::memory_order_relaxed),
+		.allocated_bytes = _allocated_bytes.load(std::memory_order_relaxed),
+	};
+}
+
+#ifdef ECSACT_CLI_ELF_ALLOC_HOOKS
+
+// Replacements the library's imports are pointed at. Each forwards to what
+// the import would have resolved to.
+
+static auto counted_malloc(std::size_t size) -> void* {
+	auto ptr = std::malloc(size);
+	if(ptr != nullptr) {
+		count_alloc(size);
+	}
+	return ptr;
+}
+
+static auto counted_calloc(std::size_t count, std::size_t size) -> void* {
+	auto ptr = std::calloc(count, size);
+	if(ptr != nullptr) {
+		count_alloc(count * size);
+	}
+	return ptr;
+}
+
+static auto counted_realloc(void* ptr, std::size_t size) -> void* {
+	auto new_ptr = std::realloc(ptr, size);
+	// realloc(ptr, 0) frees ptr and may return null
+	if(ptr != nullptr && (new_ptr != nullptr || size == 0)) {
+		count_dealloc();
+	}
+	if(new_ptr != nullptr) {
+		count_alloc(size);
+	}
+	return new_ptr;
+}
+
+static auto counted_free(void* ptr) -> void {
+	if(ptr != nullptr) {
+		count_dealloc();
+	}
+	std::free(ptr);
+}
+
+static auto counted_aligned_alloc( //
+	std::size_t alignment,
+	std::size_t size
+) -> void* {
+	auto ptr = std::aligned_alloc(alignment, size);
+	if(ptr != nullptr) {
+		count_alloc(size);
+	}
+	return ptr;
+}
+
+static auto counted_memalign( //
+	std::size_t alignment,
+	std::size_t size
+) -> void* {
+	auto ptr = ::memalign(alignment, size);
+	if(ptr != nullptr) {
+		count_alloc(size);
+	}
+	return ptr;
+}
+
+static auto counted_posix_memalign(
+	void**      out_ptr,
+	std::size_t alignment,
+	std::size_t size
+) -> int {
+	auto result = ::posix_memalign(out_ptr, alignment, size);
+	if(result == 0) {
+		count_alloc(size);
+	}
+	return result;
+}
+
+static auto counted_new(std::size_t size) -> void* {
+	auto ptr = ::operator new(size);
+	count_alloc(size);
+	return ptr;
+}
+
+static auto counted_new_array(std::size_t size) -> void* {
+	auto ptr = ::operator new[](size);
+	count_alloc(size);
+	return ptr;
+}
+
+static auto counted_delete(void* ptr) noexcept -> void {
+	if(ptr != nullptr) {
+		count_dealloc();
+	}
+	::operator delete(ptr);
+}
+
+static auto counted_delete_array(void* ptr) noexcept -> void {
+	if(ptr != nullptr) {
+		count_dealloc();
+	}
+	::operator delete[](ptr);
+}
+
+static auto counted_sized_delete(void* ptr, std::size_t) noexcept -> void {
+	counted_delete(ptr);
+}
+
+static auto counted_sized_delete_array(void* ptr, std::size_t) noexcept
+	-> void {
+	counted_delete_array(ptr);
+}
+
+struct alloc_hook {
+	std::string_view name;
+	void*            replacement;
+};
+
+static auto find_alloc_hook(std::string_view name) -> void* {
+	static const alloc_hook hooks[] = {
+		{"malloc", reinterpret_cast<void*>(&counted_malloc)},
+		{"calloc", reinterpret_cast<void*>(&counted_calloc)},
+		{"realloc", reinterpret_cast<void*>(&counted_realloc)},
+		{"free", reinterpret_cast<void*>(&counted_free)},
+		{"aligned_alloc", reinterpret_cast<void*>(&counted_aligned_alloc)},
+		{"memalign", reinterpret_cast<void*>(&counted_memalign)},
+		{"posix_memalign", reinterpret_cast<void*>(&counted_posix_memalign)},
+		// operator new/delete of a dynamically linked C++ standard library. Its
+		// own malloc calls aren't redirected so nothing is counted twice.
+		{"_Znwm", reinterpret_cast<void*>(&counted_new)},
+		{"_Znam", reinterpret_cast<void*>(&counted_new_array)},
+		{"_ZdlPv", reinterpret_cast<void*>(&counted_delete)},
+		{"_ZdaPv", reinterpret_cast<void*>(&counted_delete_array)},
+		{"_ZdlPvm", reinterpret_cast<void*>(&counted_sized_delete)},
+		{"_ZdaPvm", reinterpret_cast<void*>(&counted_sized_delete_array)},
+	};
+
+	for(auto& hook : hooks) {
+		if(hook.name == name) {
+			return hook.replacement;
+		}
+	}
+	return nullptr;
+}
+
+#	if defined(__x86_64__)
+constexpr auto ELF_JUMP_SLOT = R_X86_64_JUMP_SLOT;
+constexpr auto ELF_GLOB_DAT = R_X86_64_GLOB_DAT;
+#	elif defined(__aarch64__)
+constexpr auto ELF_JUMP_SLOT = R_AARCH64_JUMP_SLOT;
+constexpr auto ELF_GLOB_DAT = R_AARCH64_GLOB_DAT;
+#	endif
+
+struct elf_object {
+	ElfW(Addr)       base = 0;
+	const ElfW(Sym)* symbols = nullptr;
+	const char*      strings = nullptr;
+
+	/** Read only after relocation (-z relro) */
+	ElfW(Addr) relro_begin = 0;
+	ElfW(Addr) relro_end = 0;
+};
+
+/**
+ * Point the GOT entry at @p slot_addr to @p replacement. Entries in the
+ * read only after relocation range are made writable for the write.
+ */
+static auto write_got_entry(
+	const elf_object& object,
+	ElfW(Addr)        slot_addr,
+	void*             replacement
+) -> void {
+	auto is_relro =
+		slot_addr >= object.relro_begin && object.relro_end > slot_addr;
+	auto page_size = static_cast<ElfW(Addr)>(::sysconf(_SC_PAGESIZE));
+	auto page = reinterpret_cast<void*>(slot_addr & ~(page_size - 1));
+
+	if(is_relro) {
+		::mprotect(page, page_size, PROT_READ | PROT_WRITE);
+	}
+
+	*reinterpret_cast<void**>(slot_addr) = replacement;
+
+	if(is_relro) {
+		::mprotect(page, page_size, PROT_READ);
+	}
+}
+
+static auto hook_relocations(
+	const elf_object&            object,
+	std::span<const ElfW(Rela)> relocations
+) -> void {
+	for(auto& relocation : relocations) {
+		auto type = ELF64_R_TYPE(relocation.r_info);
+		if(type != ELF_JUMP_SLOT && type != ELF_GLOB_DAT) {
+			continue;
+		}
+
+		auto& symbol = object.symbols[ELF64_R_SYM(relocation.r_info)];
+		auto  replacement = find_alloc_hook(object.strings + symbol.st_name);
+		if(replacement != nullptr) {
+			write_got_entry(object, object.base + relocation.r_offset, replacement);
+		}
+	}
+}
+
+static auto hook_elf_object(const dl_phdr_info& info) -> bool {
+	auto object = elf_object{.base = info.dlpi_addr};
+	auto dynamic = static_cast<const ElfW(Dyn)*>(nullptr);
+
+	for(auto i = 0; info.dlpi_phnum > i; ++i) {
+		auto& phdr = info.dlpi_phdr[i];
+		if(phdr.p_type == PT_DYNAMIC) {
+			dynamic =
+				reinterpret_cast<const ElfW(Dyn)*>(info.dlpi_addr + phdr.p_vaddr);
+		} else if(phdr.p_type == PT_GNU_RELRO) {
+			object.relro_begin = info.dlpi_addr + phdr.p_vaddr;
+			object.relro_end = object.relro_begin + phdr.p_memsz;
+		}
+	}
+
+	if(dynamic == nullptr) {
+		return false;
+	}
+
+	// glibc relocates the dynamic section addresses in place, other loaders
+	// leave them relative to the base
+	auto to_addr = [&](ElfW(Addr) addr) -> ElfW(Addr) {
+		return addr < object.base ? addr + object.base : addr;
+	};
+
+	auto plt_relocations = ElfW(Addr){};
+	auto plt_relocations_size = std::size_t{};
+	auto plt_relocation_type = ElfW(Sxword){};
+	auto relocations = ElfW(Addr){};
+	auto relocations_size = std::size_t{};
+
+	for(auto entry = dynamic; entry->d_tag != DT_NULL; ++entry) {
+		switch(entry->d_tag) {
+			case DT_SYMTAB:
+				object.symbols =
+					reinterpret_cast<const ElfW(Sym)*>(to_addr(entry->d_un.d_ptr));
+				break;
+			case DT_STRTAB:
+				object.strings =
+					reinterpret_cast<const char*>(to_addr(entry->d_un.d_ptr));
+				break;
+			case DT_JMPREL:
+				plt_relocations = to_addr(entry->d_un.d_ptr);
+				break;
+			case DT_PLTRELSZ:
+				plt_relocations_size = entry->d_un.d_val;
+				break;
+			case DT_PLTREL:
+				plt_relocation_type = static_cast<ElfW(Sxword)>(entry->d_un.d_val);
+				break;
+			case DT_RELA:
+				relocations = to_addr(entry->d_un.d_ptr);
+				break;
+			case DT_RELASZ:
+				relocations_size = entry->d_un.d_val;
+				break;
+		}
+	}
+
+	if(object.symbols == nullptr || object.strings == nullptr) {
+		return false;
+	}
+
+	auto as_relocations = [](ElfW(Addr) addr, std::size_t size) {
+		return std::span{
+			reinterpret_cast<const ElfW(Rela)*>(addr),
+			size / sizeof(ElfW(Rela)),
+		};
+	};
+
+	// Calls go through the PLT entries (JUMP_SLOT) and -fno-plt calls or
+	// taken addresses through plain GOT entries (GLOB_DAT)
+	if(plt_relocations != 0 && plt_relocation_type == DT_RELA) {
+		hook_relocations(
+			object,
+			as_relocations(plt_relocations, plt_relocations_size)
+		);
+	}
+	if(relocations != 0) {
+		hook_relocations(object, as_relocations(relocations, relocations_size));
+	}
+
+	return true;
+}
+
+struct hook_library_context {
+	ElfW(Addr) address_in_library = 0;
+	bool       hooked = false;
+};
+
+static auto hook_library_callback(
+	dl_phdr_info* info,
+	std::size_t,
+	void* user_data
+) -> int {
+	auto context = static_cast<hook_library_context*>(user_data);
+
+	for(auto i = 0; info->dlpi_phnum > i; ++i) {
+		auto& phdr = info->dlpi_phdr[i];
+		if(phdr.p_type != PT_LOAD) {
+			continue;
+		}
+
+		auto begin = info->dlpi_addr + phdr.p_vaddr;
+		if(context->address_in_library >= begin &&
+			 begin + phdr.p_memsz > context->address_in_library) {
+			context->hooked = hook_elf_object(*info);
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+auto ecsact::cli::detail::count_library_allocs(void* library_handle) -> bool {
+	auto link_map = static_cast<struct link_map*>(nullptr);
+	if(::dlinfo(library_handle, RTLD_DI_LINKMAP, &link_map) != 0) {
+		return false;
+	}
+
+	// The library's dynamic section lies in one of its loaded segments
+	auto context = hook_library_context{
+		.address_in_library = reinterpret_cast<ElfW(Addr)>(link_map->l_ld),
+	};
+	::dl_iterate_phdr(&hook_library_callback, &context);
+
+	if(context.hooked) {
+		_counting.store(true, std::memory_order_relaxed);
+	}
+	return context.hooked;
+}
+
+#else
+
+auto ecsact::cli::detail::count_library_allocs(void*) -> bool {
+	return false;
+}
+
+#endif
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+
+namespace ecsact::cli::detail {
+
+struct alloc_counts {
+	std::uint64_t allocations = 0;
+	std::uint64_t deallocations = 0;
+	std::uint64_t allocated_bytes = 0;
+
+	constexpr auto operator-(const alloc_counts& other) const -> alloc_counts {
+		return {
+			.allocations = allocations - other.allocations,
+			.deallocations = deallocations - other.deallocations,
+			.allocated_bytes = allocated_bytes - other.allocated_bytes,
+		};
+	}
+
+	constexpr auto operator+=(const alloc_counts& other) -> alloc_counts& {
+		allocations += other.allocations;
+		deallocations += other.deallocations;
+		allocated_bytes += other.allocated_bytes;
+		return *this;
+	}
+};
+
+/**
+ * Count the allocations of an already loaded shared library from now on. Its
+ * imports of the C library's malloc family (and of operator new/delete when
+ * it links the C++ standard library dynamically) are redirected through the
+ * counters. A C++ standard library linked statically into the library (the
+ * default for `ecsact build` on clang) still allocates through the C
+ * library's malloc so those allocations are counted too. Allocations of the
+ * rest of the process are not.
+ *
+ * @param library_handle native handle of the library (`dlopen` result)
+ * @returns `false` if counting is not supported on this platform or the
+ *          library could not be found
+ */
+auto count_library_allocs(void* library_handle) -> bool;
+
+/**
+ * Whether `count_library_allocs` succeeded for any library. Allocation counts
+ * should not be reported otherwise.
+ */
+auto is_counting_allocs() -> bool;
+
+/**
+ * Snapshot of the counters of every library passed to `count_library_allocs`
+ */
+auto current_alloc_counts() -> alloc_counts;
+
+} // namespace ecsact::cli::detail
@@ -0,0 +1,33 @@
+#include "ecsact/cli/commands/benchmark/growth_detection.hh"
+
+#include <algorithm>
+#include <cmath>
+
+auto ecsact::cli::detail::is_monotonic_growth( //
+	std::span<const double> values,
+	double                  tolerance
+) -> bool {
+	if(values.size() < 3) {
+		return false;
+	}
+
+	auto running_max = values.front();
+	for(auto value : values.subspan(1)) {
+		if(value < running_max - std::abs(running_max) * tolerance) {
+			return false;
+		}
+		running_max = std::max(running_max, value);
+	}
+
+	auto first = values.front();
+	auto last = values.back();
+	if(last <= first + std::abs(first) * tolerance) {
+		return false;
+	}
+
+	// Both halves include the middle window
+	auto middle = values.size() / 2;
+	auto earlier_max = std::ranges::max(values.first(middle + 1));
+	auto later_max = std::ranges::max(values.subspan(middle));
+	return later_max > earlier_max + std::abs(earlier_max) * tolerance;
+}
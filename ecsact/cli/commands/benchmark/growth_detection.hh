@@ -0,0 +1,26 @@
+#pragma once
+
+#include <span>
+
+namespace ecsact::cli::detail {
+
+/**
+ * Detects steady growth across a series of per window measurements (latency,
+ * memory, live allocations.) Every value must stay within @p tolerance of the
+ * largest value seen so far, the last value must exceed the first by more
+ * than @p tolerance and the largest value of the later half of the windows
+ * must exceed the largest of the earlier half by more than @p tolerance.
+ * Noise around a flat line and a rise that levels off (the usual shape after
+ * warm up) are therefore not reported while a slow climb with small dips is.
+ *
+ * @param values measurements in window order
+ * @param tolerance relative amount (0.05 = 5%) values may dip or grow without
+ *        being considered growth
+ * @returns `false` if there are fewer than 3 values
+ */
+auto is_monotonic_growth( //
+	std::span<const double> values,
+	double                  tolerance
+) -> bool;
+
+} // namespace ecsact::cli::detail
@@ -0,0 +1,22 @@
+#include "ecsact/cli/commands/benchmark/latency_report.hh"
+
+using std::chrono::duration;
+using std::chrono::duration_cast;
+using std::chrono::nanoseconds;
+
+auto ecsact::cli::detail::to_latency_report(const latency_stats& stats)
+	-> latency_report_item {
+	auto to_ms = [](nanoseconds d) {
+		return duration_cast<duration<float, std::milli>>(d).count();
+	};
+
+	return latency_report_item{
+		.min_ms = to_ms(stats.min),
+		.max_ms = to_ms(stats.max),
+		.mean_ms = to_ms(stats.mean),
+		.p50_ms = to_ms(stats.p50),
+		.p90_ms = to_ms(stats.p90),
+		.p99_ms = to_ms(stats.p99),
+		.p999_ms = to_ms(stats.p999),
+	};
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "nlohmann/json.hpp"
+#include "ecsact/cli/commands/benchmark/latency_stats.hh"
+
+namespace ecsact::cli::detail {
+
+/**
+ * Latency percentiles in milliseconds as they appear in benchmark reports
+ */
+struct latency_report_item {
+	float min_ms = 0.f;
+	float max_ms = 0.f;
+	float mean_ms = 0.f;
+	float p50_ms = 0.f;
+	float p90_ms = 0.f;
+	float p99_ms = 0.f;
+	float p999_ms = 0.f;
+
+	NLOHMANN_DEFINE_TYPE_INTRUSIVE(
+		latency_report_item,
+		min_ms,
+		max_ms,
+		mean_ms,
+		p50_ms,
+		p90_ms,
+		p99_ms,
+		p999_ms
+	);
+};
+
+auto to_latency_report(const latency_stats& stats) -> latency_report_item;
+
+} // namespace ecsact::cli::detail
@@ -0,0 +1,48 @@
+#include "ecsact/cli/commands/benchmark/latency_stats.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using std::chrono::nanoseconds;
+
+static auto nearest_rank( //
+	std::span<const nanoseconds> sorted_durations,
+	double                       percentile
+) -> nanoseconds {
+	auto rank = static_cast<size_t>(
+		std::ceil(percentile * static_cast<double>(sorted_durations.size()))
+	);
+
+	if(rank == 0) {
+		rank = 1;
+	}
+
+	return sorted_durations[std::min(rank, sorted_durations.size()) - 1];
+}
+
+auto ecsact::cli::detail::compute_latency_stats( //
+	std::span<const nanoseconds> durations
+) -> latency_stats {
+	if(durations.empty()) {
+		return {};
+	}
+
+	auto sorted = std::vector<nanoseconds>{durations.begin(), durations.end()};
+	std::ranges::sort(sorted);
+
+	auto total = nanoseconds{};
+	for(auto d : sorted) {
+		total += d;
+	}
+
+	return latency_stats{
+		.min = sorted.front(),
+		.max = sorted.back(),
+		.mean = total / static_cast<nanoseconds::rep>(sorted.size()),
+		.p50 = nearest_rank(sorted, 0.50),
+		.p90 = nearest_rank(sorted, 0.90),
+		.p99 = nearest_rank(sorted, 0.99),
+		.p999 = nearest_rank(sorted, 0.999),
+	};
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <chrono>
+#include <span>
+
+namespace ecsact::cli::detail {
+
+struct latency_stats {
+	std::chrono::nanoseconds min = {};
+	std::chrono::nanoseconds max = {};
+	std::chrono::nanoseconds mean = {};
+	std::chrono::nanoseconds p50 = {};
+	std::chrono::nanoseconds p90 = {};
+	std::chrono::nanoseconds p99 = {};
+	std::chrono::nanoseconds p999 = {};
+};
+
+/**
+ * Nearest-rank percentiles of @p durations. All zeros if @p durations is
+ * empty.
+ */
+auto compute_latency_stats( //
+	std::span<const std::chrono::nanoseconds> durations
+) -> latency_stats;
+
+} // namespace ecsact::cli::detail
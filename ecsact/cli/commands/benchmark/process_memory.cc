@@ -0,0 +1,75 @@
+#include "ecsact/cli/commands/benchmark/process_memory.hh"
+
+#ifdef _WIN32
+#	include <windows.h>
+#	include <psapi.h>
+#elif defined(__APPLE__)
+#	include <mach/mach.h>
+#	include <sys/resource.h>
+#else
+#	include <cstdio>
+#	include <unistd.h>
+#	include <sys/resource.h>
+#endif
+
+auto ecsact::cli::detail::current_rss_bytes() -> std::uint64_t {
+#ifdef _WIN32
+	auto counters = PROCESS_MEMORY_COUNTERS{};
+	if(!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+		return 0;
+	}
+	return static_cast<std::uint64_t>(counters.WorkingSetSize);
+#elif defined(__APPLE__)
+	auto info = mach_task_basic_info_data_t{};
+	auto count = mach_msg_type_number_t{MACH_TASK_BASIC_INFO_COUNT};
+	auto err = task_info(
+		mach_task_self(),
+		MACH_TASK_BASIC_INFO,
+		reinterpret_cast<task_info_t>(&info),
+		&count
+	);
+	if(err != KERN_SUCCESS) {
+		return 0;
+	}
+	return static_cast<std::uint64_t>(info.resident_size);
+#else
+	auto statm = std::fopen("/proc/self/statm", "r");
+	if(statm == nullptr) {
+		return 0;
+	}
+
+	long total_pages = 0;
+	long resident_pages = 0;
+	auto matched = std::fscanf(statm, "%ld %ld", &total_pages, &resident_pages);
+	std::fclose(statm);
+
+	if(matched != 2) {
+		return 0;
+	}
+
+	return static_cast<std::uint64_t>(resident_pages) *
+		static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+auto ecsact::cli::detail::peak_rss_bytes() -> std::uint64_t {
+#ifdef _WIN32
+	auto counters = PROCESS_MEMORY_COUNTERS{};
+	if(!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+		return 0;
+	}
+	return static_cast<std::uint64_t>(counters.PeakWorkingSetSize);
+#else
+	auto usage = rusage{};
+	if(getrusage(RUSAGE_SELF, &usage) != 0) {
+		return 0;
+	}
+#	ifdef __APPLE__
+	// ru_maxrss is in bytes on macOS
+	return static_cast<std::uint64_t>(usage.ru_maxrss);
+#	else
+	// ru_maxrss is in kilobytes on linux
+	return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024;
+#	endif
+#endif
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+namespace ecsact::cli::detail {
+
+/**
+ * Resident set size of the current process in bytes. 0 if the platform does
+ * not support getting the resident set size.
+ */
+auto current_rss_bytes() -> std::uint64_t;
+
+/**
+ * Peak resident set size of the current process in bytes. 0 if the platform
+ * does not support getting the peak resident set size.
+ */
+auto peak_rss_bytes() -> std::uint64_t;
+
+} // namespace ecsact::cli::detail
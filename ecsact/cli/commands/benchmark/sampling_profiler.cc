@@ -0,0 +1,223 @@
+#include "ecsact/cli/commands/benchmark/sampling_profiler.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <format>
+#include <map>
+#include <string>
+#include <unordered_map>
+
+#ifndef _WIN32
+#	include <cxxabi.h>
+#	include <dlfcn.h>
+#	include <execinfo.h>
+#	include <sys/time.h>
+#endif
+
+using namespace std::string_literals;
+
+namespace {
+constexpr auto max_stack_depth = 64;
+
+/**
+ * Frames recorded by `backtrace` that belong to the signal handler itself
+ * (the handler and the kernel signal trampoline.)
+ */
+constexpr auto signal_frame_count = 2;
+
+auto _frames = std::vector<void*>{};
+auto _depths = std::vector<int>{};
+auto _max_samples = std::size_t{};
+auto _next_sample = std::atomic_size_t{};
+auto _dropped_samples = std::atomic_uint64_t{};
+
+thread_local volatile std::sig_atomic_t _profile_scope_active = 0;
+
+#ifndef _WIN32
+struct sigaction _prev_sigprof_action = {};
+
+auto on_sigprof(int) -> void {
+	if(!_profile_scope_active) {
+		return;
+	}
+
+	auto saved_errno = errno;
+	auto index = _next_sample.fetch_add(1, std::memory_order_relaxed);
+
+	if(index < _max_samples) {
+		_depths[index] = backtrace( //
+			_frames.data() + (index * max_stack_depth),
+			max_stack_depth
+		);
+	} else {
+		_dropped_samples.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	errno = saved_errno;
+}
+
+auto symbolize(void* addr) -> std::string {
+	auto info = Dl_info{};
+	if(dladdr(addr, &info) == 0 || info.dli_fname == nullptr) {
+		return std::format("{}", addr);
+	}
+
+	auto module = std::string{info.dli_fname};
+	if(auto slash = module.find_last_of("/\\"); slash != std::string::npos) {
+		module = module.substr(slash + 1);
+	}
+
+	if(info.dli_sname == nullptr) {
+		auto offset = reinterpret_cast<std::uintptr_t>(addr) -
+			reinterpret_cast<std::uintptr_t>(info.dli_fbase);
+		return std::format("{}+0x{:x}", module, offset);
+	}
+
+	auto status = int{};
+	auto demangled =
+		abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+	auto symbol = status == 0 ? std::string{demangled} : info.dli_sname;
+	std::free(demangled);
+
+	// ';' separates frames in the folded stacks format
+	for(auto& c : symbol) {
+		if(c == ';') {
+			c = ':';
+		}
+	}
+
+	return module + "!" + symbol;
+}
+#else
+auto symbolize(void* addr) -> std::string {
+	return std::format("{}", addr);
+}
+#endif
+} // namespace
+
+auto ecsact::cli::detail::start_sampling_profiler( //
+	std::chrono::microseconds interval,
+	std::size_t               max_samples
+) -> bool {
+#ifdef _WIN32
+	return false;
+#else
+	_max_samples = max_samples;
+	_frames.assign(max_samples * max_stack_depth, nullptr);
+	_depths.assign(max_samples, 0);
+	_next_sample = 0;
+	_dropped_samples = 0;
+
+	// The first call to backtrace may load the unwinder which is not safe to do
+	// inside of a signal handler.
+	void* warmup_frames[1];
+	backtrace(warmup_frames, 1);
+
+	struct sigaction action = {};
+	action.sa_handler = &on_sigprof;
+	action.sa_flags = SA_RESTART;
+	sigemptyset(&action.sa_mask);
+
+	if(sigaction(SIGPROF, &action, &_prev_sigprof_action) != 0) {
+		return false;
+	}
+
+	auto timer = itimerval{};
+	timer.it_interval.tv_sec = static_cast<time_t>(interval.count() / 1000000);
+	timer.it_interval.tv_usec =
+		static_cast<suseconds_t>(interval.count() % 1000000);
+	timer.it_value = timer.it_interval;
+
+	if(setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+		sigaction(SIGPROF, &_prev_sigprof_action, nullptr);
+		return false;
+	}
+
+	return true;
+#endif
+}
+
+auto ecsact::cli::detail::stop_sampling_profiler() -> profile_samples {
+	auto samples = profile_samples{};
+
+#ifndef _WIN32
+	auto timer = itimerval{};
+	setitimer(ITIMER_PROF, &timer, nullptr);
+	sigaction(SIGPROF, &_prev_sigprof_action, nullptr);
+
+	auto sample_count =
+		std::min(_next_sample.load(std::memory_order_relaxed), _max_samples);
+
+	samples.stacks.reserve(sample_count);
+	samples.dropped_sample_count = _dropped_samples.load();
+
+	for(auto i = std::size_t{}; sample_count > i; ++i) {
+		auto frames_begin = _frames.begin() + (i * max_stack_depth);
+		auto depth = _depths[i];
+		if(depth <= signal_frame_count) {
+			continue;
+		}
+
+		samples.stacks.emplace_back(
+			frames_begin + signal_frame_count,
+			frames_begin + depth
+		);
+	}
+
+	_frames = {};
+	_depths = {};
+#endif
+
+	return samples;
+}
+
+auto ecsact::cli::detail::begin_profile_scope() -> void {
+	_profile_scope_active = 1;
+}
+
+auto ecsact::cli::detail::end_profile_scope() -> void {
+	_profile_scope_active = 0;
+}
+
+auto ecsact::cli::detail::write_folded_stacks( //
+	const profile_samples& samples,
+	std::ostream&          out
+) -> void {
+	auto symbols = std::unordered_map<void*, std::string>{};
+	auto folded_counts = std::map<std::string, std::uint64_t>{};
+
+	auto symbol_for = [&](void* addr, bool is_return_address) -> auto& {
+		// Return addresses point at the instruction after the call which may
+		// already belong to the next function.
+		if(is_return_address) {
+			addr = static_cast<char*>(addr) - 1;
+		}
+
+		auto itr = symbols.find(addr);
+		if(itr == symbols.end()) {
+			itr = symbols.emplace(addr, symbolize(addr)).first;
+		}
+		return itr->second;
+	};
+
+	for(auto& stack : samples.stacks) {
+		auto folded = ""s;
+
+		// Folded stacks are written outermost frame first
+		for(auto i = stack.size(); i > 0; --i) {
+			if(!folded.empty()) {
+				folded += ";";
+			}
+			folded += symbol_for(stack[i - 1], i - 1 != 0);
+		}
+
+		folded_counts[folded] += 1;
+	}
+
+	for(auto& [folded, count] : folded_counts) {
+		out << folded << " " << count << "\n";
+	}
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace ecsact::cli::detail {
+
+struct profile_samples {
+	/**
+	 * Raw return addresses of each sample. Innermost frame first.
+	 */
+	std::vector<std::vector<void*>> stacks;
+
+	/**
+	 * Samples that arrived while the sample buffer was full.
+	 */
+	std::uint64_t dropped_sample_count = 0;
+};
+
+/**
+ * Starts a SIGPROF based sampling profiler. Samples are only recorded on a
+ * thread while it is between `begin_profile_scope` and `end_profile_scope` so
+ * work outside of the measured calls (restore, wasm load, reporting) never
+ * shows up in the profile.
+ *
+ * @param interval CPU time between samples
+ * @param max_samples samples beyond this count are dropped
+ * @returns `false` if sampling is not supported on this platform or the timer
+ *          could not be installed
+ */
+auto start_sampling_profiler( //
+	std::chrono::microseconds interval,
+	std::size_t               max_samples
+) -> bool;
+
+/**
+ * Stops the profiler started with `start_sampling_profiler` and returns all
+ * recorded samples.
+ */
+auto stop_sampling_profiler() -> profile_samples;
+
+/**
+ * Allow samples to be recorded on the calling thread.
+ */
+auto begin_profile_scope() -> void;
+
+/**
+ * Stop recording samples on the calling thread.
+ */
+auto end_profile_scope() -> void;
+
+/**
+ * Writes @p samples in the 'folded stacks' format understood by
+ * flamegraph.pl, speedscope and inferno. Frames are symbolized as
+ * `module!symbol` where possible and `module+0xoffset` otherwise.
+ */
+auto write_folded_stacks( //
+	const profile_samples& samples,
+	std::ostream&          out
+) -> void;
+
+} // namespace ecsact::cli::detail
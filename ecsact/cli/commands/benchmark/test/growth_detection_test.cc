@@ -0,0 +1,46 @@
+#include "gtest/gtest.h"
+
+#include <vector>
+#include "ecsact/cli/commands/benchmark/growth_detection.hh"
+
+using ecsact::cli::detail::is_monotonic_growth;
+
+TEST(GrowthDetection, TooFewValues) {
+	auto values = std::vector{1.0, 2.0};
+	ASSERT_FALSE(is_monotonic_growth(values, 0.05));
+}
+
+TEST(GrowthDetection, SteadyGrowth) {
+	auto values = std::vector{1.0, 1.1, 1.2, 1.3, 1.4};
+	ASSERT_TRUE(is_monotonic_growth(values, 0.05));
+}
+
+TEST(GrowthDetection, GrowthWithSmallDips) {
+	auto values = std::vector{100.0, 110.0, 108.0, 120.0, 118.0, 130.0};
+	ASSERT_TRUE(is_monotonic_growth(values, 0.05));
+}
+
+TEST(GrowthDetection, FlatNoise) {
+	auto values = std::vector{100.0, 102.0, 99.0, 101.0, 100.0, 103.0};
+	ASSERT_FALSE(is_monotonic_growth(values, 0.05));
+}
+
+TEST(GrowthDetection, LargeDip) {
+	auto values = std::vector{100.0, 150.0, 50.0, 200.0};
+	ASSERT_FALSE(is_monotonic_growth(values, 0.05));
+}
+
+TEST(GrowthDetection, RiseThenPlateau) {
+	auto values = std::vector{100.0, 200.0, 200.0, 200.0};
+	ASSERT_FALSE(is_monotonic_growth(values, 0.05));
+}
+
+TEST(GrowthDetection, RiseThenNoisyPlateau) {
+	auto values = std::vector{100.0, 150.0, 200.0, 201.0, 199.0, 202.0, 200.0};
+	ASSERT_FALSE(is_monotonic_growth(values, 0.05));
+}
+
+TEST(GrowthDetection, GrowthFromZero) {
+	auto values = std::vector{0.0, 10.0, 20.0};
+	ASSERT_TRUE(is_monotonic_growth(values, 0.05));
+}
@@ -0,0 +1,38 @@
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include "nlohmann/json.hpp"
+#include "ecsact/cli/commands/benchmark/latency_report.hh"
+
+using ecsact::cli::detail::latency_stats;
+using ecsact::cli::detail::to_latency_report;
+using namespace std::chrono_literals;
+
+TEST(LatencyReport, Milliseconds) {
+	auto report = to_latency_report(latency_stats{
+		.min = 500us,
+		.max = 20ms,
+		.mean = 2ms,
+		.p50 = 1500us,
+		.p90 = 5ms,
+		.p99 = 10ms,
+		.p999 = 15ms,
+	});
+
+	ASSERT_FLOAT_EQ(report.min_ms, 0.5f);
+	ASSERT_FLOAT_EQ(report.max_ms, 20.f);
+	ASSERT_FLOAT_EQ(report.mean_ms, 2.f);
+	ASSERT_FLOAT_EQ(report.p50_ms, 1.5f);
+	ASSERT_FLOAT_EQ(report.p90_ms, 5.f);
+	ASSERT_FLOAT_EQ(report.p99_ms, 10.f);
+	ASSERT_FLOAT_EQ(report.p999_ms, 15.f);
+}
+
+TEST(LatencyReport, Json) {
+	auto report = to_latency_report(latency_stats{.p99 = 3ms});
+	auto report_json = nlohmann::json(report);
+
+	ASSERT_EQ(report_json.size(), 7);
+	ASSERT_FLOAT_EQ(report_json["p99_ms"].get<float>(), 3.f);
+	ASSERT_FLOAT_EQ(report_json["p50_ms"].get<float>(), 0.f);
+}
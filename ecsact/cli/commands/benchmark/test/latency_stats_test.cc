@@ -0,0 +1,42 @@
+#include "gtest/gtest.h"
+
+#include <vector>
+#include <chrono>
+#include "ecsact/cli/commands/benchmark/latency_stats.hh"
+
+using ecsact::cli::detail::compute_latency_stats;
+using namespace std::chrono_literals;
+
+TEST(LatencyStats, Empty) {
+	auto stats = compute_latency_stats({});
+	ASSERT_EQ(stats.min, 0ns);
+	ASSERT_EQ(stats.max, 0ns);
+	ASSERT_EQ(stats.p99, 0ns);
+}
+
+TEST(LatencyStats, SingleSample) {
+	auto durations = std::vector{42ns};
+	auto stats = compute_latency_stats(durations);
+	ASSERT_EQ(stats.min, 42ns);
+	ASSERT_EQ(stats.max, 42ns);
+	ASSERT_EQ(stats.mean, 42ns);
+	ASSERT_EQ(stats.p50, 42ns);
+	ASSERT_EQ(stats.p999, 42ns);
+}
+
+TEST(LatencyStats, NearestRank) {
+	auto durations = std::vector<std::chrono::nanoseconds>{};
+	// intentionally unsorted
+	for(auto i = 100; i > 0; --i) {
+		durations.emplace_back(i);
+	}
+
+	auto stats = compute_latency_stats(durations);
+	ASSERT_EQ(stats.min, 1ns);
+	ASSERT_EQ(stats.max, 100ns);
+	ASSERT_EQ(stats.mean, 50ns);
+	ASSERT_EQ(stats.p50, 50ns);
+	ASSERT_EQ(stats.p90, 90ns);
+	ASSERT_EQ(stats.p99, 99ns);
+	ASSERT_EQ(stats.p999, 100ns);
+}
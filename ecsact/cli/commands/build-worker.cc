@@ -0,0 +1,196 @@
+#include "ecsact/cli/commands/build-worker.hh"
+
+#include <atomic>
+#include <filesystem>
+#include <format>
+#include <semaphore>
+#include <string>
+#include <thread>
+#include "docopt.h"
+#include "ecsact/cli/report.hh"
+#include "ecsact/cli/commands/common.hh"
+#include "ecsact/cli/commands/build/cc_compiler.hh"
+#include "ecsact/cli/commands/build/recipe/job_scheduler.hh"
+#include "ecsact/cli/commands/build/recipe/remote_compile.hh"
+#include "ecsact/cli/detail/socket.hh"
+
+namespace fs = std::filesystem;
+
+using ecsact::cli::detail::socket_connection;
+using ecsact::cli::detail::socket_endpoint;
+using ecsact::cli::detail::socket_listener;
+
+constexpr auto USAGE = R"docopt(Ecsact Build Worker Command
+
+Usage:
+  ecsact build-worker --listen=<endpoint> [--allow_tcp] [--compiler_config=<path>] [--jobs=<n>] [--temp_dir=<path>] [--format=<type>] [--report_filter=<filter>]
+
+Options:
+  --listen=<endpoint>       Socket path or host:port to accept compile jobs from 'ecsact build --executors'
+  --allow_tcp               Allow --listen to be a host:port. Any machine that can reach the port may use the worker.
+  --compiler_config=<path>  Optionally specify the compiler by name or path
+  -j --jobs=<n>             Maximum compiler processes run at once (defaults to core count)
+  --temp_dir=<path>         Optional temporary directory to use instead of generated one
+  -f --format=<type>        The format used to report progress of the worker [default: text]
+  --report_filter=<filter>  Filtering out report logs [default: none]
+
+Unix sockets are only accessible by the user running the worker. Compile
+requests may only use code generation flags like -O2 or -std=c++20, others
+are rejected.
+)docopt";
+
+/**
+ * Connections served at once. Each one runs at most one compile so this also
+ * limits the compiler processes.
+ */
+using connection_slots = std::counting_semaphore<>;
+
+static auto serve_connection(
+	socket_connection                     conn,
+	const ecsact::cli::cc_compiler&       compiler,
+	ecsact::cli::cook::remote_worker_info info,
+	fs::path                              scratch_dir
+) -> void {
+	if(!ecsact::cli::cook::send_worker_info(conn, info)) {
+		return;
+	}
+
+	// Clients also connect to ask for the worker info only
+	conn.set_receive_timeout(ecsact::cli::detail::HANDSHAKE_TIMEOUT);
+	auto request = ecsact::cli::cook::receive_compile_request(conn);
+	if(!request) {
+		return;
+	}
+
+	auto result = ecsact::cli::cook::run_remote_compile_request(
+		compiler,
+		*request,
+		scratch_dir
+	);
+
+	auto ec = std::error_code{};
+	fs::remove_all(scratch_dir, ec);
+
+	ecsact::cli::cook::send_compile_result(conn, result);
+}
+
+auto ecsact::cli::detail::build_worker_command( //
+	int         argc,
+	const char* argv[]
+) -> int {
+	auto args = docopt::docopt(USAGE, {argv + 1, argv + argc});
+
+	if(auto exit_code = process_common_args(args); exit_code != 0) {
+		return exit_code;
+	}
+
+	auto endpoint = socket_endpoint::parse(args["--listen"].asString());
+	if(!endpoint) {
+		ecsact::cli::report_error(
+			"Invalid --listen endpoint '{}'",
+			args["--listen"].asString()
+		);
+		return 1;
+	}
+
+	if(!endpoint->is_unix() && !args["--allow_tcp"].asBool()) {
+		ecsact::cli::report_error(
+			"Listening on {} accepts compile jobs from other machines. Pass "
+			"--allow_tcp to allow it.",
+			endpoint->to_string()
+		);
+		return 1;
+	}
+
+	auto jobs = ecsact::cli::cook::default_job_count();
+	try {
+		if(args["--jobs"]) {
+			jobs = static_cast<unsigned>(std::max(1L, args["--jobs"].asLong()));
+		}
+	} catch(const std::invalid_argument&) {
+		ecsact::cli::report_error("--jobs must be an integer");
+		return 1;
+	}
+
+	auto temp_dir = args["--temp_dir"].isString() //
+		? fs::path{args["--temp_dir"].asString()}
+		: fs::temp_directory_path();
+	auto work_dir = temp_dir / "ecsact-build-worker";
+
+	auto ec = std::error_code{};
+	fs::create_directories(work_dir, ec);
+	if(ec) {
+		ecsact::cli::report_error(
+			"Failed to create worker directory {}: {}",
+			work_dir.generic_string(),
+			ec.message()
+		);
+		return 1;
+	}
+
+	auto compiler = args["--compiler_config"].isString() //
+		? ecsact::cli::load_compiler_config(args["--compiler_config"].asString())
+		: ecsact::cli::detect_cc_compiler(work_dir);
+
+	if(!compiler) {
+		ecsact::cli::report_error(
+			"Failed to detect C++ compiler installed on your system"
+		);
+		return 1;
+	}
+
+	if(!is_gcc_clang_like(compiler->compiler_type)) {
+		ecsact::cli::report_error(
+			"Build workers only support gcc and clang (found {})",
+			to_string(compiler->compiler_type)
+		);
+		return 1;
+	}
+
+	auto listener = socket_listener::listen(*endpoint, ec);
+	if(ec) {
+		ecsact::cli::report_error(
+			"Failed to listen on {}: {}",
+			endpoint->to_string(),
+			ec.message()
+		);
+		return 1;
+	}
+
+	auto info = ecsact::cli::cook::remote_worker_info{
+		.compiler_type = std::string{to_string(compiler->compiler_type)},
+		.compiler_version = compiler->compiler_version,
+		.slots = jobs,
+	};
+
+	ecsact::cli::report_info(
+		"Build worker listening on {} with {} ({}), {} jobs",
+		endpoint->to_string(),
+		info.compiler_type,
+		info.compiler_version,
+		jobs
+	);
+
+	auto slots = connection_slots{static_cast<std::ptrdiff_t>(jobs)};
+	auto next_scratch_id = std::atomic_uint64_t{};
+
+	for(;;) {
+		// Connections past the limit wait in the listen backlog
+		slots.acquire();
+
+		auto conn = listener.accept(ec);
+		if(ec) {
+			slots.release();
+			ecsact::cli::report_warning("Failed to accept: {}", ec.message());
+			continue;
+		}
+
+		auto scratch_dir = work_dir / std::to_string(next_scratch_id++);
+		std::thread{
+			[&, info, conn = std::move(conn), scratch_dir]() mutable {
+				serve_connection(std::move(conn), *compiler, info, scratch_dir);
+				slots.release();
+			},
+		}.detach();
+	}
+}
@@ -15,11 +15,14 @@
 #include "ecsact/runtime/meta.hh"
 #include "ecsact/cli/report.hh"
 #include "ecsact/cli/detail/argv0.hh"
+#include "ecsact/cli/detail/cache_dir.hh"
+#include "ecsact/cli/detail/content_hash.hh"
 #include "ecsact/cli/commands/common.hh"
 #include "ecsact/cli/commands/build/recipe/taste.hh"
 #include "ecsact/cli/commands/build/build_recipe.hh"
 #include "ecsact/cli/commands/build/cc_compiler.hh"
 #include "ecsact/cli/commands/build/recipe/cook.hh"
+#include "ecsact/cli/commands/build/recipe/job_scheduler.hh"
 #include "ecsact/cli/commands/build/recipe/taste.hh"
 #include "ecsact/cli/commands/recipe-bundle/build_recipe_bundle.hh"
 
@@ -31,18 +34,31 @@ constexpr auto USAGE = R"docopt(Ecsact Build Command
 
 Usage:
   ecsact build (-h | --help)
-  ecsact build <files>... --recipe=<name>... --output=<path> [--allow-unresolved-imports] [--format=<type>] [--temp_dir=<path>] [--compiler_config=<path>] [--report_filter=<filter>] [--debug] [--tracy]
+  ecsact build <files>... --recipe=<name>... --output=<path> [--allow-unresolved-imports] [--format=<type>] [--temp_dir=<path>] [--compiler_config=<path>] [--report_filter=<filter>] [--debug] [--tracy] [--cache_dir=<path>] [--no_cache] [--clean] [--jobs=<n>] [--job_memory=<mb>] [--unity=<n>] [--pgo=<mode>] [--time_trace] [--linker=<name>] [--executors=<list>] [--repository_cache=<dir>] [--offline]
 
 Options:
   <files>                   Ecsact files used to build Ecsact Runtime
   -r --recipe=<name>        Name or path to recipe
   -o --output=<path>        Runtime output path
   --temp_dir=<path>         Optional temporary directory to use instead of generated one
-  --compiler_config=<path>  Optionally specify the compiler by name or path
+  --compiler_config=<path>  Compiler config file to use instead of detecting the compiler (see 'ecsact config compiler_config')
   -f --format=<type>        The format used to report progress of the build [default: text]
   --report_filter=<filter>  Filtering out report logs [default: none]
   --debug                   Compile with debug symbols
 	--tracy                   Enable the tracy profiler
+  --cache_dir=<path>        Persistent build cache directory (ECSACT_CACHE_DIR or user cache dir)
+  --no_cache                Do not read or write persistent build caches
+  --repository_cache=<dir>  Cache of recipe fetch downloads keyed by integrity (defaults to 'repository' in the cache directory)
+  --offline                 Never download. Recipe fetch sources must already be in the repository cache
+  --clean                   Remove the work directory of these inputs before building
+  -j --jobs=<n>             Maximum local compiler processes and source staging threads run at once (defaults to core count). Each --executors slot adds a compile on top
+  --job_memory=<mb>         Estimated memory of a single compile. Compiles wait for this much available memory
+  --unity=<n>               Combine C++ sources into n unity translation units ('auto' for one per job)
+  --pgo=<mode>              Profile guided optimization (clang only). 'instrument' writes .profraw files when the runtime runs (see ecsact benchmark --profraw)
+                            'use=<path>' optimizes with a .profdata file, .profraw file or directory of .profraw files
+  --time_trace              Compile every source with compiler timing enabled and report the slowest sources, headers, template instantiations and functions
+  --linker=<name>           Linker used by gcc/clang: lld, mold, gold, bfd or auto (mold if installed, otherwise lld for clang) [default: auto]
+  --executors=<list>        Comma separated 'ecsact build-worker' endpoints (host:port or socket path) gcc/clang sources are compiled on
 )docopt";
 
 // TODO(zaucy): Add this documentation to docopt (msvc regex fails)
@@ -86,6 +102,56 @@ auto resolve_builtin_recipe( //
 	return std::nullopt;
 }
 
+/**
+ * Work directory name that is stable across builds of the same recipes, files
+ * and options. Only paths are hashed so edits to the inputs reuse the previous
+ * work directory and only the steps affected by the edit run again.
+ */
+static auto work_dir_name(
+	const std::vector<std::string>& recipe_paths,
+	const std::vector<std::string>& files,
+	const fs::path&                 output_path,
+	auto&                           args
+) -> std::string {
+	auto hasher = ecsact::cli::detail::content_hasher{};
+
+	for(auto& recipe_path : recipe_paths) {
+		hasher.update(fs::weakly_canonical(recipe_path).generic_string());
+	}
+
+	hasher.update("");
+
+	for(auto& file : files) {
+		hasher.update(fs::weakly_canonical(file).generic_string());
+	}
+
+	hasher.update("");
+	hasher.update(fs::weakly_canonical(output_path).generic_string());
+
+	if(args["--compiler_config"].isString()) {
+		auto compiler_config_path = fs::path{args["--compiler_config"].asString()};
+		hasher.update(fs::weakly_canonical(compiler_config_path).generic_string());
+		hasher.update_file(compiler_config_path);
+	}
+
+	hasher.update(args["--debug"].asBool() ? "debug" : "");
+	hasher.update(args["--tracy"].asBool() ? "tracy" : "");
+
+	// Instrumented and optimized builds get their own work directories so
+	// switching between them doesn't recompile everything. The profile itself
+	// is part of the object keys.
+	if(args["--pgo"].isString()) {
+		auto pgo = args["--pgo"].asString();
+		hasher.update(pgo.starts_with("use=") ? "pgo-use" : pgo);
+	}
+
+	return hasher.digest().substr(0, 16);
+}
+
+auto ecsact::cli::detail::build_usage() -> std::string_view {
+	return USAGE;
+}
+
 auto ecsact::cli::detail::build_command( //
 	int         argc,
 	const char* argv[]
@@ -212,8 +278,8 @@ auto ecsact::cli::detail::build_command( //
 		}
 	}
 
-	// TODO(zaucy): Generate stable directory based on file input
-	auto work_dir = temp_dir / "ecsact-build";
+	auto work_dir = temp_dir / "ecsact-build" /
+		work_dir_name(recipe_paths, files, output_path, args);
 
 	ecsact::cli::report_info(
 		"Build Working Directory: {}",
@@ -221,13 +287,15 @@ auto ecsact::cli::detail::build_command( //
 	);
 
 	auto ec = std::error_code{};
-	fs::remove_all(work_dir, ec);
-	if(ec) {
-		ecsact::cli::report_error(
-			"Failed to clear work directory: {}",
-			ec.message()
-		);
-		return 1;
+	if(args["--clean"].asBool()) {
+		fs::remove_all(work_dir, ec);
+		if(ec) {
+			ecsact::cli::report_error(
+				"Failed to clear work directory: {}",
+				ec.message()
+			);
+			return 1;
+		}
 	}
 	fs::create_directories(work_dir, ec);
 
@@ -271,13 +339,21 @@ auto ecsact::cli::detail::build_command( //
 		ecsact::meta::package_name(main_pkg_id)
 	);
 
+	auto cache_dir = args["--cache_dir"].isString() //
+		? fs::path{args["--cache_dir"].asString()}
+		: default_cache_dir();
+	auto use_cache = !args["--no_cache"].asBool();
+
 	auto compiler_config_path = args["--compiler_config"].isString() //
 		? std::optional{fs::path{args["--compiler_config"].asString()}}
 		: std::nullopt;
 
 	auto compiler = compiler_config_path //
 		? ecsact::cli::load_compiler_config(*compiler_config_path)
-		: ecsact::cli::detect_cc_compiler(work_dir);
+		: ecsact::cli::detect_cc_compiler(
+				work_dir,
+				use_cache ? std::optional{cache_dir / "compilers"} : std::nullopt
+			);
 
 	if(!compiler) {
 		ecsact::cli::report_error(
@@ -299,6 +375,101 @@ auto ecsact::cli::detail::build_command( //
 		}
 	}
 
+	if(use_cache) {
+		ecsact::cli::report_info("Cache Directory: {}", cache_dir.generic_string());
+	}
+
+	auto repository_cache_dir = std::optional<fs::path>{};
+	if(args["--repository_cache"].isString()) {
+		repository_cache_dir = fs::path{args["--repository_cache"].asString()};
+	} else if(use_cache) {
+		repository_cache_dir = cache_dir / "repository";
+	}
+	auto offline = args["--offline"].asBool();
+
+	if(offline && !repository_cache_dir) {
+		ecsact::cli::report_error(
+			"--offline requires a repository cache (--repository_cache or no "
+			"--no_cache)"
+		);
+		return 1;
+	}
+
+	auto jobs = ecsact::cli::cook::default_job_count();
+	auto job_memory_mb = 0L;
+	try {
+		if(args["--jobs"]) {
+			jobs = static_cast<unsigned>(std::max(1L, args["--jobs"].asLong()));
+		}
+		if(args["--job_memory"]) {
+			job_memory_mb = std::max(0L, args["--job_memory"].asLong());
+		}
+	} catch(const std::invalid_argument&) {
+		ecsact::cli::report_error("--jobs and --job_memory must be integers");
+		return 1;
+	}
+
+	auto unity_count = std::optional<unsigned>{};
+	if(args["--unity"]) {
+		try {
+			unity_count = args["--unity"].asString() == "auto"
+				? 0U
+				: static_cast<unsigned>(std::max(1L, args["--unity"].asLong()));
+		} catch(const std::invalid_argument&) {
+			ecsact::cli::report_error("--unity must be an integer or 'auto'");
+			return 1;
+		}
+	}
+
+	auto pgo = ecsact::cli::cook::pgo_mode::none;
+	auto pgo_profile = fs::path{};
+	if(args["--pgo"].isString()) {
+		auto pgo_arg = args["--pgo"].asString();
+		if(pgo_arg == "instrument") {
+			pgo = ecsact::cli::cook::pgo_mode::instrument;
+		} else if(pgo_arg.starts_with("use=") && pgo_arg.size() > 4) {
+			pgo = ecsact::cli::cook::pgo_mode::use;
+			pgo_profile = fs::absolute(pgo_arg.substr(4));
+		} else {
+			ecsact::cli::report_error(
+				"--pgo must be 'instrument' or 'use=<path>' (got '{}')",
+				pgo_arg
+			);
+			return 1;
+		}
+	}
+
+	auto linker = args["--linker"].asString();
+	if(linker != "auto" && linker != "lld" && linker != "mold" &&
+		 linker != "gold" && linker != "bfd") {
+		ecsact::cli::report_error(
+			"--linker must be one of lld, mold, gold, bfd or auto (got '{}')",
+			linker
+		);
+		return 1;
+	}
+
+	auto executors = std::vector<ecsact::cli::detail::socket_endpoint>{};
+	if(args["--executors"]) {
+		auto executors_arg = args["--executors"].asString();
+		auto list = std::string_view{executors_arg};
+		while(!list.empty()) {
+			auto comma = list.find(',');
+			auto item = list.substr(0, comma);
+			list = comma == std::string_view::npos ? ""sv : list.substr(comma + 1);
+			if(item.empty()) {
+				continue;
+			}
+
+			auto endpoint = ecsact::cli::detail::socket_endpoint::parse(item);
+			if(!endpoint) {
+				ecsact::cli::report_error("Invalid build executor '{}'", item);
+				return 1;
+			}
+			executors.push_back(*endpoint);
+		}
+	}
+
 	auto cook_options = cook_recipe_options{
 		.files = file_paths,
 		.work_dir = work_dir,
@@ -306,6 +477,25 @@ auto ecsact::cli::detail::build_command( //
 		.debug = args["--debug"].asBool(),
 		.tracy = args["--tracy"].asBool(),
 		.additional_plugin_dirs = additional_plugin_dirs,
+		.object_cache_dir = use_cache //
+			? std::optional{cache_dir / "objects"}
+			: std::nullopt,
+		.repository_cache_dir = repository_cache_dir,
+		.offline = offline,
+		.codegen_cache_dir = use_cache //
+			? std::optional{cache_dir / "codegen"}
+			: std::nullopt,
+		.runfiles_cache_dir = use_cache //
+			? std::optional{cache_dir / "runfiles"}
+			: std::nullopt,
+		.jobs = jobs,
+		.job_memory_estimate = static_cast<std::uint64_t>(job_memory_mb) << 20,
+		.unity_count = unity_count,
+		.pgo = pgo,
+		.pgo_profile = pgo_profile,
+		.time_trace = args["--time_trace"].asBool(),
+		.linker = linker,
+		.executors = executors,
 	};
 	auto runtime_output_path =
 		cook_recipe(argv[0], *recipe_composite, *compiler, cook_options);
@@ -4,6 +4,7 @@
 #include <type_traits>
 #include <vector>
 #include <string>
+#include <string_view>
 
 #include "./command.hh"
 
@@ -12,6 +13,11 @@ namespace ecsact::cli::detail {
 int build_command(int argc, const char* argv[]);
 static_assert(std::is_same_v<command_fn_t, decltype(&build_command)>);
 
+/**
+ * docopt usage text of `ecsact build`
+ */
+auto build_usage() -> std::string_view;
+
 inline auto build_command(std::vector<std::string> args) -> int {
 	auto c_args = std::vector<const char*>();
 	c_args.reserve(args.size());
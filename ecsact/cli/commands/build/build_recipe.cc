@@ -30,6 +30,10 @@ static auto operator<<( //
 		out << YAML::Key << "outdir";
 		out << YAML::Value << *src.outdir;
 	}
+	if(!src.unity) {
+		out << YAML::Key << "unity";
+		out << YAML::Value << false;
+	}
 	out << YAML::EndMap;
 	return out;
 }
@@ -38,12 +42,18 @@ static auto operator<<( //
 	YAML::Emitter&                           out,
 	const ecsact::build_recipe::source_path& src
 ) -> YAML::Emitter& {
-	if(src.outdir) {
+	if(src.outdir || !src.unity) {
 		out << YAML::BeginMap;
 		out << YAML::Key << "path";
 		out << YAML::Value << src.path.generic_string();
-		out << YAML::Key << "outdir";
-		out << YAML::Value << *src.outdir;
+		if(src.outdir) {
+			out << YAML::Key << "outdir";
+			out << YAML::Value << *src.outdir;
+		}
+		if(!src.unity) {
+			out << YAML::Key << "unity";
+			out << YAML::Value << false;
+		}
 		out << YAML::EndMap;
 	} else {
 		out << src.path.generic_string();
@@ -66,6 +76,10 @@ static auto operator<<( //
 		out << YAML::Key << "outdir";
 		out << YAML::Value << *src.outdir;
 	}
+	if(!src.unity) {
+		out << YAML::Key << "unity";
+		out << YAML::Value << false;
+	}
 	out << YAML::EndMap;
 	return out;
 }
@@ -124,6 +138,11 @@ auto ecsact::build_recipe::defines() const
 	return _defines;
 }
 
+auto ecsact::build_recipe::precompiled_headers() const
+	-> std::span<const std::string> {
+	return _precompiled_headers;
+}
+
 static auto get_if_error( //
 	const auto& result
 ) -> std::optional<ecsact::build_recipe_parse_error> {
@@ -171,6 +190,16 @@ static auto parse_system_libs( //
 	return system_libs.as<std::vector<std::string>>();
 }
 
+static auto parse_precompiled_headers( //
+	YAML::Node precompiled_headers
+) -> std::variant<std::vector<std::string>, ecsact::build_recipe_parse_error> {
+	if(!precompiled_headers) {
+		return {};
+	}
+
+	return precompiled_headers.as<std::vector<std::string>>();
+}
+
 static auto parse_defines( //
 	YAML::Node defines
 )
@@ -209,6 +238,8 @@ static auto parse_sources( //
 				return ecsact::build_recipe_parse_error::invalid_source;
 			}
 
+			auto unity = src["unity"] ? src["unity"].as<bool>() : true;
+
 			if(codegen) {
 				auto entry = source_codegen{};
 				if(src["outdir"]) {
@@ -219,6 +250,7 @@ static auto parse_sources( //
 				} else {
 					entry.plugins.push_back(codegen.as<std::string>());
 				}
+				entry.unity = unity;
 				result.emplace_back(entry);
 			} else if(fetch) {
 				auto outdir = std::optional<std::string>{};
@@ -250,6 +282,7 @@ static auto parse_sources( //
 						.strip_prefix = strip_prefix,
 						.outdir = outdir,
 						.paths = paths,
+						.unity = unity,
 					}
 				);
 			} else if(path) {
@@ -272,6 +305,7 @@ static auto parse_sources( //
 					source_path{
 						.path = src_path,
 						.outdir = outdir,
+						.unity = unity,
 					}
 				);
 			}
@@ -322,6 +356,12 @@ auto ecsact::build_recipe::build_recipe_from_yaml_node( //
 		return *err;
 	}
 
+	auto precompiled_headers =
+		parse_precompiled_headers(doc["precompiled_headers"]);
+	if(auto err = get_if_error(precompiled_headers)) {
+		return *err;
+	}
+
 	auto recipe = ecsact::build_recipe{};
 	if(doc["name"]) {
 		recipe._name = doc["name"].as<std::string>();
@@ -334,6 +374,7 @@ auto ecsact::build_recipe::build_recipe_from_yaml_node( //
 	recipe._sources = get_value(sources);
 	recipe._system_libs = get_value(system_libs);
 	recipe._defines = get_value(defines);
+	recipe._precompiled_headers = get_value(precompiled_headers);
 
 	if(recipe._exports.empty()) {
 		return build_recipe_parse_error::missing_exports;
@@ -407,6 +448,11 @@ auto ecsact::build_recipe::to_yaml_string() const -> std::string {
 	}
 	emitter << YAML::EndMap;
 
+	if(!_precompiled_headers.empty()) {
+		emitter << YAML::Key << "precompiled_headers";
+		emitter << YAML::Value << _precompiled_headers;
+	}
+
 	emitter << YAML::Key << "sources";
 	emitter << YAML::Value << _sources;
 
@@ -472,6 +518,13 @@ auto ecsact::build_recipe::merge( //
 		merged_build_recipe._defines[k] = v;
 	}
 
+	merged_build_recipe._precompiled_headers = base._precompiled_headers;
+	for(auto& header : target._precompiled_headers) {
+		if(!range_contains(merged_build_recipe._precompiled_headers, header)) {
+			merged_build_recipe._precompiled_headers.push_back(header);
+		}
+	}
+
 	merged_build_recipe._exports.reserve(
 		merged_build_recipe._exports.size() + target._exports.size()
 	);
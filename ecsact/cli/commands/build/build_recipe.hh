@@ -52,6 +52,9 @@ public:
 	struct source_path {
 		std::filesystem::path      path;
 		std::optional<std::string> outdir;
+
+		/** `false` if the sources may not be combined in a unity build */
+		bool unity = true;
 	};
 
 	struct source_fetch {
@@ -60,11 +63,17 @@ public:
 		std::optional<std::string>              strip_prefix;
 		std::optional<std::string>              outdir;
 		std::optional<std::vector<std::string>> paths;
+
+		/** `false` if the sources may not be combined in a unity build */
+		bool unity = true;
 	};
 
 	struct source_codegen {
 		std::vector<std::string>   plugins;
 		std::optional<std::string> outdir;
+
+		/** `false` if the sources may not be combined in a unity build */
+		bool unity = true;
 	};
 
 	using source = std::variant<source_path, source_fetch, source_codegen>;
@@ -80,6 +89,12 @@ public:
 	auto system_libs() const -> std::span<const std::string>;
 	auto defines() const -> std::unordered_map<std::string, std::string>;
 
+	/**
+	 * Headers compiled into a precompiled header that every source is compiled
+	 * with. Paths relative to the work directory or include paths.
+	 */
+	auto precompiled_headers() const -> std::span<const std::string>;
+
 	auto to_yaml_string() const -> std::string;
 	auto to_yaml_bytes() const -> std::vector<std::byte>;
 
@@ -93,6 +108,7 @@ private:
 	std::vector<std::string> _imports;
 	std::vector<source>      _sources;
 	std::vector<std::string> _system_libs;
+	std::vector<std::string> _precompiled_headers;
 
 	std::unordered_map<std::string, std::string> _defines;
 
@@ -4,9 +4,11 @@
 #include <string>
 #include <string_view>
 #include <fstream>
+#include <mutex>
 #include <boost/process.hpp>
 #include "nlohmann/json.hpp"
 #include "ecsact/cli/commands/build/cc_compiler.hh"
+#include "ecsact/cli/commands/build/cc_compiler_cache.hh"
 #include "ecsact/cli/commands/build/cc_compiler_util.hh"
 #include "ecsact/cli/report.hh"
 
@@ -16,9 +18,12 @@ using ecsact::cli::subcommand_start_message;
 namespace fs = std::filesystem;
 namespace bp = boost::process;
 
+using compiler_cache_t = std::optional<ecsact::cli::cc_compiler_cache>;
+
 static auto cc_from_string( //
-	std::string_view str,
-	fs::path         work_dir
+	std::string_view        str,
+	fs::path                work_dir,
+	const compiler_cache_t& cache
 ) -> std::optional<ecsact::cli::cc_compiler> {
 	auto compiler_path = fs::exists(str) //
 		? fs::path{str}
@@ -40,6 +45,12 @@ static auto cc_from_string( //
 		return {};
 	}
 
+	if(cache) {
+		if(auto cached = cache->restore(compiler_path); cached) {
+			return cached;
+		}
+	}
+
 	auto compiler_version = ecsact::cli::compiler_version_string(compiler_path);
 
 	if(compiler_version.empty()) {
@@ -50,7 +61,7 @@ static auto cc_from_string( //
 		return {};
 	}
 
-	return ecsact::cli::cc_compiler{
+	auto compiler = ecsact::cli::cc_compiler{
 		.compiler_type = compiler_type,
 		.compiler_path = compiler_path,
 		.compiler_version = compiler_version,
@@ -63,10 +74,18 @@ static auto cc_from_string( //
 		.allowed_output_extensions = {".so"},
 #endif
 	};
+
+	if(cache) {
+		cache->store(compiler);
+	}
+
+	return compiler;
 }
 
 static auto cc_from_env( //
-	fs::path work_dir
+	fs::path                work_dir,
+	const compiler_cache_t& cache,
+	bool&                   reported_warning
 ) -> std::optional<ecsact::cli::cc_compiler> {
 	auto compiler = std::optional<ecsact::cli::cc_compiler>{};
 	auto cxx_env = std::getenv("CXX");
@@ -77,13 +96,15 @@ static auto cc_from_env( //
 				cxx_env,
 				std::strlen(cxx_env),
 			},
-			work_dir
+			work_dir,
+			cache
 		);
 
 		if(!compiler) {
 			ecsact::cli::report_warning(
 				"CXX environment variable was set, but was invalid"
 			);
+			reported_warning = true;
 		}
 	}
 
@@ -96,13 +117,15 @@ static auto cc_from_env( //
 					cc_env,
 					std::strlen(cc_env),
 				},
-				work_dir
+				work_dir,
+				cache
 			);
 
 			if(!compiler) {
 				ecsact::cli::report_warning(
 					"CC environment variable was set, but was invalid"
 				);
+				reported_warning = true;
 			}
 		}
 	}
@@ -203,7 +226,8 @@ auto as_vec_path(auto&& vec) -> std::vector<fs::path> {
 
 #ifdef _WIN32
 static auto cc_vswhere( //
-	fs::path work_dir
+	fs::path                work_dir,
+	const compiler_cache_t& cache
 ) -> std::optional<ecsact::cli::cc_compiler> {
 	auto vswhere = find_vswhere();
 	if(!vswhere) {
@@ -278,6 +302,35 @@ static auto cc_vswhere( //
 
 	std::string vs_installation_path = vs_config_itr->at("installationPath");
 
+	// https://github.com/microsoft/vswhere/wiki/Find-VC
+	auto version_text_path = std::format(
+		"{}\\VC\\Auxiliary\\Build\\Microsoft.VCToolsVersion.default.txt",
+		vs_installation_path
+	);
+	auto tools_version = std::string{};
+	{
+		auto version_text_stream = std::ifstream{version_text_path};
+		std::getline(version_text_stream, tools_version);
+	}
+
+	if(tools_version.empty()) {
+		ecsact::cli::report_error("Unable to read {}", version_text_path);
+		return {};
+	}
+
+	auto cl_path = std::format(
+		"{}\\VC\\Tools\\MSVC\\{}\\bin\\HostX64\\x64\\cl.exe",
+		vs_installation_path,
+		tools_version
+	);
+
+	// Extracting the environment runs vsdevcmd twice which takes seconds
+	if(cache) {
+		if(auto cached = cache->restore(cl_path); cached) {
+			return cached;
+		}
+	}
+
 	const std::string vsdevcmd_path =
 		vs_installation_path + "\\Common7\\Tools\\vsdevcmd.bat";
 	const auto vs_extract_env_path = work_dir / "vs_extract_env.bat";
@@ -310,29 +363,7 @@ static auto cc_vswhere( //
 		return {};
 	}
 
-	// https://github.com/microsoft/vswhere/wiki/Find-VC
-	auto version_text_path = std::format(
-		"{}\\VC\\Auxiliary\\Build\\Microsoft.VCToolsVersion.default.txt",
-		vs_installation_path
-	);
-	auto tools_version = std::string{};
-	{
-		auto version_text_stream = std::ifstream{version_text_path};
-		std::getline(version_text_stream, tools_version);
-	}
-
-	if(tools_version.empty()) {
-		ecsact::cli::report_error("Unable to read {}", version_text_path);
-		return {};
-	}
-
-	auto cl_path = std::format(
-		"{}\\VC\\Tools\\MSVC\\{}\\bin\\HostX64\\x64\\cl.exe",
-		vs_installation_path,
-		tools_version
-	);
-
-	return ecsact::cli::cc_compiler{
+	auto compiler = ecsact::cli::cc_compiler{
 		.compiler_type = ecsact::cli::cc_compiler_type::msvc_cl,
 		.compiler_path = cl_path,
 		.compiler_version = tools_version,
@@ -341,16 +372,23 @@ static auto cc_vswhere( //
 		.preferred_output_extension = ".dll",
 		.allowed_output_extensions = {".dll"},
 	};
+
+	if(cache) {
+		cache->store(compiler);
+	}
+
+	return compiler;
 }
 #endif
 
 static auto cc_default( //
-	fs::path work_dir
+	fs::path                work_dir,
+	const compiler_cache_t& cache
 ) -> std::optional<ecsact::cli::cc_compiler> {
 #ifdef _WIN32
-	return cc_vswhere(work_dir);
+	return cc_vswhere(work_dir, cache);
 #else
-	return cc_from_string("clang", work_dir);
+	return cc_from_string("clang", work_dir, cache);
 #endif
 }
 
@@ -360,25 +398,101 @@ static auto cc_from_env_path( //
 	return {};
 }
 
+/**
+ * Environment detect_cc_compiler looks at. Detection is only reused while
+ * this stays the same.
+ */
+static auto detection_env_key() -> std::string {
+	auto key = std::string{};
+	for(auto name : {"CXX", "CC", "PATH"}) {
+		auto value = std::getenv(name);
+		key += value ? value : "";
+		key += '\0';
+	}
+	return key;
+}
+
+static auto compiler_file_stamp(const fs::path& compiler_path) -> std::string {
+	auto ec = std::error_code{};
+	auto size = fs::file_size(compiler_path, ec);
+	if(ec) {
+		return {};
+	}
+	auto write_time = fs::last_write_time(compiler_path, ec);
+	if(ec) {
+		return {};
+	}
+	return std::format(
+		"{}:{}",
+		size,
+		write_time.time_since_epoch().count()
+	);
+}
+
+struct detected_compiler {
+	std::string              env_key;
+	std::string              compiler_stamp;
+	ecsact::cli::cc_compiler compiler;
+};
+
+// Processes that build more than once (ecsact daemon) skip detecting again
+// while the environment and compiler binary stay the same
+static auto _detected_compiler_mutex = std::mutex{};
+static auto _detected_compiler = std::optional<detected_compiler>{};
+
 auto ecsact::cli::detect_cc_compiler( //
-	fs::path work_dir
+	fs::path                work_dir,
+	std::optional<fs::path> cache_dir
 ) -> std::optional<cc_compiler> {
-	auto compiler = cc_from_env(work_dir);
+	auto lk = std::scoped_lock{_detected_compiler_mutex};
+	auto env_key = detection_env_key();
+
+	if(_detected_compiler && _detected_compiler->env_key == env_key) {
+		auto& detected = *_detected_compiler;
+		auto stamp = compiler_file_stamp(detected.compiler.compiler_path);
+		if(!stamp.empty() && stamp == detected.compiler_stamp) {
+			return detected.compiler;
+		}
+	}
+	_detected_compiler.reset();
+
+	auto cache = cache_dir //
+		? std::optional{cc_compiler_cache{*cache_dir}}
+		: std::nullopt;
+
+	auto reported_warning = false;
+	auto compiler = cc_from_env(work_dir, cache, reported_warning);
 
 	if(!compiler) {
-		compiler = cc_default(work_dir);
+		compiler = cc_default(work_dir, cache);
 	}
 
 	if(!compiler) {
 		compiler = cc_from_env_path(work_dir);
 	}
 
+	// Detections that warned are repeated so the warning is too
+	if(compiler && !reported_warning) {
+		auto stamp = compiler_file_stamp(compiler->compiler_path);
+		if(!stamp.empty()) {
+			_detected_compiler = detected_compiler{
+				.env_key = std::move(env_key),
+				.compiler_stamp = std::move(stamp),
+				.compiler = *compiler,
+			};
+		}
+	}
+
 	return compiler;
 }
 
 auto ecsact::cli::find_cc_compiler(
-	std::filesystem::path work_dir,
-	std::string           compiler_name_or_path
+	std::filesystem::path                work_dir,
+	std::string                          compiler_name_or_path,
+	std::optional<std::filesystem::path> cache_dir
 ) -> std::optional<cc_compiler> {
-	return cc_from_string(compiler_name_or_path, work_dir);
+	auto cache = cache_dir //
+		? std::optional{cc_compiler_cache{*cache_dir}}
+		: std::nullopt;
+	return cc_from_string(compiler_name_or_path, work_dir, cache);
 }
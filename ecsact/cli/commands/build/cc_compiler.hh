@@ -9,14 +9,18 @@
 #include "ecsact/cli/commands/build/cc_compiler_config.hh"
 
 namespace ecsact::cli {
-/// Find a compiler with the given name or path
+/// Find a compiler with the given name or path. Probed compilers are cached
+/// in @p cache_dir if given (see cc_compiler_cache)
 auto find_cc_compiler(
-	std::filesystem::path work_dir,
-	std::string           compiler_name_or_path
+	std::filesystem::path                work_dir,
+	std::string                          compiler_name_or_path,
+	std::optional<std::filesystem::path> cache_dir = {}
 ) -> std::optional<cc_compiler>;
 
-/// Automatically detect a C++ compiler without input
+/// Automatically detect a C++ compiler without input. Probed compilers are
+/// cached in @p cache_dir if given (see cc_compiler_cache)
 auto detect_cc_compiler( //
-	std::filesystem::path work_dir
+	std::filesystem::path                work_dir,
+	std::optional<std::filesystem::path> cache_dir = {}
 ) -> std::optional<cc_compiler>;
 } // namespace ecsact::cli
@@ -0,0 +1,132 @@
+#include "ecsact/cli/commands/build/cc_compiler_cache.hh"
+
+#include <format>
+#include <fstream>
+#include "nlohmann/json.hpp"
+#include "ecsact/cli/detail/atomic_write.hh"
+#include "ecsact/cli/detail/content_hash.hh"
+
+namespace fs = std::filesystem;
+
+using ecsact::cli::detail::atomic_write_file;
+using ecsact::cli::detail::content_hasher;
+
+/**
+ * Bump when the key or entry layout changes so stale entries are never used
+ */
+constexpr auto cc_compiler_cache_version = std::string_view{"1"};
+
+ecsact::cli::cc_compiler_cache::cc_compiler_cache(fs::path dir)
+	: _dir(std::move(dir)) {
+}
+
+auto ecsact::cli::cc_compiler_cache::key( //
+	const fs::path& compiler_path
+) -> std::optional<std::string> {
+	auto ec = std::error_code{};
+	auto absolute_path = fs::absolute(compiler_path, ec).lexically_normal();
+	if(ec) {
+		return std::nullopt;
+	}
+
+	auto size = fs::file_size(absolute_path, ec);
+	if(ec) {
+		return std::nullopt;
+	}
+
+	auto write_time = fs::last_write_time(absolute_path, ec);
+	if(ec) {
+		return std::nullopt;
+	}
+
+	auto hasher = content_hasher{};
+	hasher.update(cc_compiler_cache_version);
+	hasher.update(absolute_path.generic_string());
+	hasher.update(std::to_string(size));
+	hasher.update(std::to_string(write_time.time_since_epoch().count()));
+	return hasher.digest();
+}
+
+auto ecsact::cli::cc_compiler_cache::entry_path( //
+	std::string_view key
+) const -> fs::path {
+	return _dir / std::format("v{}", cc_compiler_cache_version) /
+		std::format("{}.json", key);
+}
+
+auto ecsact::cli::cc_compiler_cache::config_path( //
+	const fs::path& compiler_path
+) const -> std::optional<fs::path> {
+	auto compiler_key = key(compiler_path);
+	if(!compiler_key) {
+		return std::nullopt;
+	}
+
+	auto path = entry_path(*compiler_key);
+	auto ec = std::error_code{};
+	if(!fs::is_regular_file(path, ec)) {
+		return std::nullopt;
+	}
+
+	return path;
+}
+
+auto ecsact::cli::cc_compiler_cache::restore( //
+	const fs::path& compiler_path
+) const -> std::optional<cc_compiler> {
+	auto path = config_path(compiler_path);
+	if(!path) {
+		return std::nullopt;
+	}
+
+	auto file = std::ifstream{*path};
+	auto config = nlohmann::json::parse(file, nullptr, false);
+	if(config.is_discarded()) {
+		return std::nullopt;
+	}
+
+	auto compiler = parse_compiler_config(config);
+	if(!compiler) {
+		return std::nullopt;
+	}
+
+	// The key only covers the compiler binary. SDKs and standard libraries are
+	// installed and removed on their own so probe again if one went away.
+	auto ec = std::error_code{};
+	for(auto& dir : compiler->std_inc_paths) {
+		if(!fs::is_directory(dir, ec)) {
+			return std::nullopt;
+		}
+	}
+	for(auto& dir : compiler->std_lib_paths) {
+		if(!fs::is_directory(dir, ec)) {
+			return std::nullopt;
+		}
+	}
+
+	return compiler;
+}
+
+auto ecsact::cli::cc_compiler_cache::store( //
+	const cc_compiler& compiler
+) const -> bool {
+	auto compiler_key = key(compiler.compiler_path);
+	if(!compiler_key) {
+		return false;
+	}
+
+	auto ec = std::error_code{};
+	auto path = entry_path(*compiler_key);
+	fs::create_directories(path.parent_path(), ec);
+	if(ec) {
+		return false;
+	}
+
+	auto config = nlohmann::json{};
+	to_json(config, compiler);
+	config["compiler_path"] = fs::absolute(compiler.compiler_path).string();
+
+	return atomic_write_file(path, [&](std::ostream& file) {
+		file << config.dump(2) << "\n";
+	});
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include "ecsact/cli/commands/build/cc_compiler_config.hh"
+
+namespace ecsact::cli {
+
+/**
+ * Persistent cache of probed compilers (version, standard include and library
+ * paths.) Probing runs the compiler and on Windows vsdevcmd which is slow
+ * enough to matter on every build. Entries are compiler config files so they
+ * can be passed to `ecsact build --compiler_config` as is.
+ */
+class cc_compiler_cache {
+public:
+	cc_compiler_cache(std::filesystem::path dir);
+
+	/**
+	 * Identity of a compiler binary. Its path, size and modification time so
+	 * updating the compiler invalidates its entry.
+	 * @returns `std::nullopt` if the compiler could not be found
+	 */
+	static auto key( //
+		const std::filesystem::path& compiler_path
+	) -> std::optional<std::string>;
+
+	/**
+	 * Compiler config file of @p compiler_path
+	 * @returns `std::nullopt` if nothing is cached for the compiler
+	 */
+	auto config_path( //
+		const std::filesystem::path& compiler_path
+	) const -> std::optional<std::filesystem::path>;
+
+	/**
+	 * @returns `std::nullopt` if nothing is cached for the compiler or one of
+	 * its cached include or library directories no longer exists
+	 */
+	auto restore( //
+		const std::filesystem::path& compiler_path
+	) const -> std::optional<cc_compiler>;
+
+	/**
+	 * Store @p compiler under its compiler path. Failures are not fatal and only
+	 * mean the compiler is probed again next time.
+	 * @returns `false` if the entry could not be stored
+	 */
+	auto store(const cc_compiler& compiler) const -> bool;
+
+private:
+	std::filesystem::path _dir;
+
+	auto entry_path(std::string_view key) const -> std::filesystem::path;
+};
+
+} // namespace ecsact::cli
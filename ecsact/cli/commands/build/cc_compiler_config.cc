@@ -1,5 +1,6 @@
 #include "ecsact/cli/commands/build/cc_compiler_config.hh"
 
+#include <array>
 #include <fstream>
 #include <filesystem>
 #include "ecsact/cli/report.hh"
@@ -7,6 +8,42 @@
 
 namespace fs = std::filesystem;
 
+using ecsact::cli::cc_compiler_type;
+
+/**
+ * Names of `compiler_type` in compiler config files. The enum values are bit
+ * flags so magic_enum can't name them.
+ */
+constexpr auto compiler_type_names = std::array{
+	std::pair{cc_compiler_type::msvc_cl, std::string_view{"msvc_cl"}},
+	std::pair{cc_compiler_type::clang_cl, std::string_view{"clang_cl"}},
+	std::pair{cc_compiler_type::clang, std::string_view{"clang"}},
+	std::pair{cc_compiler_type::gcc, std::string_view{"gcc"}},
+	std::pair{cc_compiler_type::emcc, std::string_view{"emcc"}},
+};
+
+static auto compiler_type_name(cc_compiler_type type) -> std::string_view {
+	for(auto [named_type, name] : compiler_type_names) {
+		if(named_type == type) {
+			return name;
+		}
+	}
+
+	return "auto";
+}
+
+static auto compiler_type_from_name( //
+	std::string_view name
+) -> std::optional<cc_compiler_type> {
+	for(auto [type, type_name] : compiler_type_names) {
+		if(type_name == name) {
+			return type;
+		}
+	}
+
+	return std::nullopt;
+}
+
 auto ecsact::cli::get_compiler_type_by_path( //
 	std::filesystem::path compiler_path
 ) -> cc_compiler_type {
@@ -58,11 +95,24 @@ auto ecsact::cli::to_json( //
 	nlohmann::json&    j,
 	const cc_compiler& compiler
 ) -> void {
+	auto path_strings = [](const std::vector<fs::path>& paths) {
+		auto strings = std::vector<std::string>{};
+		strings.reserve(paths.size());
+		for(auto& path : paths) {
+			strings.emplace_back(path.string());
+		}
+		return strings;
+	};
+
 	j = nlohmann::json{
+		{"compiler_type", compiler_type_name(compiler.compiler_type)},
 		{"compiler_path", compiler.compiler_path.string()},
 		{"compiler_version", compiler.compiler_version},
 		{"install_path", compiler.install_path.string()},
+		{"std_inc_paths", path_strings(compiler.std_inc_paths)},
+		{"std_lib_paths", path_strings(compiler.std_lib_paths)},
 		{"preferred_output_extension", compiler.preferred_output_extension},
+		{"allowed_output_extensions", compiler.allowed_output_extensions},
 	};
 }
 
@@ -132,10 +182,10 @@ static auto json_get_opt( //
 	return std::nullopt;
 }
 
-static auto validate_compiler_config_json( //
+auto ecsact::cli::parse_compiler_config( //
 	const nlohmann::json& j
-) -> std::optional<ecsact::cli::cc_compiler> {
-	auto compiler = ecsact::cli::cc_compiler{};
+) -> std::optional<cc_compiler> {
+	auto compiler = cc_compiler{};
 
 	if(auto v = json_get_opt<fs::path>(j, "compiler_path"); !v) {
 		return {};
@@ -161,9 +211,12 @@ static auto validate_compiler_config_json( //
 	if(auto v = json_get_opt<std::string>(j, "compiler_type"); !v) {
 		return {};
 	} else {
+		auto compiler_type = compiler_type_from_name(*v);
 		if(v->empty() || *v == "auto") {
 			compiler.compiler_type =
 				ecsact::cli::get_compiler_type_by_path(compiler.compiler_path);
+		} else if(compiler_type) {
+			compiler.compiler_type = *compiler_type;
 		} else {
 			ecsact::cli::report_error("Invalid compiler type: {}", *v);
 			return {};
@@ -224,7 +277,7 @@ auto ecsact::cli::load_compiler_config( //
 	auto compiler_config = nlohmann::json{};
 	config_stream >> compiler_config;
 
-	auto compiler = validate_compiler_config_json(compiler_config);
+	auto compiler = parse_compiler_config(compiler_config);
 
 	if(!compiler) {
 		return {};
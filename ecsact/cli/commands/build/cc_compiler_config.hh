@@ -73,6 +73,13 @@ auto load_compiler_config( //
 	std::filesystem::path config_path
 ) -> std::optional<cc_compiler>;
 
+/**
+ * Compiler config from an already parsed config file. Problems are reported.
+ */
+auto parse_compiler_config( //
+	const nlohmann::json& config
+) -> std::optional<cc_compiler>;
+
 auto to_json(nlohmann::json& j, const cc_compiler& compiler) -> void;
 
 } // namespace ecsact::cli
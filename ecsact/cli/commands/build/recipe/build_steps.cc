@@ -0,0 +1,55 @@
+#include "ecsact/cli/commands/build/recipe/build_steps.hh"
+
+#include <algorithm>
+
+using ecsact::cli::build_steps_report_message;
+
+auto ecsact::cli::cook::build_step_recorder::add(
+	std::string                          kind,
+	std::string                          name,
+	const ecsact::cli::subcommand_usage& usage
+) -> void {
+	auto lk = std::scoped_lock{_mutex};
+	_steps.push_back({
+		.kind = std::move(kind),
+		.name = std::move(name),
+		.usage = usage,
+	});
+}
+
+auto ecsact::cli::cook::build_step_recorder::empty() const -> bool {
+	auto lk = std::scoped_lock{_mutex};
+	return _steps.empty();
+}
+
+auto ecsact::cli::cook::build_step_recorder::report( //
+	std::size_t top_count
+) const -> build_steps_report_message {
+	auto lk = std::scoped_lock{_mutex};
+
+	auto result = build_steps_report_message{
+		.total_steps = static_cast<int>(_steps.size()),
+		.total_wall_ms = 0.0,
+		.total_cpu_ms = 0.0,
+		.slowest = _steps,
+	};
+
+	for(auto& step : _steps) {
+		result.total_wall_ms += step.usage.wall_ms;
+		result.total_cpu_ms += step.usage.user_ms + step.usage.sys_ms;
+	}
+
+	// Ties broken by name so the report is stable
+	std::ranges::sort(result.slowest, [](const auto& a, const auto& b) {
+		if(a.usage.wall_ms != b.usage.wall_ms) {
+			return a.usage.wall_ms > b.usage.wall_ms;
+		}
+		return a.name < b.name;
+	});
+
+	if(result.slowest.size() > top_count) {
+		result.slowest.resize(top_count);
+	}
+
+	return result;
+}
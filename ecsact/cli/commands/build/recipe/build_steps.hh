@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "ecsact/cli/report_message.hh"
+
+namespace ecsact::cli::cook {
+
+/**
+ * Collects the time and memory of every compile and link subcommand of a
+ * build. Safe to use from every compile job at once.
+ */
+class build_step_recorder {
+public:
+	auto add(
+		std::string                          kind,
+		std::string                          name,
+		const ecsact::cli::subcommand_usage& usage
+	) -> void;
+
+	auto empty() const -> bool;
+
+	/**
+	 * @param top_count maximum number of steps listed
+	 */
+	auto report(std::size_t top_count) const
+		-> ecsact::cli::build_steps_report_message;
+
+private:
+	mutable std::mutex                                         _mutex;
+	std::vector<ecsact::cli::build_steps_report_message::step> _steps;
+};
+
+} // namespace ecsact::cli::cook
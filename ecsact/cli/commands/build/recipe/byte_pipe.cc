@@ -0,0 +1,62 @@
+#include "ecsact/cli/commands/build/recipe/byte_pipe.hh"
+
+using ecsact::cli::cook::byte_pipe;
+
+byte_pipe::byte_pipe(std::size_t max_buffered_bytes)
+	: _max_buffered_bytes(max_buffered_bytes) {
+}
+
+auto byte_pipe::write(std::span<const std::byte> bytes) -> bool {
+	if(bytes.empty()) {
+		return true;
+	}
+
+	auto lk = std::unique_lock{_mutex};
+
+	// A chunk larger than the limit is still accepted once the pipe is empty
+	_cv.wait(lk, [&] {
+		return _cancelled || _buffered_bytes == 0 ||
+			_buffered_bytes + bytes.size() <= _max_buffered_bytes;
+	});
+
+	if(_cancelled) {
+		return false;
+	}
+
+	_chunks.emplace_back(bytes.begin(), bytes.end());
+	_buffered_bytes += bytes.size();
+	_cv.notify_all();
+
+	return true;
+}
+
+auto byte_pipe::close() -> void {
+	auto lk = std::lock_guard{_mutex};
+	_closed = true;
+	_cv.notify_all();
+}
+
+auto byte_pipe::read() -> std::span<const std::byte> {
+	auto lk = std::unique_lock{_mutex};
+	_cv.wait(lk, [&] { return _closed || _cancelled || !_chunks.empty(); });
+
+	if(_chunks.empty() || _cancelled) {
+		_read_chunk.clear();
+		return {};
+	}
+
+	_read_chunk = std::move(_chunks.front());
+	_chunks.pop_front();
+	_buffered_bytes -= _read_chunk.size();
+	_cv.notify_all();
+
+	return _read_chunk;
+}
+
+auto byte_pipe::cancel() -> void {
+	auto lk = std::lock_guard{_mutex};
+	_cancelled = true;
+	_chunks.clear();
+	_buffered_bytes = 0;
+	_cv.notify_all();
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace ecsact::cli::cook {
+
+/**
+ * Bounded queue of bytes between one writer thread and one reader thread.
+ * Lets a download keep going while the data already received is decompressed
+ * without ever holding more than a fixed amount in memory.
+ */
+class byte_pipe {
+public:
+	/**
+	 * @param max_buffered_bytes writes block while this much is waiting to be
+	 *        read
+	 */
+	byte_pipe(std::size_t max_buffered_bytes);
+
+	/**
+	 * Append @p bytes. Blocks while the pipe is full.
+	 * @returns `false` if the reader cancelled and no more data is wanted
+	 */
+	auto write(std::span<const std::byte> bytes) -> bool;
+
+	/**
+	 * No more data will be written. Reads return an empty span once everything
+	 * written so far is read.
+	 */
+	auto close() -> void;
+
+	/**
+	 * Next chunk of written data. Blocks until there is data or the pipe is
+	 * closed.
+	 * @returns empty span when closed and drained. Valid until the next read.
+	 */
+	auto read() -> std::span<const std::byte>;
+
+	/**
+	 * The reader stopped reading (e.g. after an error). Blocked and future
+	 * writes return `false`.
+	 */
+	auto cancel() -> void;
+
+private:
+	std::mutex                         _mutex;
+	std::condition_variable            _cv;
+	std::deque<std::vector<std::byte>> _chunks;
+	std::vector<std::byte>             _read_chunk;
+	std::size_t                        _buffered_bytes = 0;
+	std::size_t                        _max_buffered_bytes;
+	bool                               _closed = false;
+	bool                               _cancelled = false;
+};
+
+} // namespace ecsact::cli::cook
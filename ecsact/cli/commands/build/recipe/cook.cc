@@ -6,26 +6,44 @@
 #include <string>
 #include <fstream>
 #include <cstdio>
-#include <future>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
 #include <set>
+#include <map>
+#include <sstream>
+#include <thread>
 #include <curl/curl.h>
 #undef fopen
 #include <boost/url.hpp>
-#include <boost/algorithm/string/case_conv.hpp>
 #include "magic_enum.hpp"
 #include "ecsact/cli/detail/proc_exec.hh"
 #include "ecsact/cli/commands/build/cc_compiler_config.hh"
 #include "ecsact/cli/commands/build/cc_defines_gen.hh"
 #include "ecsact/cli/commands/codegen/codegen.hh"
 #include "ecsact/cli/commands/codegen/codegen_util.hh"
-#include "ecsact/cli/commands/build/get_modules.hh"
+#include "ecsact/cli/commands/build/recipe/build_steps.hh"
+#include "ecsact/cli/commands/build/recipe/byte_pipe.hh"
+#include "ecsact/cli/commands/build/recipe/dylib_imports.hh"
 #include "ecsact/cli/commands/build/recipe/integrity.hh"
+#include "ecsact/cli/commands/build/recipe/job_scheduler.hh"
+#include "ecsact/cli/commands/build/recipe/object_cache.hh"
+#include "ecsact/cli/commands/build/recipe/pgo.hh"
+#include "ecsact/cli/commands/build/recipe/remote_compile.hh"
+#include "ecsact/cli/commands/build/recipe/repository_cache.hh"
+#include "ecsact/cli/commands/build/recipe/response_file.hh"
+#include "ecsact/cli/commands/build/recipe/source_graph.hh"
+#include "ecsact/cli/commands/build/recipe/stage_files.hh"
+#include "ecsact/cli/commands/build/recipe/time_trace.hh"
+#include "ecsact/cli/commands/build/recipe/unity_build.hh"
+#include "ecsact/cli/commands/build/recipe/work_dir_state.hh"
 #include "ecsact/cli/report.hh"
 #include "ecsact/cli/detail/argv0.hh"
 #include "ecsact/cli/detail/download.hh"
 #include "ecsact/cli/detail/glob.hh"
 #include "ecsact/cli/detail/archive.hh"
 #include "ecsact/cli/detail/long_path_workaround.hh"
+#include "ecsact/cli/detail/content_hash.hh"
 #ifndef ECSACT_CLI_USE_SDK_VERSION
 #	include "ecsact/cli/commands/build/recipe/cook_runfiles.hh"
 #endif
@@ -33,9 +51,40 @@
 using ecsact::cli::message_variant_t;
 using ecsact::cli::report_error;
 using ecsact::cli::report_warning;
-using ecsact::cli::detail::download_file;
+using ecsact::cli::subcommand_usage;
+using ecsact::cli::cook::build_step_recorder;
+using ecsact::cli::cook::byte_pipe;
+using ecsact::cli::cook::generate_dylib_imports;
+using ecsact::cli::cook::job_scheduler;
+using ecsact::cli::cook::object_cache;
+using ecsact::cli::cook::load_compile_times;
+using ecsact::cli::cook::partition_unity_sources;
+using ecsact::cli::cook::pgo_mode;
+using ecsact::cli::cook::prepare_pgo_profile;
+using ecsact::cli::cook::read_stamp;
+using ecsact::cli::cook::remote_compile_request;
+using ecsact::cli::cook::remote_executor_pool;
+using ecsact::cli::cook::repository_cache;
+using ecsact::cli::cook::run_source_graph;
+using ecsact::cli::cook::save_compile_times;
+using ecsact::cli::cook::source_dependencies;
+using ecsact::cli::cook::source_graph_node;
+using ecsact::cli::cook::stage_file;
+using ecsact::cli::cook::stage_method;
+using ecsact::cli::cook::staged_file_stamp;
+using ecsact::cli::cook::time_trace_aggregator;
+using ecsact::cli::cook::unity_source;
+using ecsact::cli::cook::work_dir_state;
+using ecsact::cli::cook::write_stamp;
+using ecsact::cli::cook::write_gnu_response_file;
+using ecsact::cli::cook::write_unity_sources;
+using ecsact::cli::detail::content_hasher;
+using ecsact::cli::detail::download_file_chunks;
+using ecsact::cli::detail::extract_archive;
 using ecsact::cli::detail::expand_path_globs;
+using ecsact::cli::detail::hash_file;
 using ecsact::cli::detail::integrity;
+using ecsact::cli::detail::integrity_hasher;
 using ecsact::cli::detail::long_path_workaround;
 using ecsact::cli::detail::path_before_glob;
 using ecsact::cli::detail::path_matches_glob;
@@ -138,37 +187,243 @@ static auto find_wasmer_dir() -> std::optional<fs::path> {
 	return std::nullopt;
 }
 
+constexpr auto FETCH_CHUNK_SIZE = std::size_t{64 * 1024};
+constexpr auto FETCH_PIPE_BUFFER_SIZE = std::size_t{4 * 1024 * 1024};
+
+struct fetch_stream_result {
+	/** Integrity of every fetched byte */
+	integrity fetched_integrity;
+
+	/** Temporary path and final path of every file written */
+	std::vector<std::pair<fs::path, fs::path>> staged_files;
+
+	/** Set if fetching or extracting failed. Nothing is staged then. */
+	std::optional<std::string> error;
+};
+
+static auto discard_staged_files(
+	const std::vector<std::pair<fs::path, fs::path>>& staged_files
+) -> void {
+	for(auto& [tmp_path, _] : staged_files) {
+		auto ec = std::error_code{};
+		fs::remove(tmp_path, ec);
+	}
+}
+
+/**
+ * Stream a fetch source from @p cached_path (or its url if there is none) into
+ * @p outdir. While the data is arriving it is hashed, decompressed if it is an
+ * archive and written to @p cache_writer so memory use stays the same no
+ * matter the download size. Files are written next to their final path and
+ * only moved there by the caller once the integrity is checked.
+ */
+static auto stream_fetch_source(
+	const ecsact::build_recipe::source_fetch& src,
+	const fs::path&                           outdir,
+	std::optional<fs::path>                   cached_path,
+	enum integrity::kind                      integrity_kind,
+	repository_cache::entry_writer*           cache_writer
+) -> fetch_stream_result {
+	auto result = fetch_stream_result{};
+	auto hasher = integrity_hasher{integrity_kind};
+	auto pipe = byte_pipe{FETCH_PIPE_BUFFER_SIZE};
+
+	auto on_chunk = [&](std::span<const std::byte> chunk) -> bool {
+		hasher.update(chunk);
+		if(cache_writer) {
+			cache_writer->write(chunk);
+		}
+		return pipe.write(chunk);
+	};
+
+	// Downloading (or reading the cache) runs on its own thread so network time
+	// overlaps with decompressing and writing files
+	auto fetch_error = std::optional<std::string>{};
+	auto fetch_thread = std::thread{[&] {
+		if(cached_path) {
+			auto file = std::ifstream{*cached_path, std::ios_base::binary};
+			auto buffer = std::vector<std::byte>(FETCH_CHUNK_SIZE);
+			while(file) {
+				file.read(
+					reinterpret_cast<char*>(buffer.data()),
+					static_cast<std::streamsize>(buffer.size())
+				);
+				auto read_amount = static_cast<std::size_t>(file.gcount());
+				if(!on_chunk(std::span{buffer.data(), read_amount})) {
+					break;
+				}
+			}
+			if(file.bad()) {
+				fetch_error = std::format("failed to read {}", cached_path->string());
+			}
+		} else {
+			auto download_error = download_file_chunks(src.url, on_chunk);
+			if(download_error) {
+				fetch_error = std::format(
+					"failed to download {}: {}",
+					src.url,
+					download_error->what()
+				);
+			}
+		}
+		pipe.close();
+	}};
+
+	auto created_out_dirs = std::set<fs::path>{};
+	auto stage_output = [&](fs::path out_file_path) -> fs::path {
+		auto dir = out_file_path.parent_path();
+		if(!created_out_dirs.contains(dir)) {
+			auto ec = std::error_code{};
+			fs::create_directories(dir, ec);
+			if(ec) {
+				throw std::logic_error{std::format(
+					"failed to create dir {}: {}",
+					dir.string(),
+					ec.message()
+				)};
+			}
+			created_out_dirs.insert(dir);
+		}
+
+		auto tmp_path = out_file_path;
+		tmp_path += ".fetch-tmp";
+		result.staged_files.emplace_back(tmp_path, out_file_path);
+		return tmp_path;
+	};
+
+	auto extract_error = std::optional<std::string>{};
+	try {
+		if(is_archive(src.url)) {
+			extract_archive(
+				[&] { return pipe.read(); },
+				[&](std::string_view path) -> std::vector<fs::path> {
+					ecsact::cli::report_info("archive path={}", path);
+					if(src.strip_prefix) {
+						if(path.starts_with(*src.strip_prefix)) {
+							path = path.substr(src.strip_prefix->size());
+						}
+					}
+
+					auto out_file_paths = std::vector<fs::path>{};
+					if(src.paths) {
+						for(auto glob : *src.paths) {
+							if(path_matches_glob(path, glob)) {
+								auto before_glob = path_before_glob(glob);
+								auto rel_outdir = outdir;
+								if(auto stripped = path_strip_prefix(path, before_glob)) {
+									rel_outdir = outdir / *stripped;
+								}
+								out_file_paths.emplace_back(rel_outdir / fs::path{path});
+							}
+						}
+					} else {
+						out_file_paths.emplace_back(outdir / fs::path{path});
+					}
+
+					auto tmp_paths = std::vector<fs::path>{};
+					for(auto i = std::size_t{}; out_file_paths.size() > i; ++i) {
+						auto prev_end = out_file_paths.begin() + i;
+						auto duplicate = std::find(
+							out_file_paths.begin(),
+							prev_end,
+							out_file_paths[i]
+						);
+						if(duplicate == prev_end) {
+							tmp_paths.emplace_back(stage_output(out_file_paths[i]));
+						}
+					}
+					return tmp_paths;
+				}
+			);
+
+			// An archive may end before the data does (e.g. tar padding.) The rest
+			// still counts towards the integrity.
+			while(!pipe.read().empty()) {
+			}
+		} else {
+			auto path = std::string{boost::url{src.url}.path().c_str()};
+			if(src.strip_prefix) {
+				if(path.starts_with(*src.strip_prefix)) {
+					path = path.substr(src.strip_prefix->size());
+				}
+			}
+
+			auto tmp_path = stage_output(outdir / fs::path{path}.filename());
+			auto file = std::ofstream{
+				tmp_path,
+				std::ios_base::binary | std::ios_base::trunc,
+			};
+			for(auto chunk = pipe.read(); !chunk.empty(); chunk = pipe.read()) {
+				file.write(
+					reinterpret_cast<const char*>(chunk.data()),
+					static_cast<std::streamsize>(chunk.size())
+				);
+			}
+
+			file.close();
+			if(!file) {
+				throw std::logic_error{
+					std::format("failed to write {}", tmp_path.string()),
+				};
+			}
+		}
+	} catch(const std::exception& err) {
+		// Includes invalid urls (boost::system::system_error)
+		extract_error =
+			std::format("failed to extract {}: {}", src.url, err.what());
+		pipe.cancel();
+	} catch(...) {
+		// Destroying a joinable thread terminates the process
+		pipe.cancel();
+		fetch_thread.join();
+		throw;
+	}
+
+	fetch_thread.join();
+
+	result.fetched_integrity = hasher.finish();
+
+	// A failed download usually also breaks the extraction so it is the more
+	// useful error to show
+	if(fetch_error || extract_error) {
+		result.error = fetch_error ? fetch_error : extract_error;
+		discard_staged_files(result.staged_files);
+		result.staged_files.clear();
+	}
+
+	return result;
+}
+
 static auto handle_source( //
 	fs::path                                base_directory,
 	ecsact::build_recipe::source_fetch      src,
-	const ecsact::cli::cook_recipe_options& options
+	const ecsact::cli::cook_recipe_options& options,
+	work_dir_state&                         state,
+	std::vector<fs::path>&                  out_outputs
 ) -> int {
 	auto outdir = src.outdir //
 		? options.work_dir / *src.outdir
 		: options.work_dir;
-	auto url = boost::url{src.url};
-	auto created_out_dirs = std::set<std::string>{};
-
-	auto ensure_dir = [&created_out_dirs](fs::path p) -> int {
-		auto dir = p.parent_path();
-		if(created_out_dirs.contains(dir.generic_string())) {
-			return 0;
-		}
-
-		auto ec = std::error_code{};
-		fs::create_directories(dir, ec);
-		if(ec) {
-			ecsact::cli::report_error(
-				"failed to create dir {}: {}",
-				dir.string(),
-				ec.message()
-			);
-			return 1;
-		}
-
-		created_out_dirs.insert(dir.generic_string());
+	auto written_files = std::vector<fs::path>{};
+
+	auto step_id = std::format("fetch:{}:{}", outdir.generic_string(), src.url);
+	auto input_hasher = content_hasher{};
+	input_hasher.update(src.url);
+	input_hasher.update(src.integrity.value_or(""));
+	input_hasher.update(src.strip_prefix.value_or(""));
+	for(auto glob : src.paths.value_or(std::vector<std::string>{})) {
+		input_hasher.update(glob);
+	}
+	auto input_hash = input_hasher.digest();
+
+	// Without an integrity the contents behind the url may change so it is
+	// always fetched again
+	if(src.integrity && state.up_to_date(step_id, input_hash)) {
+		ecsact::cli::report_info("Fetch {} is up to date", src.url);
+		out_outputs = state.previous_outputs(step_id);
+		state.record(step_id, input_hash, out_outputs);
 		return 0;
-	};
+	}
 
 	auto src_integrity = std::optional<integrity>{};
 	if(src.integrity) {
@@ -179,91 +434,140 @@ static auto handle_source( //
 		}
 	}
 
-	auto downloaded_data = download_file(src.url);
-	if(!downloaded_data) {
-		report_error(
-			"failed to download {}: {}",
-			src.url,
-			downloaded_data.error().what()
-		);
-		return 1;
+	auto integrity_kind = src_integrity //
+		? src_integrity->kind()
+		: integrity::sha256;
+
+	auto repo_cache = options.repository_cache_dir //
+		? std::optional{repository_cache{*options.repository_cache_dir}}
+		: std::nullopt;
+	auto repo_cache_key = repository_cache::key(src_integrity, src.url);
+
+	// Entries keyed by url may be stale so they are only used offline
+	auto fetched = std::optional<fetch_stream_result>{};
+	if(repo_cache && (options.offline || src_integrity)) {
+		if(auto cached_path = repo_cache->restore_path(repo_cache_key)) {
+			ecsact::cli::report_info("Using cached download of {}", src.url);
+			fetched = stream_fetch_source(
+				src,
+				outdir,
+				cached_path,
+				integrity_kind,
+				nullptr
+			);
+
+			auto corrupt = fetched->error ||
+				(src_integrity && fetched->fetched_integrity != *src_integrity);
+			if(corrupt) {
+				report_warning("Repository cache entry for {} is corrupt", src.url);
+				discard_staged_files(fetched->staged_files);
+				repo_cache->remove(repo_cache_key);
+				fetched = std::nullopt;
+			}
+		}
 	}
-	auto downloaded_data_integrity = integrity::from_bytes(
-		src_integrity ? src_integrity->kind() : integrity::sha256,
-		std::span{downloaded_data->data(), downloaded_data->size()}
-	);
 
-	if(src_integrity) {
-		if(*src_integrity != downloaded_data_integrity) {
+	if(!fetched) {
+		if(options.offline) {
+			report_error(
+				"{} is not in the repository cache and downloads are disabled "
+				"(--offline)",
+				src.url
+			);
+			return 1;
+		}
+
+		auto cache_writer = repo_cache //
+			? std::optional{repo_cache->begin_store()}
+			: std::nullopt;
+		fetched = stream_fetch_source(
+			src,
+			outdir,
+			std::nullopt,
+			integrity_kind,
+			cache_writer ? &*cache_writer : nullptr
+		);
+
+		if(fetched->error) {
+			report_error("{}", *fetched->error);
+			return 1;
+		}
+
+		if(src_integrity && fetched->fetched_integrity != *src_integrity) {
 			report_warning(
 				"{} integrity is {} and was expected to be {}",
 				src.url,
-				downloaded_data_integrity.to_string(),
+				fetched->fetched_integrity.to_string(),
 				src_integrity->to_string()
 			);
+			discard_staged_files(fetched->staged_files);
 			return 1;
 		}
-	} else {
+
+		if(cache_writer) {
+			cache_writer->commit(repo_cache_key);
+
+			// Later builds that pin this integrity find it without downloading
+			if(!src_integrity) {
+				cache_writer->commit(
+					repository_cache::key(fetched->fetched_integrity, src.url)
+				);
+			}
+		}
+	}
+
+	if(!src_integrity) {
 		report_warning(
 			"{} integrity is {}",
 			src.url,
-			downloaded_data_integrity.to_string()
+			fetched->fetched_integrity.to_string()
 		);
 	}
 
-	if(is_archive(src.url)) {
-		ecsact::cli::detail::read_archive(
-			*downloaded_data,
-			[&](std::string_view path, std::span<std::byte> data) {
-				ecsact::cli::report_info(
-					"archive path={} data.size={}",
-					path,
-					data.size()
-				);
-				if(src.strip_prefix) {
-					if(path.starts_with(*src.strip_prefix)) {
-						path = path.substr(src.strip_prefix->size());
-					}
-				}
-				if(src.paths) {
-					for(auto glob : *src.paths) {
-						if(path_matches_glob(path, glob)) {
-							auto before_glob = path_before_glob(glob);
-							auto rel_outdir = outdir;
-							if(auto stripped = path_strip_prefix(path, before_glob)) {
-								rel_outdir = outdir / *stripped;
-							}
-							auto out_file_path = rel_outdir / fs::path{path};
-							ensure_dir(out_file_path);
-							write_file(out_file_path, data);
-						}
-					}
-				} else {
-					auto out_file_path = outdir / fs::path{path};
-					ensure_dir(out_file_path);
-					write_file(out_file_path, data);
-				}
-			}
-		);
-	} else {
-		auto path = std::string{url.path().c_str()};
-		if(src.strip_prefix) {
-			if(path.starts_with(*src.strip_prefix)) {
-				path = path.substr(src.strip_prefix->size());
-			}
+	for(auto& [tmp_path, out_file_path] : fetched->staged_files) {
+		auto ec = std::error_code{};
+		fs::rename(tmp_path, out_file_path, ec);
+		if(ec) {
+			report_error(
+				"failed to write {}: {}",
+				out_file_path.string(),
+				ec.message()
+			);
+			discard_staged_files(fetched->staged_files);
+			return 1;
 		}
-		auto out_file_path = outdir / fs::path{path}.filename();
-		ensure_dir(out_file_path);
-		write_file(out_file_path, *downloaded_data);
+		written_files.emplace_back(out_file_path);
 	}
 
+	out_outputs = written_files;
+	state.record(step_id, input_hash, std::move(written_files));
+
 	return 0;
 }
 
+/**
+ * Last write time of every regular file in @p dir
+ */
+static auto snapshot_files( //
+	const fs::path& dir
+) -> std::map<fs::path, fs::file_time_type> {
+	auto snapshot = std::map<fs::path, fs::file_time_type>{};
+	auto ec = std::error_code{};
+	for(auto& entry : fs::recursive_directory_iterator(dir, ec)) {
+		if(entry.is_regular_file(ec)) {
+			snapshot.emplace(entry.path(), entry.last_write_time(ec));
+		}
+	}
+
+	return snapshot;
+}
+
 static auto handle_source( //
 	fs::path                                base_directory,
 	ecsact::build_recipe::source_codegen    src,
-	const ecsact::cli::cook_recipe_options& options
+	const ecsact::cli::cook_recipe_options& options,
+	work_dir_state&                         state,
+	std::vector<fs::path>&                  out_outputs
 ) -> int {
 	auto default_plugins_dir = ecsact::cli::get_default_plugins_dir();
 	auto plugin_paths = std::vector<fs::path>{};
@@ -289,18 +593,84 @@ static auto handle_source( //
 		plugin_paths.push_back(*plugin_path);
 	}
 
+	auto step_id = std::format("codegen:{}", out_dir.generic_string());
+	auto input_hasher = content_hasher{};
+	for(auto& file : options.files) {
+		input_hasher.update(file.generic_string());
+		if(!input_hasher.update_file(file)) {
+			ecsact::cli::report_error("Failed to read {}", file.generic_string());
+			return 1;
+		}
+	}
+
+	for(auto& plugin_path : plugin_paths) {
+		auto ec = std::error_code{};
+		auto plugin_size = fs::file_size(plugin_path, ec);
+		auto plugin_write_time = fs::last_write_time(plugin_path, ec);
+		input_hasher.update(plugin_path.generic_string());
+		input_hasher.update(std::to_string(plugin_size));
+		input_hasher.update(
+			std::to_string(plugin_write_time.time_since_epoch().count())
+		);
+	}
+	auto input_hash = input_hasher.digest();
+
+	if(state.up_to_date(step_id, input_hash)) {
+		ecsact::cli::report_info(
+			"Codegen for {} is up to date",
+			out_dir.generic_string()
+		);
+		out_outputs = state.previous_outputs(step_id);
+		state.record(step_id, input_hash, out_outputs);
+		return 0;
+	}
+
+	auto files_before = snapshot_files(out_dir);
+
 	auto exit_code = ecsact::cli::codegen({
 		.plugin_paths = plugin_paths,
 		.outdir = out_dir,
+		.cache_dir = options.codegen_cache_dir,
 	});
 
-	return exit_code;
+	if(exit_code != 0) {
+		return exit_code;
+	}
+
+	// Plugins rewrite every output file so anything new or touched is an output
+	auto outputs = std::vector<fs::path>{};
+	for(auto&& [path, write_time] : snapshot_files(out_dir)) {
+		auto before = files_before.find(path);
+		if(before == files_before.end() || before->second != write_time) {
+			outputs.emplace_back(path);
+		}
+	}
+
+	out_outputs = outputs;
+	state.record(step_id, input_hash, std::move(outputs));
+
+	return 0;
+}
+
+static auto stage_method_verb(stage_method method) -> std::string_view {
+	switch(method) {
+		case stage_method::reflink:
+			return "Cloned";
+		case stage_method::hardlink:
+			return "Linked";
+		case stage_method::copy:
+			return "Copied";
+	}
+
+	return "Copied";
 }
 
 static auto handle_source( //
 	fs::path                                base_directory,
 	ecsact::build_recipe::source_path       src,
-	const ecsact::cli::cook_recipe_options& options
+	const ecsact::cli::cook_recipe_options& options,
+	work_dir_state&                         state,
+	std::vector<fs::path>&                  out_outputs
 ) -> int {
 	auto src_path = src.path;
 	if(!src_path.is_absolute()) {
@@ -316,6 +686,12 @@ static auto handle_source( //
 	auto ec = std::error_code{};
 	fs::create_directories(outdir, ec);
 
+	auto step_id = std::format(
+		"path:{}:{}",
+		outdir.generic_string(),
+		src_path.generic_string()
+	);
+
 	auto before_glob = path_before_glob(src_path);
 	auto paths = expand_path_globs(src_path, ec);
 	if(ec) {
@@ -327,6 +703,8 @@ static auto handle_source( //
 		return 1;
 	}
 
+	auto src_files = std::vector<fs::path>{};
+	auto outputs = std::vector<fs::path>{};
 	for(auto path : paths) {
 		if(!fs::exists(path)) {
 			ecsact::cli::report_error(
@@ -348,28 +726,121 @@ static auto handle_source( //
 		}
 
 		rel_outdir = rel_outdir.lexically_normal();
+		src_files.emplace_back(path);
+		outputs.emplace_back(rel_outdir / path.filename());
+	}
+
+	auto stamps = std::vector<std::optional<staged_file_stamp>>(outputs.size());
+	auto up_to_date_count = std::atomic_int{};
+
+	// Vendored source trees can be large so files are staged in parallel. Jobs
+	// is this source's share of --jobs when other sources run alongside it.
+	auto results = run_source_graph(
+		std::vector<std::vector<std::size_t>>(outputs.size()),
+		options.jobs,
+		[&](std::size_t index) -> int {
+			auto& path = src_files[index];
+			auto& out_file_path = outputs[index];
+			auto ec = std::error_code{};
+
+			auto src_size = fs::file_size(path, ec);
+			auto src_write_time = fs::file_time_type{};
+			if(!ec) {
+				src_write_time = fs::last_write_time(path, ec);
+			}
+			if(ec) {
+				ecsact::cli::report_error(
+					"Failed to read source {}: {}",
+					path.generic_string(),
+					ec.message()
+				);
+				return 1;
+			}
 
-		fs::create_directories(rel_outdir, ec);
-		fs::copy(path, rel_outdir, ec);
+			auto stamp = staged_file_stamp{
+				.size = src_size,
+				.write_time = src_write_time.time_since_epoch().count(),
+			};
+
+			// Unchanged size and write time are trusted. If only the write time
+			// changed the contents are compared by hash before staging again.
+			auto prev_stamp_str = state.previous_stamp(step_id, out_file_path);
+			auto prev_stamp = prev_stamp_str //
+				? staged_file_stamp::parse(*prev_stamp_str)
+				: std::nullopt;
+			auto out_file_size = fs::file_size(out_file_path, ec);
+			if(!ec && prev_stamp && prev_stamp->size == stamp.size &&
+				 out_file_size == stamp.size) {
+				if(prev_stamp->write_time == stamp.write_time) {
+					stamps[index] = *prev_stamp;
+					up_to_date_count += 1;
+					return 0;
+				}
 
-		if(ec) {
-			ecsact::cli::report_error(
-				"Failed to copy source {} to {}: {}",
-				path.generic_string(),
-				rel_outdir.generic_string(),
-				ec.message()
+				stamp.hash = hash_file(path).value_or("");
+				if(stamp.hash == prev_stamp->hash) {
+					stamps[index] = stamp;
+					up_to_date_count += 1;
+					return 0;
+				}
+			}
+
+			if(stamp.hash.empty()) {
+				stamp.hash = hash_file(path).value_or("");
+			}
+
+			fs::create_directories(out_file_path.parent_path(), ec);
+			auto method = stage_file(path, out_file_path, ec);
+			if(ec) {
+				ecsact::cli::report_error(
+					"Failed to copy source {} to {}: {}",
+					path.generic_string(),
+					out_file_path.parent_path().generic_string(),
+					ec.message()
+				);
+				return 1;
+			}
+
+			if(!stamp.hash.empty()) {
+				stamps[index] = stamp;
+			}
+
+			ecsact::cli::report_info(
+				"{} {} to {}",
+				stage_method_verb(method),
+				path.string(),
+				out_file_path.parent_path().string()
 			);
+			return 0;
+		}
+	);
+
+	for(auto& result : results) {
+		if(!result || *result != 0) {
 			return 1;
 		}
+	}
 
+	if(up_to_date_count > 0) {
 		ecsact::cli::report_info(
-			"Copied {} to {}",
-			path.string(),
-			rel_outdir.string(),
-			ec.message()
+			"{} source(s) from {} are up to date",
+			up_to_date_count.load(),
+			src_path.generic_string()
 		);
 	}
 
+	auto output_stamps = std::map<fs::path, std::string>{};
+	for(auto i = std::size_t{}; outputs.size() > i; ++i) {
+		if(stamps[i]) {
+			output_stamps.emplace(outputs[i], stamps[i]->to_string());
+		}
+	}
+
+	// Staging always runs since unchanged files are cheap to skip. Recording it
+	// keeps its outputs from being removed as stale.
+	out_outputs = outputs;
+	state.record(step_id, "", std::move(outputs), std::move(output_stamps));
+
 	return 0;
 }
 
@@ -379,97 +850,564 @@ constexpr auto GENERATED_DYLIB_DISCLAIMER = R"(
 ////////////////////////////////////////////////////////////////////////////////
 )";
 
-constexpr auto LOAD_AT_RUNTIME_GUARD = R"(
-#ifndef ECSACT_{0}_API_LOAD_AT_RUNTIME
-#   error "Expected ECSACT_{0}_API_LOAD_AT_RUNTIME to be set"
-#endif // ECSACT_{0}_API_LOAD_AT_RUNTIME
+struct compile_options {
+	fs::path work_dir;
 
-#ifdef ECSACT_{0}_API
-#   error "ECSACT_{0}_API may not be set while using generated dylib source"
-#endif // ECSACT_{0}_API
-)";
+	ecsact::cli::cc_compiler                     compiler;
+	std::vector<fs::path>                        inc_dirs;
+	std::vector<std::string>                     system_libs;
+	std::unordered_map<std::string, std::string> defines;
+	std::vector<fs::path>                        srcs;
+	fs::path                                     output_path;
+	std::vector<std::string>                     imports;
+	std::vector<std::string>                     exports;
+	std::optional<fs::path>                      tracy_dir;
+	bool                                         debug;
+	std::optional<object_cache>                  obj_cache;
+	job_scheduler&                               scheduler;
+	std::vector<std::string>                     precompiled_headers;
+	pgo_mode                                     pgo = pgo_mode::none;
+
+	/** Indexed profile relative to the work directory for `pgo_mode::use` */
+	fs::path pgo_profdata;
+
+	/** Compile every source with timing enabled and report where time went */
+	bool time_trace = false;
+
+	/** Requested gcc/clang linker. Empty or "auto" to pick one. */
+	std::string linker;
+
+	/** Build workers preprocessed gcc/clang sources may be compiled on */
+	remote_executor_pool* executors = nullptr;
+};
+
+/**
+ * A precompiled header built for a single compile and the extra arguments
+ * every translation unit needs to use it
+ */
+struct precompiled_header {
+	std::vector<std::string> compile_args;
+	std::vector<std::string> preprocess_args;
 
-static auto generate_dylib_imports( //
-	auto&&        imports,
-	std::ostream& output
+	/** Changes whenever the precompiled header is rebuilt */
+	std::string key;
+
+	/** Object that must be linked (cl only) */
+	std::optional<fs::path> object;
+};
+
+struct tracy_compile_options {
+	fs::path                 tracy_dir;
+	fs::path                 output_path;
+	ecsact::cli::cc_compiler compiler;
+};
+
+/**
+ * Entries in each list of the time trace report
+ */
+constexpr auto TIME_TRACE_TOP_COUNT = std::size_t{10};
+
+/**
+ * Report the time traces of every compiled source. Sources without a trace
+ * only contribute their measured compile time.
+ */
+static auto report_time_trace(
+	const std::vector<fs::path>&      srcs,
+	const std::vector<std::uint64_t>& compile_times,
+	const std::vector<fs::path>&      trace_paths
 ) -> void {
-	auto mods = ecsact::cli::detail::get_ecsact_modules(as_vec(imports));
-	output << GENERATED_DYLIB_DISCLAIMER;
-	output << "#include <string>\n";
-	output << "#include \"ecsact/runtime/common.h\"\n";
-	for(auto&& [module_name, _] : mods.module_methods) {
-		output << std::format("#include \"ecsact/runtime/{}.h\"\n", module_name);
-	}
-
-	for(auto&& [module_name, _] : mods.module_methods) {
-		output << std::format( //
-			LOAD_AT_RUNTIME_GUARD,
-			boost::to_upper_copy(module_name)
+	auto aggregator = time_trace_aggregator{};
+	auto traced_count = 0;
+
+	for(auto i = 0; srcs.size() > i; ++i) {
+		auto src_name = srcs[i].generic_string();
+		auto has_trace = trace_paths.size() > i &&
+			aggregator.add_file(src_name, trace_paths[i]);
+		if(has_trace) {
+			traced_count += 1;
+		} else if(compile_times[i] > 0) {
+			aggregator.add_source_time(src_name, compile_times[i]);
+		}
+	}
+
+	if(aggregator.source_count() == 0) {
+		return;
+	}
+
+	if(traced_count != aggregator.source_count()) {
+		ecsact::cli::report_info(
+			"Time traces available for {} of {} sources",
+			traced_count,
+			aggregator.source_count()
 		);
 	}
 
-	output << "\n";
+	ecsact::cli::report(aggregator.report(TIME_TRACE_TOP_COUNT));
+}
+
+/**
+ * Steps listed in the build steps report
+ */
+constexpr auto BUILD_STEPS_TOP_COUNT = std::size_t{10};
 
-	for(std::string_view imp : imports) {
-		output << std::format( //
-			"decltype({0})({0}) = nullptr;\n",
-			imp
+static auto report_build_steps(const build_step_recorder& steps) -> void {
+	if(!steps.empty()) {
+		ecsact::cli::report(steps.report(BUILD_STEPS_TOP_COUNT));
+	}
+}
+
+static auto elapsed_us( //
+	std::chrono::steady_clock::time_point start
+) -> std::uint64_t {
+	auto elapsed = std::chrono::steady_clock::now() - start;
+	return static_cast<std::uint64_t>(
+		std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()
+	);
+}
+
+/**
+ * Remember how long each compiled source took so later unity builds can
+ * balance their translation units.
+ * @param srcs absolute or relative to @p work_dir
+ */
+static auto record_compile_times(
+	const fs::path&                   work_dir,
+	const std::vector<fs::path>&      srcs,
+	const std::vector<std::uint64_t>& compile_times
+) -> void {
+	auto compile_times_by_src = std::unordered_map<std::string, std::uint64_t>{};
+	for(auto i = 0; srcs.size() > i; ++i) {
+		if(compile_times[i] == 0) {
+			continue;
+		}
+
+		auto src = (work_dir / srcs[i]).lexically_normal();
+		compile_times_by_src[src.generic_string()] = compile_times[i];
+	}
+
+	save_compile_times(work_dir, compile_times_by_src);
+}
+
+/**
+ * Key for a link of @p object_keys with @p link_args. Used to skip the link
+ * when nothing changed since the last build.
+ * @returns `std::nullopt` if any object has no key
+ */
+static auto link_stamp(
+	const ecsact::cli::cc_compiler& compiler,
+	const std::vector<std::string>& link_args,
+	const std::vector<std::string>& object_keys
+) -> std::optional<std::string> {
+	auto hasher = content_hasher{};
+	hasher.update(compiler.compiler_path.generic_string());
+	hasher.update(compiler.compiler_version);
+	for(auto& arg : link_args) {
+		hasher.update(arg);
+	}
+
+	for(auto& key : object_keys) {
+		if(key.empty()) {
+			return std::nullopt;
+		}
+		hasher.update(key);
+	}
+
+	return hasher.digest();
+}
+
+/**
+ * Linker given to gcc/clang with -fuse-ld. If none is @p requested mold is
+ * preferred when installed, then lld for clang.
+ * @returns `std::nullopt` to use the compiler's default linker
+ */
+static auto select_linker(
+	const ecsact::cli::cc_compiler& compiler,
+	const std::string&              requested
+) -> std::optional<std::string> {
+	if(!requested.empty() && requested != "auto") {
+		return requested;
+	}
+
+	using ecsact::cli::cc_compiler_type;
+
+#if !defined(_WIN32)
+	if(compiler.compiler_type == cc_compiler_type::clang ||
+		 compiler.compiler_type == cc_compiler_type::gcc) {
+		// -fuse-ld=mold looks for ld.mold
+		if(ecsact::cli::detail::which("ld.mold")) {
+			return "mold";
+		}
+	}
+#endif
+
+	if(compiler.compiler_type == cc_compiler_type::clang) {
+		return "lld";
+	}
+
+	return std::nullopt;
+}
+
+static auto format_byte_size(std::uintmax_t bytes) -> std::string {
+	if(bytes >= 1024 * 1024) {
+		return std::format("{:.1f}MiB", bytes / (1024.0 * 1024.0));
+	}
+	if(bytes >= 1024) {
+		return std::format("{:.1f}KiB", bytes / 1024.0);
+	}
+	return std::format("{}B", bytes);
+}
+
+/**
+ * Report how long the link took and how big its inputs and output are
+ */
+static auto report_link_stats(
+	const fs::path&              work_dir,
+	const std::vector<fs::path>& objects,
+	const fs::path&              output_path,
+	std::uint64_t                link_us
+) -> void {
+	auto ec = std::error_code{};
+	auto objects_size = std::uintmax_t{};
+	for(auto& obj : objects) {
+		auto obj_size = fs::file_size(work_dir / obj, ec);
+		if(!ec) {
+			objects_size += obj_size;
+		}
+	}
+
+	auto output_size = fs::file_size(output_path, ec);
+
+	ecsact::cli::report_info(
+		"Linked {} objects ({}) in {:.2f}s. Output is {}",
+		objects.size(),
+		format_byte_size(objects_size),
+		link_us / 1'000'000.0,
+		ec ? "missing"s : format_byte_size(output_size)
+	);
+}
+
+/**
+ * Write the header that includes every recipe precompiled header. Headers
+ * found in @p work_dir are included by absolute path, others from the
+ * include paths. The file is left as is if its contents would not change so
+ * its write time still matches the one recorded in the precompiled header.
+ */
+static auto write_prefix_header(
+	const fs::path&                 prefix_header_path,
+	const std::vector<std::string>& headers,
+	const fs::path&                 work_dir
+) -> void {
+	auto ec = std::error_code{};
+	fs::create_directories(prefix_header_path.parent_path(), ec);
+
+	auto contents = std::stringstream{};
+	contents << GENERATED_DYLIB_DISCLAIMER << "\n";
+	contents << "#pragma once\n\n";
+	for(auto& header : headers) {
+		auto work_dir_header = (work_dir / header).lexically_normal();
+		if(fs::exists(work_dir_header, ec)) {
+			contents << std::format(
+				"#include \"{}\"\n",
+				fs::absolute(work_dir_header).generic_string()
+			);
+		} else {
+			contents << std::format("#include <{}>\n", header);
+		}
+	}
+
+	auto existing = std::stringstream{};
+	if(auto existing_file = std::ifstream{prefix_header_path}; existing_file) {
+		existing << existing_file.rdbuf();
+	}
+
+	if(existing.str() != contents.str()) {
+		std::ofstream{prefix_header_path, std::ios::trunc} << contents.str();
+	}
+}
+
+/**
+ * Build (or reuse) a clang/gcc precompiled header of the recipe's
+ * precompiled headers compiled with @p compile_args.
+ * @returns `std::nullopt` if the precompiled header could not be built
+ */
+static auto clang_gcc_precompile_header(
+	const compile_options&          options,
+	const std::vector<std::string>& compile_args
+) -> std::optional<precompiled_header> {
+	const auto is_clang =
+		options.compiler.compiler_type == ecsact::cli::cc_compiler_type::clang;
+	const auto pch_dir = fs::path{"intermediate"} / "pch";
+	const auto prefix_header = pch_dir / "ecsact-pch.hh";
+
+	// gcc picks up <header>.gch automatically when <header> is included
+	auto pch_file = prefix_header;
+	pch_file += is_clang ? ".pch" : ".gch";
+
+	write_prefix_header(
+		options.work_dir / prefix_header,
+		options.precompiled_headers,
+		options.work_dir
+	);
+
+	auto pch_args = compile_args;
+	assert(pch_args.size() >= 2 && pch_args[0] == "-x");
+	pch_args[1] = "c++-header";
+	pch_args.push_back(prefix_header.generic_string());
+
+	auto preprocess_args = pch_args;
+	preprocess_args.push_back("-E");
+	preprocess_args.push_back("-w");
+
+	auto preprocessed = ecsact::cli::detail::spawn_get_stdout_bytes(
+		options.compiler.compiler_path,
+		preprocess_args,
+		options.work_dir
+	);
+
+	if(!preprocessed) {
+		report_warning("Failed to preprocess precompiled header. Not using it");
+		return std::nullopt;
+	}
+
+	// clang rejects a precompiled header if any of its inputs has a different
+	// write time than when it was built. Headers are rewritten by codegen and
+	// precompiled headers are restored from the cache into other work
+	// directories, so inputs are validated by content instead. The key
+	// already covers the preprocessed content.
+	auto result = precompiled_header{
+		.compile_args = is_clang //
+			? std::vector<std::string>{
+					"-include-pch",
+					pch_file.generic_string(),
+					"-fpch-validate-input-files-content",
+				}
+			: std::vector<std::string>{"-include", prefix_header.generic_string()},
+		.preprocess_args = {"-include", prefix_header.generic_string()},
+		// Precompiled headers record the absolute paths of their inputs so they
+		// are only reused from other work directories if they don't include any
+		// work directory headers
+		.key = object_cache::key(options.compiler, {}, pch_args, *preprocessed),
+	};
+
+	auto pch_path = options.work_dir / pch_file;
+	auto pch_stamp_path = pch_path;
+	pch_stamp_path += ".key";
+
+	if(fs::exists(pch_path) && read_stamp(pch_stamp_path) == result.key) {
+		ecsact::cli::report_info("Precompiled header is up to date");
+		return result;
+	}
+
+	if(options.obj_cache && options.obj_cache->restore(result.key, pch_path)) {
+		ecsact::cli::report_info("Precompiled header restored from cache");
+		write_stamp(pch_stamp_path, result.key);
+		return result;
+	}
+
+	auto ec = std::error_code{};
+	fs::remove(pch_stamp_path, ec);
+
+	pch_args.push_back("-o");
+	pch_args.push_back(pch_file.generic_string());
+
+	ecsact::cli::report_info("Building precompiled header...");
+	auto exit_code = ecsact::cli::detail::spawn_and_report_output(
+		options.compiler.compiler_path,
+		pch_args,
+		options.work_dir
+	);
+
+	if(exit_code != 0) {
+		report_warning(
+			"Failed to build precompiled header (exit code {}). Not using it",
+			exit_code
 		);
+		return std::nullopt;
+	}
+
+	if(options.obj_cache) {
+		options.obj_cache->store(result.key, pch_path);
+	}
+	write_stamp(pch_stamp_path, result.key);
+
+	return result;
+}
+
+/**
+ * Build (or reuse) a cl precompiled header of the recipe's precompiled
+ * headers. cl also produces an object that must be linked.
+ * @returns `std::nullopt` if the precompiled header could not be built
+ */
+static auto cl_precompile_header(
+	const compile_options&               options,
+	const std::vector<std::string>&      main_args,
+	const fs::path&                      main_params_file,
+	const fs::path&                      intermediate_dir,
+	ecsact::cli::detail::spawn_reporter& reporter
+) -> std::optional<precompiled_header> {
+	const auto pch_dir = intermediate_dir / "pch";
+	const auto prefix_header = pch_dir / "ecsact-pch.hh";
+	const auto pch_src = pch_dir / "ecsact-pch.cc";
+	const auto pch_file = pch_dir / "ecsact-pch.pch";
+	const auto pch_obj = pch_dir / "ecsact-pch.obj";
+
+	write_prefix_header(
+		prefix_header,
+		options.precompiled_headers,
+		options.work_dir
+	);
+
+	// The prefix header is force included so the source itself is empty
+	std::ofstream{pch_src, std::ios::trunc} << GENERATED_DYLIB_DISCLAIMER;
+
+	// /Yc, /Yu and /FI must name the header exactly the same way
+	const auto prefix_header_arg = prefix_header.string();
+
+	auto pch_args = std::vector<std::string>{};
+	pch_args.push_back("/c");
+	pch_args.push_back(std::format("@{}", main_params_file.string()));
+	pch_args.push_back(pch_src.string());
+	pch_args.push_back("/std:c++20");
+	pch_args.push_back(std::format("/FI{}", prefix_header_arg));
+
+	auto preprocess_args = pch_args;
+	preprocess_args.push_back("/E");
+	preprocess_args.push_back("/w");
+
+	auto preprocessed = ecsact::cli::detail::spawn_get_stdout_bytes(
+		options.compiler.compiler_path,
+		preprocess_args
+	);
+
+	if(!preprocessed) {
+		report_warning("Failed to preprocess precompiled header. Not using it");
+		return std::nullopt;
+	}
+
+	auto key_args = main_args;
+	key_args.insert(key_args.end(), pch_args.begin(), pch_args.end());
+
+	auto result = precompiled_header{
+		.compile_args =
+			{
+				std::format("/Yu{}", prefix_header_arg),
+				std::format("/FI{}", prefix_header_arg),
+				std::format("/Fp{}", pch_file.string()),
+			},
+		.preprocess_args = {std::format("/FI{}", prefix_header_arg)},
+		// Keeps the work directory, see `clang_gcc_precompile_header`
+		.key = object_cache::key(options.compiler, {}, key_args, *preprocessed),
+		.object = pch_obj,
+	};
+
+	// The object is cached under its own key next to the precompiled header
+	auto obj_key = result.key + "-obj";
+	auto pch_stamp_path = pch_file;
+	pch_stamp_path += ".key";
+
+	if(fs::exists(pch_file) && fs::exists(pch_obj) &&
+		 read_stamp(pch_stamp_path) == result.key) {
+		ecsact::cli::report_info("Precompiled header is up to date");
+		return result;
 	}
 
-	output << "\n";
+	if(options.obj_cache && options.obj_cache->restore(result.key, pch_file) &&
+		 options.obj_cache->restore(obj_key, pch_obj)) {
+		ecsact::cli::report_info("Precompiled header restored from cache");
+		write_stamp(pch_stamp_path, result.key);
+		return result;
+	}
 
-	output << //
-		"extern \"C\" ECSACT_EXPORT(\"ecsact_dylib_has_fn\") "
-		"auto ecsact_dylib_has_fn(const char* fn_name) -> bool {\n";
+	auto ec = std::error_code{};
+	fs::remove(pch_stamp_path, ec);
+
+	pch_args.push_back(std::format("/Yc{}", prefix_header_arg));
+	pch_args.push_back(std::format("/Fp{}", pch_file.string()));
+	pch_args.push_back(std::format("/Fo{}", pch_obj.string()));
 
-	for(std::string_view imp : imports) {
-		output << std::format(
-			"\tif(std::string{{\"{}\"}} == fn_name) return true;\n",
-			imp
+	ecsact::cli::report_info("Building precompiled header...");
+	auto exit_code = ecsact::cli::detail::spawn_and_report(
+		options.compiler.compiler_path,
+		pch_args,
+		reporter
+	);
+
+	if(exit_code != 0) {
+		report_warning(
+			"Failed to build precompiled header (exit code {}). Not using it",
+			exit_code
 		);
+		return std::nullopt;
 	}
 
-	output << "\treturn false;\n";
-	output << "}\n\n";
+	if(options.obj_cache) {
+		options.obj_cache->store(result.key, pch_file);
+		options.obj_cache->store(obj_key, pch_obj);
+	}
+	write_stamp(pch_stamp_path, result.key);
+
+	return result;
+}
+
+/**
+ * Drop the arguments that only matter while preprocessing (language,
+ * include directories and defines) so the rest can be used to compile the
+ * preprocessed source on a build worker
+ */
+static auto remote_compile_args( //
+	const std::vector<std::string>& compile_args
+) -> std::vector<std::string> {
+	auto result = std::vector<std::string>{};
+	for(auto i = std::size_t{}; compile_args.size() > i; ++i) {
+		const auto& arg = compile_args[i];
+		if(arg == "-x" || arg == "-isystem") {
+			i += 1;
+			continue;
+		}
+
+		if(arg.starts_with("-isystem ") || arg.starts_with("-D")) {
+			continue;
+		}
+
+		result.push_back(arg);
+	}
+
+	return result;
+}
+
+/**
+ * Compile an already preprocessed source on a build worker
+ * @returns `false` if no worker compiled it. The source should be compiled
+ * locally instead.
+ */
+static auto try_remote_compile(
+	remote_executor_pool&           executors,
+	const std::vector<std::string>& compile_args,
+	std::vector<std::byte>          preprocessed,
+	const fs::path&                 rel_src,
+	const fs::path&                 obj_path
+) -> bool {
+	auto result = executors.try_compile({
+		.args = remote_compile_args(compile_args),
+		.preprocessed_source = std::move(preprocessed),
+	});
+
+	// Failed compiles are repeated locally so errors are reported the same way
+	if(!result || result->exit_code != 0) {
+		return false;
+	}
 
-	output << //
-		"extern \"C\" ECSACT_EXPORT(\"ecsact_dylib_set_fn_addr\") "
-		"auto ecsact_dylib_set_fn_addr(const char* fn_name, void(*fn_ptr)()) -> "
-		"void {\n";
+	write_file(obj_path, result->object);
 
-	for(std::string_view imp : imports) {
-		output << std::format(
-			"\tif(std::string{{\"{0}\"}} == fn_name) {{ {0} = "
-			"reinterpret_cast<decltype({0})>(fn_ptr); return; }}\n",
-			imp
-		);
+	auto output = std::istringstream{result->output};
+	auto line = std::string{};
+	while(std::getline(output, line)) {
+		ecsact::cli::report_info("{}: {}", rel_src.generic_string(), line);
 	}
 
-	output << "}\n\n";
+	return true;
 }
 
-struct compile_options {
-	fs::path work_dir;
-
-	ecsact::cli::cc_compiler                     compiler;
-	std::vector<fs::path>                        inc_dirs;
-	std::vector<std::string>                     system_libs;
-	std::unordered_map<std::string, std::string> defines;
-	std::vector<fs::path>                        srcs;
-	fs::path                                     output_path;
-	std::vector<std::string>                     imports;
-	std::vector<std::string>                     exports;
-	std::optional<fs::path>                      tracy_dir;
-	bool                                         debug;
-};
-
-struct tracy_compile_options {
-	fs::path                 tracy_dir;
-	fs::path                 output_path;
-	ecsact::cli::cc_compiler compiler;
-};
-
 auto clang_gcc_compile(compile_options options) -> int {
 	const fs::path clang = options.compiler.compiler_path;
 
@@ -480,7 +1418,6 @@ auto clang_gcc_compile(compile_options options) -> int {
 
 	auto compile_proc_args = std::vector<std::string>{};
 
-	compile_proc_args.push_back("-c");
 	compile_proc_args.push_back("-x");
 	compile_proc_args.push_back("c++");
 
@@ -496,9 +1433,13 @@ auto clang_gcc_compile(compile_options options) -> int {
 	}
 
 	for(auto inc_dir : options.inc_dirs) {
+		// Shared include dirs may be on another drive than the work dir
+		auto rel_inc_dir = fs::relative(inc_dir, options.work_dir);
 		compile_proc_args.push_back("-isystem");
 		compile_proc_args.push_back(
-			fs::relative(inc_dir, options.work_dir).generic_string()
+			rel_inc_dir.empty() //
+				? inc_dir.generic_string()
+				: rel_inc_dir.generic_string()
 		);
 	}
 
@@ -533,6 +1474,30 @@ auto clang_gcc_compile(compile_options options) -> int {
 	}
 
 	compile_proc_args.push_back("-O3");
+	compile_proc_args.push_back("-static");
+
+	if(options.pgo == pgo_mode::instrument) {
+		compile_proc_args.push_back("-fprofile-generate");
+	} else if(options.pgo == pgo_mode::use) {
+		compile_proc_args.push_back(
+			std::format("-fprofile-use={}", options.pgo_profdata.generic_string())
+		);
+		// Code the profiled run never reached or that changed since is expected
+		compile_proc_args.push_back("-Wno-profile-instr-unprofiled");
+		compile_proc_args.push_back("-Wno-profile-instr-out-of-date");
+	}
+
+	auto pch = options.precompiled_headers.empty()
+		? std::nullopt
+		: clang_gcc_precompile_header(options, compile_proc_args);
+
+	auto intermediate_dir = fs::path{"intermediate"};
+	auto up_to_date_count = std::atomic_int{};
+	auto cache_hits = std::atomic_int{};
+	auto cache_misses = std::atomic_int{};
+
+	auto valid_srcs = std::vector<fs::path>{};
+	valid_srcs.reserve(options.srcs.size());
 
 	for(auto src : options.srcs) {
 		if(src.extension().string().starts_with(".h")) {
@@ -543,27 +1508,207 @@ auto clang_gcc_compile(compile_options options) -> int {
 			continue;
 		}
 
-		compile_proc_args.push_back(fs::relative(src, options.work_dir).string());
+		valid_srcs.emplace_back(fs::relative(src, options.work_dir));
 	}
 
-	compile_proc_args.push_back("-static");
+	// Relative to the work directory. Linked in this exact order.
+	auto objects = std::vector<fs::path>{};
+	objects.reserve(valid_srcs.size());
+	for(auto& rel_src : valid_srcs) {
+		auto& rel_obj = objects.emplace_back(intermediate_dir / rel_src);
+		rel_obj += ".o";
+	}
+
+	// Key of each object's preprocessed source and compile args. Empty if the
+	// source could not be preprocessed.
+	auto object_keys = std::vector<std::string>(objects.size());
+
+	// Microseconds spent compiling each source. 0 if it was not compiled.
+	auto compile_times = std::vector<std::uint64_t>(objects.size());
+
+	// clang writes the -ftime-trace output next to the object
+	auto trace_paths = std::vector<fs::path>{};
+	if(options.time_trace &&
+		 options.compiler.compiler_type == ecsact::cli::cc_compiler_type::clang) {
+		for(auto& rel_obj : objects) {
+			auto& trace_path = trace_paths.emplace_back(options.work_dir / rel_obj);
+			trace_path.replace_extension(".json");
+		}
+	}
+
+	auto steps = build_step_recorder{};
 
 	ecsact::cli::report_info("Compiling runtime...");
 
-	auto compile_proc_exit_code = ecsact::cli::detail::spawn_and_report_output(
-		clang,
-		compile_proc_args,
-		options.work_dir
-	);
+	auto compile_src = [&](std::size_t index) -> int {
+		const auto& rel_src = valid_srcs[index];
+		const auto& rel_obj = objects[index];
+		const auto  obj_path = options.work_dir / rel_obj;
+		auto        obj_stamp_path = obj_path;
+		obj_stamp_path += ".key";
+
+		auto src_compile_args = compile_proc_args;
+		src_compile_args.push_back("-c");
+		src_compile_args.push_back(rel_src.string());
+
+		auto preprocess_args = src_compile_args;
+		preprocess_args.push_back("-E");
+		// warnings are reported by the real compile
+		preprocess_args.push_back("-w");
+
+		// The key args also name the precompiled header build so a rebuilt one
+		// recompiles every source
+		auto key_args = src_compile_args;
+		if(pch) {
+			preprocess_args.insert(
+				preprocess_args.end(),
+				pch->preprocess_args.begin(),
+				pch->preprocess_args.end()
+			);
+			src_compile_args.insert(
+				src_compile_args.end(),
+				pch->compile_args.begin(),
+				pch->compile_args.end()
+			);
+			key_args = src_compile_args;
+			key_args.push_back(pch->key);
+		}
 
-	if(compile_proc_exit_code != 0) {
-		ecsact::cli::report_error(
-			"Runtime compile failed. Exited with code {}",
-			compile_proc_exit_code
+		auto preprocessed = ecsact::cli::detail::spawn_get_stdout_bytes(
+			clang,
+			preprocess_args,
+			options.work_dir
+		);
+
+		auto& key = object_keys[index];
+		if(preprocessed) {
+			key = object_cache::key(
+				options.compiler,
+				options.work_dir,
+				key_args,
+				*preprocessed
+			);
+
+			// Time tracing measures every compile so nothing is reused
+			if(!options.time_trace && fs::exists(obj_path) &&
+				 read_stamp(obj_stamp_path) == key) {
+				up_to_date_count += 1;
+				return 0;
+			}
+
+			if(options.obj_cache && !options.time_trace) {
+				if(options.obj_cache->restore(key, obj_path)) {
+					cache_hits += 1;
+					write_stamp(obj_stamp_path, key);
+					return 0;
+				}
+
+				cache_misses += 1;
+			}
+		}
+
+		auto ec = std::error_code{};
+		fs::create_directories(obj_path.parent_path(), ec);
+		fs::remove(obj_stamp_path, ec);
+
+		auto store_object = [&] {
+			if(!key.empty()) {
+				if(options.obj_cache) {
+					options.obj_cache->store(key, obj_path);
+				}
+				write_stamp(obj_stamp_path, key);
+			}
+		};
+
+		// The profile and time traces only exist on this machine
+		if(options.executors && preprocessed && !options.time_trace &&
+			 options.pgo != pgo_mode::use) {
+			auto remote_start = std::chrono::steady_clock::now();
+			auto remote_compiled = try_remote_compile(
+				*options.executors,
+				compile_proc_args,
+				std::move(*preprocessed),
+				rel_src,
+				obj_path
+			);
+			if(remote_compiled) {
+				compile_times[index] = elapsed_us(remote_start);
+				store_object();
+				return 0;
+			}
+		}
+
+		// Timing doesn't change the object so it is left out of the key
+		if(!trace_paths.empty()) {
+			fs::remove(trace_paths[index], ec);
+			src_compile_args.push_back("-ftime-trace");
+		} else if(options.time_trace) {
+			src_compile_args.push_back("-ftime-report");
+		}
+
+		src_compile_args.push_back("-o");
+		src_compile_args.push_back(rel_obj.string());
+
+		auto compile_start = std::chrono::steady_clock::now();
+		auto compile_usage = subcommand_usage{};
+		auto compile_proc_exit_code = ecsact::cli::detail::spawn_and_report_output(
+			clang,
+			src_compile_args,
+			options.work_dir,
+			compile_usage
 		);
+		compile_times[index] = elapsed_us(compile_start);
+		steps.add("compile", rel_src.generic_string(), compile_usage);
+
+		if(compile_proc_exit_code == 0) {
+			store_object();
+		}
+
+		return compile_proc_exit_code;
+	};
+
+	auto compile_exit_codes =
+		options.scheduler.run(valid_srcs.size(), compile_src);
+
+	record_compile_times(options.work_dir, valid_srcs, compile_times);
+
+	if(options.time_trace) {
+		report_time_trace(valid_srcs, compile_times, trace_paths);
+	}
+
+	auto any_src_compile_failures = false;
+	for(auto i = 0; compile_exit_codes.size() > i; ++i) {
+		if(compile_exit_codes[i] != 0) {
+			any_src_compile_failures = true;
+			ecsact::cli::report_error(
+				"Failed to compile {}. Exited with code {}",
+				valid_srcs[i].generic_string(),
+				compile_exit_codes[i]
+			);
+		}
+	}
+
+	if(any_src_compile_failures) {
+		report_build_steps(steps);
 		return 1;
 	}
 
+	if(up_to_date_count > 0) {
+		ecsact::cli::report_info(
+			"{} of {} objects are up to date",
+			up_to_date_count.load(),
+			objects.size()
+		);
+	}
+
+	if(options.obj_cache) {
+		ecsact::cli::report_info(
+			"Object cache: {} hits, {} misses",
+			cache_hits.load(),
+			cache_misses.load()
+		);
+	}
+
 	auto link_proc_args = std::vector<std::string>{};
 
 	link_proc_args.push_back("-shared");
@@ -573,8 +1718,13 @@ auto clang_gcc_compile(compile_options options) -> int {
 	link_proc_args.push_back("-Wl,--exclude-libs,ALL");
 #endif
 
-	if(options.compiler.compiler_type == ecsact::cli::cc_compiler_type::clang) {
-		link_proc_args.push_back("-fuse-ld=lld");
+	auto linker = select_linker(options.compiler, options.linker);
+	if(linker) {
+		link_proc_args.push_back(std::format("-fuse-ld={}", *linker));
+	}
+
+	if(options.pgo == pgo_mode::instrument) {
+		link_proc_args.push_back("-fprofile-generate");
 	}
 
 	link_proc_args.push_back("-o");
@@ -582,16 +1732,8 @@ auto clang_gcc_compile(compile_options options) -> int {
 		fs::relative(options.output_path, options.work_dir).string()
 	);
 
-	for(auto p : fs::recursive_directory_iterator(options.work_dir)) {
-		if(!p.is_regular_file()) {
-			continue;
-		}
-
-		if(p.path().extension() == ".o") {
-			link_proc_args.push_back( //
-				fs::relative(p.path(), options.work_dir).string()
-			);
-		}
+	for(auto& rel_obj : objects) {
+		link_proc_args.push_back(rel_obj.string());
 	}
 
 	for(auto lib_dir : options.compiler.std_lib_paths) {
@@ -608,13 +1750,35 @@ auto clang_gcc_compile(compile_options options) -> int {
 	link_proc_args.push_back("-lpthread");
 	link_proc_args.push_back("-ldl");
 
-	ecsact::cli::report_info("Linking runtime...");
+	auto link_stamp_path = options.work_dir / "link.key";
+	auto link_key = link_stamp(options.compiler, link_proc_args, object_keys);
+	if(link_key && fs::exists(options.output_path) &&
+		 read_stamp(link_stamp_path) == link_key) {
+		report_build_steps(steps);
+		ecsact::cli::report_info("Runtime is up to date");
+		return 0;
+	}
+
+	ecsact::cli::report_info(
+		"Linking runtime with {}...",
+		linker.value_or("default linker")
+	);
+
+	// The object list alone can exceed command line limits
+	auto link_params_file = options.work_dir / "link.params";
+	write_gnu_response_file(link_params_file, link_proc_args);
 
+	auto link_start = std::chrono::steady_clock::now();
+	auto link_usage = subcommand_usage{};
 	auto link_proc_exit_code = ecsact::cli::detail::spawn_and_report_output(
 		clang,
-		link_proc_args,
-		options.work_dir
+		{std::format("@{}", link_params_file.filename().string())},
+		options.work_dir,
+		link_usage
 	);
+	auto link_us = elapsed_us(link_start);
+	steps.add("link", options.output_path.filename().string(), link_usage);
+	report_build_steps(steps);
 
 	if(link_proc_exit_code != 0) {
 		ecsact::cli::report_error(
@@ -624,6 +1788,12 @@ auto clang_gcc_compile(compile_options options) -> int {
 		return 1;
 	}
 
+	report_link_stats(options.work_dir, objects, options.output_path, link_us);
+
+	if(link_key) {
+		write_stamp(link_stamp_path, *link_key);
+	}
+
 	return 0;
 }
 
@@ -824,7 +1994,9 @@ auto cl_compile(compile_options options) -> int {
 		cl_args.push_back(std::format("/I{}", options.tracy_dir->string()));
 	}
 
-	auto main_params_file =
+	// The params file contents must be part of the object cache key
+	const auto main_args = cl_args;
+	auto       main_params_file =
 		create_params_file(long_path_workaround(options.work_dir / "main.params"));
 
 	auto valid_srcs = std::vector<fs::path>{};
@@ -850,47 +2022,159 @@ auto cl_compile(compile_options options) -> int {
 		valid_srcs.emplace_back(src);
 	}
 
-	auto src_compile_exit_code_futures = std::vector<std::future<int>>{};
-	src_compile_exit_code_futures.reserve(valid_srcs.size());
+	auto objects = std::vector<fs::path>{};
+	objects.reserve(valid_srcs.size());
+	for(auto& src : valid_srcs) {
+		auto& obj_path = objects.emplace_back(intermediate_dir / src.filename());
+		obj_path.replace_extension(".obj");
+	}
+
+	auto pch = options.precompiled_headers.empty()
+		? std::nullopt
+		: cl_precompile_header(
+				options,
+				main_args,
+				main_params_file,
+				intermediate_dir,
+				reporter
+			);
+
+	// Key of each object's preprocessed source and compile args. Empty if the
+	// source could not be preprocessed.
+	auto object_keys = std::vector<std::string>(objects.size());
+
+	// Microseconds spent compiling each source. 0 if it was not compiled.
+	auto compile_times = std::vector<std::uint64_t>(objects.size());
+
+	auto up_to_date_count = std::atomic_int{};
+	auto cache_hits = std::atomic_int{};
+	auto cache_misses = std::atomic_int{};
+	auto steps = build_step_recorder{};
+
+	auto compile_src = [&](std::size_t index) -> int {
+		const auto& src = valid_srcs[index];
+		const auto& obj_path = objects[index];
+		auto        obj_stamp_path = obj_path;
+		obj_stamp_path += ".key";
+
+		auto src_cl_args = cl_args;
+		src_cl_args.push_back("/c");
+		src_cl_args.push_back(std::format("@{}", main_params_file.string()));
+		src_cl_args.push_back(abs_from_wd(src).string());
+		// src_cl_args.push_back(src.string());
+
+		if(src.extension() == ".c") {
+			src_cl_args.push_back("/std:c17");
+		} else {
+			src_cl_args.push_back("/std:c++20");
+		}
+
+		auto preprocess_args = src_cl_args;
+		preprocess_args.push_back("/E");
+		// warnings are reported by the real compile
+		preprocess_args.push_back("/w");
+
+		// The precompiled header is C++ only
+		const auto uses_pch = pch && src.extension() != ".c";
+		if(uses_pch) {
+			preprocess_args.insert(
+				preprocess_args.end(),
+				pch->preprocess_args.begin(),
+				pch->preprocess_args.end()
+			);
+			src_cl_args.insert(
+				src_cl_args.end(),
+				pch->compile_args.begin(),
+				pch->compile_args.end()
+			);
+		}
+
+		auto preprocessed = ecsact::cli::detail::spawn_get_stdout_bytes(
+			options.compiler.compiler_path,
+			preprocess_args
+		);
+
+		auto& key = object_keys[index];
+		if(preprocessed) {
+			auto key_args = main_args;
+			key_args.insert(key_args.end(), src_cl_args.begin(), src_cl_args.end());
+			if(uses_pch) {
+				key_args.push_back(pch->key);
+			}
+
+			// cl objects embed the absolute work directory (__FILE__ from the
+			// absolute line markers and /Z7 debug info) so they are only reused
+			// from the same work directory
+			key = object_cache::key(options.compiler, {}, key_args, *preprocessed);
 
-	for(auto src : valid_srcs) {
-		src_compile_exit_code_futures.emplace_back(
-			std::async(std::launch::async, [&, src] {
-				auto src_cl_args = cl_args;
-				src_cl_args.push_back("/c");
-				src_cl_args.push_back(std::format("@{}", main_params_file.string()));
-				src_cl_args.push_back(abs_from_wd(src).string());
-				// src_cl_args.push_back(src.string());
+			if(!options.time_trace && fs::exists(obj_path) &&
+				 read_stamp(obj_stamp_path) == key) {
+				up_to_date_count += 1;
+				return 0;
+			}
 
-				if(src.extension() == ".c") {
-					src_cl_args.push_back("/std:c17");
-				} else {
-					src_cl_args.push_back("/std:c++20");
+			if(options.obj_cache && !options.time_trace) {
+				if(options.obj_cache->restore(key, obj_path)) {
+					cache_hits += 1;
+					write_stamp(obj_stamp_path, key);
+					return 0;
 				}
 
-				src_cl_args.push_back(
-					std::format(
-						"/Fo{}\\", // typos:disable-line
-						long_path_workaround(intermediate_dir).string()
-					)
-				);
+				cache_misses += 1;
+			}
+		}
 
-				return ecsact::cli::detail::spawn_and_report(
-					options.compiler.compiler_path,
-					src_cl_args,
-					reporter
-				);
-			})
+		auto ec = std::error_code{};
+		fs::remove(obj_stamp_path, ec);
+
+		// cl has no trace file. Front-end/back-end times and the per include
+		// and per function timings are printed with the compile output.
+		if(options.time_trace) {
+			src_cl_args.push_back("/Bt+");
+			src_cl_args.push_back("/d1reportTime");
+		}
+
+		src_cl_args.push_back(
+			std::format(
+				"/Fo{}\\", // typos:disable-line
+				long_path_workaround(intermediate_dir).string()
+			)
+		);
+
+		auto compile_start = std::chrono::steady_clock::now();
+		auto compile_usage = subcommand_usage{};
+		auto exit_code = ecsact::cli::detail::spawn_and_report(
+			options.compiler.compiler_path,
+			src_cl_args,
+			reporter,
+			fs::current_path(),
+			compile_usage
 		);
+		compile_times[index] = elapsed_us(compile_start);
+		steps.add("compile", src.generic_string(), compile_usage);
+
+		if(exit_code == 0 && !key.empty()) {
+			if(options.obj_cache) {
+				options.obj_cache->store(key, obj_path);
+			}
+			write_stamp(obj_stamp_path, key);
+		}
+
+		return exit_code;
+	};
+
+	auto src_compile_exit_codes =
+		options.scheduler.run(valid_srcs.size(), compile_src);
+
+	record_compile_times(options.work_dir, valid_srcs, compile_times);
+
+	if(options.time_trace) {
+		report_time_trace(valid_srcs, compile_times, {});
 	}
 
 	auto any_src_compile_failures = false;
-	auto src_compile_exit_codes = std::vector<std::future<int>>{};
-	src_compile_exit_codes.reserve(src_compile_exit_code_futures.size());
-
-	for(auto i = 0; src_compile_exit_code_futures.size() > i; ++i) {
-		auto& fut = src_compile_exit_code_futures.at(i);
-		auto  compile_exit_code = fut.get();
+	for(auto i = 0; src_compile_exit_codes.size() > i; ++i) {
+		auto compile_exit_code = src_compile_exit_codes[i];
 
 		if(compile_exit_code != 0) {
 			any_src_compile_failures = true;
@@ -904,11 +2188,39 @@ auto cl_compile(compile_options options) -> int {
 	}
 
 	if(any_src_compile_failures) {
+		report_build_steps(steps);
 		return 1;
 	}
 
-	for(fs::path obj_f : fs::recursive_directory_iterator(intermediate_dir)) {
-		cl_args.push_back(obj_f.string());
+	if(up_to_date_count > 0) {
+		ecsact::cli::report_info(
+			"{} of {} objects are up to date",
+			up_to_date_count.load(),
+			objects.size()
+		);
+	}
+
+	if(options.obj_cache) {
+		ecsact::cli::report_info(
+			"Object cache: {} hits, {} misses",
+			cache_hits.load(),
+			cache_misses.load()
+		);
+	}
+
+	// Only objects of the current sources. The intermediate directory may still
+	// have objects from a previous build.
+	for(auto& obj_path : objects) {
+		cl_args.push_back(obj_path.string());
+	}
+
+	if(pch && pch->object) {
+		cl_args.push_back(pch->object->string());
+	}
+
+	auto link_key_args = cl_args;
+	if(pch) {
+		link_key_args.push_back(pch->key);
 	}
 
 	auto obj_params_file = create_params_file(
@@ -964,11 +2276,32 @@ auto cl_compile(compile_options options) -> int {
 
 	cl_args.push_back(std::format("/OUT:{}", options.output_path.string()));
 
+	// The params files are referenced by path so their contents are part of the
+	// link key instead
+	link_key_args.insert(link_key_args.end(), main_args.begin(), main_args.end());
+	link_key_args.insert(link_key_args.end(), cl_args.begin(), cl_args.end());
+
+	auto link_stamp_path = options.work_dir / "link.key";
+	auto link_key = link_stamp(options.compiler, link_key_args, object_keys);
+	if(link_key && fs::exists(options.output_path) &&
+		 read_stamp(link_stamp_path) == link_key) {
+		report_build_steps(steps);
+		ecsact::cli::report_info("Runtime is up to date");
+		return 0;
+	}
+
+	auto link_start = std::chrono::steady_clock::now();
+	auto link_usage = subcommand_usage{};
 	auto compile_exit_code = ecsact::cli::detail::spawn_and_report(
 		options.compiler.compiler_path,
 		cl_args,
-		reporter
+		reporter,
+		fs::current_path(),
+		link_usage
 	);
+	auto link_us = elapsed_us(link_start);
+	steps.add("link", options.output_path.filename().string(), link_usage);
+	report_build_steps(steps);
 
 	if(compile_exit_code != 0) {
 		ecsact::cli::report_error(
@@ -979,9 +2312,77 @@ auto cl_compile(compile_options options) -> int {
 		return 1;
 	}
 
+	report_link_stats(options.work_dir, objects, options.output_path, link_us);
+
+	if(link_key) {
+		write_stamp(link_stamp_path, *link_key);
+	}
+
 	return 0;
 }
 
+/**
+ * Replace the C++ sources in @p source_files with @p unity_count unity
+ * translation units that include them. Headers, C sources and sources in
+ * @p unity_excluded are kept as is.
+ */
+static auto unity_source_files(
+	const std::vector<fs::path>& source_files,
+	const std::set<fs::path>&    unity_excluded,
+	unsigned                     unity_count,
+	const fs::path&              work_dir,
+	const fs::path&              unity_dir
+) -> std::vector<fs::path> {
+	auto compile_times = load_compile_times(work_dir);
+	auto result = std::vector<fs::path>{};
+	auto candidates = std::vector<unity_source>{};
+	auto excluded_count = 0;
+
+	for(auto& src : source_files) {
+		auto ext = src.extension().string();
+		auto is_unity_candidate = !ext.starts_with(".h") && ext != ".ipp" &&
+			ext != ".inc" && ext != ".inl" && ext != ".c" &&
+			!unity_excluded.contains(src.lexically_normal());
+
+		if(!is_unity_candidate) {
+			if(unity_excluded.contains(src.lexically_normal())) {
+				excluded_count += 1;
+			}
+			result.emplace_back(src);
+			continue;
+		}
+
+		candidates.emplace_back(unity_source{.path = src});
+	}
+
+	// Previous compile times are only comparable with each other so they are
+	// used if every candidate has one. Otherwise file size approximates cost.
+	auto all_have_compile_times = std::ranges::all_of(candidates, [&](auto& c) {
+		return compile_times.contains(c.path.lexically_normal().generic_string());
+	});
+
+	for(auto& candidate : candidates) {
+		auto ec = std::error_code{};
+		candidate.weight = all_have_compile_times
+			? compile_times.at(candidate.path.lexically_normal().generic_string())
+			: fs::file_size(candidate.path, ec);
+	}
+
+	auto candidate_count = candidates.size();
+	auto groups = partition_unity_sources(std::move(candidates), unity_count);
+	auto unity_srcs = write_unity_sources(groups, unity_dir);
+	result.insert(result.end(), unity_srcs.begin(), unity_srcs.end());
+
+	ecsact::cli::report_info(
+		"Unity build: {} sources in {} translation units ({} excluded)",
+		candidate_count,
+		unity_srcs.size(),
+		excluded_count
+	);
+
+	return result;
+}
+
 auto ecsact::cli::cook_recipe( //
 	const char*                 argv0,
 	const ecsact::build_recipe& recipe,
@@ -989,20 +2390,92 @@ auto ecsact::cli::cook_recipe( //
 	const cook_recipe_options&  recipe_options
 ) -> std::optional<std::filesystem::path> {
 	auto exit_code = int{};
+	auto state = work_dir_state::load(recipe_options.work_dir);
 
-	for(auto& src : recipe.sources()) {
-		exit_code = std::visit(
+	auto sources = recipe.sources();
+	auto source_nodes = std::vector<source_graph_node>{};
+	source_nodes.reserve(sources.size());
+	for(auto& src : sources) {
+		std::visit(
 			[&](auto& src) {
-				return handle_source(recipe.base_directory(), src, recipe_options);
+				source_nodes.push_back({
+					.outdir = src.outdir //
+						? recipe_options.work_dir / *src.outdir
+						: recipe_options.work_dir,
+					.exclusive = std::is_same_v<
+						std::decay_t<decltype(src)>,
+						ecsact::build_recipe::source_codegen>,
+				});
 			},
 			src
 		);
+	}
+
+	// Sources writing to separate directories don't affect each other so they
+	// are fetched, copied and generated concurrently
+	auto source_outputs = std::vector<std::vector<fs::path>>(sources.size());
+
+	// Path sources stage their files with a pool of their own. Each source
+	// running at once gets an even share of --jobs so the nested pools never
+	// add up to more threads than --jobs.
+	auto running_sources =
+		std::clamp<std::size_t>(sources.size(), 1, recipe_options.jobs);
+	auto source_options = recipe_options;
+	source_options.jobs = std::max(
+		1u,
+		static_cast<unsigned>(recipe_options.jobs / running_sources)
+	);
 
-		if(exit_code != 0) {
+	auto source_results = run_source_graph(
+		source_dependencies(source_nodes),
+		recipe_options.jobs,
+		[&](std::size_t index) -> int {
+			return std::visit(
+				[&](auto& src) {
+					return handle_source(
+						recipe.base_directory(),
+						src,
+						source_options,
+						state,
+						source_outputs[index]
+					);
+				},
+				sources[index]
+			);
+		}
+	);
+
+	for(auto& result : source_results) {
+		if(!result || *result != 0) {
 			return {};
 		}
 	}
 
+	// Outputs of sources the recipe marked as unsafe for unity builds
+	auto unity_excluded = std::set<fs::path>{};
+	for(auto i = std::size_t{}; sources.size() > i; ++i) {
+		auto src_unity = std::visit(
+			[](auto& src) { return src.unity; },
+			sources[i]
+		);
+		if(!src_unity) {
+			for(auto& output : source_outputs[i]) {
+				unity_excluded.insert(output.lexically_normal());
+			}
+		}
+	}
+
+	for(auto& removed : state.remove_stale_outputs()) {
+		ecsact::cli::report_info("Removed stale {}", removed.generic_string());
+	}
+
+	if(!state.save()) {
+		ecsact::cli::report_warning(
+			"Failed to save build state in {}",
+			recipe_options.work_dir.generic_string()
+		);
+	}
+
 	auto output_path = recipe_options.output_path;
 
 	if(output_path.has_extension()) {
@@ -1047,13 +2520,34 @@ auto ecsact::cli::cook_recipe( //
 		generate_dylib_imports(recipe.imports(), dylib_src_stream);
 	}
 
-	for(auto entry : fs::recursive_directory_iterator(src_dir)) {
-		if(!entry.is_regular_file()) {
+	auto unity_dir = recipe_options.work_dir / "unity";
+	auto work_dir_runfiles_dir = recipe_options.work_dir / "runfiles";
+
+	// Directories the build itself writes to. Generated unity sources are only
+	// added when requested below. Staged runfiles (e.g. TracyClient.cpp with
+	// --no_cache) and the cl precompiled header source are never recipe
+	// sources.
+	const auto generated_dirs = std::array{
+		unity_dir,
+		work_dir_runfiles_dir,
+		recipe_options.work_dir / "intermediate",
+	};
+
+	for(auto itr = fs::recursive_directory_iterator(src_dir);
+			itr != fs::recursive_directory_iterator{};
+			++itr) {
+		if(itr->is_directory() &&
+			 std::ranges::find(generated_dirs, itr->path()) != generated_dirs.end()) {
+			itr.disable_recursion_pending();
+			continue;
+		}
+
+		if(!itr->is_regular_file()) {
 			continue;
 		}
 
-		if(is_cpp_file(entry)) {
-			source_files.emplace_back(entry.path());
+		if(is_cpp_file(*itr)) {
+			source_files.emplace_back(itr->path());
 		}
 	}
 
@@ -1062,26 +2556,115 @@ auto ecsact::cli::cook_recipe( //
 		return {};
 	}
 
+	if(recipe_options.unity_count) {
+		source_files = unity_source_files(
+			source_files,
+			unity_excluded,
+			*recipe_options.unity_count == 0 //
+				? recipe_options.jobs
+				: *recipe_options.unity_count,
+			recipe_options.work_dir,
+			unity_dir
+		);
+	}
+
+	std::optional<fs::path> tracy_dir;
 #ifndef ECSACT_CLI_USE_SDK_VERSION
-	auto loaded_runfiles = ecsact::cli::cook::load_runfiles(argv0, inc_dir);
-	if(!loaded_runfiles) {
+	auto runfiles_cache_dir =
+		recipe_options.runfiles_cache_dir.value_or(work_dir_runfiles_dir);
+
+	auto runfiles_inc_dir =
+		ecsact::cli::cook::load_runfiles(argv0, runfiles_cache_dir);
+	if(!runfiles_inc_dir) {
 		return {};
 	}
+
+	// Searched first so the runtime headers win over ones from recipe sources
+	inc_dirs.insert(inc_dirs.begin(), *runfiles_inc_dir);
+
+	if(recipe_options.tracy) {
+		tracy_dir =
+			ecsact::cli::cook::load_tracy_runfiles(argv0, runfiles_cache_dir);
+		if(!tracy_dir) {
+			return {};
+		}
+	}
 #else
 	auto exec_path = ecsact::cli::detail::canon_argv0(argv0);
 	auto install_prefix = exec_path.parent_path().parent_path();
 
 	inc_dirs.push_back(install_prefix / "include");
 #endif
-	std::optional<fs::path> tracy_dir;
-#ifndef ECSACT_CLI_USE_SDK_VERSION
-	if(recipe_options.tracy) {
-		tracy_dir = recipe_options.work_dir / "third_party" / "tracy";
-		auto success = ecsact::cli::cook::load_tracy_runfiles(argv0, *tracy_dir);
+
+	auto obj_cache = recipe_options.object_cache_dir //
+		? std::optional{object_cache{*recipe_options.object_cache_dir}}
+		: std::nullopt;
+
+	auto pgo_profdata = fs::path{};
+	if(recipe_options.pgo != pgo_mode::none &&
+		 compiler.compiler_type != cc_compiler_type::clang) {
+		ecsact::cli::report_error(
+			"Profile guided optimization is only supported with clang (not {})",
+			to_string(compiler.compiler_type)
+		);
+		return {};
+	}
+
+	if(recipe_options.pgo == pgo_mode::use) {
+		auto profdata = prepare_pgo_profile(
+			compiler.compiler_path,
+			recipe_options.pgo_profile,
+			recipe_options.work_dir / "pgo"
+		);
+		if(!profdata) {
+			return {};
+		}
+
+		pgo_profdata = fs::relative(*profdata, recipe_options.work_dir);
+		ecsact::cli::report_info(
+			"Optimizing with profile {}",
+			profdata->generic_string()
+		);
+	} else if(recipe_options.pgo == pgo_mode::instrument) {
+		ecsact::cli::report_info(
+			"Instrumenting runtime for profile guided optimization"
+		);
+	}
+
+	auto executors = std::optional<remote_executor_pool>{};
+	if(!recipe_options.executors.empty()) {
+		if(is_cl_like(compiler.compiler_type)) {
+			ecsact::cli::report_warning(
+				"Build executors ignored. {} sources are always compiled locally",
+				to_string(compiler.compiler_type)
+			);
+		} else {
+			executors.emplace(recipe_options.executors, compiler);
+		}
+	}
+
+	// Sources are still preprocessed locally so every worker slot needs a job
+	// of its own on top of the local ones
+	auto remote_slots = executors ? executors->slot_count() : 0u;
+
+	auto scheduler = job_scheduler{{
+		.max_jobs = recipe_options.jobs + remote_slots,
+		.job_memory_estimate = recipe_options.job_memory_estimate,
+	}};
+
+	if(scheduler.has_jobserver()) {
+		ecsact::cli::report_info("Using make jobserver for parallel jobs");
 	}
-#endif
 
 	if(is_cl_like(compiler.compiler_type)) {
+		if(!recipe_options.linker.empty() && recipe_options.linker != "auto") {
+			ecsact::cli::report_warning(
+				"Linker {} ignored. {} always uses its own linker",
+				recipe_options.linker,
+				to_string(compiler.compiler_type)
+			);
+		}
+
 #ifndef ECSACT_CLI_USE_SDK_VERSION
 		if(recipe_options.tracy) {
 			exit_code = cl_tracy_compile({
@@ -1106,6 +2689,10 @@ auto ecsact::cli::cook_recipe( //
 			.exports = as_vec(recipe.exports()),
 			.tracy_dir = tracy_dir,
 			.debug = recipe_options.debug,
+			.obj_cache = obj_cache,
+			.scheduler = scheduler,
+			.precompiled_headers = as_vec(recipe.precompiled_headers()),
+			.time_trace = recipe_options.time_trace,
 		});
 	} else {
 		exit_code = clang_gcc_compile({
@@ -1119,6 +2706,14 @@ auto ecsact::cli::cook_recipe( //
 			.imports = as_vec(recipe.imports()),
 			.exports = as_vec(recipe.exports()),
 			.debug = recipe_options.debug,
+			.obj_cache = obj_cache,
+			.scheduler = scheduler,
+			.precompiled_headers = as_vec(recipe.precompiled_headers()),
+			.pgo = recipe_options.pgo,
+			.pgo_profdata = pgo_profdata,
+			.time_trace = recipe_options.time_trace,
+			.linker = recipe_options.linker,
+			.executors = executors ? &*executors : nullptr,
 		});
 	}
 
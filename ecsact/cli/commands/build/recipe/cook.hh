@@ -1,9 +1,14 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
 #include <optional>
+#include <string>
+#include <vector>
 #include "ecsact/cli/commands/build/build_recipe.hh"
 #include "ecsact/cli/commands/build/cc_compiler_config.hh"
+#include "ecsact/cli/commands/build/recipe/pgo.hh"
+#include "ecsact/cli/detail/socket.hh"
 
 namespace ecsact::cli {
 
@@ -16,6 +21,69 @@ struct cook_recipe_options {
 
 	/** Other directories to check for codegen plugins */
 	std::vector<std::filesystem::path> additional_plugin_dirs;
+
+	/** Persistent object file cache directory. No caching if unset. */
+	std::optional<std::filesystem::path> object_cache_dir;
+
+	/**
+	 * Persistent cache of recipe `fetch` downloads keyed by their integrity. No
+	 * caching if unset.
+	 */
+	std::optional<std::filesystem::path> repository_cache_dir;
+
+	/** Fail instead of downloading fetch sources missing from the cache */
+	bool offline = false;
+
+	/** Persistent codegen plugin output cache directory. No caching if unset. */
+	std::optional<std::filesystem::path> codegen_cache_dir;
+
+	/**
+	 * Directory the ecsact runtime headers and tracy sources are staged in once
+	 * and shared by every build. Staged in the work dir if unset.
+	 */
+	std::optional<std::filesystem::path> runfiles_cache_dir;
+
+	/** Maximum compiler/linker subprocesses run at once */
+	unsigned jobs = 1;
+
+	/**
+	 * Estimated peak memory of a single compile in bytes. Compiles wait for at
+	 * least this much available memory. No throttling if 0.
+	 */
+	std::uint64_t job_memory_estimate = 0;
+
+	/**
+	 * Combine C++ sources into this many unity translation units. 0 uses the
+	 * job count. No unity build if unset.
+	 */
+	std::optional<unsigned> unity_count;
+
+	/** Profile guided optimization (clang only) */
+	cook::pgo_mode pgo = cook::pgo_mode::none;
+
+	/**
+	 * Profile used with `pgo_mode::use`. A .profdata file, a .profraw file or a
+	 * directory of .profraw files.
+	 */
+	std::filesystem::path pgo_profile;
+
+	/**
+	 * Compile every source with compiler timing enabled (-ftime-trace for
+	 * clang) and report an aggregated time trace
+	 */
+	bool time_trace = false;
+
+	/**
+	 * gcc/clang linker (lld, mold, gold or bfd.) Empty picks mold if installed,
+	 * otherwise lld for clang and the compiler default for gcc.
+	 */
+	std::string linker;
+
+	/**
+	 * `ecsact build-worker` endpoints gcc/clang sources are compiled on. Sources
+	 * are preprocessed locally and compiled locally when every worker is busy.
+	 */
+	std::vector<ecsact::cli::detail::socket_endpoint> executors;
 };
 
 /**
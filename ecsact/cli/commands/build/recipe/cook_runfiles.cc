@@ -1,6 +1,9 @@
 #include "cook_runfiles.hh"
 
+#include <array>
 #include <filesystem>
+#include <format>
+#include <memory>
 #include <vector>
 #include <string>
 #include <system_error>
@@ -8,29 +11,25 @@
 
 #include "tools/cpp/runfiles/runfiles.h"
 #include "ecsact/cli/report.hh"
+#include "ecsact/cli/commands/build/recipe/stage_files.hh"
+#include "ecsact/cli/detail/atomic_write.hh"
+#include "ecsact/cli/detail/content_hash.hh"
 
 namespace fs = std::filesystem;
 using bazel::tools::cpp::runfiles::Runfiles;
+using ecsact::cli::cook::runfile;
+using ecsact::cli::detail::content_hasher;
+using ecsact::cli::detail::unique_tmp_path;
 using namespace std::string_view_literals;
 
-auto ecsact::cli::cook::load_runfiles(
-	const char*           argv0,
-	std::filesystem::path inc_dir
-) -> bool {
-	auto ec = std::error_code{};
-
-	auto runfiles_error = std::string{};
-	auto runfiles = std::unique_ptr<Runfiles>(
-		Runfiles::Create(argv0, BAZEL_CURRENT_REPOSITORY, &runfiles_error)
-	);
-	if(!runfiles) {
-		ecsact::cli::report_error("Failed to load runfiles: {}", runfiles_error);
-		return false;
-	}
-
-	ecsact::cli::report_info("Using ecsact headers from runfiles");
+/**
+ * Bump when the key or staged layout changes so stale directories are never
+ * used
+ */
+constexpr auto runfiles_cache_version = std::string_view{"1"};
 
-	auto ecsact_runtime_headers_from_runfiles = std::vector<std::string>{
+constexpr auto ecsact_runtime_headers_from_runfiles =
+	std::to_array<std::string_view>({
 		"ecsact_runtime/ecsact/lib.hh",
 		"ecsact_runtime/ecsact/runtime.h",
 		"ecsact_runtime/ecsact/runtime/async.h",
@@ -48,68 +47,10 @@ auto ecsact::cli::cook::load_runfiles(
 		"ecsact_runtime/ecsact/runtime/static.h",
 		"ecsact_runtime/ecsact/si/wasm.h",
 		"ecsact_runtime/ecsact/si/wasm.hh",
-	};
-
-	for(auto hdr : ecsact_runtime_headers_from_runfiles) {
-		auto full_hdr_path = runfiles->Rlocation(hdr);
-
-		if(full_hdr_path.empty()) {
-			ecsact::cli::report_error(
-				"Cannot find ecsact_runtime header in runfiles: {}",
-				hdr
-			);
-			return false;
-		}
-
-		auto rel_hdr_path = hdr.substr("ecsact_runtime/"sv.size());
-		fs::create_directories((inc_dir / rel_hdr_path).parent_path(), ec);
-		auto some_bullshit = inc_dir / rel_hdr_path;
-
-		if(fs::exists(inc_dir / rel_hdr_path)) {
-			ecsact::cli::report_warning(
-				"Overwriting ecsact runtime header {} with runfiles header",
-				rel_hdr_path
-			);
-		}
-
-		fs::copy_file(
-			full_hdr_path,
-			inc_dir / rel_hdr_path,
-			fs::copy_options::overwrite_existing,
-			ec
-		);
-		if(ec) {
-			ecsact::cli::report_error(
-				"Failed to copy ecsact runtime header from runfiles. {} -> {}\n{}",
-				full_hdr_path,
-				(inc_dir / rel_hdr_path).generic_string(),
-				ec.message()
-			);
-			return false;
-		}
-	}
-
-	return true;
-}
+	});
 
-auto ecsact::cli::cook::load_tracy_runfiles(
-	const char*           argv0,
-	std::filesystem::path tracy_dir
-) -> bool {
-	auto ec = std::error_code{};
-
-	fs::create_directories(tracy_dir, ec);
-
-	if(ec) {
-		ecsact::cli::report_error(
-			"Failed to create tracy directory for runfiles. {} -> {}\n",
-			tracy_dir.generic_string(),
-			ec.message()
-		);
-		return false;
-	}
-
-	auto tracy_src_runfiles = std::vector<std::string>{
+constexpr auto tracy_src_runfiles =
+	std::to_array<std::string_view>({
 		"public/TracyClient.cpp",
 		"public/tracy/TracyC.h",
 		"public/tracy/Tracy.hpp",
@@ -168,58 +109,181 @@ auto ecsact::cli::cook::load_tracy_runfiles(
 		"public/client/TracySysTime.cpp",
 		"public/client/TracySysTrace.cpp",
 		"public/client/tracy_rpmalloc.cpp",
-	};
+	});
 
+static auto create_runfiles(const char* argv0) -> std::unique_ptr<Runfiles> {
 	auto runfiles_error = std::string{};
 	auto runfiles = std::unique_ptr<Runfiles>(
 		Runfiles::Create(argv0, BAZEL_CURRENT_REPOSITORY, &runfiles_error)
 	);
 	if(!runfiles) {
 		ecsact::cli::report_error("Failed to load runfiles: {}", runfiles_error);
-		return false;
 	}
+	return runfiles;
+}
 
-	ecsact::cli::report_info("Tracy set, using runfiles");
+/**
+ * Key of @p files without reading them. Runfiles are read only build outputs
+ * so their size and modification time change whenever their contents do.
+ */
+static auto runfiles_key( //
+	std::span<const runfile> files
+) -> std::optional<std::string> {
+	auto ec = std::error_code{};
+	auto hasher = content_hasher{};
+	hasher.update(runfiles_cache_version);
 
-	for(auto hdr : tracy_src_runfiles) {
-		auto full_hdr_path = runfiles->Rlocation("tracy/" + hdr);
+	for(auto& file : files) {
+		auto size = fs::file_size(file.src, ec);
+		if(ec) {
+			return std::nullopt;
+		}
 
-		if(full_hdr_path.empty()) {
+		auto write_time = fs::last_write_time(file.src, ec);
+		if(ec) {
+			return std::nullopt;
+		}
+
+		hasher.update(file.rel_path.generic_string());
+		hasher.update(file.src.generic_string());
+		hasher.update(std::to_string(size));
+		hasher.update(std::to_string(write_time.time_since_epoch().count()));
+	}
+
+	return hasher.digest();
+}
+
+auto ecsact::cli::cook::stage_runfiles(
+	const fs::path&          cache_dir,
+	std::string_view         name,
+	std::span<const runfile> files
+) -> std::optional<fs::path> {
+	auto key = runfiles_key(files);
+	if(!key) {
+		ecsact::cli::report_error("Cannot read {} runfiles", name);
+		return std::nullopt;
+	}
+
+	auto ec = std::error_code{};
+	auto staged_dir = cache_dir / std::format("v{}", runfiles_cache_version) /
+		name / *key;
+	if(fs::is_directory(staged_dir, ec)) {
+		return staged_dir;
+	}
+
+	auto tmp_dir = unique_tmp_path(staged_dir);
+
+	for(auto& file : files) {
+		auto dst = tmp_dir / file.rel_path;
+		fs::create_directories(dst.parent_path(), ec);
+		if(!ec) {
+			// Runfiles are usually symlinks into the build output tree
+			auto src = fs::canonical(file.src, ec);
+			if(!ec) {
+				stage_file(src, dst, ec);
+			}
+		}
+
+		if(ec) {
 			ecsact::cli::report_error(
-				"Cannot find tracy header in runfiles: {}",
-				hdr
+				"Failed to stage {} runfile. {} -> {}\n{}",
+				name,
+				file.src.generic_string(),
+				dst.generic_string(),
+				ec.message()
 			);
-			return false;
+			fs::remove_all(tmp_dir, ec);
+			return std::nullopt;
 		}
+	}
+
+	fs::rename(tmp_dir, staged_dir, ec);
+	if(ec) {
+		fs::remove_all(tmp_dir, ec);
 
-		auto rel_hdr_path = hdr.substr("public/"sv.size());
+		// Another build staged the same files first
+		if(fs::is_directory(staged_dir, ec)) {
+			return staged_dir;
+		}
 
-		fs::create_directories((tracy_dir / rel_hdr_path).parent_path(), ec);
-		auto some_bullshit = tracy_dir / rel_hdr_path;
+		ecsact::cli::report_error(
+			"Failed to stage {} runfiles in {}",
+			name,
+			staged_dir.generic_string()
+		);
+		return std::nullopt;
+	}
+
+	ecsact::cli::report_info(
+		"Staged {} runfiles in {}",
+		name,
+		staged_dir.generic_string()
+	);
+	return staged_dir;
+}
+
+auto ecsact::cli::cook::load_runfiles( //
+	const char*     argv0,
+	const fs::path& cache_dir
+) -> std::optional<fs::path> {
+	auto runfiles = create_runfiles(argv0);
+	if(!runfiles) {
+		return std::nullopt;
+	}
 
-		if(fs::exists(tracy_dir / rel_hdr_path)) {
-			ecsact::cli::report_warning(
-				"Overwriting tracy header {} with runfiles header",
-				rel_hdr_path
+	ecsact::cli::report_info("Using ecsact headers from runfiles");
+
+	auto files = std::vector<runfile>{};
+	files.reserve(ecsact_runtime_headers_from_runfiles.size());
+	for(auto hdr : ecsact_runtime_headers_from_runfiles) {
+		auto full_hdr_path = runfiles->Rlocation(std::string{hdr});
+
+		if(full_hdr_path.empty()) {
+			ecsact::cli::report_error(
+				"Cannot find ecsact_runtime header in runfiles: {}",
+				hdr
 			);
+			return std::nullopt;
 		}
 
-		fs::copy_file(
-			full_hdr_path,
-			tracy_dir / rel_hdr_path,
-			fs::copy_options::overwrite_existing,
-			ec
-		);
+		files.emplace_back(runfile{
+			.src = full_hdr_path,
+			.rel_path = hdr.substr("ecsact_runtime/"sv.size()),
+		});
+	}
 
-		if(ec) {
+	return stage_runfiles(cache_dir, "ecsact_runtime", files);
+}
+
+auto ecsact::cli::cook::load_tracy_runfiles( //
+	const char*     argv0,
+	const fs::path& cache_dir
+) -> std::optional<fs::path> {
+	auto runfiles = create_runfiles(argv0);
+	if(!runfiles) {
+		return std::nullopt;
+	}
+
+	ecsact::cli::report_info("Tracy set, using runfiles");
+
+	auto files = std::vector<runfile>{};
+	files.reserve(tracy_src_runfiles.size());
+	for(auto hdr : tracy_src_runfiles) {
+		auto full_hdr_path = runfiles->Rlocation(std::format("tracy/{}", hdr));
+
+		if(full_hdr_path.empty()) {
 			ecsact::cli::report_error(
-				"Failed to copy tracy header from runfiles. {} -> {}\n{}",
-				full_hdr_path,
-				(tracy_dir / rel_hdr_path).generic_string(),
-				ec.message()
+				"Cannot find tracy header in runfiles: {}",
+				hdr
 			);
-			return false;
+			return std::nullopt;
 		}
+
+		files.emplace_back(runfile{
+			.src = full_hdr_path,
+			.rel_path = hdr.substr("public/"sv.size()),
+		});
 	}
-	return true;
+
+	return stage_runfiles(cache_dir, "tracy", files);
 }
@@ -1,9 +1,48 @@
 #pragma once
 
 #include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
 
 namespace ecsact::cli::cook {
-auto load_runfiles(const char* argv0, std::filesystem::path inc_dir) -> bool;
-auto load_tracy_runfiles(const char* argv0, std::filesystem::path inc_dir)
-	-> bool;
+
+struct runfile {
+	/** Resolved runfiles location */
+	std::filesystem::path src;
+	/** Path relative to the staged directory */
+	std::filesystem::path rel_path;
+};
+
+/**
+ * Stage @p files into a versioned directory in @p cache_dir shared by every
+ * build. The directory is keyed by the files' paths, sizes and modification
+ * times and is never modified once staged so compiles see stable paths and
+ * modification times.
+ * @returns staged directory or `std::nullopt` on failure (reported)
+ */
+auto stage_runfiles(
+	const std::filesystem::path& cache_dir,
+	std::string_view             name,
+	std::span<const runfile>     files
+) -> std::optional<std::filesystem::path>;
+
+/**
+ * Stage the ecsact runtime headers from runfiles into @p cache_dir
+ * @returns include directory with the headers
+ */
+auto load_runfiles( //
+	const char*                  argv0,
+	const std::filesystem::path& cache_dir
+) -> std::optional<std::filesystem::path>;
+
+/**
+ * Stage the tracy client sources from runfiles into @p cache_dir
+ * @returns tracy source directory
+ */
+auto load_tracy_runfiles( //
+	const char*                  argv0,
+	const std::filesystem::path& cache_dir
+) -> std::optional<std::filesystem::path>;
+
 } // namespace ecsact::cli::cook
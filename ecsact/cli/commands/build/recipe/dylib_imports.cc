@@ -0,0 +1,147 @@
+#include "ecsact/cli/commands/build/recipe/dylib_imports.hh"
+
+#include <algorithm>
+#include <format>
+#include <string_view>
+#include <vector>
+#include <boost/algorithm/string/case_conv.hpp>
+#include "ecsact/cli/commands/build/get_modules.hh"
+
+constexpr auto GENERATED_DYLIB_DISCLAIMER = R"(
+////////////////////////////////////////////////////////////////////////////////
+//                    THIS FILE IS GENERATED - DO NOT EDIT                    //
+////////////////////////////////////////////////////////////////////////////////
+)";
+
+constexpr auto LOAD_AT_RUNTIME_GUARD = R"(
+#ifndef ECSACT_{0}_API_LOAD_AT_RUNTIME
+#   error "Expected ECSACT_{0}_API_LOAD_AT_RUNTIME to be set"
+#endif // ECSACT_{0}_API_LOAD_AT_RUNTIME
+
+#ifdef ECSACT_{0}_API
+#   error "ECSACT_{0}_API may not be set while using generated dylib source"
+#endif // ECSACT_{0}_API
+)";
+
+constexpr auto GENERATED_DYLIB_IMPORT_TYPE = R"(
+namespace {
+using ecsact_dylib_fn_t = void (*)();
+
+struct ecsact_dylib_import {
+	std::string_view name;
+	void (*set)(ecsact_dylib_fn_t);
+};
+)";
+
+constexpr auto GENERATED_DYLIB_LOOKUP = R"(
+static_assert(std::ranges::is_sorted(
+	ecsact_dylib_imports,
+	{},
+	&ecsact_dylib_import::name
+));
+
+auto ecsact_dylib_find_import( //
+	std::string_view fn_name
+) -> const ecsact_dylib_import* {
+	auto itr = std::ranges::lower_bound(
+		ecsact_dylib_imports,
+		fn_name,
+		{},
+		&ecsact_dylib_import::name
+	);
+	if(itr != ecsact_dylib_imports.end() && itr->name == fn_name) {
+		return &*itr;
+	}
+	return nullptr;
+}
+} // namespace
+
+extern "C" ECSACT_EXPORT("ecsact_dylib_has_fn")
+auto ecsact_dylib_has_fn(const char* fn_name) -> bool {
+	return ecsact_dylib_find_import(fn_name) != nullptr;
+}
+
+extern "C" ECSACT_EXPORT("ecsact_dylib_set_fn_addr")
+auto ecsact_dylib_set_fn_addr(const char* fn_name, void (*fn_ptr)()) -> void {
+	if(auto imp = ecsact_dylib_find_import(fn_name)) {
+		imp->set(fn_ptr);
+	}
+}
+
+/**
+ * Bind @p count functions in one call. Names that aren't imported are ignored.
+ * @returns number of functions bound
+ */
+extern "C" ECSACT_EXPORT("ecsact_dylib_set_fn_table")
+auto ecsact_dylib_set_fn_table(
+	const char* const* fn_names,
+	void (*const*      fn_ptrs)(),
+	int32_t            count
+) -> int32_t {
+	auto bound_count = int32_t{};
+	for(auto i = int32_t{}; count > i; ++i) {
+		if(auto imp = ecsact_dylib_find_import(fn_names[i])) {
+			imp->set(fn_ptrs[i]);
+			bound_count += 1;
+		}
+	}
+	return bound_count;
+}
+)";
+
+auto ecsact::cli::cook::generate_dylib_imports( //
+	std::span<const std::string> imports,
+	std::ostream&                output
+) -> void {
+	auto mods = ecsact::cli::detail::get_ecsact_modules(
+		std::vector<std::string>{imports.begin(), imports.end()}
+	);
+	output << GENERATED_DYLIB_DISCLAIMER;
+	output << "#include <algorithm>\n";
+	output << "#include <array>\n";
+	output << "#include <cstdint>\n";
+	output << "#include <string_view>\n";
+	output << "#include \"ecsact/runtime/common.h\"\n";
+	for(auto&& [module_name, _] : mods.module_methods) {
+		output << std::format("#include \"ecsact/runtime/{}.h\"\n", module_name);
+	}
+
+	for(auto&& [module_name, _] : mods.module_methods) {
+		output << std::format( //
+			LOAD_AT_RUNTIME_GUARD,
+			boost::to_upper_copy(module_name)
+		);
+	}
+
+	output << "\n";
+
+	for(std::string_view imp : imports) {
+		output << std::format( //
+			"decltype({0})({0}) = nullptr;\n",
+			imp
+		);
+	}
+
+	// Lookups binary search the import table instead of comparing every name
+	auto sorted_imports =
+		std::vector<std::string>{imports.begin(), imports.end()};
+	std::ranges::sort(sorted_imports);
+
+	output << GENERATED_DYLIB_IMPORT_TYPE;
+	output << std::format(
+		"\nconstexpr auto ecsact_dylib_imports = "
+		"std::array<ecsact_dylib_import, {}>{{{{\n",
+		sorted_imports.size()
+	);
+
+	for(std::string_view imp : sorted_imports) {
+		output << std::format(
+			"\t{{\"{0}\", [](ecsact_dylib_fn_t fn) {{ "
+			"{0} = reinterpret_cast<decltype({0})>(fn); }}}},\n",
+			imp
+		);
+	}
+
+	output << "}};\n";
+	output << GENERATED_DYLIB_LOOKUP;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <ostream>
+#include <span>
+#include <string>
+
+namespace ecsact::cli::cook {
+
+/**
+ * Write the C++ source that lets a runtime built with `ecsact build` have its
+ * imported Ecsact API functions bound at load time. It defines a function
+ * pointer for each of @p imports and exports `ecsact_dylib_has_fn`,
+ * `ecsact_dylib_set_fn_addr` and `ecsact_dylib_set_fn_table` (binds many
+ * functions in one call for hosts), which look names up in a table sorted at
+ * generation time.
+ *
+ * The source must be compiled with `ECSACT_<MODULE>_API_LOAD_AT_RUNTIME`
+ * defined for the module of every import.
+ */
+auto generate_dylib_imports( //
+	std::span<const std::string> imports,
+	std::ostream&                output
+) -> void;
+
+} // namespace ecsact::cli::cook
@@ -44,6 +44,47 @@ auto ecsact::cli::detail::integrity::from_bytes( //
 	}
 }
 
+struct ecsact::cli::detail::integrity_hasher::state {
+	SHA256_CTX sha256_ctx;
+};
+
+ecsact::cli::detail::integrity_hasher::integrity_hasher( //
+	enum integrity::kind kind
+)
+	: _kind(kind), _state(std::make_unique<state>()) {
+	if(_kind == integrity::sha256) {
+		SHA256_Init(&_state->sha256_ctx);
+	}
+}
+
+ecsact::cli::detail::integrity_hasher::integrity_hasher(integrity_hasher&&) =
+	default;
+
+ecsact::cli::detail::integrity_hasher::~integrity_hasher() = default;
+
+auto ecsact::cli::detail::integrity_hasher::update( //
+	std::span<const std::byte> bytes
+) -> void {
+	if(_kind == integrity::sha256) {
+		SHA256_Update(&_state->sha256_ctx, bytes.data(), bytes.size());
+	}
+}
+
+auto ecsact::cli::detail::integrity_hasher::finish() -> integrity {
+	switch(_kind) {
+		case integrity::sha256: {
+			auto result = integrity_sha256{};
+			SHA256_Final(
+				reinterpret_cast<uint8_t*>(result._data.data()),
+				&_state->sha256_ctx
+			);
+			return result;
+		}
+		case integrity::unknown:
+			return integrity_unknown{};
+	}
+}
+
 auto ecsact::cli::detail::integrity::from_string( //
 	std::string_view str
 ) -> integrity {
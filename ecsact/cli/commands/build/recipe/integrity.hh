@@ -6,6 +6,7 @@
 #include <variant>
 #include <array>
 #include <cstddef>
+#include <memory>
 
 namespace ecsact::cli::detail {
 struct integrity_unknown {
@@ -118,4 +119,28 @@ struct integrity : std::variant<integrity_unknown, integrity_sha256> {
 		return std::visit([](auto& v) { return v.to_string(); }, *this);
 	}
 };
+
+/**
+ * Computes an integrity a chunk at a time (e.g. while downloading) instead of
+ * from one buffer
+ */
+class integrity_hasher {
+public:
+	integrity_hasher(enum integrity::kind kind);
+	integrity_hasher(integrity_hasher&&);
+	~integrity_hasher();
+
+	auto update(std::span<const std::byte> bytes) -> void;
+
+	/**
+	 * Integrity of every byte passed to update()
+	 */
+	auto finish() -> integrity;
+
+private:
+	struct state;
+
+	enum integrity::kind   _kind;
+	std::unique_ptr<state> _state;
+};
 } // namespace ecsact::cli::detail
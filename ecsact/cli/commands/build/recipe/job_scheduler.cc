@@ -0,0 +1,401 @@
+#include "ecsact/cli/commands/build/recipe/job_scheduler.hh"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <thread>
+#include "ecsact/cli/report.hh"
+
+#ifdef _WIN32
+#	define WIN32_LEAN_AND_MEAN
+#	include <windows.h>
+#elif defined(__APPLE__)
+#	include <mach/mach.h>
+#	include <fcntl.h>
+#	include <poll.h>
+#	include <unistd.h>
+#else
+#	include <fcntl.h>
+#	include <poll.h>
+#	include <unistd.h>
+#endif
+
+using namespace std::string_view_literals;
+
+using ecsact::cli::cook::job_scheduler;
+using ecsact::cli::cook::jobserver_auth;
+
+/**
+ * How often a job waiting on memory or a jobserver token checks again
+ */
+constexpr auto poll_interval = std::chrono::milliseconds{50};
+
+class job_scheduler::jobserver_client {
+public:
+	static auto connect( //
+		const jobserver_auth& auth
+	) -> std::unique_ptr<jobserver_client> {
+		auto client = std::unique_ptr<jobserver_client>{new jobserver_client{}};
+#ifdef _WIN32
+		if(!auth.semaphore_name) {
+			return nullptr;
+		}
+
+		client->_semaphore =
+			OpenSemaphoreA(SEMAPHORE_ALL_ACCESS, FALSE, auth.semaphore_name->c_str());
+		if(client->_semaphore == nullptr) {
+			return nullptr;
+		}
+#else
+		if(auth.fifo_path) {
+			// Our own non-blocking open so a token taken by another process between
+			// poll and read doesn't block us
+			client->_read_fd = open(auth.fifo_path->c_str(), O_RDONLY | O_NONBLOCK);
+			client->_write_fd = open(auth.fifo_path->c_str(), O_WRONLY);
+			client->_owns_fds = true;
+		} else {
+			client->_read_fd = auth.read_fd;
+			client->_write_fd = auth.write_fd;
+		}
+
+		// make only passes the pipe to recipes it knows run make ('+' prefix or
+		// $(MAKE)). Otherwise the descriptors are closed.
+		if(client->_read_fd < 0 || fcntl(client->_read_fd, F_GETFD) == -1) {
+			return nullptr;
+		}
+		if(client->_write_fd < 0 || fcntl(client->_write_fd, F_GETFD) == -1) {
+			return nullptr;
+		}
+#endif
+
+		return client;
+	}
+
+	~jobserver_client() {
+#ifdef _WIN32
+		if(_semaphore != nullptr) {
+			CloseHandle(_semaphore);
+		}
+#else
+		if(_owns_fds) {
+			if(_read_fd >= 0) {
+				close(_read_fd);
+			}
+			if(_write_fd >= 0) {
+				close(_write_fd);
+			}
+		}
+#endif
+	}
+
+	/**
+	 * Wait up to @p timeout for a token
+	 */
+	auto try_acquire(std::chrono::milliseconds timeout) -> bool {
+#ifdef _WIN32
+		auto wait_result = WaitForSingleObject(
+			_semaphore,
+			static_cast<DWORD>(timeout.count())
+		);
+		return wait_result == WAIT_OBJECT_0;
+#else
+		auto read_poll = pollfd{.fd = _read_fd, .events = POLLIN, .revents = 0};
+		if(poll(&read_poll, 1, static_cast<int>(timeout.count())) <= 0) {
+			return false;
+		}
+
+		auto token = char{};
+		if(read(_read_fd, &token, 1) != 1) {
+			return false;
+		}
+
+		auto lk = std::scoped_lock{_tokens_mutex};
+		_tokens.push_back(token);
+		return true;
+#endif
+	}
+
+	/**
+	 * Give back a token taken with `try_acquire`
+	 */
+	auto release() -> void {
+#ifdef _WIN32
+		ReleaseSemaphore(_semaphore, 1, nullptr);
+#else
+		auto token = char{'+'};
+		{
+			auto lk = std::scoped_lock{_tokens_mutex};
+			if(!_tokens.empty()) {
+				token = _tokens.back();
+				_tokens.pop_back();
+			}
+		}
+
+		// Losing a token would slow down the outer build so retry interrupts
+		while(write(_write_fd, &token, 1) == -1 && errno == EINTR) {
+		}
+#endif
+	}
+
+private:
+	jobserver_client() = default;
+
+#ifdef _WIN32
+	HANDLE _semaphore = nullptr;
+#else
+	int               _read_fd = -1;
+	int               _write_fd = -1;
+	bool              _owns_fds = false;
+	std::mutex        _tokens_mutex;
+	std::vector<char> _tokens;
+#endif
+};
+
+auto ecsact::cli::cook::parse_jobserver_auth( //
+	std::string_view makeflags
+) -> std::optional<jobserver_auth> {
+	auto auth = std::optional<jobserver_auth>{};
+
+	// make may list the flag more than once. The last one wins.
+	while(!makeflags.empty()) {
+		auto arg_end = makeflags.find(' ');
+		auto arg = makeflags.substr(0, arg_end);
+		makeflags = arg_end == std::string_view::npos //
+			? std::string_view{}
+			: makeflags.substr(arg_end + 1);
+
+		auto value = std::string_view{};
+		if(arg.starts_with("--jobserver-auth="sv)) {
+			value = arg.substr("--jobserver-auth="sv.size());
+		} else if(arg.starts_with("--jobserver-fds="sv)) {
+			value = arg.substr("--jobserver-fds="sv.size());
+		} else {
+			continue;
+		}
+
+		auto parsed = jobserver_auth{};
+		if(value.starts_with("fifo:"sv)) {
+			parsed.fifo_path = std::string{value.substr("fifo:"sv.size())};
+			auth = parsed;
+			continue;
+		}
+
+		auto comma = value.find(',');
+		if(comma == std::string_view::npos) {
+			parsed.semaphore_name = std::string{value};
+			auth = parsed;
+			continue;
+		}
+
+		auto read_fd_str = std::string{value.substr(0, comma)};
+		auto write_fd_str = std::string{value.substr(comma + 1)};
+		char* read_fd_end = nullptr;
+		char* write_fd_end = nullptr;
+		parsed.read_fd =
+			static_cast<int>(std::strtol(read_fd_str.c_str(), &read_fd_end, 10));
+		parsed.write_fd =
+			static_cast<int>(std::strtol(write_fd_str.c_str(), &write_fd_end, 10));
+
+		if(read_fd_str.empty() || *read_fd_end != '\0' || write_fd_str.empty() ||
+			 *write_fd_end != '\0') {
+			continue;
+		}
+
+		if(parsed.read_fd < 0 || parsed.write_fd < 0) {
+			// make uses -1,-1 for recipes it did not hand the jobserver to
+			auth = std::nullopt;
+			continue;
+		}
+
+		auth = parsed;
+	}
+
+	return auth;
+}
+
+job_scheduler::job_scheduler(job_scheduler_options options)
+	: _options(options) {
+	_options.max_jobs = std::max(1U, _options.max_jobs);
+
+	if(!_options.use_jobserver) {
+		return;
+	}
+
+	auto makeflags = std::getenv("MAKEFLAGS");
+	if(makeflags == nullptr) {
+		return;
+	}
+
+	if(auto auth = parse_jobserver_auth(makeflags); auth) {
+		_jobserver = jobserver_client::connect(*auth);
+	}
+}
+
+job_scheduler::~job_scheduler() = default;
+
+auto job_scheduler::max_jobs() const -> unsigned {
+	return _options.max_jobs;
+}
+
+auto job_scheduler::has_jobserver() const -> bool {
+	return _jobserver != nullptr;
+}
+
+auto job_scheduler::run( //
+	std::size_t                     count,
+	std::function<int(std::size_t)> job
+) -> std::vector<int> {
+	auto exit_codes = std::vector<int>(count, 0);
+
+	auto max_jobs = _options.max_jobs;
+	if(_options.job_memory_estimate > 0) {
+		// Jobs that just started have not grown yet so available memory alone
+		// would let far too many start at once
+		if(auto available = available_system_memory(); available) {
+			auto memory_max_jobs = *available / _options.job_memory_estimate;
+			max_jobs = static_cast<unsigned>(
+				std::clamp<std::uint64_t>(memory_max_jobs, 1, max_jobs)
+			);
+		}
+	}
+
+	auto has_enough_memory = [this] {
+		if(_options.job_memory_estimate == 0) {
+			return true;
+		}
+
+		auto available = available_system_memory();
+		return !available || *available >= _options.job_memory_estimate;
+	};
+
+	auto mutex = std::mutex{};
+	auto job_done = std::condition_variable{};
+	auto in_flight = 0U;
+
+	// The token every process implicitly holds from the outer make
+	auto implicit_token_free = true;
+
+	auto jobs = std::vector<std::future<void>>{};
+	jobs.reserve(count);
+
+	for(auto index = std::size_t{}; count > index; ++index) {
+		auto lk = std::unique_lock{mutex};
+		job_done.wait(lk, [&] { return max_jobs > in_flight; });
+
+		auto has_token = false;
+		while(in_flight > 0) {
+			if(!has_enough_memory()) {
+				job_done.wait_for(lk, poll_interval);
+				continue;
+			}
+
+			if(!_jobserver || implicit_token_free) {
+				break;
+			}
+
+			lk.unlock();
+			auto acquired = _jobserver->try_acquire(poll_interval);
+			lk.lock();
+
+			if(acquired) {
+				has_token = true;
+				break;
+			}
+		}
+
+		auto uses_implicit_token = !has_token;
+		if(uses_implicit_token) {
+			implicit_token_free = false;
+		}
+
+		in_flight += 1;
+		lk.unlock();
+
+		jobs.emplace_back(std::async(std::launch::async, [&, index, has_token] {
+			// The slot must be given back even if the job throws or every job after
+			// it waits forever
+			try {
+				exit_codes[index] = job(index);
+			} catch(const std::exception& err) {
+				ecsact::cli::report_error("Build job failed: {}", err.what());
+				exit_codes[index] = 1;
+			} catch(...) {
+				ecsact::cli::report_error("Build job failed");
+				exit_codes[index] = 1;
+			}
+
+			if(has_token) {
+				_jobserver->release();
+			}
+
+			{
+				auto lk = std::scoped_lock{mutex};
+				in_flight -= 1;
+				if(!has_token) {
+					implicit_token_free = true;
+				}
+			}
+			job_done.notify_all();
+		}));
+	}
+
+	for(auto& job : jobs) {
+		job.get();
+	}
+
+	return exit_codes;
+}
+
+auto ecsact::cli::cook::default_job_count() -> unsigned {
+	return std::max(1U, std::thread::hardware_concurrency());
+}
+
+auto ecsact::cli::cook::available_system_memory()
+	-> std::optional<std::uint64_t> {
+#ifdef _WIN32
+	auto status = MEMORYSTATUSEX{};
+	status.dwLength = sizeof(status);
+	if(!GlobalMemoryStatusEx(&status)) {
+		return std::nullopt;
+	}
+	return static_cast<std::uint64_t>(status.ullAvailPhys);
+#elif defined(__APPLE__)
+	auto stats = vm_statistics64_data_t{};
+	auto count = mach_msg_type_number_t{HOST_VM_INFO64_COUNT};
+	auto err = host_statistics64(
+		mach_host_self(),
+		HOST_VM_INFO64,
+		reinterpret_cast<host_info64_t>(&stats),
+		&count
+	);
+	if(err != KERN_SUCCESS) {
+		return std::nullopt;
+	}
+	auto pages = static_cast<std::uint64_t>(stats.free_count) +
+		static_cast<std::uint64_t>(stats.inactive_count);
+	return pages * static_cast<std::uint64_t>(vm_page_size);
+#else
+	auto meminfo = std::ifstream{"/proc/meminfo"};
+	auto line = std::string{};
+	while(std::getline(meminfo, line)) {
+		if(!line.starts_with("MemAvailable:")) {
+			continue;
+		}
+
+		// MemAvailable:   12345678 kB
+		auto value_kb = std::strtoull(
+			line.c_str() + "MemAvailable:"sv.size(),
+			nullptr,
+			10
+		);
+		return static_cast<std::uint64_t>(value_kb) * 1024;
+	}
+	return std::nullopt;
+#endif
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ecsact::cli::cook {
+
+/**
+ * Connection details of a GNU make jobserver found in `MAKEFLAGS`
+ */
+struct jobserver_auth {
+	/** Named pipe (make >= 4.4 `fifo:PATH`) */
+	std::optional<std::string> fifo_path;
+
+	/** Inherited pipe file descriptors (`R,W`) */
+	int read_fd = -1;
+	int write_fd = -1;
+
+	/** Windows semaphore name */
+	std::optional<std::string> semaphore_name;
+};
+
+/**
+ * Find the jobserver in a `MAKEFLAGS` value. Both `--jobserver-auth=` and the
+ * older `--jobserver-fds=` spellings are understood.
+ * @returns `std::nullopt` if @p makeflags does not name a jobserver
+ */
+auto parse_jobserver_auth( //
+	std::string_view makeflags
+) -> std::optional<jobserver_auth>;
+
+struct job_scheduler_options {
+	/**
+	 * Maximum jobs run at once
+	 */
+	unsigned max_jobs = 1;
+
+	/**
+	 * Estimated peak memory of a single job in bytes. A new job is only started
+	 * while at least this much system memory is available. No throttling if 0.
+	 */
+	std::uint64_t job_memory_estimate = 0;
+
+	/**
+	 * Take a jobserver token from the outer make (if there is one) for every
+	 * job beyond the first.
+	 */
+	bool use_jobserver = true;
+};
+
+/**
+ * Runs the subprocess jobs of a single `ecsact build` (compiles, links) with a
+ * bounded amount of parallelism. The limit applies to the jobs of one `run`
+ * call. Recipe sources are fetched and staged before any compile through
+ * `run_source_graph` which has a limit of its own.
+ */
+class job_scheduler {
+public:
+	job_scheduler(job_scheduler_options options);
+	job_scheduler(job_scheduler&&) = delete;
+	~job_scheduler();
+
+	/**
+	 * Calls @p job with every index in [0, @p count) and waits for all of them
+	 * to finish. At least one job is always allowed to run so a tight memory
+	 * limit or a busy jobserver only slows the build down.
+	 * @returns exit code of each job by index. 1 for jobs that threw.
+	 */
+	auto run( //
+		std::size_t                     count,
+		std::function<int(std::size_t)> job
+	) -> std::vector<int>;
+
+	auto max_jobs() const -> unsigned;
+
+	/**
+	 * @returns `true` if jobs are limited by an outer make jobserver
+	 */
+	auto has_jobserver() const -> bool;
+
+private:
+	class jobserver_client;
+
+	job_scheduler_options             _options;
+	std::unique_ptr<jobserver_client> _jobserver;
+};
+
+/**
+ * Default for `--jobs`. Number of hardware threads.
+ */
+auto default_job_count() -> unsigned;
+
+/**
+ * Physical memory currently available for new processes in bytes
+ * @returns `std::nullopt` if unknown on this platform
+ */
+auto available_system_memory() -> std::optional<std::uint64_t>;
+
+} // namespace ecsact::cli::cook
@@ -0,0 +1,184 @@
+#include "ecsact/cli/commands/build/recipe/object_cache.hh"
+
+#include <algorithm>
+#include <format>
+#include <chrono>
+#include <vector>
+#include "ecsact/cli/detail/atomic_write.hh"
+#include "ecsact/cli/detail/content_hash.hh"
+
+namespace fs = std::filesystem;
+
+using ecsact::cli::detail::atomic_copy_file;
+using ecsact::cli::detail::content_hasher;
+
+/**
+ * Bump when the key or entry layout changes so stale entries are never used
+ */
+constexpr auto object_cache_version = std::string_view{"2"};
+
+/**
+ * Ways the work directory is spelled in compile args and preprocessor line
+ * markers. Line markers escape the backslashes of Windows paths.
+ */
+static auto work_dir_spellings( //
+	const fs::path& work_dir
+) -> std::vector<std::string> {
+	if(work_dir.empty()) {
+		return {};
+	}
+
+	auto dir = fs::absolute(work_dir).lexically_normal();
+	if(!dir.has_filename()) {
+		dir = dir.parent_path();
+	}
+
+	// Every path would match a root directory
+	if(dir.relative_path().empty()) {
+		return {};
+	}
+
+	auto escaped = std::string{};
+	for(auto c : dir.string()) {
+		if(c == '\\') {
+			escaped.push_back('\\');
+		}
+		escaped.push_back(c);
+	}
+
+	auto spellings = std::vector<std::string>{
+		dir.generic_string(),
+		dir.string(),
+		std::move(escaped),
+	};
+	std::ranges::sort(spellings);
+	auto duplicates = std::ranges::unique(spellings);
+	spellings.erase(duplicates.begin(), duplicates.end());
+	return spellings;
+}
+
+/**
+ * Hash @p str with every work directory spelling replaced by the same
+ * placeholder
+ */
+static auto update_without_work_dir(
+	content_hasher&                 hasher,
+	std::string_view                str,
+	const std::vector<std::string>& spellings
+) -> void {
+	auto update_str = [&](std::string_view part) {
+		hasher.update_bytes(std::as_bytes(std::span{part}));
+	};
+
+	// Next match of each spelling so every spelling is only searched once
+	auto matches = std::vector<std::size_t>{};
+	for(auto& spelling : spellings) {
+		matches.push_back(str.find(spelling));
+	}
+
+	auto pos = std::size_t{0};
+	for(;;) {
+		auto next = std::ranges::min_element(matches);
+		if(next == matches.end() || *next == std::string_view::npos) {
+			break;
+		}
+
+		auto& spelling = spellings[next - matches.begin()];
+		update_str(str.substr(pos, *next - pos));
+		update_str("<work_dir>");
+		pos = *next + spelling.size();
+
+		for(auto i = std::size_t{0}; matches.size() > i; ++i) {
+			if(matches[i] < pos) {
+				matches[i] = str.find(spellings[i], pos);
+			}
+		}
+	}
+
+	update_str(str.substr(pos));
+}
+
+ecsact::cli::cook::object_cache::object_cache(fs::path dir)
+	: _dir(std::move(dir)) {
+}
+
+auto ecsact::cli::cook::object_cache::key(
+	const cc_compiler&           compiler,
+	const fs::path&              work_dir,
+	std::span<const std::string> compile_args,
+	std::span<const std::byte>   preprocessed_source
+) -> std::string {
+	auto hasher = content_hasher{};
+
+	hasher.update(object_cache_version);
+	hasher.update(to_string(compiler.compiler_type));
+	hasher.update(compiler.compiler_version);
+	hasher.update(compiler.compiler_path.generic_string());
+
+	// Compilers may be upgraded in place without the path or reported version
+	// changing (e.g. nightly builds)
+	auto ec = std::error_code{};
+	auto compiler_size = fs::file_size(compiler.compiler_path, ec);
+	auto compiler_mtime = fs::last_write_time(compiler.compiler_path, ec);
+	hasher.update(std::format(
+		"{}:{}",
+		ec ? 0 : compiler_size,
+		compiler_mtime.time_since_epoch().count()
+	));
+
+	auto spellings = work_dir_spellings(work_dir);
+	for(auto& arg : compile_args) {
+		update_without_work_dir(hasher, arg, spellings);
+		// Same separator `content_hasher::update` adds
+		hasher.update(std::string_view{});
+	}
+
+	update_without_work_dir(
+		hasher,
+		std::string_view{
+			reinterpret_cast<const char*>(preprocessed_source.data()),
+			preprocessed_source.size(),
+		},
+		spellings
+	);
+
+	return hasher.digest();
+}
+
+auto ecsact::cli::cook::object_cache::entry_path( //
+	std::string_view key
+) const -> fs::path {
+	return _dir / key.substr(0, 2) / std::format("{}.o", key);
+}
+
+auto ecsact::cli::cook::object_cache::restore(
+	std::string_view key,
+	const fs::path&  object_path
+) const -> bool {
+	auto ec = std::error_code{};
+	auto entry = entry_path(key);
+
+	if(!fs::exists(entry, ec)) {
+		return false;
+	}
+
+	fs::create_directories(object_path.parent_path(), ec);
+	fs::copy_file(entry, object_path, fs::copy_options::overwrite_existing, ec);
+
+	return !ec;
+}
+
+auto ecsact::cli::cook::object_cache::store(
+	std::string_view key,
+	const fs::path&  object_path
+) const -> bool {
+	auto ec = std::error_code{};
+	auto entry = entry_path(key);
+
+	fs::create_directories(entry.parent_path(), ec);
+	if(ec) {
+		return false;
+	}
+
+	return atomic_copy_file(object_path, entry);
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <cstddef>
+#include "ecsact/cli/commands/build/cc_compiler_config.hh"
+
+namespace ecsact::cli::cook {
+
+/**
+ * Persistent content addressed cache of compiled object files shared between
+ * `ecsact build` invocations.
+ */
+class object_cache {
+public:
+	object_cache(std::filesystem::path dir);
+
+	/**
+	 * Cache key for a single translation unit.
+	 *
+	 * @param compiler compiler identity (type, version, path and binary
+	 *        size/modification time) is part of the key
+	 * @param work_dir directory the translation unit is compiled in. Left out
+	 *        of @p compile_args and preprocessor line markers so the same
+	 *        translation unit built in another work directory hits the cache.
+	 *        Empty to keep it when the object embeds the work directory.
+	 * @param compile_args full compiler argument vector used to compile the
+	 *        translation unit
+	 * @param preprocessed_source preprocessor output of the translation unit so
+	 *        that changes to any included header change the key
+	 */
+	static auto key(
+		const cc_compiler&           compiler,
+		const std::filesystem::path& work_dir,
+		std::span<const std::string> compile_args,
+		std::span<const std::byte>   preprocessed_source
+	) -> std::string;
+
+	/**
+	 * Copy the cached object for @p key to @p object_path.
+	 * @returns `false` if there is no object cached for @p key
+	 */
+	auto restore( //
+		std::string_view             key,
+		const std::filesystem::path& object_path
+	) const -> bool;
+
+	/**
+	 * Store @p object_path under @p key. Failures are not fatal and only mean
+	 * the next build will compile the translation unit again.
+	 * @returns `false` if the object could not be stored
+	 */
+	auto store( //
+		std::string_view             key,
+		const std::filesystem::path& object_path
+	) const -> bool;
+
+private:
+	std::filesystem::path _dir;
+
+	auto entry_path(std::string_view key) const -> std::filesystem::path;
+};
+
+} // namespace ecsact::cli::cook
@@ -0,0 +1,191 @@
+#include "ecsact/cli/commands/build/recipe/pgo.hh"
+
+#include <algorithm>
+#include <format>
+#include <string>
+#include "ecsact/cli/report.hh"
+#include "ecsact/cli/detail/content_hash.hh"
+#include "ecsact/cli/detail/proc_exec.hh"
+
+namespace fs = std::filesystem;
+
+#ifdef _WIN32
+constexpr auto EXE_SUFFIX = ".exe";
+#else
+constexpr auto EXE_SUFFIX = "";
+#endif
+
+static auto find_llvm_profdata( //
+	const fs::path& compiler_path
+) -> std::optional<fs::path> {
+	for(auto& candidate :
+			ecsact::cli::cook::llvm_profdata_candidates(compiler_path)) {
+		if(!candidate.has_parent_path()) {
+			if(auto found = ecsact::cli::detail::which(candidate.string())) {
+				return found;
+			}
+			continue;
+		}
+
+		auto ec = std::error_code{};
+		if(fs::is_regular_file(candidate, ec)) {
+			return candidate;
+		}
+	}
+
+	return std::nullopt;
+}
+
+auto ecsact::cli::cook::llvm_profdata_candidates( //
+	const fs::path& compiler_path
+) -> std::vector<fs::path> {
+	auto names = std::vector<std::string>{};
+
+	auto stem = compiler_path.stem().string();
+	if(auto dash = stem.rfind('-'); dash != std::string::npos) {
+		auto version = stem.substr(dash + 1);
+		auto is_version = !version.empty() &&
+			std::ranges::all_of(version, [](char c) { return c >= '0' && c <= '9'; });
+		if(is_version) {
+			names.emplace_back(
+				std::format("llvm-profdata-{}{}", version, EXE_SUFFIX)
+			);
+		}
+	}
+	names.emplace_back(std::format("llvm-profdata{}", EXE_SUFFIX));
+
+	auto candidates = std::vector<fs::path>{};
+	if(compiler_path.has_parent_path()) {
+		for(auto& name : names) {
+			candidates.emplace_back(compiler_path.parent_path() / name);
+		}
+	}
+
+	// No parent path means look it up on PATH
+	for(auto& name : names) {
+		candidates.emplace_back(name);
+	}
+
+	return candidates;
+}
+
+auto ecsact::cli::cook::collect_raw_profiles( //
+	const fs::path& profile
+) -> std::vector<fs::path> {
+	auto ec = std::error_code{};
+	if(!fs::is_directory(profile, ec)) {
+		if(fs::is_regular_file(profile, ec)) {
+			return {profile};
+		}
+		return {};
+	}
+
+	auto raw_profiles = std::vector<fs::path>{};
+	for(auto& entry : fs::directory_iterator{profile, ec}) {
+		if(entry.is_regular_file() && entry.path().extension() == ".profraw") {
+			raw_profiles.emplace_back(entry.path());
+		}
+	}
+
+	std::ranges::sort(raw_profiles);
+	return raw_profiles;
+}
+
+auto ecsact::cli::cook::prepare_pgo_profile(
+	const fs::path& compiler_path,
+	const fs::path& profile,
+	const fs::path& pgo_dir
+) -> std::optional<fs::path> {
+	auto ec = std::error_code{};
+	fs::create_directories(pgo_dir, ec);
+
+	auto merged = pgo_dir / "merged.profdata";
+
+	if(profile.extension() == ".profdata") {
+		fs::copy_file(profile, merged, fs::copy_options::overwrite_existing, ec);
+		if(ec) {
+			ecsact::cli::report_error(
+				"Failed to copy profile {}: {}",
+				profile.generic_string(),
+				ec.message()
+			);
+			return std::nullopt;
+		}
+	} else {
+		auto raw_profiles = collect_raw_profiles(profile);
+		if(raw_profiles.empty()) {
+			ecsact::cli::report_error(
+				"No .profraw files found at {}",
+				profile.generic_string()
+			);
+			return std::nullopt;
+		}
+
+		auto llvm_profdata = find_llvm_profdata(compiler_path);
+		if(!llvm_profdata) {
+			ecsact::cli::report_error(
+				"Cannot find llvm-profdata for {}. It is required to merge .profraw "
+				"files, pass a .profdata file instead.",
+				compiler_path.generic_string()
+			);
+			return std::nullopt;
+		}
+
+		auto merge_args = std::vector<std::string>{
+			"merge",
+			std::format("-output={}", merged.string()),
+		};
+		for(auto& raw_profile : raw_profiles) {
+			merge_args.emplace_back(raw_profile.string());
+		}
+
+		ecsact::cli::report_info(
+			"Merging {} raw profile(s) with {}",
+			raw_profiles.size(),
+			llvm_profdata->generic_string()
+		);
+
+		auto merge_exit_code =
+			ecsact::cli::detail::spawn_and_report_output(*llvm_profdata, merge_args);
+		if(merge_exit_code != 0) {
+			ecsact::cli::report_error(
+				"llvm-profdata merge failed. Exited with code {}",
+				merge_exit_code
+			);
+			return std::nullopt;
+		}
+	}
+
+	auto profile_hash = ecsact::cli::detail::hash_file(merged);
+	if(!profile_hash) {
+		ecsact::cli::report_error(
+			"Failed to read merged profile {}",
+			merged.generic_string()
+		);
+		return std::nullopt;
+	}
+
+	auto profdata = pgo_dir / std::format("{}.profdata", *profile_hash);
+	fs::rename(merged, profdata, ec);
+	if(ec) {
+		ecsact::cli::report_error(
+			"Failed to move merged profile to {}: {}",
+			profdata.generic_string(),
+			ec.message()
+		);
+		return std::nullopt;
+	}
+
+	// Profiles from previous builds are never used again
+	auto stale_profiles = std::vector<fs::path>{};
+	for(auto& entry : fs::directory_iterator{pgo_dir, ec}) {
+		if(entry.path() != profdata) {
+			stale_profiles.emplace_back(entry.path());
+		}
+	}
+	for(auto& stale_profile : stale_profiles) {
+		fs::remove(stale_profile, ec);
+	}
+
+	return profdata;
+}
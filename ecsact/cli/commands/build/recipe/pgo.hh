@@ -0,0 +1,51 @@
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+namespace ecsact::cli::cook {
+
+enum class pgo_mode {
+	/** Regular optimized build */
+	none,
+
+	/** Build with `-fprofile-generate` so running the runtime writes .profraw */
+	instrument,
+
+	/** Build with `-fprofile-use` and a previously collected profile */
+	use,
+};
+
+/**
+ * llvm-profdata executables that may match the compiler at @p compiler_path,
+ * most specific first. Versioned compilers (e.g. `clang-18`) prefer the
+ * versioned llvm-profdata since the raw profile format changes between LLVM
+ * releases.
+ */
+auto llvm_profdata_candidates( //
+	const std::filesystem::path& compiler_path
+) -> std::vector<std::filesystem::path>;
+
+/**
+ * Raw profiles found at @p profile. Either the file itself or every .profraw
+ * file in the directory.
+ */
+auto collect_raw_profiles( //
+	const std::filesystem::path& profile
+) -> std::vector<std::filesystem::path>;
+
+/**
+ * Turn @p profile (a .profdata file, a .profraw file or a directory of .profraw
+ * files) into an indexed profile in @p pgo_dir. Raw profiles are merged with
+ * the llvm-profdata belonging to @p compiler_path. The result is named by its
+ * contents so a new profile changes the compile arguments (and object keys.)
+ * @returns path of the indexed profile or `std::nullopt` on error (reported)
+ */
+auto prepare_pgo_profile(
+	const std::filesystem::path& compiler_path,
+	const std::filesystem::path& profile,
+	const std::filesystem::path& pgo_dir
+) -> std::optional<std::filesystem::path>;
+
+} // namespace ecsact::cli::cook
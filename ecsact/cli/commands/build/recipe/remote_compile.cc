@@ -0,0 +1,431 @@
+#include "ecsact/cli/commands/build/recipe/remote_compile.hh"
+
+#include <algorithm>
+#include <array>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <span>
+#include "nlohmann/json.hpp"
+#include "ecsact/cli/report.hh"
+#include "ecsact/cli/detail/proc_exec.hh"
+
+namespace fs = std::filesystem;
+
+using ecsact::cli::detail::read_frame;
+using ecsact::cli::detail::socket_connection;
+using ecsact::cli::detail::socket_endpoint;
+using ecsact::cli::detail::write_frame;
+
+/**
+ * Headers are small. Frames larger than this are treated as a broken
+ * connection rather than allocated.
+ */
+constexpr auto MAX_HEADER_FRAME_SIZE = std::uint64_t{16} * 1024 * 1024;
+constexpr auto MAX_DATA_FRAME_SIZE = std::uint64_t{2} * 1024 * 1024 * 1024;
+
+static auto write_header(
+	socket_connection&    conn,
+	const nlohmann::json& header
+) -> bool {
+	auto str = header.dump();
+	return write_frame(conn, std::as_bytes(std::span{str}));
+}
+
+static auto read_header(socket_connection& conn)
+	-> std::optional<nlohmann::json> {
+	auto data = std::vector<std::byte>{};
+	if(!read_frame(conn, MAX_HEADER_FRAME_SIZE, data)) {
+		return std::nullopt;
+	}
+
+	auto str = std::string_view{
+		reinterpret_cast<const char*>(data.data()),
+		data.size(),
+	};
+	auto header = nlohmann::json::parse(str, nullptr, false);
+	if(header.is_discarded() || !header.is_object()) {
+		return std::nullopt;
+	}
+
+	return header;
+}
+
+auto ecsact::cli::cook::send_worker_info(
+	socket_connection&        conn,
+	const remote_worker_info& info
+) -> bool {
+	return write_header(
+		conn,
+		{
+			{"protocol_version", info.protocol_version},
+			{"compiler_type", info.compiler_type},
+			{"compiler_version", info.compiler_version},
+			{"slots", info.slots},
+		}
+	);
+}
+
+auto ecsact::cli::cook::receive_worker_info( //
+	socket_connection& conn
+) -> std::optional<remote_worker_info> {
+	auto header = read_header(conn);
+	if(!header) {
+		return std::nullopt;
+	}
+
+	try {
+		return remote_worker_info{
+			.protocol_version = header->at("protocol_version").get<int>(),
+			.compiler_type = header->at("compiler_type").get<std::string>(),
+			.compiler_version = header->at("compiler_version").get<std::string>(),
+			.slots = header->at("slots").get<unsigned>(),
+		};
+	} catch(const nlohmann::json::exception&) {
+		return std::nullopt;
+	}
+}
+
+auto ecsact::cli::cook::send_compile_request(
+	socket_connection&            conn,
+	const remote_compile_request& request
+) -> bool {
+	return write_header(conn, {{"args", request.args}}) &&
+		write_frame(conn, request.preprocessed_source);
+}
+
+auto ecsact::cli::cook::receive_compile_request( //
+	socket_connection& conn
+) -> std::optional<remote_compile_request> {
+	auto header = read_header(conn);
+	if(!header) {
+		return std::nullopt;
+	}
+
+	auto request = remote_compile_request{};
+	try {
+		request.args = header->at("args").get<std::vector<std::string>>();
+	} catch(const nlohmann::json::exception&) {
+		return std::nullopt;
+	}
+
+	if(!read_frame(conn, MAX_DATA_FRAME_SIZE, request.preprocessed_source)) {
+		return std::nullopt;
+	}
+
+	return request;
+}
+
+auto ecsact::cli::cook::send_compile_result(
+	socket_connection&           conn,
+	const remote_compile_result& result
+) -> bool {
+	return write_header(
+					 conn,
+					 {
+						 {"exit_code", result.exit_code},
+						 {"output", result.output},
+					 }
+				 ) &&
+		write_frame(conn, result.object);
+}
+
+auto ecsact::cli::cook::receive_compile_result( //
+	socket_connection& conn
+) -> std::optional<remote_compile_result> {
+	auto header = read_header(conn);
+	if(!header) {
+		return std::nullopt;
+	}
+
+	auto result = remote_compile_result{};
+	try {
+		result.exit_code = header->at("exit_code").get<int>();
+		result.output = header->at("output").get<std::string>();
+	} catch(const nlohmann::json::exception&) {
+		return std::nullopt;
+	}
+
+	if(!read_frame(conn, MAX_DATA_FRAME_SIZE, result.object)) {
+		return std::nullopt;
+	}
+
+	return result;
+}
+
+static auto write_bytes_file(
+	const fs::path&            path,
+	std::span<const std::byte> data
+) -> bool {
+	auto file = std::ofstream{path, std::ios::binary | std::ios::trunc};
+	file.write(
+		reinterpret_cast<const char*>(data.data()),
+		static_cast<std::streamsize>(data.size())
+	);
+	return static_cast<bool>(file);
+}
+
+static auto read_bytes_file(const fs::path& path)
+	-> std::optional<std::vector<std::byte>> {
+	auto file = std::ifstream{path, std::ios::binary};
+	if(!file) {
+		return std::nullopt;
+	}
+
+	auto chars = std::vector<char>{
+		std::istreambuf_iterator<char>{file},
+		std::istreambuf_iterator<char>{},
+	};
+	auto bytes = std::vector<std::byte>(chars.size());
+	std::ranges::transform(chars, bytes.begin(), [](char c) {
+		return static_cast<std::byte>(c);
+	});
+	return bytes;
+}
+
+auto ecsact::cli::cook::is_allowed_remote_compile_arg( //
+	std::string_view arg
+) -> bool {
+	constexpr auto allowed_args = std::array<std::string_view, 13>{
+		"-O0",
+		"-O1",
+		"-O2",
+		"-O3",
+		"-Os",
+		"-Oz",
+		"-Og",
+		"-Ofast",
+		"-fPIC",
+		"-static",
+		"-fprofile-generate",
+		"-stdlib=libc++",
+		"-stdlib=libstdc++",
+	};
+	if(std::ranges::find(allowed_args, arg) != allowed_args.end()) {
+		return true;
+	}
+
+	auto is_value_char = [](char c) {
+		return (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '+' ||
+			c == '-';
+	};
+
+	if(arg.starts_with("-std=")) {
+		auto value = arg.substr(5);
+		return !value.empty() && std::ranges::all_of(value, is_value_char);
+	}
+
+	if(arg.starts_with("-fvisibility=")) {
+		auto value = arg.substr(13);
+		return value == "default" || value == "hidden" || value == "protected";
+	}
+
+	// Flags that take a value (paths, plugin arguments, profile files) are
+	// rejected by only allowing `-f<name>`
+	if(arg.starts_with("-f")) {
+		auto name = arg.substr(2);
+		return !name.empty() && std::ranges::all_of(name, is_value_char) &&
+			name.find("plugin") == std::string_view::npos;
+	}
+
+	return false;
+}
+
+auto ecsact::cli::cook::run_remote_compile_request(
+	const ecsact::cli::cc_compiler& compiler,
+	const remote_compile_request&   request,
+	const fs::path&                 scratch_dir
+) -> remote_compile_result {
+	// The argv is rebuilt from allowed arguments only. Anything else could run
+	// arbitrary code on the worker.
+	auto args = std::vector<std::string>{};
+	args.reserve(request.args.size() + 6);
+	for(auto& arg : request.args) {
+		if(!is_allowed_remote_compile_arg(arg)) {
+			return {
+				.exit_code = 1,
+				.output = std::format("build worker does not allow argument {}", arg),
+			};
+		}
+		args.push_back(arg);
+	}
+
+	auto ec = std::error_code{};
+	fs::create_directories(scratch_dir, ec);
+
+	auto input_path = scratch_dir / "input.ii";
+	auto output_path = scratch_dir / "output.o";
+	fs::remove(output_path, ec);
+
+	if(!write_bytes_file(input_path, request.preprocessed_source)) {
+		return {
+			.exit_code = 1,
+			.output = std::format(
+				"failed to write {} on build worker",
+				input_path.generic_string()
+			),
+		};
+	}
+
+	args.push_back("-x");
+	args.push_back("c++-cpp-output");
+	args.push_back("-c");
+	args.push_back(input_path.string());
+	args.push_back("-o");
+	args.push_back(output_path.string());
+
+	auto compile = ecsact::cli::detail::spawn_get_output(
+		compiler.compiler_path,
+		args,
+		scratch_dir
+	);
+
+	auto result = remote_compile_result{
+		.exit_code = compile.exit_code,
+		.output = std::move(compile.output),
+	};
+
+	if(result.exit_code == 0) {
+		auto object = read_bytes_file(output_path);
+		if(!object) {
+			result.exit_code = 1;
+			result.output += "\nbuild worker compiler did not write an object";
+		} else {
+			result.object = std::move(*object);
+		}
+	}
+
+	fs::remove(input_path, ec);
+	fs::remove(output_path, ec);
+
+	return result;
+}
+
+ecsact::cli::cook::remote_executor_pool::remote_executor_pool(
+	const std::vector<socket_endpoint>& endpoints,
+	const ecsact::cli::cc_compiler&     compiler
+)
+	: _compiler(compiler) {
+	auto compiler_type = std::string{to_string(compiler.compiler_type)};
+
+	for(auto& endpoint : endpoints) {
+		auto ec = std::error_code{};
+		auto conn = socket_connection::connect(endpoint, ec);
+		if(ec) {
+			ecsact::cli::report_warning(
+				"Skipping build executor {}: {}",
+				endpoint.to_string(),
+				ec.message()
+			);
+			continue;
+		}
+
+		conn.set_receive_timeout(ecsact::cli::detail::HANDSHAKE_TIMEOUT);
+		auto info = receive_worker_info(conn);
+		if(!info) {
+			ecsact::cli::report_warning(
+				"Skipping build executor {}: not an ecsact build worker",
+				endpoint.to_string()
+			);
+			continue;
+		}
+
+		if(info->protocol_version != REMOTE_COMPILE_PROTOCOL_VERSION) {
+			ecsact::cli::report_warning(
+				"Skipping build executor {}: protocol version {} (expected {})",
+				endpoint.to_string(),
+				info->protocol_version,
+				REMOTE_COMPILE_PROTOCOL_VERSION
+			);
+			continue;
+		}
+
+		// Objects have to come out the same as a local compile would produce
+		if(info->compiler_type != compiler_type ||
+			 info->compiler_version != compiler.compiler_version) {
+			ecsact::cli::report_warning(
+				"Skipping build executor {}: compiler {} {} does not match {} {}",
+				endpoint.to_string(),
+				info->compiler_type,
+				info->compiler_version,
+				compiler_type,
+				compiler.compiler_version
+			);
+			continue;
+		}
+
+		if(info->slots == 0) {
+			continue;
+		}
+
+		ecsact::cli::report_info(
+			"Using build executor {} ({} slots)",
+			endpoint.to_string(),
+			info->slots
+		);
+		_executors.push_back({
+			.endpoint = endpoint,
+			.slots = info->slots,
+		});
+	}
+}
+
+auto ecsact::cli::cook::remote_executor_pool::slot_count() const -> unsigned {
+	auto lk = std::scoped_lock{_mutex};
+	auto count = 0u;
+	for(auto& exec : _executors) {
+		if(!exec.failed) {
+			count += exec.slots;
+		}
+	}
+	return count;
+}
+
+auto ecsact::cli::cook::remote_executor_pool::try_compile( //
+	const remote_compile_request& request
+) -> std::optional<remote_compile_result> {
+	auto index = std::optional<std::size_t>{};
+	auto endpoint = socket_endpoint{};
+	{
+		auto lk = std::scoped_lock{_mutex};
+		for(auto i = std::size_t{}; _executors.size() > i; ++i) {
+			auto& exec = _executors[i];
+			if(!exec.failed && exec.slots > exec.busy) {
+				exec.busy += 1;
+				index = i;
+				endpoint = exec.endpoint;
+				break;
+			}
+		}
+	}
+
+	if(!index) {
+		return std::nullopt;
+	}
+
+	auto result = std::optional<remote_compile_result>{};
+	auto ec = std::error_code{};
+	auto conn = socket_connection::connect(endpoint, ec);
+	if(!ec) {
+		conn.set_receive_timeout(ecsact::cli::detail::HANDSHAKE_TIMEOUT);
+		if(receive_worker_info(conn) && send_compile_request(conn, request)) {
+			// The result only arrives once the compile is done
+			conn.set_receive_timeout(std::chrono::milliseconds{0});
+			result = receive_compile_result(conn);
+		}
+	}
+
+	auto lk = std::scoped_lock{_mutex};
+	auto& exec = _executors[*index];
+	exec.busy -= 1;
+	if(!result && !exec.failed) {
+		// A worker that dropped a job is not trusted for the rest of the build
+		exec.failed = true;
+		ecsact::cli::report_warning(
+			"Build executor {} failed, compiling locally instead",
+			endpoint.to_string()
+		);
+	}
+
+	return result;
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ecsact/cli/commands/build/cc_compiler_config.hh"
+#include "ecsact/cli/detail/socket.hh"
+
+namespace ecsact::cli::cook {
+
+/**
+ * Bumped whenever a message of the remote compile protocol changes
+ */
+constexpr auto REMOTE_COMPILE_PROTOCOL_VERSION = 1;
+
+/**
+ * Sent by a worker as soon as a connection is accepted
+ */
+struct remote_worker_info {
+	int         protocol_version = REMOTE_COMPILE_PROTOCOL_VERSION;
+	std::string compiler_type;
+	std::string compiler_version;
+
+	/** Compiles the worker runs at once */
+	unsigned slots = 1;
+};
+
+/**
+ * A single gcc/clang compile of an already preprocessed C++ source
+ */
+struct remote_compile_request {
+	/** Compile arguments without the input, `-c` and `-o` */
+	std::vector<std::string> args;
+	std::vector<std::byte>   preprocessed_source;
+};
+
+struct remote_compile_result {
+	int exit_code = 0;
+
+	/** Compiler stdout and stderr */
+	std::string output;
+
+	/** Object file contents. Empty if the compile failed. */
+	std::vector<std::byte> object;
+};
+
+// Each message is one JSON header frame, requests and results are followed
+// by one binary frame. A frame is a 64-bit little endian size and the bytes.
+
+auto send_worker_info(
+	ecsact::cli::detail::socket_connection& conn,
+	const remote_worker_info&               info
+) -> bool;
+
+auto receive_worker_info( //
+	ecsact::cli::detail::socket_connection& conn
+) -> std::optional<remote_worker_info>;
+
+auto send_compile_request(
+	ecsact::cli::detail::socket_connection& conn,
+	const remote_compile_request&           request
+) -> bool;
+
+auto receive_compile_request( //
+	ecsact::cli::detail::socket_connection& conn
+) -> std::optional<remote_compile_request>;
+
+auto send_compile_result(
+	ecsact::cli::detail::socket_connection& conn,
+	const remote_compile_result&            result
+) -> bool;
+
+auto receive_compile_result( //
+	ecsact::cli::detail::socket_connection& conn
+) -> std::optional<remote_compile_result>;
+
+/**
+ * Whether a build worker passes @p arg from a compile request to its
+ * compiler. Only code generation flags are allowed, nothing that names a
+ * file, loads a plugin or changes which tools run.
+ */
+auto is_allowed_remote_compile_arg(std::string_view arg) -> bool;
+
+/**
+ * Compile @p request with @p compiler (worker side.) Files are written to
+ * @p scratch_dir which must not be shared with other running compiles.
+ * Requests with any argument `is_allowed_remote_compile_arg` rejects fail
+ * without running the compiler.
+ */
+auto run_remote_compile_request(
+	const ecsact::cli::cc_compiler& compiler,
+	const remote_compile_request&   request,
+	const std::filesystem::path&    scratch_dir
+) -> remote_compile_result;
+
+/**
+ * Compile workers (`ecsact build-worker`) that preprocessed sources are sent
+ * to. Shared by every compile job of a build.
+ */
+class remote_executor_pool {
+public:
+	/**
+	 * Asks every endpoint for its compiler. Endpoints that can't be reached or
+	 * use a different compiler than @p compiler are skipped with a warning.
+	 */
+	remote_executor_pool(
+		const std::vector<ecsact::cli::detail::socket_endpoint>& endpoints,
+		const ecsact::cli::cc_compiler&                          compiler
+	);
+
+	/**
+	 * Total compiles the usable workers run at once
+	 */
+	auto slot_count() const -> unsigned;
+
+	/**
+	 * Compile @p request on a worker with a free slot
+	 * @returns `std::nullopt` if every worker is busy or the worker failed. The
+	 * source should be compiled locally instead.
+	 */
+	auto try_compile( //
+		const remote_compile_request& request
+	) -> std::optional<remote_compile_result>;
+
+private:
+	struct executor {
+		ecsact::cli::detail::socket_endpoint endpoint;
+		unsigned                             slots;
+		unsigned                             busy = 0;
+		bool                                 failed = false;
+	};
+
+	mutable std::mutex       _mutex;
+	std::vector<executor>    _executors;
+	ecsact::cli::cc_compiler _compiler;
+};
+
+} // namespace ecsact::cli::cook
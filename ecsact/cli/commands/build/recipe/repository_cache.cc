@@ -0,0 +1,193 @@
+#include "ecsact/cli/commands/build/recipe/repository_cache.hh"
+
+#include <format>
+#include <fstream>
+#include <utility>
+#include "ecsact/cli/detail/atomic_write.hh"
+#include "ecsact/cli/detail/content_hash.hh"
+
+namespace fs = std::filesystem;
+
+using ecsact::cli::detail::atomic_copy_file;
+using ecsact::cli::detail::content_hasher;
+using ecsact::cli::detail::integrity;
+
+/**
+ * Bump when the key or entry layout changes so stale entries are never used
+ */
+constexpr auto repository_cache_version = std::string_view{"1"};
+
+ecsact::cli::cook::repository_cache::repository_cache(fs::path dir)
+	: _dir(std::move(dir)) {
+}
+
+auto ecsact::cli::cook::repository_cache::key(
+	const std::optional<integrity>& download_integrity,
+	std::string_view                url
+) -> std::string {
+	if(download_integrity && *download_integrity) {
+		// The integrity string is base64 which isn't safe to use as a file name.
+		// Only the algorithm prefix (e.g. sha256-) is kept.
+		auto integrity_str = download_integrity->to_string();
+		auto key = integrity_str.substr(0, integrity_str.find('-') + 1);
+
+		auto data = std::span{
+			download_integrity->data(),
+			download_integrity->size(),
+		};
+		for(auto b : data) {
+			key += std::format("{:02x}", static_cast<unsigned>(b));
+		}
+
+		return key;
+	}
+
+	auto hasher = content_hasher{};
+	hasher.update(repository_cache_version);
+	hasher.update(url);
+	return std::format("url-{}", hasher.digest());
+}
+
+auto ecsact::cli::cook::repository_cache::entry_path( //
+	std::string_view key
+) const -> fs::path {
+	return _dir / std::format("v{}", repository_cache_version) / key;
+}
+
+auto ecsact::cli::cook::repository_cache::unique_tmp_path() const
+	-> fs::path {
+	// Downloads are written before their key is known
+	return ecsact::cli::detail::unique_tmp_path(entry_path("download"));
+}
+
+auto ecsact::cli::cook::repository_cache::restore_path( //
+	std::string_view key
+) const -> std::optional<fs::path> {
+	auto ec = std::error_code{};
+	auto entry = entry_path(key);
+	if(!fs::is_regular_file(entry, ec)) {
+		return std::nullopt;
+	}
+
+	return entry;
+}
+
+auto ecsact::cli::cook::repository_cache::restore( //
+	std::string_view key
+) const -> std::optional<std::vector<std::byte>> {
+	auto ec = std::error_code{};
+	auto entry = entry_path(key);
+
+	auto size = fs::file_size(entry, ec);
+	if(ec) {
+		return std::nullopt;
+	}
+
+	auto file = std::ifstream{entry, std::ios_base::binary};
+	if(!file) {
+		return std::nullopt;
+	}
+
+	auto data = std::vector<std::byte>(static_cast<std::size_t>(size));
+	file.read(
+		reinterpret_cast<char*>(data.data()),
+		static_cast<std::streamsize>(data.size())
+	);
+	if(file.gcount() != static_cast<std::streamsize>(data.size())) {
+		return std::nullopt;
+	}
+
+	return data;
+}
+
+ecsact::cli::cook::repository_cache::entry_writer::entry_writer( //
+	const repository_cache& cache
+)
+	: _cache(&cache), _tmp_path(cache.unique_tmp_path()) {
+	auto ec = std::error_code{};
+	fs::create_directories(_tmp_path.parent_path(), ec);
+	if(!ec) {
+		_file.open(_tmp_path, std::ios_base::binary);
+	}
+}
+
+ecsact::cli::cook::repository_cache::entry_writer::entry_writer( //
+	entry_writer&& other
+)
+	: _cache(other._cache)
+	, _tmp_path(std::exchange(other._tmp_path, {}))
+	, _file(std::move(other._file))
+	, _committed_path(std::move(other._committed_path)) {
+}
+
+ecsact::cli::cook::repository_cache::entry_writer::~entry_writer() {
+	if(_file.is_open()) {
+		_file.close();
+	}
+
+	if(!_tmp_path.empty()) {
+		auto ec = std::error_code{};
+		fs::remove(_tmp_path, ec);
+	}
+}
+
+auto ecsact::cli::cook::repository_cache::entry_writer::write(
+	std::span<const std::byte> data
+) -> void {
+	if(_file.is_open()) {
+		_file.write(
+			reinterpret_cast<const char*>(data.data()),
+			static_cast<std::streamsize>(data.size())
+		);
+	}
+}
+
+auto ecsact::cli::cook::repository_cache::entry_writer::commit( //
+	std::string_view key
+) -> bool {
+	auto ec = std::error_code{};
+	auto entry = _cache->entry_path(key);
+
+	if(_committed_path) {
+		return atomic_copy_file(*_committed_path, entry);
+	}
+
+	if(!_file.is_open()) {
+		return false;
+	}
+
+	_file.close();
+	if(!_file) {
+		return false;
+	}
+
+	fs::rename(_tmp_path, entry, ec);
+	if(ec) {
+		return false;
+	}
+
+	_tmp_path.clear();
+	_committed_path = entry;
+	return true;
+}
+
+auto ecsact::cli::cook::repository_cache::begin_store() const
+	-> entry_writer {
+	return entry_writer{*this};
+}
+
+auto ecsact::cli::cook::repository_cache::store(
+	std::string_view           key,
+	std::span<const std::byte> data
+) const -> bool {
+	auto writer = begin_store();
+	writer.write(data);
+	return writer.commit(key);
+}
+
+auto ecsact::cli::cook::repository_cache::remove( //
+	std::string_view key
+) const -> void {
+	auto ec = std::error_code{};
+	fs::remove(entry_path(key), ec);
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ecsact/cli/commands/build/recipe/integrity.hh"
+
+namespace ecsact::cli::cook {
+
+/**
+ * Persistent cache of downloaded recipe `fetch` sources shared between
+ * `ecsact build` invocations. Entries are keyed by their integrity so the
+ * same archive is only ever downloaded once no matter which url it came from.
+ */
+class repository_cache {
+public:
+	repository_cache(std::filesystem::path dir);
+
+	/**
+	 * Cache key of a download. The integrity is used when there is one,
+	 * otherwise a hash of @p url.
+	 */
+	static auto key(
+		const std::optional<ecsact::cli::detail::integrity>& download_integrity,
+		std::string_view                                     url
+	) -> std::string;
+
+	/**
+	 * Read the cached download for @p key
+	 * @returns `std::nullopt` if nothing is cached for @p key
+	 */
+	auto restore( //
+		std::string_view key
+	) const -> std::optional<std::vector<std::byte>>;
+
+	/**
+	 * Path of the cached download for @p key so it can be read without loading
+	 * all of it into memory
+	 * @returns `std::nullopt` if nothing is cached for @p key
+	 */
+	auto restore_path( //
+		std::string_view key
+	) const -> std::optional<std::filesystem::path>;
+
+	/**
+	 * Writes a new entry a chunk at a time (e.g. while it is downloaded).
+	 * Nothing is visible in the cache until commit() and uncommitted data is
+	 * removed when the writer is destroyed.
+	 */
+	class entry_writer {
+	public:
+		entry_writer(entry_writer&& other);
+		~entry_writer();
+
+		auto write(std::span<const std::byte> data) -> void;
+
+		/**
+		 * Store everything written so far under @p key. May be called again to
+		 * store the same data under another key.
+		 * @returns `false` if the entry could not be stored
+		 */
+		auto commit(std::string_view key) -> bool;
+
+	private:
+		friend repository_cache;
+
+		entry_writer(const repository_cache& cache);
+
+		const repository_cache*              _cache;
+		std::filesystem::path                _tmp_path;
+		std::ofstream                        _file;
+		std::optional<std::filesystem::path> _committed_path;
+	};
+
+	/**
+	 * Start writing a new entry
+	 */
+	auto begin_store() const -> entry_writer;
+
+	/**
+	 * Store @p data under @p key. Failures are not fatal and only mean the next
+	 * build will download again.
+	 * @returns `false` if the data could not be stored
+	 */
+	auto store( //
+		std::string_view           key,
+		std::span<const std::byte> data
+	) const -> bool;
+
+	/**
+	 * Remove the entry for @p key (e.g. if it no longer matches its integrity)
+	 */
+	auto remove(std::string_view key) const -> void;
+
+private:
+	std::filesystem::path _dir;
+
+	auto entry_path(std::string_view key) const -> std::filesystem::path;
+	auto unique_tmp_path() const -> std::filesystem::path;
+};
+
+} // namespace ecsact::cli::cook
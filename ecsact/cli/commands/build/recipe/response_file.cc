@@ -0,0 +1,31 @@
+#include "ecsact/cli/commands/build/recipe/response_file.hh"
+
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+auto ecsact::cli::cook::quote_gnu_response_file_arg( //
+	std::string_view arg
+) -> std::string {
+	auto quoted = std::string{};
+	quoted.reserve(arg.size() + 2);
+	quoted.push_back('"');
+	for(auto c : arg) {
+		if(c == '"' || c == '\\') {
+			quoted.push_back('\\');
+		}
+		quoted.push_back(c);
+	}
+	quoted.push_back('"');
+	return quoted;
+}
+
+auto ecsact::cli::cook::write_gnu_response_file(
+	const fs::path&                 response_file_path,
+	const std::vector<std::string>& args
+) -> void {
+	auto response_file = std::ofstream{response_file_path};
+	for(auto& arg : args) {
+		response_file << quote_gnu_response_file_arg(arg) << "\n";
+	}
+}
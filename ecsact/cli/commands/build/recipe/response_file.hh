@@ -0,0 +1,25 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ecsact::cli::cook {
+
+/**
+ * Quote @p arg for a GNU style response file (gcc, clang and clang-cl in GNU
+ * mode.) These drivers tokenize response files with GNU rules on every
+ * platform so backslashes are escaped on Windows too.
+ */
+auto quote_gnu_response_file_arg(std::string_view arg) -> std::string;
+
+/**
+ * Write @p args to a gcc/clang response file, one quoted argument per line
+ */
+auto write_gnu_response_file(
+	const std::filesystem::path&    response_file_path,
+	const std::vector<std::string>& args
+) -> void;
+
+} // namespace ecsact::cli::cook
@@ -0,0 +1,141 @@
+#include "ecsact/cli/commands/build/recipe/source_graph.hh"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+static auto is_path_prefix(const fs::path& prefix, const fs::path& path)
+	-> bool {
+	auto [prefix_end, _] = std::mismatch(
+		prefix.begin(),
+		prefix.end(),
+		path.begin(),
+		path.end()
+	);
+	return prefix_end == prefix.end();
+}
+
+static auto outdirs_overlap(const fs::path& a, const fs::path& b) -> bool {
+	auto a_normal = a.lexically_normal();
+	auto b_normal = b.lexically_normal();
+
+	// `a/` and `a` are the same directory
+	if(!a_normal.has_filename()) {
+		a_normal = a_normal.parent_path();
+	}
+	if(!b_normal.has_filename()) {
+		b_normal = b_normal.parent_path();
+	}
+
+	return is_path_prefix(a_normal, b_normal) ||
+		is_path_prefix(b_normal, a_normal);
+}
+
+auto ecsact::cli::cook::source_dependencies( //
+	std::span<const source_graph_node> nodes
+) -> std::vector<std::vector<std::size_t>> {
+	auto dependencies = std::vector<std::vector<std::size_t>>(nodes.size());
+	auto last_exclusive = std::optional<std::size_t>{};
+
+	for(auto i = std::size_t{}; nodes.size() > i; ++i) {
+		for(auto j = std::size_t{}; i > j; ++j) {
+			auto exclusive_dep = nodes[i].exclusive && last_exclusive == j;
+			if(exclusive_dep || outdirs_overlap(nodes[i].outdir, nodes[j].outdir)) {
+				dependencies[i].push_back(j);
+			}
+		}
+
+		if(nodes[i].exclusive) {
+			last_exclusive = i;
+		}
+	}
+
+	return dependencies;
+}
+
+auto ecsact::cli::cook::run_source_graph(
+	const std::vector<std::vector<std::size_t>>& dependencies,
+	unsigned                                     max_jobs,
+	std::function<int(std::size_t)>              job
+) -> std::vector<std::optional<int>> {
+	auto count = dependencies.size();
+	auto results = std::vector<std::optional<int>>(count);
+	if(count == 0) {
+		return results;
+	}
+
+	auto dependents = std::vector<std::vector<std::size_t>>(count);
+	auto waiting_on = std::vector<std::size_t>(count);
+	auto ready = std::deque<std::size_t>{};
+
+	for(auto i = std::size_t{}; count > i; ++i) {
+		waiting_on[i] = dependencies[i].size();
+		for(auto dep : dependencies[i]) {
+			dependents[dep].push_back(i);
+		}
+		if(waiting_on[i] == 0) {
+			ready.push_back(i);
+		}
+	}
+
+	auto mutex = std::mutex{};
+	auto cv = std::condition_variable{};
+	auto finished_count = std::size_t{};
+	auto failed = false;
+
+	auto worker = [&] {
+		auto lk = std::unique_lock{mutex};
+		for(;;) {
+			cv.wait(lk, [&] {
+				return failed || finished_count == count || !ready.empty();
+			});
+
+			if(failed || finished_count == count) {
+				return;
+			}
+
+			auto index = ready.front();
+			ready.pop_front();
+
+			lk.unlock();
+			auto exit_code = job(index);
+			lk.lock();
+
+			results[index] = exit_code;
+			finished_count += 1;
+
+			if(exit_code != 0) {
+				failed = true;
+			} else {
+				for(auto dependent : dependents[index]) {
+					waiting_on[dependent] -= 1;
+					if(waiting_on[dependent] == 0) {
+						ready.push_back(dependent);
+					}
+				}
+			}
+
+			cv.notify_all();
+		}
+	};
+
+	auto thread_count = std::clamp<std::size_t>(max_jobs, 1, count);
+	auto threads = std::vector<std::thread>{};
+	threads.reserve(thread_count - 1);
+	for(auto i = std::size_t{1}; thread_count > i; ++i) {
+		threads.emplace_back(worker);
+	}
+
+	// The calling thread works too so a single job never needs a thread
+	worker();
+
+	for(auto& thread : threads) {
+		thread.join();
+	}
+
+	return results;
+}
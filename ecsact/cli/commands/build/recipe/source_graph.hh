@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace ecsact::cli::cook {
+
+/**
+ * A recipe source as far as ordering is concerned
+ */
+struct source_graph_node {
+	/** Directory the source writes its files to */
+	std::filesystem::path outdir;
+
+	/**
+	 * Exclusive sources never run at the same time as each other (codegen
+	 * plugins share process wide state)
+	 */
+	bool exclusive = false;
+};
+
+/**
+ * Sources each source has to wait for. A source depends on every earlier
+ * source whose output directory contains or is contained by its own and
+ * exclusive sources depend on the previous exclusive source.
+ * @returns indices of the sources each source depends on
+ */
+auto source_dependencies( //
+	std::span<const source_graph_node> nodes
+) -> std::vector<std::vector<std::size_t>>;
+
+/**
+ * Call @p job with the index of every source once all of its dependencies
+ * succeeded. At most @p max_jobs run at once. No new jobs start after one
+ * fails.
+ * @returns exit code of each job by index. `std::nullopt` if it didn't run.
+ */
+auto run_source_graph(
+	const std::vector<std::vector<std::size_t>>& dependencies,
+	unsigned                                     max_jobs,
+	std::function<int(std::size_t)>              job
+) -> std::vector<std::optional<int>>;
+
+} // namespace ecsact::cli::cook
@@ -0,0 +1,201 @@
+#include "ecsact/cli/commands/build/recipe/stage_files.hh"
+
+#include <charconv>
+#include <format>
+#ifdef __linux__
+#	include <cerrno>
+#	include <fcntl.h>
+#	include <linux/fs.h>
+#	include <sys/ioctl.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#elif defined(__APPLE__)
+#	include <sys/clonefile.h>
+#endif
+
+namespace fs = std::filesystem;
+
+using ecsact::cli::cook::stage_method;
+using ecsact::cli::cook::staged_file_stamp;
+
+#ifdef __linux__
+/**
+ * Closes a file descriptor when it goes out of scope
+ */
+struct scoped_fd {
+	int fd;
+
+	~scoped_fd() {
+		if(fd != -1) {
+			close(fd);
+		}
+	}
+};
+#endif
+
+/**
+ * Clone @p src to the new file @p dst sharing its data blocks (btrfs, xfs,
+ * apfs, etc.)
+ */
+static auto try_reflink(const fs::path& src, const fs::path& dst) -> bool {
+#if defined(__linux__)
+	auto src_fd = scoped_fd{open(src.c_str(), O_RDONLY | O_CLOEXEC)};
+	if(src_fd.fd == -1) {
+		return false;
+	}
+
+	struct stat src_stat = {};
+	if(fstat(src_fd.fd, &src_stat) != 0) {
+		return false;
+	}
+
+	auto dst_fd = scoped_fd{open(
+		dst.c_str(),
+		O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC,
+		src_stat.st_mode & 07777
+	)};
+	if(dst_fd.fd == -1) {
+		return false;
+	}
+
+	if(ioctl(dst_fd.fd, FICLONE, src_fd.fd) != 0) {
+		unlink(dst.c_str());
+		return false;
+	}
+
+	return true;
+#elif defined(__APPLE__)
+	return clonefile(src.c_str(), dst.c_str(), 0) == 0;
+#else
+	return false;
+#endif
+}
+
+/**
+ * Copy @p src to the new file @p dst. On Linux the copy happens in the kernel
+ * with copy_file_range which some file systems turn into a clone anyway.
+ */
+static auto copy_contents(
+	const fs::path&  src,
+	const fs::path&  dst,
+	std::error_code& ec
+) -> void {
+#ifdef __linux__
+	auto src_fd = scoped_fd{open(src.c_str(), O_RDONLY | O_CLOEXEC)};
+	struct stat src_stat = {};
+	if(src_fd.fd != -1 && fstat(src_fd.fd, &src_stat) == 0) {
+		auto dst_fd = scoped_fd{open(
+			dst.c_str(),
+			O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+			src_stat.st_mode & 07777
+		)};
+
+		auto remaining = static_cast<std::size_t>(src_stat.st_size);
+		while(dst_fd.fd != -1 && remaining > 0) {
+			auto copied = copy_file_range(
+				src_fd.fd,
+				nullptr,
+				dst_fd.fd,
+				nullptr,
+				remaining,
+				0
+			);
+			if(copied <= 0) {
+				break;
+			}
+			remaining -= static_cast<std::size_t>(copied);
+		}
+
+		if(dst_fd.fd != -1 && remaining == 0) {
+			ec.clear();
+			return;
+		}
+
+		// Not supported between these file systems (or by this kernel)
+		auto remove_ec = std::error_code{};
+		fs::remove(dst, remove_ec);
+	}
+#endif
+
+	fs::copy_file(src, dst, fs::copy_options::overwrite_existing, ec);
+}
+
+auto ecsact::cli::cook::stage_file(
+	const fs::path&  src,
+	const fs::path&  dst,
+	std::error_code& ec
+) -> stage_method {
+	ec.clear();
+
+	// Staging goes through a temporary file that replaces dst so an existing
+	// hard link at dst is unlinked instead of its source being overwritten
+	auto tmp_path = dst;
+	tmp_path += ".stage-tmp";
+	fs::remove(tmp_path, ec);
+	ec.clear();
+
+	auto method = stage_method::copy;
+	auto link_ec = std::error_code{};
+	if(try_reflink(src, tmp_path)) {
+		method = stage_method::reflink;
+	} else if(fs::create_hard_link(src, tmp_path, link_ec), !link_ec) {
+		method = stage_method::hardlink;
+	} else {
+		copy_contents(src, tmp_path, ec);
+	}
+
+	if(!ec) {
+		fs::rename(tmp_path, dst, ec);
+	}
+
+	if(ec) {
+		auto remove_ec = std::error_code{};
+		fs::remove(tmp_path, remove_ec);
+	}
+
+	return method;
+}
+
+auto staged_file_stamp::to_string() const -> std::string {
+	return std::format("{}:{}:{}", size, write_time, hash);
+}
+
+auto staged_file_stamp::parse( //
+	std::string_view str
+) -> std::optional<staged_file_stamp> {
+	auto stamp = staged_file_stamp{};
+
+	auto size_end = str.find(':');
+	auto write_time_end = str.find(':', size_end + 1);
+	if(size_end == std::string_view::npos) {
+		return std::nullopt;
+	}
+	if(write_time_end == std::string_view::npos) {
+		return std::nullopt;
+	}
+
+	auto size_str = str.substr(0, size_end);
+	auto write_time_str =
+		str.substr(size_end + 1, write_time_end - size_end - 1);
+
+	auto size_result = std::from_chars(
+		size_str.data(),
+		size_str.data() + size_str.size(),
+		stamp.size
+	);
+	auto write_time_result = std::from_chars(
+		write_time_str.data(),
+		write_time_str.data() + write_time_str.size(),
+		stamp.write_time
+	);
+	if(size_result.ec != std::errc{} || write_time_result.ec != std::errc{}) {
+		return std::nullopt;
+	}
+
+	stamp.hash = str.substr(write_time_end + 1);
+	if(stamp.hash.empty()) {
+		return std::nullopt;
+	}
+
+	return stamp;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace ecsact::cli::cook {
+
+enum class stage_method {
+	/** Copy on write clone sharing the source's data blocks */
+	reflink,
+	/** Hard link to the source file */
+	hardlink,
+	/** Regular copy */
+	copy,
+};
+
+/**
+ * Put the contents of @p src at @p dst as cheaply as the file system allows.
+ * A reflink is tried first, then a hard link and finally a regular copy. An
+ * existing @p dst is replaced and never written through since it may be a hard
+ * link to a source file.
+ * @returns how the file was staged. Only meaningful if @p ec is not set.
+ */
+auto stage_file(
+	const std::filesystem::path& src,
+	const std::filesystem::path& dst,
+	std::error_code&             ec
+) -> stage_method;
+
+/**
+ * What a source file looked like when it was staged. Lets the next build skip
+ * staging files that did not change without reading them.
+ */
+struct staged_file_stamp {
+	std::uintmax_t size = 0;
+	std::int64_t   write_time = 0;
+	std::string    hash;
+
+	auto to_string() const -> std::string;
+
+	static auto parse( //
+		std::string_view str
+	) -> std::optional<staged_file_stamp>;
+};
+
+} // namespace ecsact::cli::cook
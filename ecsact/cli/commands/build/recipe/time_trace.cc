@@ -0,0 +1,147 @@
+#include "ecsact/cli/commands/build/recipe/time_trace.hh"
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+#include "nlohmann/json.hpp"
+
+namespace fs = std::filesystem;
+
+using ecsact::cli::time_trace_report_message;
+
+auto ecsact::cli::cook::time_trace_aggregator::add(
+	const std::string& source_name,
+	std::istream&      trace
+) -> bool {
+	auto j = nlohmann::json::parse(trace, nullptr, false);
+	if(j.is_discarded() || !j.is_object() || !j.contains("traceEvents")) {
+		return false;
+	}
+
+	auto& events = j["traceEvents"];
+	if(!events.is_array()) {
+		return false;
+	}
+
+	auto source_us = std::uint64_t{};
+	auto frontend_us = std::uint64_t{};
+	auto backend_us = std::uint64_t{};
+
+	for(auto& event : events) {
+		if(!event.is_object() || event.value("ph", "") != "X") {
+			continue;
+		}
+
+		auto name = event.value("name", "");
+		auto dur = event.value("dur", std::uint64_t{});
+		auto detail = std::string{};
+		if(auto args = event.find("args"); args != event.end()) {
+			detail = args->value("detail", "");
+		}
+
+		// "Total <name>" events are clang's own sums of every <name> event
+		if(name == "Total ExecuteCompiler") {
+			source_us = dur;
+		} else if(name == "Total Frontend") {
+			frontend_us = dur;
+		} else if(name == "Total Backend") {
+			backend_us = dur;
+		} else if(detail.empty()) {
+			continue;
+		} else if(name == "Source") {
+			auto& entry = _headers[detail];
+			entry.duration_us += dur;
+			entry.count += 1;
+		} else if(name == "InstantiateClass" || name == "InstantiateFunction") {
+			auto& entry = _templates[detail];
+			entry.duration_us += dur;
+			entry.count += 1;
+		} else if(name == "OptFunction" || name == "CodeGen Function") {
+			auto& entry = _functions[detail];
+			entry.duration_us += dur;
+			entry.count += 1;
+		}
+	}
+
+	if(source_us == 0) {
+		source_us = frontend_us + backend_us;
+	}
+
+	auto& source = _sources[source_name];
+	source.duration_us += source_us;
+	source.count += 1;
+
+	_frontend_us += frontend_us;
+	_backend_us += backend_us;
+
+	return true;
+}
+
+auto ecsact::cli::cook::time_trace_aggregator::add_file(
+	const std::string& source_name,
+	const fs::path&    trace_path
+) -> bool {
+	auto trace = std::ifstream{trace_path};
+	if(!trace) {
+		return false;
+	}
+
+	return add(source_name, trace);
+}
+
+auto ecsact::cli::cook::time_trace_aggregator::add_source_time(
+	const std::string& source_name,
+	std::uint64_t      duration_us
+) -> void {
+	auto& source = _sources[source_name];
+	source.duration_us += duration_us;
+	source.count += 1;
+}
+
+auto ecsact::cli::cook::time_trace_aggregator::source_count() const
+	-> std::size_t {
+	return _sources.size();
+}
+
+static auto top_entries(
+	const auto& totals,
+	std::size_t top_count
+) -> std::vector<time_trace_report_message::entry> {
+	auto entries = std::vector<time_trace_report_message::entry>{};
+	entries.reserve(totals.size());
+
+	for(auto&& [name, total] : totals) {
+		entries.push_back({
+			.name = name,
+			.duration_ms = static_cast<double>(total.duration_us) / 1000.0,
+			.count = total.count,
+		});
+	}
+
+	// Ties broken by name so the report is stable
+	std::ranges::sort(entries, [](const auto& a, const auto& b) {
+		if(a.duration_ms != b.duration_ms) {
+			return a.duration_ms > b.duration_ms;
+		}
+		return a.name < b.name;
+	});
+
+	if(entries.size() > top_count) {
+		entries.resize(top_count);
+	}
+
+	return entries;
+}
+
+auto ecsact::cli::cook::time_trace_aggregator::report( //
+	std::size_t top_count
+) const -> time_trace_report_message {
+	return {
+		.total_frontend_ms = static_cast<double>(_frontend_us) / 1000.0,
+		.total_backend_ms = static_cast<double>(_backend_us) / 1000.0,
+		.sources = top_entries(_sources, top_count),
+		.headers = top_entries(_headers, top_count),
+		.templates = top_entries(_templates, top_count),
+		.functions = top_entries(_functions, top_count),
+	};
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <filesystem>
+#include <istream>
+#include <string>
+#include <unordered_map>
+#include "ecsact/cli/report_message.hh"
+
+namespace ecsact::cli::cook {
+
+/**
+ * Combines the clang `-ftime-trace` output of many translation units into a
+ * single report
+ */
+class time_trace_aggregator {
+public:
+	/**
+	 * Add the trace of the translation unit @p source_name
+	 * @returns `false` if @p trace is not a valid time trace
+	 */
+	auto add(const std::string& source_name, std::istream& trace) -> bool;
+
+	/**
+	 * Add the trace file at @p trace_path
+	 * @returns `false` if the file is missing or not a valid time trace
+	 */
+	auto add_file( //
+		const std::string&           source_name,
+		const std::filesystem::path& trace_path
+	) -> bool;
+
+	/**
+	 * Add only the compile time of a translation unit. Used for compilers that
+	 * can't write a time trace.
+	 */
+	auto add_source_time( //
+		const std::string& source_name,
+		std::uint64_t      duration_us
+	) -> void;
+
+	/**
+	 * Number of translation units added so far
+	 */
+	auto source_count() const -> std::size_t;
+
+	/**
+	 * @param top_count maximum number of entries in each list
+	 */
+	auto report(std::size_t top_count) const
+		-> ecsact::cli::time_trace_report_message;
+
+private:
+	struct totals {
+		std::uint64_t duration_us = 0;
+		int           count = 0;
+	};
+
+	using totals_map = std::unordered_map<std::string, totals>;
+
+	std::uint64_t _frontend_us = 0;
+	std::uint64_t _backend_us = 0;
+	totals_map    _sources;
+	totals_map    _headers;
+	totals_map    _templates;
+	totals_map    _functions;
+};
+
+} // namespace ecsact::cli::cook
@@ -0,0 +1,137 @@
+#include "ecsact/cli/commands/build/recipe/unity_build.hh"
+
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <sstream>
+#include "nlohmann/json.hpp"
+
+namespace fs = std::filesystem;
+
+constexpr auto UNITY_SOURCE_DISCLAIMER = R"(
+////////////////////////////////////////////////////////////////////////////////
+//                    THIS FILE IS GENERATED - DO NOT EDIT                    //
+////////////////////////////////////////////////////////////////////////////////
+)";
+
+static auto compile_times_path(const fs::path& work_dir) -> fs::path {
+	return work_dir / "ecsact-compile-times.json";
+}
+
+auto ecsact::cli::cook::partition_unity_sources( //
+	std::vector<unity_source> sources,
+	std::size_t               group_count
+) -> std::vector<std::vector<fs::path>> {
+	group_count = std::min(group_count, sources.size());
+	if(group_count == 0) {
+		return {};
+	}
+
+	// Heaviest first into the lightest group. Ties broken by path so the
+	// result is stable.
+	std::ranges::sort(sources, [](const auto& a, const auto& b) {
+		if(a.weight != b.weight) {
+			return a.weight > b.weight;
+		}
+		return a.path < b.path;
+	});
+
+	auto groups = std::vector<std::vector<fs::path>>(group_count);
+	auto group_weights = std::vector<std::uint64_t>(group_count, 0);
+
+	for(auto& src : sources) {
+		auto lightest = std::ranges::min_element(group_weights);
+		auto index = std::distance(group_weights.begin(), lightest);
+		groups[index].emplace_back(src.path);
+		// Every source costs something even if its weight is unknown
+		*lightest += std::max<std::uint64_t>(src.weight, 1);
+	}
+
+	for(auto& group : groups) {
+		std::ranges::sort(group);
+	}
+
+	return groups;
+}
+
+auto ecsact::cli::cook::write_unity_sources(
+	const std::vector<std::vector<fs::path>>& groups,
+	const fs::path&                           unity_dir
+) -> std::vector<fs::path> {
+	auto ec = std::error_code{};
+	fs::create_directories(unity_dir, ec);
+
+	auto unity_sources = std::vector<fs::path>{};
+	unity_sources.reserve(groups.size());
+
+	for(auto i = 0; groups.size() > i; ++i) {
+		auto contents = std::stringstream{};
+		contents << UNITY_SOURCE_DISCLAIMER << "\n";
+		for(auto& src : groups[i]) {
+			contents << std::format("#include \"{}\"\n", src.generic_string());
+		}
+
+		auto& unity_src = unity_sources.emplace_back(
+			unity_dir / std::format("ecsact-unity-{}.cc", i)
+		);
+
+		auto existing = std::stringstream{};
+		if(auto existing_file = std::ifstream{unity_src}; existing_file) {
+			existing << existing_file.rdbuf();
+		}
+
+		if(existing.str() != contents.str()) {
+			std::ofstream{unity_src, std::ios_base::trunc} << contents.str();
+		}
+	}
+
+	// Translation units from a previous build with more groups
+	for(auto i = groups.size();; ++i) {
+		if(!fs::remove(unity_dir / std::format("ecsact-unity-{}.cc", i), ec)) {
+			break;
+		}
+	}
+
+	return unity_sources;
+}
+
+auto ecsact::cli::cook::load_compile_times( //
+	const fs::path& work_dir
+) -> std::unordered_map<std::string, std::uint64_t> {
+	auto compile_times = std::unordered_map<std::string, std::uint64_t>{};
+
+	auto file = std::ifstream{compile_times_path(work_dir)};
+	if(!file) {
+		return compile_times;
+	}
+
+	auto j = nlohmann::json::parse(file, nullptr, false);
+	if(j.is_discarded() || !j.is_object()) {
+		return compile_times;
+	}
+
+	for(auto& [src, time] : j.items()) {
+		if(time.is_number_unsigned()) {
+			compile_times[src] = time.get<std::uint64_t>();
+		}
+	}
+
+	return compile_times;
+}
+
+auto ecsact::cli::cook::save_compile_times(
+	const fs::path&                                       work_dir,
+	const std::unordered_map<std::string, std::uint64_t>& compile_times
+) -> void {
+	if(compile_times.empty()) {
+		return;
+	}
+
+	auto merged = load_compile_times(work_dir);
+	for(auto&& [src, time] : compile_times) {
+		merged[src] = time;
+	}
+
+	auto file = std::ofstream{compile_times_path(work_dir)};
+	file << nlohmann::json(merged).dump(1, '\t');
+}
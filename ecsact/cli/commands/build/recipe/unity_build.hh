@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ecsact::cli::cook {
+
+struct unity_source {
+	std::filesystem::path path;
+
+	/**
+	 * Relative cost of compiling this source (previous compile time or file
+	 * size.) Only compared with the weight of other sources.
+	 */
+	std::uint64_t weight = 0;
+};
+
+/**
+ * Split @p sources into at most @p group_count groups with roughly equal total
+ * weight. The result only depends on the paths and weights given so unchanged
+ * inputs produce identical unity translation units (and object cache hits.)
+ */
+auto partition_unity_sources( //
+	std::vector<unity_source> sources,
+	std::size_t               group_count
+) -> std::vector<std::vector<std::filesystem::path>>;
+
+/**
+ * Write one translation unit per group to @p unity_dir that includes every
+ * source of the group. Files whose contents would not change are left as is.
+ * @returns paths of the written translation units
+ */
+auto write_unity_sources(
+	const std::vector<std::vector<std::filesystem::path>>& groups,
+	const std::filesystem::path&                           unity_dir
+) -> std::vector<std::filesystem::path>;
+
+/**
+ * Compile time of each source path in microseconds from previous builds in
+ * @p work_dir
+ */
+auto load_compile_times( //
+	const std::filesystem::path& work_dir
+) -> std::unordered_map<std::string, std::uint64_t>;
+
+/**
+ * Merge @p compile_times (source path to microseconds) with the compile times
+ * already recorded in @p work_dir
+ */
+auto save_compile_times(
+	const std::filesystem::path&                          work_dir,
+	const std::unordered_map<std::string, std::uint64_t>& compile_times
+) -> void;
+
+} // namespace ecsact::cli::cook
@@ -0,0 +1,234 @@
+#include "ecsact/cli/commands/build/recipe/work_dir_state.hh"
+
+#include <fstream>
+#include "nlohmann/json.hpp"
+
+namespace fs = std::filesystem;
+
+using ecsact::cli::cook::work_dir_state;
+
+/**
+ * Bump when the state file layout changes so old state is ignored
+ */
+constexpr auto work_dir_state_version = 1;
+
+static auto state_path(const fs::path& work_dir) -> fs::path {
+	return work_dir / "ecsact-build-state.json";
+}
+
+auto work_dir_state::load(fs::path work_dir) -> work_dir_state {
+	auto state = work_dir_state{};
+	state._work_dir = work_dir;
+
+	auto file = std::ifstream{state_path(work_dir)};
+	if(!file) {
+		return state;
+	}
+
+	auto j = nlohmann::json::parse(file, nullptr, false);
+	if(j.is_discarded() || !j.is_object()) {
+		return state;
+	}
+
+	if(j.value("version", 0) != work_dir_state_version) {
+		return state;
+	}
+
+	auto steps = j.value("steps", nlohmann::json::object());
+	for(auto& [step_id, step_json] : steps.items()) {
+		auto& prev_step = state._previous_steps[step_id];
+		prev_step.input_hash = step_json.value("input_hash", "");
+		for(auto& output : step_json.value("outputs", nlohmann::json::array())) {
+			if(output.is_string()) {
+				prev_step.outputs.emplace_back(output.get<std::string>());
+			}
+		}
+
+		auto stamps = step_json.value("output_stamps", nlohmann::json::object());
+		for(auto& [output, stamp] : stamps.items()) {
+			if(stamp.is_string()) {
+				prev_step.output_stamps[output] = stamp.get<std::string>();
+			}
+		}
+	}
+
+	return state;
+}
+
+auto work_dir_state::save() const -> bool {
+	auto steps = nlohmann::json::object();
+	for(auto& [step_id, step] : _current_steps) {
+		auto outputs = nlohmann::json::array();
+		for(auto& output : step.outputs) {
+			outputs.push_back(output.generic_string());
+		}
+
+		steps[step_id] = nlohmann::json{
+			{"input_hash", step.input_hash},
+			{"outputs", outputs},
+		};
+
+		if(!step.output_stamps.empty()) {
+			auto& stamps = steps[step_id]["output_stamps"];
+			for(auto& [output, stamp] : step.output_stamps) {
+				stamps[output.generic_string()] = stamp;
+			}
+		}
+	}
+
+	auto j = nlohmann::json{
+		{"version", work_dir_state_version},
+		{"steps", steps},
+	};
+
+	auto file = std::ofstream{state_path(_work_dir)};
+	if(!file) {
+		return false;
+	}
+
+	file << j.dump(1, '\t');
+	return static_cast<bool>(file);
+}
+
+auto work_dir_state::up_to_date(
+	std::string_view step_id,
+	std::string_view input_hash
+) const -> bool {
+	auto itr = _previous_steps.find(step_id);
+	if(itr == _previous_steps.end()) {
+		return false;
+	}
+
+	if(itr->second.input_hash != input_hash) {
+		return false;
+	}
+
+	auto ec = std::error_code{};
+	for(auto& output : itr->second.outputs) {
+		if(!fs::exists(_work_dir / output, ec)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+auto work_dir_state::previous_outputs( //
+	std::string_view step_id
+) const -> std::vector<fs::path> {
+	auto itr = _previous_steps.find(step_id);
+	if(itr == _previous_steps.end()) {
+		return {};
+	}
+
+	auto outputs = std::vector<fs::path>{};
+	outputs.reserve(itr->second.outputs.size());
+	for(auto& output : itr->second.outputs) {
+		outputs.emplace_back(_work_dir / output);
+	}
+
+	return outputs;
+}
+
+auto work_dir_state::previous_stamp(
+	std::string_view step_id,
+	const fs::path&  output
+) const -> std::optional<std::string> {
+	auto itr = _previous_steps.find(step_id);
+	if(itr == _previous_steps.end()) {
+		return std::nullopt;
+	}
+
+	auto stamp_itr = itr->second.output_stamps.find(to_relative(output));
+	if(stamp_itr == itr->second.output_stamps.end()) {
+		return std::nullopt;
+	}
+
+	return stamp_itr->second;
+}
+
+auto work_dir_state::record(
+	std::string                     step_id,
+	std::string                     input_hash,
+	std::vector<fs::path>           outputs,
+	std::map<fs::path, std::string> output_stamps
+) -> void {
+	for(auto& output : outputs) {
+		output = to_relative(output);
+	}
+
+	auto relative_stamps = std::map<fs::path, std::string>{};
+	for(auto& [output, stamp] : output_stamps) {
+		relative_stamps.emplace(to_relative(output), std::move(stamp));
+	}
+
+	auto lk = std::lock_guard{*_current_steps_mutex};
+	_current_steps[std::move(step_id)] = step{
+		.input_hash = std::move(input_hash),
+		.outputs = std::move(outputs),
+		.output_stamps = std::move(relative_stamps),
+	};
+}
+
+auto work_dir_state::current_outputs() const -> std::vector<fs::path> {
+	auto lk = std::lock_guard{*_current_steps_mutex};
+	auto outputs = std::vector<fs::path>{};
+	for(auto& [_, step] : _current_steps) {
+		for(auto& output : step.outputs) {
+			outputs.emplace_back(_work_dir / output);
+		}
+	}
+
+	return outputs;
+}
+
+auto work_dir_state::remove_stale_outputs() -> std::vector<fs::path> {
+	auto current_outputs = std::set<fs::path>{};
+	for(auto& [_, step] : _current_steps) {
+		current_outputs.insert(step.outputs.begin(), step.outputs.end());
+	}
+
+	auto removed = std::vector<fs::path>{};
+	for(auto& [_, step] : _previous_steps) {
+		for(auto& output : step.outputs) {
+			if(current_outputs.contains(output)) {
+				continue;
+			}
+
+			auto ec = std::error_code{};
+			if(fs::remove(_work_dir / output, ec)) {
+				removed.emplace_back(_work_dir / output);
+			}
+		}
+	}
+
+	return removed;
+}
+
+auto work_dir_state::to_relative(fs::path p) const -> fs::path {
+	if(p.is_absolute()) {
+		p = p.lexically_relative(_work_dir);
+	}
+
+	return p.lexically_normal();
+}
+
+auto ecsact::cli::cook::read_stamp( //
+	const fs::path& stamp_path
+) -> std::optional<std::string> {
+	auto file = std::ifstream{stamp_path};
+	auto hash = std::string{};
+	if(!file || !std::getline(file, hash) || hash.empty()) {
+		return std::nullopt;
+	}
+
+	return hash;
+}
+
+auto ecsact::cli::cook::write_stamp(
+	const fs::path&  stamp_path,
+	std::string_view hash
+) -> void {
+	auto file = std::ofstream{stamp_path, std::ios_base::trunc};
+	file << hash << "\n";
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ecsact::cli::cook {
+
+/**
+ * Record of the steps (fetch, copy, codegen) a previous `ecsact build` ran in
+ * a work directory, the hash of their inputs and the files they produced. Used
+ * to skip steps whose inputs have not changed and to remove files that are no
+ * longer produced by any step.
+ */
+class work_dir_state {
+public:
+	/**
+	 * Load the state of @p work_dir. Missing or unreadable state is treated as
+	 * if nothing was built before.
+	 */
+	static auto load(std::filesystem::path work_dir) -> work_dir_state;
+
+	/**
+	 * Write every step recorded during this build. Steps from the previous
+	 * build that were not recorded again are forgotten.
+	 */
+	auto save() const -> bool;
+
+	/**
+	 * @returns `true` if @p step_id previously ran with @p input_hash and every
+	 *          file it produced still exists
+	 */
+	auto up_to_date( //
+		std::string_view step_id,
+		std::string_view input_hash
+	) const -> bool;
+
+	/**
+	 * Files @p step_id produced in the previous build
+	 */
+	auto previous_outputs( //
+		std::string_view step_id
+	) const -> std::vector<std::filesystem::path>;
+
+	/**
+	 * Stamp @p step_id recorded for @p output in the previous build
+	 * @param output absolute path or path relative to the work directory
+	 */
+	auto previous_stamp(
+		std::string_view             step_id,
+		const std::filesystem::path& output
+	) const -> std::optional<std::string>;
+
+	/**
+	 * Record that @p step_id ran (or was up to date) during this build. Safe to
+	 * call from multiple threads.
+	 * @param outputs absolute paths or paths relative to the work directory
+	 * @param output_stamps optional per output data for the next build to check
+	 *        (e.g. the size and hash of the file an output was copied from)
+	 */
+	auto record(
+		std::string                                  step_id,
+		std::string                                  input_hash,
+		std::vector<std::filesystem::path>           outputs,
+		std::map<std::filesystem::path, std::string> output_stamps = {}
+	) -> void;
+
+	/**
+	 * Files recorded by every step during this build
+	 */
+	auto current_outputs() const -> std::vector<std::filesystem::path>;
+
+	/**
+	 * Remove files produced by the previous build that no step produced during
+	 * this build (e.g. a source removed from a recipe.)
+	 * @returns removed files
+	 */
+	auto remove_stale_outputs() -> std::vector<std::filesystem::path>;
+
+private:
+	struct step {
+		std::string                                  input_hash;
+		std::vector<std::filesystem::path>           outputs;
+		std::map<std::filesystem::path, std::string> output_stamps;
+	};
+
+	std::filesystem::path                    _work_dir;
+	std::map<std::string, step, std::less<>> _previous_steps;
+	std::map<std::string, step, std::less<>> _current_steps;
+	std::unique_ptr<std::mutex> _current_steps_mutex =
+		std::make_unique<std::mutex>();
+
+	auto to_relative(std::filesystem::path p) const -> std::filesystem::path;
+};
+
+/**
+ * Small text file holding a hash next to a build output (e.g. `foo.o.key`)
+ * used to tell if the output is up to date.
+ */
+auto read_stamp( //
+	const std::filesystem::path& stamp_path
+) -> std::optional<std::string>;
+
+auto write_stamp( //
+	const std::filesystem::path& stamp_path,
+	std::string_view             hash
+) -> void;
+
+} // namespace ecsact::cli::cook
@@ -0,0 +1,78 @@
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+#include "ecsact/cli/commands/build/recipe/build_steps.hh"
+
+using ecsact::cli::subcommand_usage;
+using ecsact::cli::cook::build_step_recorder;
+
+static auto usage(double wall_ms, double user_ms = 0.0) -> subcommand_usage {
+	return {
+		.wall_ms = wall_ms,
+		.user_ms = user_ms,
+		.sys_ms = user_ms / 10.0,
+		.peak_rss_bytes = 1024,
+	};
+}
+
+TEST(BuildSteps, Empty) {
+	auto recorder = build_step_recorder{};
+	EXPECT_TRUE(recorder.empty());
+
+	auto report = recorder.report(10);
+	EXPECT_EQ(report.total_steps, 0);
+	EXPECT_EQ(report.total_wall_ms, 0.0);
+	EXPECT_TRUE(report.slowest.empty());
+}
+
+TEST(BuildSteps, SlowestFirstAndTruncated) {
+	auto recorder = build_step_recorder{};
+	recorder.add("compile", "a.cc", usage(100.0, 90.0));
+	recorder.add("compile", "b.cc", usage(300.0, 280.0));
+	recorder.add("link", "runtime.so", usage(200.0, 150.0));
+	EXPECT_FALSE(recorder.empty());
+
+	auto report = recorder.report(2);
+	EXPECT_EQ(report.total_steps, 3);
+	EXPECT_DOUBLE_EQ(report.total_wall_ms, 600.0);
+	EXPECT_DOUBLE_EQ(report.total_cpu_ms, 520.0 + 52.0);
+
+	ASSERT_EQ(report.slowest.size(), 2);
+	EXPECT_EQ(report.slowest[0].name, "b.cc");
+	EXPECT_EQ(report.slowest[0].kind, "compile");
+	EXPECT_EQ(report.slowest[1].name, "runtime.so");
+	EXPECT_EQ(report.slowest[1].kind, "link");
+	EXPECT_EQ(report.slowest[1].usage.peak_rss_bytes, 1024);
+}
+
+TEST(BuildSteps, TiesSortedByName) {
+	auto recorder = build_step_recorder{};
+	recorder.add("compile", "c.cc", usage(50.0));
+	recorder.add("compile", "a.cc", usage(50.0));
+	recorder.add("compile", "b.cc", usage(50.0));
+
+	auto report = recorder.report(10);
+	ASSERT_EQ(report.slowest.size(), 3);
+	EXPECT_EQ(report.slowest[0].name, "a.cc");
+	EXPECT_EQ(report.slowest[1].name, "b.cc");
+	EXPECT_EQ(report.slowest[2].name, "c.cc");
+}
+
+TEST(BuildSteps, ConcurrentAdds) {
+	auto recorder = build_step_recorder{};
+	auto threads = std::vector<std::thread>{};
+	for(auto t = 0; 4 > t; ++t) {
+		threads.emplace_back([&recorder, t] {
+			for(auto i = 0; 100 > i; ++i) {
+				recorder.add("compile", std::to_string(t * 100 + i), usage(1.0));
+			}
+		});
+	}
+
+	for(auto& thread : threads) {
+		thread.join();
+	}
+
+	EXPECT_EQ(recorder.report(1).total_steps, 400);
+}
@@ -0,0 +1,78 @@
+#include "gtest/gtest.h"
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "ecsact/cli/commands/build/recipe/byte_pipe.hh"
+
+using ecsact::cli::cook::byte_pipe;
+
+static auto as_bytes(std::string_view str) -> std::span<const std::byte> {
+	return {reinterpret_cast<const std::byte*>(str.data()), str.size()};
+}
+
+static auto read_all(byte_pipe& pipe) -> std::string {
+	auto result = std::string{};
+	for(auto chunk = pipe.read(); !chunk.empty(); chunk = pipe.read()) {
+		result.append(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+	}
+	return result;
+}
+
+TEST(BytePipe, ReadsWritesInOrder) {
+	auto pipe = byte_pipe{1024};
+	ASSERT_TRUE(pipe.write(as_bytes("hello ")));
+	ASSERT_TRUE(pipe.write(as_bytes("world")));
+	pipe.close();
+
+	EXPECT_EQ(read_all(pipe), "hello world");
+	EXPECT_TRUE(pipe.read().empty());
+}
+
+TEST(BytePipe, WriterBlocksWhileFull) {
+	auto pipe = byte_pipe{8};
+	auto expected = std::string{};
+	for(auto i = 0; 100 > i; ++i) {
+		expected += std::to_string(i);
+	}
+
+	// Far more data than fits in the pipe at once
+	auto writer = std::thread{[&] {
+		for(auto i = 0; 100 > i; ++i) {
+			auto str = std::to_string(i);
+			ASSERT_TRUE(pipe.write(as_bytes(str)));
+		}
+		pipe.close();
+	}};
+
+	EXPECT_EQ(read_all(pipe), expected);
+	writer.join();
+}
+
+TEST(BytePipe, OversizedChunkStillFits) {
+	auto pipe = byte_pipe{2};
+	auto writer = std::thread{[&] {
+		ASSERT_TRUE(pipe.write(as_bytes("larger than the pipe")));
+		pipe.close();
+	}};
+
+	EXPECT_EQ(read_all(pipe), "larger than the pipe");
+	writer.join();
+}
+
+TEST(BytePipe, CancelUnblocksWriter) {
+	auto pipe = byte_pipe{4};
+	ASSERT_TRUE(pipe.write(as_bytes("full")));
+
+	auto write_result = true;
+	auto writer = std::thread{[&] { write_result = pipe.write(as_bytes("more")); }};
+
+	pipe.cancel();
+	writer.join();
+
+	EXPECT_FALSE(write_result);
+	EXPECT_FALSE(pipe.write(as_bytes("after")));
+	EXPECT_TRUE(pipe.read().empty());
+}
@@ -0,0 +1,119 @@
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include "ecsact/cli/commands/build/cc_compiler_cache.hh"
+#include "ecsact/cli/commands/build/test/temp_dir_test.hh"
+
+namespace fs = std::filesystem;
+
+using ecsact::cli::cc_compiler;
+using ecsact::cli::cc_compiler_cache;
+using ecsact::cli::cc_compiler_type;
+
+class CcCompilerCache : public TempDirTest {
+protected:
+	fs::path compiler_path;
+
+	void SetUp() override {
+		TempDirTest::SetUp();
+
+		compiler_path = test_dir / "bin" / "clang++";
+		fs::create_directories(compiler_path.parent_path());
+		write_file(compiler_path, "not a real compiler");
+		fs::create_directories(test_dir / "include");
+		fs::create_directories(test_dir / "lib");
+	}
+
+	auto write_file(fs::path path, std::string contents) -> fs::path {
+		auto file = std::ofstream{path, std::ios_base::binary};
+		file << contents;
+		return path;
+	}
+
+	auto make_compiler() -> cc_compiler {
+		return cc_compiler{
+			.compiler_type = cc_compiler_type::clang,
+			.compiler_path = compiler_path,
+			.compiler_version = "clang version 18.1.0",
+			.install_path = compiler_path.parent_path(),
+			.std_inc_paths = {test_dir / "include"},
+			.std_lib_paths = {test_dir / "lib"},
+			.preferred_output_extension = ".so",
+			.allowed_output_extensions = {".so", ".wasm"},
+		};
+	}
+};
+
+TEST_F(CcCompilerCache, RestoresStoredCompiler) {
+	auto cache = cc_compiler_cache{test_dir / "cache"};
+	ASSERT_FALSE(cache.restore(compiler_path));
+	ASSERT_TRUE(cache.store(make_compiler()));
+
+	auto restored = cache.restore(compiler_path);
+	ASSERT_TRUE(restored);
+	auto expected = make_compiler();
+	EXPECT_EQ(restored->compiler_type, expected.compiler_type);
+	EXPECT_EQ(restored->compiler_path, fs::absolute(compiler_path));
+	EXPECT_EQ(restored->compiler_version, expected.compiler_version);
+	EXPECT_EQ(restored->install_path, expected.install_path);
+	EXPECT_EQ(restored->std_inc_paths, expected.std_inc_paths);
+	EXPECT_EQ(restored->std_lib_paths, expected.std_lib_paths);
+	EXPECT_EQ(
+		restored->preferred_output_extension,
+		expected.preferred_output_extension
+	);
+	EXPECT_EQ(
+		restored->allowed_output_extensions,
+		expected.allowed_output_extensions
+	);
+}
+
+TEST_F(CcCompilerCache, ChangedCompilerMisses) {
+	auto cache = cc_compiler_cache{test_dir / "cache"};
+	ASSERT_TRUE(cache.store(make_compiler()));
+	auto key = cc_compiler_cache::key(compiler_path);
+	ASSERT_TRUE(key);
+
+	write_file(compiler_path, "a different compiler");
+	EXPECT_NE(cc_compiler_cache::key(compiler_path), key);
+	EXPECT_FALSE(cache.restore(compiler_path));
+
+	ASSERT_TRUE(cache.store(make_compiler()));
+	auto write_time = fs::last_write_time(compiler_path);
+	fs::last_write_time(compiler_path, write_time + std::chrono::hours{1});
+	EXPECT_FALSE(cache.restore(compiler_path));
+}
+
+TEST_F(CcCompilerCache, MissingStandardDirMisses) {
+	auto cache = cc_compiler_cache{test_dir / "cache"};
+	ASSERT_TRUE(cache.store(make_compiler()));
+	ASSERT_TRUE(cache.restore(compiler_path));
+
+	fs::remove_all(test_dir / "lib");
+	EXPECT_FALSE(cache.restore(compiler_path));
+
+	fs::create_directories(test_dir / "lib");
+	fs::remove_all(test_dir / "include");
+	EXPECT_FALSE(cache.restore(compiler_path));
+}
+
+TEST_F(CcCompilerCache, MissingCompilerHasNoKey) {
+	EXPECT_FALSE(cc_compiler_cache::key(test_dir / "missing"));
+	EXPECT_FALSE(cc_compiler_cache{test_dir}.config_path(test_dir / "missing"));
+}
+
+TEST_F(CcCompilerCache, EntryIsCompilerConfig) {
+	auto cache = cc_compiler_cache{test_dir / "cache"};
+	ASSERT_TRUE(cache.store(make_compiler()));
+
+	auto config_path = cache.config_path(compiler_path);
+	ASSERT_TRUE(config_path);
+
+	auto compiler = ecsact::cli::load_compiler_config(*config_path);
+	ASSERT_TRUE(compiler);
+	EXPECT_EQ(compiler->compiler_type, cc_compiler_type::clang);
+	EXPECT_EQ(compiler->compiler_version, "clang version 18.1.0");
+}
@@ -0,0 +1,98 @@
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "ecsact/cli/commands/build/recipe/cook_runfiles.hh"
+#include "ecsact/cli/commands/build/test/temp_dir_test.hh"
+
+namespace fs = std::filesystem;
+
+using ecsact::cli::cook::runfile;
+using ecsact::cli::cook::stage_runfiles;
+
+class CookRunfiles : public TempDirTest {
+protected:
+	fs::path cache_dir;
+
+	void SetUp() override {
+		TempDirTest::SetUp();
+		cache_dir = test_dir / "cache";
+		fs::create_directories(test_dir / "runfiles");
+	}
+
+	auto write_file(fs::path path, std::string contents) -> fs::path {
+		auto file = std::ofstream{path, std::ios_base::binary};
+		file << contents;
+		return path;
+	}
+
+	auto read_file(fs::path path) -> std::string {
+		auto file = std::ifstream{path, std::ios_base::binary};
+		return std::string{std::istreambuf_iterator<char>{file}, {}};
+	}
+
+	auto make_runfiles() -> std::vector<runfile> {
+		return {
+			runfile{
+				.src = write_file(test_dir / "runfiles" / "core.h", "core"),
+				.rel_path = "ecsact/runtime/core.h",
+			},
+			runfile{
+				.src = write_file(test_dir / "runfiles" / "lib.hh", "lib"),
+				.rel_path = "ecsact/lib.hh",
+			},
+		};
+	}
+};
+
+TEST_F(CookRunfiles, StagesFiles) {
+	auto staged_dir = stage_runfiles(cache_dir, "test", make_runfiles());
+	ASSERT_TRUE(staged_dir);
+	EXPECT_EQ(read_file(*staged_dir / "ecsact/runtime/core.h"), "core");
+	EXPECT_EQ(read_file(*staged_dir / "ecsact/lib.hh"), "lib");
+}
+
+TEST_F(CookRunfiles, UnchangedRunfilesAreNotStagedAgain) {
+	auto files = make_runfiles();
+	auto staged_dir = stage_runfiles(cache_dir, "test", files);
+	ASSERT_TRUE(staged_dir);
+
+	auto staged_hdr = *staged_dir / "ecsact/runtime/core.h";
+	auto write_time = fs::last_write_time(staged_hdr);
+
+	EXPECT_EQ(stage_runfiles(cache_dir, "test", files), staged_dir);
+	EXPECT_EQ(fs::last_write_time(staged_hdr), write_time);
+}
+
+TEST_F(CookRunfiles, ChangedRunfilesAreStagedSeparately) {
+	auto files = make_runfiles();
+	auto staged_dir = stage_runfiles(cache_dir, "test", files);
+	ASSERT_TRUE(staged_dir);
+
+	write_file(files[0].src, "changed core");
+	fs::last_write_time(
+		files[0].src,
+		fs::last_write_time(files[0].src) + std::chrono::hours{1}
+	);
+
+	auto changed_staged_dir = stage_runfiles(cache_dir, "test", files);
+	ASSERT_TRUE(changed_staged_dir);
+	EXPECT_NE(changed_staged_dir, staged_dir);
+	EXPECT_EQ(
+		read_file(*changed_staged_dir / "ecsact/runtime/core.h"),
+		"changed core"
+	);
+}
+
+TEST_F(CookRunfiles, MissingRunfileFails) {
+	auto files = make_runfiles();
+	files.push_back(runfile{
+		.src = test_dir / "runfiles" / "missing.h",
+		.rel_path = "missing.h",
+	});
+
+	EXPECT_FALSE(stage_runfiles(cache_dir, "test", files));
+}
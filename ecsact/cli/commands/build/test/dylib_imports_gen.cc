@@ -0,0 +1,19 @@
+#include <fstream>
+#include <string>
+#include <vector>
+#include "ecsact/cli/commands/build/recipe/dylib_imports.hh"
+
+/**
+ * Writes the generated dylib source for the imports after the output path so
+ * dylib_imports_test can compile it
+ */
+auto main(int argc, char* argv[]) -> int {
+	if(argc < 2) {
+		return 1;
+	}
+
+	auto imports = std::vector<std::string>{argv + 2, argv + argc};
+	auto output = std::ofstream{argv[1]};
+	ecsact::cli::cook::generate_dylib_imports(imports, output);
+	return output ? 0 : 1;
+}
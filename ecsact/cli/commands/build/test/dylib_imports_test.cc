@@ -0,0 +1,118 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include "ecsact/runtime/core.h"
+
+using namespace std::string_view_literals;
+
+// Defined by the generated dylib source this test is linked with
+extern "C" auto ecsact_dylib_has_fn(const char* fn_name) -> bool;
+extern "C" auto ecsact_dylib_set_fn_addr( //
+	const char* fn_name,
+	void (*fn_ptr)()
+) -> void;
+extern "C" auto ecsact_dylib_set_fn_table(
+	const char* const* fn_names,
+	void (*const*      fn_ptrs)(),
+	int32_t            count
+) -> int32_t;
+
+/**
+ * Imports the source was generated with are the first
+ * ECSACT_DYLIB_IMPORTS_TEST_COUNT of these. They aren't sorted so the table
+ * has to sort them.
+ */
+constexpr auto all_imports = std::array{
+	"ecsact_destroy_registry"sv,
+	"ecsact_create_registry"sv,
+	"ecsact_clear_registry"sv,
+};
+
+constexpr auto imports =
+	std::span{all_imports}.first<ECSACT_DYLIB_IMPORTS_TEST_COUNT>();
+
+template<int N>
+static auto fake_fn() -> void {
+}
+
+TEST(DylibImports, HasFn) {
+	for(auto name : all_imports) {
+		auto imported = std::ranges::find(imports, name) != imports.end();
+		EXPECT_EQ(ecsact_dylib_has_fn(name.data()), imported) << name;
+	}
+
+	EXPECT_FALSE(ecsact_dylib_has_fn(""));
+	EXPECT_FALSE(ecsact_dylib_has_fn("ecsact_"));
+	EXPECT_FALSE(ecsact_dylib_has_fn("ecsact_destroy_registryy"));
+	EXPECT_FALSE(ecsact_dylib_has_fn("zzz"));
+}
+
+TEST(DylibImports, SetFnAddr) {
+	// Names that aren't imported are ignored
+	ecsact_dylib_set_fn_addr("ecsact_not_imported", &fake_fn<-1>);
+
+#if ECSACT_DYLIB_IMPORTS_TEST_COUNT > 0
+	ASSERT_EQ(ecsact_destroy_registry, nullptr);
+	ecsact_dylib_set_fn_addr("ecsact_destroy_registry", &fake_fn<0>);
+	EXPECT_EQ(
+		reinterpret_cast<void (*)()>(ecsact_destroy_registry),
+		&fake_fn<0>
+	);
+#endif
+
+#if ECSACT_DYLIB_IMPORTS_TEST_COUNT > 1
+	ASSERT_EQ(ecsact_create_registry, nullptr);
+	ASSERT_EQ(ecsact_clear_registry, nullptr);
+	ecsact_dylib_set_fn_addr("ecsact_create_registry", &fake_fn<1>);
+	ecsact_dylib_set_fn_addr("ecsact_clear_registry", &fake_fn<2>);
+	EXPECT_EQ(
+		reinterpret_cast<void (*)()>(ecsact_create_registry),
+		&fake_fn<1>
+	);
+	EXPECT_EQ(reinterpret_cast<void (*)()>(ecsact_clear_registry), &fake_fn<2>);
+	EXPECT_EQ(
+		reinterpret_cast<void (*)()>(ecsact_destroy_registry),
+		&fake_fn<0>
+	);
+#endif
+}
+
+TEST(DylibImports, SetFnTable) {
+	const char* fn_names[] = {
+		"ecsact_clear_registry",
+		"ecsact_not_imported",
+		"ecsact_destroy_registry",
+		"ecsact_create_registry",
+	};
+	void (*fn_ptrs[])() = {
+		&fake_fn<12>,
+		&fake_fn<-1>,
+		&fake_fn<10>,
+		&fake_fn<11>,
+	};
+
+	auto bound_count = ecsact_dylib_set_fn_table(fn_names, fn_ptrs, 4);
+	ASSERT_EQ(bound_count, static_cast<int32_t>(imports.size()));
+
+#if ECSACT_DYLIB_IMPORTS_TEST_COUNT > 0
+	EXPECT_EQ(
+		reinterpret_cast<void (*)()>(ecsact_destroy_registry),
+		&fake_fn<10>
+	);
+#endif
+
+#if ECSACT_DYLIB_IMPORTS_TEST_COUNT > 1
+	EXPECT_EQ(
+		reinterpret_cast<void (*)()>(ecsact_create_registry),
+		&fake_fn<11>
+	);
+	EXPECT_EQ(
+		reinterpret_cast<void (*)()>(ecsact_clear_registry),
+		&fake_fn<12>
+	);
+#endif
+}
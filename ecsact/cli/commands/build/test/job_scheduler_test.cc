@@ -0,0 +1,106 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include "ecsact/cli/commands/build/recipe/job_scheduler.hh"
+
+using ecsact::cli::cook::job_scheduler;
+using ecsact::cli::cook::parse_jobserver_auth;
+
+TEST(JobScheduler, ReturnsExitCodesByIndex) {
+	auto scheduler = job_scheduler{{.max_jobs = 4, .use_jobserver = false}};
+	auto exit_codes = scheduler.run(10, [](std::size_t index) {
+		return static_cast<int>(index);
+	});
+
+	ASSERT_EQ(exit_codes.size(), 10);
+	for(auto i = 0; exit_codes.size() > i; ++i) {
+		ASSERT_EQ(exit_codes[i], i);
+	}
+}
+
+TEST(JobScheduler, NeverExceedsMaxJobs) {
+	auto scheduler = job_scheduler{{.max_jobs = 3, .use_jobserver = false}};
+	auto running = std::atomic_int{};
+	auto max_running = std::atomic_int{};
+
+	scheduler.run(20, [&](std::size_t) {
+		auto now_running = running.fetch_add(1) + 1;
+		auto prev_max = max_running.load();
+		while(now_running > prev_max &&
+					!max_running.compare_exchange_weak(prev_max, now_running)) {
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds{5});
+		running -= 1;
+		return 0;
+	});
+
+	ASSERT_LE(max_running.load(), 3);
+	ASSERT_GE(max_running.load(), 1);
+}
+
+TEST(JobScheduler, HugeMemoryEstimateStillRunsEveryJob) {
+	auto scheduler = job_scheduler{{
+		.max_jobs = 8,
+		.job_memory_estimate = std::uint64_t{1} << 62,
+		.use_jobserver = false,
+	}};
+	auto ran = std::atomic_int{};
+
+	scheduler.run(5, [&](std::size_t) {
+		ran += 1;
+		return 0;
+	});
+
+	ASSERT_EQ(ran.load(), 5);
+}
+
+TEST(JobScheduler, ThrowingJobFailsWithoutBlockingOthers) {
+	auto scheduler = job_scheduler{{.max_jobs = 1, .use_jobserver = false}};
+	auto exit_codes = scheduler.run(3, [](std::size_t index) -> int {
+		if(index == 0) {
+			throw std::runtime_error{"job failed"};
+		}
+		return 0;
+	});
+
+	ASSERT_EQ(exit_codes, (std::vector{1, 0, 0}));
+}
+
+TEST(JobScheduler, ParseJobserverFds) {
+	auto auth = parse_jobserver_auth("-j8 --jobserver-auth=3,4");
+	ASSERT_TRUE(auth);
+	ASSERT_EQ(auth->read_fd, 3);
+	ASSERT_EQ(auth->write_fd, 4);
+	ASSERT_FALSE(auth->fifo_path);
+}
+
+TEST(JobScheduler, ParseJobserverLegacyFds) {
+	auto auth = parse_jobserver_auth("--jobserver-fds=5,6 -j");
+	ASSERT_TRUE(auth);
+	ASSERT_EQ(auth->read_fd, 5);
+	ASSERT_EQ(auth->write_fd, 6);
+}
+
+TEST(JobScheduler, ParseJobserverFifo) {
+	auto auth = parse_jobserver_auth("-j4 --jobserver-auth=fifo:/tmp/GMfifo1");
+	ASSERT_TRUE(auth);
+	ASSERT_EQ(auth->fifo_path, "/tmp/GMfifo1");
+}
+
+TEST(JobScheduler, ParseJobserverLastWins) {
+	auto auth = parse_jobserver_auth(
+		"--jobserver-auth=3,4 --jobserver-auth=fifo:/tmp/GMfifo2"
+	);
+	ASSERT_TRUE(auth);
+	ASSERT_EQ(auth->fifo_path, "/tmp/GMfifo2");
+}
+
+TEST(JobScheduler, ParseNoJobserver) {
+	ASSERT_FALSE(parse_jobserver_auth(""));
+	ASSERT_FALSE(parse_jobserver_auth("-j4 -k"));
+	ASSERT_FALSE(parse_jobserver_auth("--jobserver-auth=-1,-1"));
+}
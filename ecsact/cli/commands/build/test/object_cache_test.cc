@@ -0,0 +1,105 @@
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "ecsact/cli/commands/build/recipe/object_cache.hh"
+#include "ecsact/cli/commands/build/test/temp_dir_test.hh"
+
+namespace fs = std::filesystem;
+
+using ecsact::cli::cc_compiler;
+using ecsact::cli::cc_compiler_type;
+using ecsact::cli::cook::object_cache;
+
+class ObjectCache : public TempDirTest {
+protected:
+	auto write_file(fs::path path, std::string contents) -> fs::path {
+		auto file = std::ofstream{path, std::ios_base::binary};
+		file << contents;
+		return path;
+	}
+
+	auto read_file(fs::path path) -> std::string {
+		auto file = std::ifstream{path, std::ios_base::binary};
+		return std::string{std::istreambuf_iterator<char>{file}, {}};
+	}
+};
+
+static auto as_bytes(std::string_view str) -> std::vector<std::byte> {
+	auto bytes = reinterpret_cast<const std::byte*>(str.data());
+	return {bytes, bytes + str.size()};
+}
+
+static auto test_compiler() -> cc_compiler {
+	return cc_compiler{
+		.compiler_type = cc_compiler_type::clang,
+		.compiler_path = "/does/not/exist/clang",
+		.compiler_version = "17.0.0",
+	};
+}
+
+TEST_F(ObjectCache, KeyChangesWithInputs) {
+	auto cache = object_cache{test_dir / "cache"};
+	auto args = std::vector<std::string>{"-O3", "-c", "a.cc"};
+	auto src = as_bytes("int a = 1;");
+
+	auto base_key = cache.key(test_compiler(), "work", args, src);
+	ASSERT_EQ(base_key, cache.key(test_compiler(), "work", args, src));
+
+	auto other_src = as_bytes("int a = 2;");
+	ASSERT_NE(base_key, cache.key(test_compiler(), "work", args, other_src));
+
+	auto other_args = std::vector<std::string>{"-O2", "-c", "a.cc"};
+	ASSERT_NE(base_key, cache.key(test_compiler(), "work", other_args, src));
+
+	auto other_compiler = test_compiler();
+	other_compiler.compiler_version = "18.0.0";
+	ASSERT_NE(base_key, cache.key(other_compiler, "work", args, src));
+
+	// arguments must not be confused when concatenated
+	auto split_args = std::vector<std::string>{"-O", "3-c", "a.cc"};
+	ASSERT_NE(base_key, cache.key(test_compiler(), "work", split_args, src));
+}
+
+TEST_F(ObjectCache, MissThenHit) {
+	auto cache = object_cache{test_dir / "cache"};
+	auto key = cache.key(test_compiler(), "work", {}, as_bytes("int a;"));
+	auto restored_path = test_dir / "out" / "a.o";
+
+	ASSERT_FALSE(cache.restore(key, restored_path));
+	ASSERT_FALSE(fs::exists(restored_path));
+
+	auto obj_path = write_file(test_dir / "a.o", "object contents");
+	ASSERT_TRUE(cache.store(key, obj_path));
+
+	ASSERT_TRUE(cache.restore(key, restored_path));
+	ASSERT_EQ(read_file(restored_path), "object contents");
+}
+
+TEST_F(ObjectCache, KeyIgnoresWorkDir) {
+	auto key_in = [&](fs::path work_dir, std::string_view marker_dir) {
+		auto args = std::vector<std::string>{
+			"-I" + (work_dir / "include").generic_string(),
+			"-c",
+			"a.cc",
+		};
+		auto src = std::format("# 1 \"{}/include/a.hh\"\nint a;", marker_dir);
+		return object_cache::key(test_compiler(), work_dir, args, as_bytes(src));
+	};
+
+	auto work_a = test_dir / "a";
+	auto work_b = test_dir / "b";
+	ASSERT_EQ(
+		key_in(work_a, work_a.generic_string()),
+		key_in(work_b, work_b.generic_string())
+	);
+
+	// Paths outside the work directory still matter
+	ASSERT_NE(
+		key_in(work_a, work_a.generic_string()),
+		key_in(work_a, work_b.generic_string())
+	);
+}
@@ -0,0 +1,66 @@
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+#include "ecsact/cli/commands/build/recipe/pgo.hh"
+
+namespace fs = std::filesystem;
+
+using ecsact::cli::cook::collect_raw_profiles;
+using ecsact::cli::cook::llvm_profdata_candidates;
+
+#ifdef _WIN32
+#	define EXE ".exe"
+#else
+#	define EXE ""
+#endif
+
+TEST(Pgo, VersionedCompilerPrefersVersionedProfdata) {
+	auto candidates = llvm_profdata_candidates("/usr/bin/clang++-18" EXE);
+	ASSERT_EQ(
+		candidates,
+		(std::vector<fs::path>{
+			"/usr/bin/llvm-profdata-18" EXE,
+			"/usr/bin/llvm-profdata" EXE,
+			"llvm-profdata-18" EXE,
+			"llvm-profdata" EXE,
+		})
+	);
+}
+
+TEST(Pgo, UnversionedCompiler) {
+	auto candidates = llvm_profdata_candidates("/opt/llvm/bin/clang" EXE);
+	ASSERT_EQ(
+		candidates,
+		(std::vector<fs::path>{
+			"/opt/llvm/bin/llvm-profdata" EXE,
+			"llvm-profdata" EXE,
+		})
+	);
+}
+
+TEST(Pgo, CompilerOnPath) {
+	auto candidates = llvm_profdata_candidates("clang" EXE);
+	ASSERT_EQ(candidates, (std::vector<fs::path>{"llvm-profdata" EXE}));
+}
+
+TEST(Pgo, CollectRawProfiles) {
+	auto dir = fs::temp_directory_path() / "ecsact_pgo_test";
+	fs::remove_all(dir);
+	fs::create_directories(dir);
+	std::ofstream{dir / "b.profraw"};
+	std::ofstream{dir / "a.profraw"};
+	std::ofstream{dir / "notes.txt"};
+
+	ASSERT_EQ(
+		collect_raw_profiles(dir),
+		(std::vector<fs::path>{dir / "a.profraw", dir / "b.profraw"})
+	);
+	ASSERT_EQ(
+		collect_raw_profiles(dir / "a.profraw"),
+		(std::vector<fs::path>{dir / "a.profraw"})
+	);
+	ASSERT_TRUE(collect_raw_profiles(dir / "missing").empty());
+
+	fs::remove_all(dir);
+}
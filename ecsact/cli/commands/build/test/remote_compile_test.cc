@@ -0,0 +1,305 @@
+#include "gtest/gtest.h"
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include "ecsact/cli/commands/build/recipe/remote_compile.hh"
+#include "ecsact/cli/commands/build/test/socket_test.hh"
+
+namespace fs = std::filesystem;
+
+using ecsact::cli::cc_compiler;
+using ecsact::cli::cc_compiler_type;
+using ecsact::cli::cook::is_allowed_remote_compile_arg;
+using ecsact::cli::cook::receive_compile_request;
+using ecsact::cli::cook::receive_compile_result;
+using ecsact::cli::cook::receive_worker_info;
+using ecsact::cli::cook::remote_compile_request;
+using ecsact::cli::cook::remote_compile_result;
+using ecsact::cli::cook::remote_executor_pool;
+using ecsact::cli::cook::remote_worker_info;
+using ecsact::cli::cook::run_remote_compile_request;
+using ecsact::cli::cook::send_compile_request;
+using ecsact::cli::cook::send_compile_result;
+using ecsact::cli::cook::send_worker_info;
+using ecsact::cli::detail::read_frame;
+using ecsact::cli::detail::socket_connection;
+using ecsact::cli::detail::socket_endpoint;
+using ecsact::cli::detail::socket_listener;
+
+TEST(RemoteCompile, ParseEndpoints) {
+	auto tcp = socket_endpoint::parse("build-box:9000");
+	ASSERT_TRUE(tcp);
+	EXPECT_FALSE(tcp->is_unix());
+	EXPECT_EQ(tcp->host, "build-box");
+	EXPECT_EQ(tcp->port, 9000);
+
+	auto local = socket_endpoint::parse(":9000");
+	ASSERT_TRUE(local);
+	EXPECT_EQ(local->host, "localhost");
+
+	auto unix_prefixed = socket_endpoint::parse("unix:worker.sock");
+	ASSERT_TRUE(unix_prefixed);
+	EXPECT_TRUE(unix_prefixed->is_unix());
+	EXPECT_EQ(unix_prefixed->unix_path, fs::path{"worker.sock"});
+
+	auto unix_path = socket_endpoint::parse("/tmp/worker.sock");
+	ASSERT_TRUE(unix_path);
+	EXPECT_TRUE(unix_path->is_unix());
+
+	EXPECT_FALSE(socket_endpoint::parse(""));
+	EXPECT_FALSE(socket_endpoint::parse("build-box:notaport"));
+	EXPECT_FALSE(socket_endpoint::parse("build-box:70000"));
+}
+
+TEST(RemoteCompile, ListenKeepsFilesThatAreNotSockets) {
+	auto endpoint = test_socket_endpoint("not_a_socket");
+	std::ofstream{endpoint.unix_path} << "notes";
+
+	auto ec = std::error_code{};
+	auto listener = socket_listener::listen(endpoint, ec);
+	EXPECT_EQ(ec, std::make_error_code(std::errc::file_exists));
+	EXPECT_FALSE(listener);
+	EXPECT_TRUE(fs::is_regular_file(endpoint.unix_path));
+
+	fs::remove(endpoint.unix_path);
+}
+
+TEST(RemoteCompile, ListenReplacesStaleSocket) {
+	auto endpoint = test_socket_endpoint("stale");
+	auto ec = std::error_code{};
+	{
+		auto listener = socket_listener::listen(endpoint, ec);
+		ASSERT_FALSE(ec) << ec.message();
+		// Moved away so closing the listener leaves the socket file behind
+		fs::rename(endpoint.unix_path, endpoint.unix_path.string() + ".tmp");
+	}
+	fs::rename(endpoint.unix_path.string() + ".tmp", endpoint.unix_path);
+
+	auto listener = socket_listener::listen(endpoint, ec);
+	EXPECT_FALSE(ec) << ec.message();
+	EXPECT_TRUE(listener);
+}
+
+#ifndef _WIN32
+TEST(RemoteCompile, UnixSocketIsOwnerOnly) {
+	auto endpoint = test_socket_endpoint("owner_only");
+	auto ec = std::error_code{};
+	auto listener = socket_listener::listen(endpoint, ec);
+	ASSERT_FALSE(ec) << ec.message();
+
+	auto perms = fs::status(endpoint.unix_path).permissions();
+	EXPECT_EQ(perms, fs::perms::owner_read | fs::perms::owner_write);
+}
+#endif
+
+TEST(RemoteCompile, FrameLargerThanSentFails) {
+	auto endpoint = test_socket_endpoint("short_frame");
+	auto ec = std::error_code{};
+	auto listener = socket_listener::listen(endpoint, ec);
+	ASSERT_FALSE(ec) << ec.message();
+
+	auto peer = std::thread{[&] {
+		auto connect_ec = std::error_code{};
+		auto conn = socket_connection::connect(endpoint, connect_ec);
+		if(connect_ec) {
+			return;
+		}
+
+		// Claims a 1 GiB frame and sends 4 bytes of it
+		auto size_bytes = std::array<std::byte, 8>{};
+		size_bytes[3] = std::byte{0x40};
+		conn.write_all(size_bytes);
+		conn.write_all(bytes("data"));
+	}};
+
+	auto conn = listener.accept(ec);
+	ASSERT_FALSE(ec) << ec.message();
+	peer.join();
+
+	auto data = std::vector<std::byte>{};
+	EXPECT_FALSE(read_frame(conn, std::uint64_t{1} << 31, data));
+	EXPECT_LT(data.capacity(), std::size_t{1} << 30);
+}
+
+TEST(RemoteCompile, AllowedArgs) {
+	auto allowed_args = std::vector<std::string>{
+		"-O3",
+		"-std=c++20",
+		"-stdlib=libc++",
+		"-fPIC",
+		"-static",
+		"-fprofile-generate",
+		"-fvisibility=hidden",
+		"-fvisibility-inlines-hidden",
+		"-ffunction-sections",
+		"-fexperimental-library",
+	};
+	for(auto& arg : allowed_args) {
+		EXPECT_TRUE(is_allowed_remote_compile_arg(arg)) << arg;
+	}
+
+	auto rejected_args = std::vector<std::string>{
+		"-fplugin=evil.so",
+		"-fpass-plugin=evil.so",
+		"-fplugin",
+		"-fprofile-generate=/tmp",
+		"-B/tmp",
+		"-Xclang",
+		"-load",
+		"-o",
+		"-std=c++20 -fplugin=evil.so",
+		"-std=../../x",
+		"-isystem",
+		"-include/etc/passwd",
+		"@args.rsp",
+		"input.ii",
+		"",
+	};
+	for(auto& arg : rejected_args) {
+		EXPECT_FALSE(is_allowed_remote_compile_arg(arg)) << arg;
+	}
+}
+
+TEST(RemoteCompile, RejectedArgsNeverRunTheCompiler) {
+	auto compiler = cc_compiler{
+		.compiler_type = cc_compiler_type::clang,
+		.compiler_path = "compiler-that-does-not-exist",
+		.compiler_version = "18.1.0",
+	};
+	auto scratch_dir =
+		fs::temp_directory_path() / "ecsact_remote_compile_test" / "rejected";
+
+	auto result = run_remote_compile_request(
+		compiler,
+		{
+			.args = {"-O2", "-Xclang", "-load", "-Xclang", "evil.so"},
+			.preprocessed_source = bytes("int main() { return 0; }"),
+		},
+		scratch_dir
+	);
+	EXPECT_NE(result.exit_code, 0);
+	EXPECT_NE(result.output.find("-Xclang"), std::string::npos);
+	EXPECT_TRUE(result.object.empty());
+	EXPECT_FALSE(fs::exists(scratch_dir));
+}
+
+TEST(RemoteCompile, RequestAndResultRoundTrip) {
+	auto endpoint = test_socket_endpoint("round_trip");
+	auto ec = std::error_code{};
+	auto listener = socket_listener::listen(endpoint, ec);
+	ASSERT_FALSE(ec) << ec.message();
+
+	auto received_request = std::optional<remote_compile_request>{};
+	auto worker = std::thread{[&] {
+		auto accept_ec = std::error_code{};
+		auto conn = listener.accept(accept_ec);
+		if(accept_ec) {
+			return;
+		}
+
+		send_worker_info(
+			conn,
+			{
+				.compiler_type = "clang",
+				.compiler_version = "18.1.0",
+				.slots = 4,
+			}
+		);
+		received_request = receive_compile_request(conn);
+		send_compile_result(
+			conn,
+			{
+				.exit_code = 0,
+				.output = "warning: example",
+				.object = bytes("\x7f" "ELF object"),
+			}
+		);
+	}};
+
+	auto conn = socket_connection::connect(endpoint, ec);
+	ASSERT_FALSE(ec) << ec.message();
+
+	auto info = receive_worker_info(conn);
+	ASSERT_TRUE(info);
+	EXPECT_EQ(info->compiler_type, "clang");
+	EXPECT_EQ(info->compiler_version, "18.1.0");
+	EXPECT_EQ(info->slots, 4);
+
+	auto request = remote_compile_request{
+		.args = {"-std=c++20", "-O2", "-fPIC"},
+		.preprocessed_source = bytes("int main() { return 0; }"),
+	};
+	ASSERT_TRUE(send_compile_request(conn, request));
+
+	auto result = receive_compile_result(conn);
+	worker.join();
+
+	ASSERT_TRUE(received_request);
+	EXPECT_EQ(received_request->args, request.args);
+	EXPECT_EQ(
+		received_request->preprocessed_source,
+		request.preprocessed_source
+	);
+
+	ASSERT_TRUE(result);
+	EXPECT_EQ(result->exit_code, 0);
+	EXPECT_EQ(result->output, "warning: example");
+	EXPECT_EQ(result->object, bytes("\x7f" "ELF object"));
+}
+
+TEST(RemoteCompile, ClosedConnectionIsNotAResult) {
+	auto endpoint = test_socket_endpoint("closed");
+	auto ec = std::error_code{};
+	auto listener = socket_listener::listen(endpoint, ec);
+	ASSERT_FALSE(ec) << ec.message();
+
+	auto worker = std::thread{[&] {
+		auto accept_ec = std::error_code{};
+		auto conn = listener.accept(accept_ec);
+		// Closed without sending anything
+	}};
+
+	auto conn = socket_connection::connect(endpoint, ec);
+	ASSERT_FALSE(ec) << ec.message();
+	worker.join();
+
+	EXPECT_FALSE(receive_worker_info(conn));
+}
+
+TEST(RemoteCompile, PoolSkipsMismatchedAndUnreachableWorkers) {
+	auto endpoint = test_socket_endpoint("mismatch");
+	auto ec = std::error_code{};
+	auto listener = socket_listener::listen(endpoint, ec);
+	ASSERT_FALSE(ec) << ec.message();
+
+	auto worker = std::thread{[&] {
+		auto accept_ec = std::error_code{};
+		auto conn = listener.accept(accept_ec);
+		if(!accept_ec) {
+			send_worker_info(
+				conn,
+				{
+					.compiler_type = "gcc",
+					.compiler_version = "13.2.0",
+					.slots = 8,
+				}
+			);
+		}
+	}};
+
+	auto compiler = cc_compiler{
+		.compiler_type = cc_compiler_type::clang,
+		.compiler_path = "clang++",
+		.compiler_version = "18.1.0",
+	};
+	auto pool = remote_executor_pool{
+		{endpoint, test_socket_endpoint("nobody_listening")},
+		compiler,
+	};
+	worker.join();
+
+	EXPECT_EQ(pool.slot_count(), 0);
+	EXPECT_FALSE(pool.try_compile({}));
+}
@@ -0,0 +1,110 @@
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "ecsact/cli/commands/build/recipe/repository_cache.hh"
+#include "ecsact/cli/commands/build/test/temp_dir_test.hh"
+
+namespace fs = std::filesystem;
+
+using ecsact::cli::cook::repository_cache;
+using ecsact::cli::detail::integrity;
+
+using RepositoryCache = TempDirTest;
+
+static auto as_bytes(std::string_view str) -> std::vector<std::byte> {
+	auto bytes = reinterpret_cast<const std::byte*>(str.data());
+	return {bytes, bytes + str.size()};
+}
+
+TEST_F(RepositoryCache, IntegrityKeyIgnoresUrl) {
+	auto data = as_bytes("archive contents");
+	auto data_integrity = integrity::from_bytes(integrity::sha256, data);
+
+	auto a = repository_cache::key(data_integrity, "https://a.example/x.tar.gz");
+	auto b = repository_cache::key(data_integrity, "https://b.example/y.tar.gz");
+	EXPECT_EQ(a, b);
+	EXPECT_TRUE(a.starts_with("sha256-"));
+	EXPECT_EQ(a.size(), std::string_view{"sha256-"}.size() + 64);
+	EXPECT_EQ(a.find_first_of("/\\+="), std::string::npos);
+}
+
+TEST_F(RepositoryCache, UrlKeyWithoutIntegrity) {
+	auto a = repository_cache::key(std::nullopt, "https://a.example/x.tar.gz");
+	auto b = repository_cache::key(std::nullopt, "https://a.example/y.tar.gz");
+	EXPECT_NE(a, b);
+	EXPECT_TRUE(a.starts_with("url-"));
+	EXPECT_EQ(
+		a,
+		repository_cache::key(std::nullopt, "https://a.example/x.tar.gz")
+	);
+}
+
+TEST_F(RepositoryCache, StoreAndRestore) {
+	auto cache = repository_cache{test_dir};
+	auto data = as_bytes("archive contents");
+	auto key = repository_cache::key(
+		integrity::from_bytes(integrity::sha256, data),
+		"https://a.example/x.tar.gz"
+	);
+
+	EXPECT_FALSE(cache.restore(key));
+	ASSERT_TRUE(cache.store(key, data));
+
+	auto restored = cache.restore(key);
+	ASSERT_TRUE(restored);
+	EXPECT_EQ(*restored, data);
+
+	cache.remove(key);
+	EXPECT_FALSE(cache.restore(key));
+}
+
+TEST_F(RepositoryCache, EmptyDownload) {
+	auto cache = repository_cache{test_dir};
+	auto key = repository_cache::key(std::nullopt, "https://a.example/empty");
+
+	ASSERT_TRUE(cache.store(key, {}));
+	auto restored = cache.restore(key);
+	ASSERT_TRUE(restored);
+	EXPECT_TRUE(restored->empty());
+}
+
+TEST_F(RepositoryCache, StreamedEntry) {
+	auto cache = repository_cache{test_dir};
+	auto data = as_bytes("archive contents");
+	auto key = repository_cache::key(std::nullopt, "https://a.example/x.tar.gz");
+	auto other_key = repository_cache::key(
+		integrity::from_bytes(integrity::sha256, data),
+		"https://a.example/x.tar.gz"
+	);
+
+	{
+		auto writer = cache.begin_store();
+		writer.write(std::span{data}.first(7));
+		writer.write(std::span{data}.subspan(7));
+		EXPECT_FALSE(cache.restore_path(key));
+		ASSERT_TRUE(writer.commit(key));
+		ASSERT_TRUE(writer.commit(other_key));
+	}
+
+	EXPECT_TRUE(cache.restore_path(key));
+	EXPECT_EQ(cache.restore(key), data);
+	EXPECT_EQ(cache.restore(other_key), data);
+}
+
+TEST_F(RepositoryCache, UncommittedEntryIsRemoved) {
+	auto cache = repository_cache{test_dir};
+	auto key = repository_cache::key(std::nullopt, "https://a.example/x.tar.gz");
+
+	{
+		auto writer = cache.begin_store();
+		writer.write(as_bytes("partial download"));
+	}
+
+	EXPECT_FALSE(cache.restore_path(key));
+	for(auto& entry : fs::recursive_directory_iterator(test_dir)) {
+		EXPECT_FALSE(entry.is_regular_file()) << entry.path();
+	}
+}
@@ -0,0 +1,91 @@
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "ecsact/cli/commands/build/recipe/response_file.hh"
+
+using ecsact::cli::cook::quote_gnu_response_file_arg;
+using ecsact::cli::cook::write_gnu_response_file;
+
+namespace fs = std::filesystem;
+
+/**
+ * Splits a response file the way GNU style drivers do. A backslash escapes
+ * the next character and double quotes group characters including spaces.
+ */
+static auto tokenize_gnu(const std::string& contents)
+	-> std::vector<std::string> {
+	auto tokens = std::vector<std::string>{};
+	auto token = std::string{};
+	auto in_token = false;
+	auto in_quotes = false;
+
+	for(auto i = std::size_t{0}; contents.size() > i; ++i) {
+		auto c = contents[i];
+		if(c == '\\' && contents.size() > i + 1) {
+			token.push_back(contents[++i]);
+			in_token = true;
+		} else if(c == '"') {
+			in_quotes = !in_quotes;
+			in_token = true;
+		} else if(!in_quotes && (c == ' ' || c == '\n')) {
+			if(in_token) {
+				tokens.push_back(std::move(token));
+				token.clear();
+				in_token = false;
+			}
+		} else {
+			token.push_back(c);
+			in_token = true;
+		}
+	}
+
+	if(in_token) {
+		tokens.push_back(std::move(token));
+	}
+
+	return tokens;
+}
+
+TEST(ResponseFile, QuotesPlainArg) {
+	ASSERT_EQ(quote_gnu_response_file_arg("-O2"), "\"-O2\"");
+	ASSERT_EQ(quote_gnu_response_file_arg(""), "\"\"");
+}
+
+TEST(ResponseFile, EscapesBackslashesAndQuotes) {
+	ASSERT_EQ(
+		quote_gnu_response_file_arg(R"(C:\Program Files\lib)"),
+		R"("C:\\Program Files\\lib")"
+	);
+	ASSERT_EQ(
+		quote_gnu_response_file_arg(R"(-DNAME="a b")"),
+		R"("-DNAME=\"a b\"")"
+	);
+}
+
+TEST(ResponseFile, RoundTrip) {
+	auto args = std::vector<std::string>{
+		"-o",
+		R"(C:\Users\Some One\out dir\runtime.dll)",
+		R"(intermediate\obj\foo bar.o)",
+		R"(-LC:\Program Files\LLVM\lib)",
+		R"(\\server\share\lib.a)",
+		R"(-DQUOTED="x\y")",
+		"",
+	};
+
+	auto response_file_path =
+		fs::path{testing::TempDir()} / "ecsact_response_file_test.rsp";
+	write_gnu_response_file(response_file_path, args);
+
+	auto contents = std::string{};
+	{
+		auto file = std::ifstream{response_file_path, std::ios::binary};
+		contents.assign(std::istreambuf_iterator<char>{file}, {});
+	}
+	fs::remove(response_file_path);
+
+	ASSERT_EQ(tokenize_gnu(contents), args);
+}
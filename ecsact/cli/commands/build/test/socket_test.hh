@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <format>
+#include <string_view>
+#include <vector>
+#include "gtest/gtest.h"
+#include "ecsact/cli/detail/socket.hh"
+
+/**
+ * Unix socket endpoint in the temp directory. Named after the running test
+ * suite and @p name so test binaries running at once never share one.
+ */
+inline auto test_socket_endpoint( //
+	std::string_view name
+) -> ecsact::cli::detail::socket_endpoint {
+	auto test_info = testing::UnitTest::GetInstance()->current_test_info();
+	auto dir = std::filesystem::temp_directory_path() / "ecsact_socket_test";
+	std::filesystem::create_directories(dir);
+	return ecsact::cli::detail::socket_endpoint{
+		.unix_path =
+			dir / std::format("{}_{}.sock", test_info->test_suite_name(), name),
+	};
+}
+
+inline auto bytes(std::string_view str) -> std::vector<std::byte> {
+	auto result = std::vector<std::byte>{};
+	for(auto c : str) {
+		result.push_back(static_cast<std::byte>(c));
+	}
+	return result;
+}
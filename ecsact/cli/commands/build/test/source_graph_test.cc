@@ -0,0 +1,121 @@
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+#include "ecsact/cli/commands/build/recipe/source_graph.hh"
+
+using namespace std::chrono_literals;
+
+using ecsact::cli::cook::run_source_graph;
+using ecsact::cli::cook::source_dependencies;
+using ecsact::cli::cook::source_graph_node;
+
+using dependency_list = std::vector<std::vector<std::size_t>>;
+
+TEST(SourceGraph, DisjointOutdirsAreIndependent) {
+	auto nodes = std::vector<source_graph_node>{
+		{.outdir = "work/a"},
+		{.outdir = "work/b"},
+		{.outdir = "work/ab"},
+	};
+
+	EXPECT_EQ(source_dependencies(nodes), (dependency_list{{}, {}, {}}));
+}
+
+TEST(SourceGraph, OverlappingOutdirsAreOrdered) {
+	auto nodes = std::vector<source_graph_node>{
+		{.outdir = "work/a"},
+		{.outdir = "work/a/nested"},
+		{.outdir = "work/b/"},
+		{.outdir = "work/./b"},
+		{.outdir = "work"},
+	};
+
+	EXPECT_EQ(
+		source_dependencies(nodes),
+		(dependency_list{{}, {0}, {}, {2}, {0, 1, 2, 3}})
+	);
+}
+
+TEST(SourceGraph, ExclusiveSourcesAreChained) {
+	auto nodes = std::vector<source_graph_node>{
+		{.outdir = "work/a", .exclusive = true},
+		{.outdir = "work/b"},
+		{.outdir = "work/c", .exclusive = true},
+		{.outdir = "work/d", .exclusive = true},
+	};
+
+	EXPECT_EQ(source_dependencies(nodes), (dependency_list{{}, {}, {0}, {2}}));
+}
+
+TEST(SourceGraph, RunsDependenciesFirst) {
+	auto deps = dependency_list{{}, {0}, {1}, {}, {2, 3}};
+	auto mutex = std::mutex{};
+	auto order = std::vector<std::size_t>{};
+
+	auto results = run_source_graph(deps, 4, [&](std::size_t index) {
+		auto lk = std::lock_guard{mutex};
+		order.push_back(index);
+		return 0;
+	});
+
+	ASSERT_EQ(order.size(), deps.size());
+	auto position = std::vector<std::size_t>(deps.size());
+	for(auto i = std::size_t{}; order.size() > i; ++i) {
+		position[order[i]] = i;
+	}
+
+	for(auto i = std::size_t{}; deps.size() > i; ++i) {
+		EXPECT_EQ(results[i], 0);
+		for(auto dep : deps[i]) {
+			EXPECT_LT(position[dep], position[i]);
+		}
+	}
+}
+
+TEST(SourceGraph, RunsIndependentSourcesConcurrently) {
+	auto mutex = std::mutex{};
+	auto cv = std::condition_variable{};
+	auto arrived = 0;
+
+	// Each job waits for the other one so this only passes if both run at once
+	auto results = run_source_graph({{}, {}}, 2, [&](std::size_t) {
+		auto lk = std::unique_lock{mutex};
+		arrived += 1;
+		cv.notify_all();
+		return cv.wait_for(lk, 10s, [&] { return arrived == 2; }) ? 0 : 1;
+	});
+
+	EXPECT_EQ(results[0], 0);
+	EXPECT_EQ(results[1], 0);
+}
+
+TEST(SourceGraph, FailureSkipsDependents) {
+	auto deps = dependency_list{{}, {0}, {1}};
+	auto calls = std::atomic_int{};
+
+	auto results = run_source_graph(deps, 2, [&](std::size_t index) {
+		calls += 1;
+		return index == 0 ? 3 : 0;
+	});
+
+	EXPECT_EQ(calls, 1);
+	EXPECT_EQ(results[0], 3);
+	EXPECT_FALSE(results[1]);
+	EXPECT_FALSE(results[2]);
+}
+
+TEST(SourceGraph, SingleJobRunsInOrder) {
+	auto order = std::vector<std::size_t>{};
+
+	auto results = run_source_graph({{}, {}, {}}, 1, [&](std::size_t index) {
+		order.push_back(index);
+		return 0;
+	});
+
+	EXPECT_EQ(order, (std::vector<std::size_t>{0, 1, 2}));
+	EXPECT_EQ(results.size(), 3);
+}
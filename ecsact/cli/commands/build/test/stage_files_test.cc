@@ -0,0 +1,83 @@
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "ecsact/cli/commands/build/recipe/stage_files.hh"
+#include "ecsact/cli/commands/build/test/temp_dir_test.hh"
+
+namespace fs = std::filesystem;
+
+using ecsact::cli::cook::stage_file;
+using ecsact::cli::cook::staged_file_stamp;
+
+class StageFiles : public TempDirTest {
+protected:
+	auto write(fs::path rel_path, std::string_view contents) -> fs::path {
+		auto path = test_dir / rel_path;
+		std::ofstream{path, std::ios_base::binary} << contents;
+		return path;
+	}
+
+	auto read(fs::path path) -> std::string {
+		auto stream = std::stringstream{};
+		stream << std::ifstream{path, std::ios_base::binary}.rdbuf();
+		return stream.str();
+	}
+};
+
+TEST_F(StageFiles, StagesContents) {
+	auto src = write("src.cc", "int main() {}");
+	auto dst = test_dir / "dst.cc";
+
+	auto ec = std::error_code{};
+	stage_file(src, dst, ec);
+	ASSERT_FALSE(ec) << ec.message();
+	EXPECT_EQ(read(dst), "int main() {}");
+	EXPECT_FALSE(fs::exists(test_dir / "dst.cc.stage-tmp"));
+}
+
+TEST_F(StageFiles, ReplacesExistingWithoutWritingThrough) {
+	auto src = write("src.cc", "new");
+	auto other = write("other.cc", "other");
+	auto dst = test_dir / "dst.cc";
+
+	// dst is a hard link to an unrelated file which must keep its contents
+	fs::create_hard_link(other, dst);
+
+	auto ec = std::error_code{};
+	stage_file(src, dst, ec);
+	ASSERT_FALSE(ec) << ec.message();
+	EXPECT_EQ(read(dst), "new");
+	EXPECT_EQ(read(other), "other");
+}
+
+TEST_F(StageFiles, MissingSource) {
+	auto ec = std::error_code{};
+	stage_file(test_dir / "missing.cc", test_dir / "dst.cc", ec);
+	EXPECT_TRUE(ec);
+	EXPECT_FALSE(fs::exists(test_dir / "dst.cc"));
+}
+
+TEST_F(StageFiles, StampRoundTrip) {
+	auto stamp = staged_file_stamp{
+		.size = 42,
+		.write_time = -7,
+		.hash = "0123456789abcdef",
+	};
+
+	auto parsed = staged_file_stamp::parse(stamp.to_string());
+	ASSERT_TRUE(parsed);
+	EXPECT_EQ(parsed->size, 42);
+	EXPECT_EQ(parsed->write_time, -7);
+	EXPECT_EQ(parsed->hash, "0123456789abcdef");
+}
+
+TEST_F(StageFiles, InvalidStamp) {
+	EXPECT_FALSE(staged_file_stamp::parse(""));
+	EXPECT_FALSE(staged_file_stamp::parse("42"));
+	EXPECT_FALSE(staged_file_stamp::parse("42:1"));
+	EXPECT_FALSE(staged_file_stamp::parse("42:1:"));
+	EXPECT_FALSE(staged_file_stamp::parse("x:1:abc"));
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <filesystem>
+#include "gtest/gtest.h"
+
+/**
+ * Gives every test an empty `test_dir` of its own that is removed after the
+ * test
+ */
+class TempDirTest : public testing::Test {
+protected:
+	std::filesystem::path test_dir;
+
+	void SetUp() override {
+		auto test_info = testing::UnitTest::GetInstance()->current_test_info();
+		test_dir = std::filesystem::temp_directory_path() / "ecsact_test" /
+			test_info->test_suite_name() / test_info->name();
+		std::filesystem::remove_all(test_dir);
+		std::filesystem::create_directories(test_dir);
+	}
+
+	void TearDown() override {
+		std::filesystem::remove_all(test_dir);
+	}
+};
@@ -0,0 +1,98 @@
+#include "gtest/gtest.h"
+
+#include <sstream>
+#include "ecsact/cli/commands/build/recipe/time_trace.hh"
+
+using ecsact::cli::cook::time_trace_aggregator;
+
+constexpr auto FOO_TRACE = R"({
+	"traceEvents": [
+		{"ph": "X", "name": "Source", "dur": 3000, "args": {"detail": "a.hh"}},
+		{"ph": "X", "name": "Source", "dur": 1000, "args": {"detail": "b.hh"}},
+		{"ph": "X", "name": "InstantiateClass", "dur": 500,
+		 "args": {"detail": "std::vector<int>"}},
+		{"ph": "X", "name": "OptFunction", "dur": 700,
+		 "args": {"detail": "_Z3foov"}},
+		{"ph": "M", "name": "process_name", "args": {"name": "clang"}},
+		{"ph": "X", "name": "Total Frontend", "dur": 8000},
+		{"ph": "X", "name": "Total Backend", "dur": 2000},
+		{"ph": "X", "name": "Total ExecuteCompiler", "dur": 10000}
+	]
+})";
+
+constexpr auto BAR_TRACE = R"({
+	"traceEvents": [
+		{"ph": "X", "name": "Source", "dur": 2500, "args": {"detail": "a.hh"}},
+		{"ph": "X", "name": "InstantiateFunction", "dur": 900,
+		 "args": {"detail": "bar<float>"}},
+		{"ph": "X", "name": "Total Frontend", "dur": 3000},
+		{"ph": "X", "name": "Total Backend", "dur": 1000}
+	]
+})";
+
+static auto add_trace(
+	time_trace_aggregator& aggregator,
+	std::string            source_name,
+	std::string            trace
+) -> bool {
+	auto stream = std::stringstream{trace};
+	return aggregator.add(source_name, stream);
+}
+
+TEST(TimeTrace, AggregatesAcrossSources) {
+	auto aggregator = time_trace_aggregator{};
+	ASSERT_TRUE(add_trace(aggregator, "foo.cc", FOO_TRACE));
+	ASSERT_TRUE(add_trace(aggregator, "bar.cc", BAR_TRACE));
+	ASSERT_EQ(aggregator.source_count(), 2);
+
+	auto report = aggregator.report(10);
+	ASSERT_DOUBLE_EQ(report.total_frontend_ms, 11.0);
+	ASSERT_DOUBLE_EQ(report.total_backend_ms, 3.0);
+
+	ASSERT_EQ(report.sources.size(), 2);
+	ASSERT_EQ(report.sources[0].name, "foo.cc");
+	ASSERT_DOUBLE_EQ(report.sources[0].duration_ms, 10.0);
+	// Without "Total ExecuteCompiler" frontend and backend are summed
+	ASSERT_EQ(report.sources[1].name, "bar.cc");
+	ASSERT_DOUBLE_EQ(report.sources[1].duration_ms, 4.0);
+
+	ASSERT_EQ(report.headers.size(), 2);
+	ASSERT_EQ(report.headers[0].name, "a.hh");
+	ASSERT_DOUBLE_EQ(report.headers[0].duration_ms, 5.5);
+	ASSERT_EQ(report.headers[0].count, 2);
+
+	ASSERT_EQ(report.templates.size(), 2);
+	ASSERT_EQ(report.templates[0].name, "bar<float>");
+
+	ASSERT_EQ(report.functions.size(), 1);
+	ASSERT_EQ(report.functions[0].name, "_Z3foov");
+}
+
+TEST(TimeTrace, SourceTimeOnly) {
+	auto aggregator = time_trace_aggregator{};
+	aggregator.add_source_time("foo.cc", 2000);
+	aggregator.add_source_time("bar.cc", 3000);
+
+	auto report = aggregator.report(10);
+	ASSERT_EQ(report.sources.size(), 2);
+	ASSERT_EQ(report.sources[0].name, "bar.cc");
+	ASSERT_DOUBLE_EQ(report.sources[0].duration_ms, 3.0);
+	ASSERT_TRUE(report.headers.empty());
+}
+
+TEST(TimeTrace, LimitsEntries) {
+	auto aggregator = time_trace_aggregator{};
+	ASSERT_TRUE(add_trace(aggregator, "foo.cc", FOO_TRACE));
+
+	auto report = aggregator.report(1);
+	ASSERT_EQ(report.headers.size(), 1);
+	ASSERT_EQ(report.headers[0].name, "a.hh");
+}
+
+TEST(TimeTrace, RejectsInvalidTrace) {
+	auto aggregator = time_trace_aggregator{};
+	ASSERT_FALSE(add_trace(aggregator, "foo.cc", "not json"));
+	ASSERT_FALSE(add_trace(aggregator, "foo.cc", R"({"other": []})"));
+	ASSERT_FALSE(aggregator.add_file("foo.cc", "missing-trace.json"));
+	ASSERT_EQ(aggregator.source_count(), 0);
+}
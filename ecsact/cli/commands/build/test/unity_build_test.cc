@@ -0,0 +1,77 @@
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include "ecsact/cli/commands/build/recipe/unity_build.hh"
+#include "ecsact/cli/commands/build/test/temp_dir_test.hh"
+
+namespace fs = std::filesystem;
+
+using ecsact::cli::cook::load_compile_times;
+using ecsact::cli::cook::partition_unity_sources;
+using ecsact::cli::cook::save_compile_times;
+using ecsact::cli::cook::unity_source;
+using ecsact::cli::cook::write_unity_sources;
+
+using UnityBuild = TempDirTest;
+
+TEST_F(UnityBuild, BalancesByWeight) {
+	auto groups = partition_unity_sources(
+		{
+			{.path = "a.cc", .weight = 10},
+			{.path = "b.cc", .weight = 6},
+			{.path = "c.cc", .weight = 4},
+			{.path = "d.cc", .weight = 1},
+		},
+		2
+	);
+
+	ASSERT_EQ(groups.size(), 2);
+	ASSERT_EQ(groups[0], (std::vector<fs::path>{"a.cc", "d.cc"}));
+	ASSERT_EQ(groups[1], (std::vector<fs::path>{"b.cc", "c.cc"}));
+}
+
+TEST_F(UnityBuild, NeverMoreGroupsThanSources) {
+	auto groups = partition_unity_sources({{.path = "a.cc", .weight = 1}}, 8);
+	ASSERT_EQ(groups.size(), 1);
+	ASSERT_TRUE(partition_unity_sources({}, 8).empty());
+}
+
+TEST_F(UnityBuild, StableForSameInputs) {
+	auto sources = std::vector<unity_source>{
+		{.path = "x.cc", .weight = 3},
+		{.path = "y.cc", .weight = 3},
+		{.path = "z.cc", .weight = 3},
+	};
+	auto reversed = std::vector(sources.rbegin(), sources.rend());
+
+	ASSERT_EQ(
+		partition_unity_sources(sources, 2),
+		partition_unity_sources(reversed, 2)
+	);
+}
+
+TEST_F(UnityBuild, WritesIncludesAndRemovesExtraUnits) {
+	auto unity_dir = test_dir / "unity";
+	auto srcs = write_unity_sources({{"/a.cc", "/b.cc"}, {"/c.cc"}}, unity_dir);
+	ASSERT_EQ(srcs.size(), 2);
+
+	auto contents = std::stringstream{};
+	contents << std::ifstream{srcs[0]}.rdbuf();
+	ASSERT_NE(contents.str().find("#include \"/a.cc\""), std::string::npos);
+	ASSERT_NE(contents.str().find("#include \"/b.cc\""), std::string::npos);
+
+	srcs = write_unity_sources({{"/a.cc", "/b.cc", "/c.cc"}}, unity_dir);
+	ASSERT_EQ(srcs.size(), 1);
+	ASSERT_FALSE(fs::exists(unity_dir / "ecsact-unity-1.cc"));
+}
+
+TEST_F(UnityBuild, CompileTimesMerge) {
+	save_compile_times(test_dir, {{"a.cc", 100}, {"b.cc", 200}});
+	save_compile_times(test_dir, {{"b.cc", 50}});
+
+	auto times = load_compile_times(test_dir);
+	ASSERT_EQ(times.at("a.cc"), 100);
+	ASSERT_EQ(times.at("b.cc"), 50);
+}
@@ -0,0 +1,84 @@
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+#include "ecsact/cli/commands/build/recipe/work_dir_state.hh"
+#include "ecsact/cli/commands/build/test/temp_dir_test.hh"
+
+namespace fs = std::filesystem;
+
+using ecsact::cli::cook::read_stamp;
+using ecsact::cli::cook::work_dir_state;
+using ecsact::cli::cook::write_stamp;
+
+class WorkDirState : public TempDirTest {
+protected:
+	auto touch(fs::path rel_path) -> fs::path {
+		auto path = test_dir / rel_path;
+		fs::create_directories(path.parent_path());
+		std::ofstream{path} << "contents";
+		return path;
+	}
+};
+
+TEST_F(WorkDirState, NothingUpToDateInitially) {
+	auto state = work_dir_state::load(test_dir);
+	ASSERT_FALSE(state.up_to_date("fetch:a", "hash"));
+}
+
+TEST_F(WorkDirState, UpToDateAfterSave) {
+	{
+		auto state = work_dir_state::load(test_dir);
+		state.record("fetch:a", "hash", {touch("a/a.cc")});
+		ASSERT_TRUE(state.save());
+	}
+
+	auto state = work_dir_state::load(test_dir);
+	ASSERT_TRUE(state.up_to_date("fetch:a", "hash"));
+	ASSERT_FALSE(state.up_to_date("fetch:a", "other_hash"));
+	ASSERT_EQ(state.previous_outputs("fetch:a").size(), 1);
+
+	fs::remove(test_dir / "a/a.cc");
+	ASSERT_FALSE(state.up_to_date("fetch:a", "hash"));
+}
+
+TEST_F(WorkDirState, RemoveStaleOutputs) {
+	{
+		auto state = work_dir_state::load(test_dir);
+		state.record("path:a", "", {touch("a.cc"), touch("b.cc")});
+		state.record("path:c", "", {touch("c.cc")});
+		ASSERT_TRUE(state.save());
+	}
+
+	auto state = work_dir_state::load(test_dir);
+	state.record("path:a", "", {test_dir / "a.cc"});
+	auto removed = state.remove_stale_outputs();
+
+	ASSERT_EQ(removed.size(), 2);
+	ASSERT_TRUE(fs::exists(test_dir / "a.cc"));
+	ASSERT_FALSE(fs::exists(test_dir / "b.cc"));
+	ASSERT_FALSE(fs::exists(test_dir / "c.cc"));
+}
+
+TEST_F(WorkDirState, OutputStamps) {
+	{
+		auto state = work_dir_state::load(test_dir);
+		auto a = touch("a/a.cc");
+		state.record("path:a", "", {a}, {{a, "1:2:abc"}});
+		ASSERT_TRUE(state.save());
+	}
+
+	auto state = work_dir_state::load(test_dir);
+	ASSERT_EQ(state.previous_stamp("path:a", test_dir / "a/a.cc"), "1:2:abc");
+	ASSERT_EQ(state.previous_stamp("path:a", "a/a.cc"), "1:2:abc");
+	ASSERT_FALSE(state.previous_stamp("path:a", "a/b.cc"));
+	ASSERT_FALSE(state.previous_stamp("path:b", "a/a.cc"));
+}
+
+TEST_F(WorkDirState, Stamp) {
+	auto stamp_path = test_dir / "a.o.key";
+	ASSERT_FALSE(read_stamp(stamp_path));
+
+	write_stamp(stamp_path, "abc");
+	ASSERT_EQ(read_stamp(stamp_path), "abc");
+}
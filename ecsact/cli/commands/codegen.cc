@@ -19,6 +19,7 @@
 #include "ecsact/codegen/plugin.h"
 #include "ecsact/codegen/plugin_validate.hh"
 #include "ecsact/cli/commands/codegen/codegen_util.hh"
+#include "ecsact/cli/detail/cache_dir.hh"
 
 namespace fs = std::filesystem;
 constexpr auto file_readonly_perms = fs::perms::others_read |
@@ -28,7 +29,7 @@ constexpr auto USAGE = R"(Ecsact Codegen Command
 
 Usage:
   ecsact codegen <files>... --plugin=<plugin> [--stdout]
-  ecsact codegen <files>... --plugin=<plugin>... [--outdir=<directory>] [--format=<type>] [--report_filter=<filter>] [--print-output-files]
+  ecsact codegen <files>... --plugin=<plugin>... [--outdir=<directory>] [--format=<type>] [--report_filter=<filter>] [--print-output-files] [--cache_dir=<path>] [--no_cache]
 
 Options:
   -p, --plugin=<plugin>     Name of bundled plugin or path to plugin.
@@ -37,6 +38,8 @@ Options:
   -f --format=<type>        The format used to report progress of the build [default: text]
   --report_filter=<filter>  Filtering out report logs [default: none]
   --print-output-files      Simply print output file paths to stdout. No codegen will occur.
+  --cache_dir=<path>        Persistent cache directory. Plugin outputs are cached in its 'codegen' subdirectory (ECSACT_CACHE_DIR or user cache dir)
+  --no_cache                Always run every plugin instead of restoring unchanged outputs from the cache
 )";
 
 static auto stdout_write_fn(
@@ -47,6 +50,10 @@ static auto stdout_write_fn(
 	std::cout << std::string_view(str, str_len);
 }
 
+auto ecsact::cli::detail::codegen_usage() -> std::string_view {
+	return USAGE;
+}
+
 int ecsact::cli::detail::codegen_command(int argc, const char* argv[]) {
 	using namespace std::string_literals;
 
@@ -95,8 +102,7 @@ int ecsact::cli::detail::codegen_command(int argc, const char* argv[]) {
 
 		if(plugin_path) {
 			std::error_code ec;
-			auto&           plugin = plugins.emplace_back();
-			plugin.load(plugin_path->string(), ec);
+			plugins.emplace_back(load_plugin(*plugin_path, ec));
 			auto validate_result = ecsact::codegen::plugin_validate(*plugin_path);
 			if(validate_result.ok()) {
 				plugin_paths.emplace_back(*plugin_path);
@@ -158,10 +164,19 @@ int ecsact::cli::detail::codegen_command(int argc, const char* argv[]) {
 		}
 	}
 
+	auto cache_dir = std::optional<fs::path>{};
+	if(!args.at("--no_cache").asBool()) {
+		cache_dir = args.at("--cache_dir").isString() //
+			? fs::path{args.at("--cache_dir").asString()}
+			: default_cache_dir();
+		*cache_dir /= "codegen";
+	}
+
 	auto codegen_options = ecsact::cli::codegen_options{
 		.plugin_paths = plugin_paths,
 		.outdir = outdir,
 		.only_print_output_files = only_print_output_files,
+		.cache_dir = cache_dir,
 	};
 
 	if(args.at("--stdout").asBool()) {
@@ -3,6 +3,7 @@
 #include <type_traits>
 #include <vector>
 #include <string>
+#include <string_view>
 
 #include "./command.hh"
 
@@ -11,6 +12,11 @@ namespace ecsact::cli::detail {
 int codegen_command(int argc, const char* argv[]);
 static_assert(std::is_same_v<command_fn_t, decltype(&codegen_command)>);
 
+/**
+ * docopt usage text of `ecsact codegen`
+ */
+auto codegen_usage() -> std::string_view;
+
 inline auto codegen_command(std::vector<std::string> args) -> int {
 	auto c_args = std::vector<const char*>();
 	c_args.reserve(args.size());
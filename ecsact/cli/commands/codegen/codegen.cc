@@ -2,11 +2,19 @@
 
 #include <filesystem>
 #include <string.h>
+#include <algorithm>
 #include <array>
 #include <format>
+#include <fstream>
+#include <set>
+#include <span>
+#include <sstream>
+#include <unordered_map>
 #include <boost/dll.hpp>
 #include "ecsact/runtime/meta.h"
 #include "ecsact/cli/report.hh"
+#include "ecsact/cli/commands/codegen/codegen_cache.hh"
+#include "ecsact/cli/commands/codegen/codegen_util.hh"
 #include "ecsact/codegen/plugin.h"
 #include "ecsact/runtime/dylib.h"
 
@@ -63,11 +71,202 @@ static auto codegen_report_fn(
 	}
 }
 
+/**
+ * File of @p package_id followed by the files of every package it imports
+ * (directly or not) in a stable order
+ */
+static auto package_closure_files( //
+	ecsact_package_id package_id
+) -> std::vector<fs::path> {
+	auto files = std::vector<fs::path>{};
+	auto visited = std::set<ecsact_package_id>{};
+	auto pending = std::vector<ecsact_package_id>{package_id};
+
+	while(!pending.empty()) {
+		auto id = pending.back();
+		pending.pop_back();
+		if(!visited.insert(id).second) {
+			continue;
+		}
+
+		files.emplace_back(ecsact_meta_package_file_path(id));
+
+		auto dependencies = std::vector<ecsact_package_id>(
+			static_cast<std::size_t>(ecsact_meta_count_dependencies(id))
+		);
+		ecsact_meta_get_dependencies(
+			id,
+			static_cast<int32_t>(dependencies.size()),
+			dependencies.data(),
+			nullptr
+		);
+		pending.insert(pending.end(), dependencies.rbegin(), dependencies.rend());
+	}
+
+	return files;
+}
+
+using cached_entry_t = std::optional<ecsact::cli::codegen_cache::entry>;
+
+/**
+ * Directory plugin output paths of @p package_file_path are relative to
+ */
+static auto output_root(
+	const std::optional<fs::path>& outdir,
+	const fs::path&                package_file_path
+) -> fs::path {
+	return outdir ? *outdir : package_file_path.parent_path();
+}
+
+/**
+ * Write cached outputs of a plugin for each of @p package_ids
+ * @returns `false` if an output conflicted with another plugin or could not be
+ *          written
+ */
+static auto restore_cached_outputs(
+	std::span<const cached_entry_t>               entries,
+	std::span<const ecsact_package_id>            package_ids,
+	const std::optional<fs::path>&                outdir,
+	std::unordered_map<std::string, std::string>& output_paths
+) -> bool {
+	auto success = true;
+	for(auto i = 0; entries.size() > i; ++i) {
+		auto& entry = *entries[i];
+		auto  package_file_path =
+			fs::path{ecsact_meta_package_file_path(package_ids[i])};
+		auto output_dir = output_root(outdir, package_file_path);
+
+		for(auto& output : entry.files) {
+			auto output_file_path = output_dir / output.rel_path;
+			auto [itr, inserted] =
+				output_paths.emplace(output_file_path.string(), entry.plugin_name);
+			if(!inserted) {
+				success = false;
+				ecsact::cli::report_error(
+					"Plugin '{}' has conflicts with plugin '{}' output file {}",
+					entry.plugin_name,
+					itr->second,
+					output_file_path.string()
+				);
+				continue;
+			}
+
+			auto ec = std::error_code{};
+			fs::create_directories(output_file_path.parent_path(), ec);
+			if(fs::exists(output_file_path)) {
+				fs::permissions(output_file_path, fs::perms::all);
+			}
+
+			auto file = std::ofstream{output_file_path, std::ios_base::binary};
+			file << output.contents;
+			if(!file) {
+				success = false;
+				ecsact::cli::report_error(
+					"Failed to write {}",
+					output_file_path.string()
+				);
+			}
+		}
+	}
+
+	if(success && !entries.empty()) {
+		ecsact::cli::report_info(
+			"Restored '{}' codegen for {} package(s) from cache",
+			entries.front()->plugin_name,
+			entries.size()
+		);
+	}
+
+	return success;
+}
+
+/**
+ * Read back what a plugin wrote for a package and store it in @p cache
+ */
+static auto store_cached_outputs(
+	const ecsact::cli::codegen_cache& cache,
+	std::string_view                  key,
+	const std::string&                plugin_name,
+	const fs::path&                   output_dir,
+	const std::vector<fs::path>&      output_file_paths
+) -> void {
+	auto entry = ecsact::cli::codegen_cache::entry{.plugin_name = plugin_name};
+	for(auto& output_file_path : output_file_paths) {
+		auto file = std::ifstream{output_file_path, std::ios_base::binary};
+		if(!file) {
+			return;
+		}
+
+		auto contents = std::stringstream{};
+		contents << file.rdbuf();
+		auto rel_path = output_file_path.lexically_relative(output_dir);
+		entry.files.push_back({
+			.rel_path = rel_path.generic_string(),
+			.contents = std::move(contents).str(),
+		});
+	}
+
+	cache.store(key, entry);
+}
+
 auto ecsact::cli::codegen(codegen_options options) -> int {
 	auto plugins = std::vector<boost::dll::shared_library>{};
 	// key = plugin name, value = plugin path
 	auto plugin_names = std::unordered_map<std::string, std::string>{};
 
+	std::vector<ecsact_package_id> package_ids;
+	package_ids.resize(static_cast<int32_t>(ecsact_meta_count_packages()));
+	ecsact_meta_get_package_ids(
+		static_cast<int32_t>(package_ids.size()),
+		package_ids.data(),
+		nullptr
+	);
+
+	// Only outputs written to files are cached
+	auto cache = options.cache_dir && !options.write_fn &&
+			!options.only_print_output_files
+		? std::optional{codegen_cache{*options.cache_dir}}
+		: std::nullopt;
+
+	// [plugin index][package index]
+	auto cache_keys = std::vector<std::vector<std::optional<std::string>>>(
+		options.plugin_paths.size(),
+		std::vector<std::optional<std::string>>(package_ids.size())
+	);
+	auto cached_entries = std::vector<std::vector<cached_entry_t>>(
+		options.plugin_paths.size(),
+		std::vector<cached_entry_t>(package_ids.size())
+	);
+
+	if(cache) {
+		auto package_files = std::vector<std::vector<fs::path>>{};
+		for(auto package_id : package_ids) {
+			package_files.emplace_back(package_closure_files(package_id));
+		}
+
+		for(auto i = 0; options.plugin_paths.size() > i; ++i) {
+			auto plugin_key = codegen_cache::plugin_key(options.plugin_paths[i]);
+			if(!plugin_key) {
+				continue;
+			}
+
+			for(auto j = 0; package_ids.size() > j; ++j) {
+				cache_keys[i][j] = codegen_cache::key(*plugin_key, package_files[j]);
+				if(cache_keys[i][j]) {
+					cached_entries[i][j] = cache->restore(*cache_keys[i][j]);
+				}
+			}
+		}
+	}
+
+	// Plugins with every output cached are never loaded
+	auto fully_cached = [&](std::size_t plugin_index) -> bool {
+		return !package_ids.empty() &&
+			std::ranges::all_of(cached_entries[plugin_index], [](auto& entry) {
+				return entry.has_value();
+			});
+	};
+
 	auto unload_plugins = [&plugins] {
 		for(auto& plugin : plugins) {
 			if(plugin) {
@@ -76,10 +275,25 @@ auto ecsact::cli::codegen(codegen_options options) -> int {
 		}
 	};
 
-	for(auto plugin_path : options.plugin_paths) {
-		auto  ec = std::error_code{};
+	for(auto i = 0; options.plugin_paths.size() > i; ++i) {
+		auto& plugin_path = options.plugin_paths[i];
 		auto& plugin = plugins.emplace_back();
-		plugin.load(plugin_path.string(), ec);
+		if(fully_cached(i)) {
+			auto& plugin_name = cached_entries[i].front()->plugin_name;
+			if(plugin_names.contains(plugin_name)) {
+				ecsact::cli::report_error(
+					"Multiple plugins with name '{}'",
+					plugin_name
+				);
+				unload_plugins();
+				return 1;
+			}
+			plugin_names.emplace(plugin_name, plugin_path.string());
+			continue;
+		}
+
+		auto ec = std::error_code{};
+		plugin = load_plugin(plugin_path, ec);
 		if(ec) {
 			ecsact::cli::report_error(
 				"Failed to load plugin {}: {}",
@@ -99,21 +313,28 @@ auto ecsact::cli::codegen(codegen_options options) -> int {
 			unload_plugins();
 			return 1;
 		}
+		plugin_names.emplace(plugin_name, plugin_path.string());
 	}
 
-	std::vector<ecsact_package_id> package_ids;
-	package_ids.resize(static_cast<int32_t>(ecsact_meta_count_packages()));
-	ecsact_meta_get_package_ids(
-		static_cast<int32_t>(package_ids.size()),
-		package_ids.data(),
-		nullptr
-	);
-
 	// key is output path, value is plugin responsible for generating it
 	auto output_paths = std::unordered_map<std::string, std::string>{};
 	auto has_plugin_error = false;
 
-	for(auto& plugin : plugins) {
+	for(auto plugin_index = 0; plugins.size() > plugin_index; ++plugin_index) {
+		auto& plugin = plugins[plugin_index];
+		if(!plugin) {
+			auto restored = restore_cached_outputs(
+				cached_entries[plugin_index],
+				package_ids,
+				options.outdir,
+				output_paths
+			);
+			if(!restored) {
+				has_plugin_error = true;
+			}
+			continue;
+		}
+
 		// precondition: these methods should've been checked in validation
 		assert(plugin.has("ecsact_codegen_plugin"));
 		assert(plugin.has("ecsact_codegen_plugin_name"));
@@ -163,7 +384,23 @@ auto ecsact::cli::codegen(codegen_options options) -> int {
 			}
 		}
 
-		for(auto package_id : package_ids) {
+		for(auto package_index = 0; package_ids.size() > package_index;
+				++package_index) {
+			auto package_id = package_ids[package_index];
+			auto& cached_entry = cached_entries[plugin_index][package_index];
+			if(cached_entry) {
+				auto restored = restore_cached_outputs(
+					std::span{&cached_entry, 1},
+					std::span{&package_id, 1},
+					options.outdir,
+					output_paths
+				);
+				if(!restored) {
+					has_plugin_error = true;
+				}
+				continue;
+			}
+
 			auto package_file_path =
 				fs::path{ecsact_meta_package_file_path(package_id)};
 
@@ -292,6 +529,7 @@ auto ecsact::cli::codegen(codegen_options options) -> int {
 					plugin_fn(package_id, &file_write_fn, &codegen_report_fn);
 				}
 
+				auto plugin_fatal_error = received_fatal_codegen_report;
 				if(received_fatal_codegen_report) {
 					received_fatal_codegen_report = false;
 					has_plugin_error = true;
@@ -303,6 +541,17 @@ auto ecsact::cli::codegen(codegen_options options) -> int {
 					file_write_stream.close();
 				}
 				file_write_streams.clear();
+
+				auto& cache_key = cache_keys[plugin_index][package_index];
+				if(cache && cache_key && !plugin_fatal_error) {
+					store_cached_outputs(
+						*cache,
+						*cache_key,
+						plugin_name,
+						output_root(options.outdir, package_file_path),
+						plugin_output_paths
+					);
+				}
 			}
 		}
 		plugin.unload();
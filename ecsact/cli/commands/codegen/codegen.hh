@@ -12,6 +12,12 @@ struct codegen_options {
 	std::optional<std::filesystem::path>     outdir;
 	std::optional<ecsact_codegen_write_fn_t> write_fn;
 	bool                                     only_print_output_files;
+
+	/**
+	 * Persistent cache of plugin outputs (see `codegen_cache`.) Not used with
+	 * `write_fn` or `only_print_output_files`. No caching if unset.
+	 */
+	std::optional<std::filesystem::path> cache_dir;
 };
 
 auto codegen(codegen_options options) -> int;
@@ -0,0 +1,130 @@
+#include "ecsact/cli/commands/codegen/codegen_cache.hh"
+
+#include <format>
+#include <fstream>
+#include "ecsact/cli/detail/atomic_write.hh"
+#include "ecsact/cli/detail/content_hash.hh"
+
+namespace fs = std::filesystem;
+
+using ecsact::cli::detail::atomic_write_file;
+using ecsact::cli::detail::content_hasher;
+using ecsact::cli::detail::hash_file;
+
+/**
+ * Bump when the key or entry layout changes so stale entries are never used
+ */
+constexpr auto codegen_cache_version = std::string_view{"2"};
+
+/**
+ * First line of every entry file
+ */
+constexpr auto codegen_cache_entry_header =
+	std::string_view{"ecsact-codegen-cache"};
+
+ecsact::cli::codegen_cache::codegen_cache(fs::path dir) : _dir(std::move(dir)) {
+}
+
+auto ecsact::cli::codegen_cache::plugin_key( //
+	const fs::path& plugin_path
+) -> std::optional<std::string> {
+	auto plugin_hash = hash_file(plugin_path);
+	if(!plugin_hash) {
+		return std::nullopt;
+	}
+
+	auto hasher = content_hasher{};
+	hasher.update(codegen_cache_version);
+	hasher.update(plugin_path.filename().generic_string());
+	hasher.update(*plugin_hash);
+	return hasher.digest();
+}
+
+auto ecsact::cli::codegen_cache::key(
+	std::string_view          plugin_key,
+	std::span<const fs::path> package_files
+) -> std::optional<std::string> {
+	auto hasher = content_hasher{};
+	hasher.update(codegen_cache_version);
+	hasher.update(plugin_key);
+
+	for(auto& package_file : package_files) {
+		// Outputs are named after the package file so its name counts too
+		hasher.update(package_file.filename().generic_string());
+		if(!hasher.update_file(package_file)) {
+			return std::nullopt;
+		}
+	}
+
+	return hasher.digest();
+}
+
+auto ecsact::cli::codegen_cache::entry_path( //
+	std::string_view key
+) const -> fs::path {
+	return _dir / std::format("v{}", codegen_cache_version) / key.substr(0, 2) /
+		key;
+}
+
+auto ecsact::cli::codegen_cache::restore( //
+	std::string_view key
+) const -> std::optional<entry> {
+	auto file = std::ifstream{entry_path(key), std::ios_base::binary};
+	if(!file) {
+		return std::nullopt;
+	}
+
+	auto header = std::string{};
+	auto result = entry{};
+	auto file_count = std::size_t{};
+	std::getline(file, header);
+	std::getline(file, result.plugin_name);
+	file >> file_count;
+	file.ignore(1);
+	if(!file || header != codegen_cache_entry_header) {
+		return std::nullopt;
+	}
+
+	for(auto i = std::size_t{}; file_count > i; ++i) {
+		auto& output = result.files.emplace_back();
+		auto  size = std::size_t{};
+		std::getline(file, output.rel_path);
+		file >> size;
+		file.ignore(1);
+		if(!file) {
+			return std::nullopt;
+		}
+
+		output.contents.resize(size);
+		file.read(output.contents.data(), static_cast<std::streamsize>(size));
+		if(file.gcount() != static_cast<std::streamsize>(size)) {
+			return std::nullopt;
+		}
+	}
+
+	return result;
+}
+
+auto ecsact::cli::codegen_cache::store( //
+	std::string_view key,
+	const entry&     e
+) const -> bool {
+	auto ec = std::error_code{};
+	auto path = entry_path(key);
+
+	fs::create_directories(path.parent_path(), ec);
+	if(ec) {
+		return false;
+	}
+
+	return atomic_write_file(path, [&](std::ostream& file) {
+		file << codegen_cache_entry_header << "\n";
+		file << e.plugin_name << "\n";
+		file << e.files.size() << "\n";
+		for(auto& output : e.files) {
+			file << output.rel_path << "\n";
+			file << output.contents.size() << "\n";
+			file << output.contents;
+		}
+	});
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ecsact::cli {
+
+/**
+ * Persistent cache of codegen plugin outputs shared between `ecsact codegen`
+ * and `ecsact build`. Entries are keyed by the contents of a package and every
+ * package it imports along with the plugin binary so a plugin doesn't have to
+ * be loaded at all when none of its packages changed.
+ */
+class codegen_cache {
+public:
+	struct output_file {
+		/**
+		 * Generic path relative to the output directory. Plugins may write into
+		 * subdirectories of it.
+		 */
+		std::string rel_path;
+		std::string contents;
+	};
+
+	struct entry {
+		/** Name the plugin reported (e.g. for output conflict errors) */
+		std::string              plugin_name;
+		std::vector<output_file> files;
+	};
+
+	codegen_cache(std::filesystem::path dir);
+
+	/**
+	 * Identity of a plugin binary. Its contents are hashed so rebuilding a
+	 * plugin in place invalidates its entries.
+	 * @returns `std::nullopt` if the plugin could not be read
+	 */
+	static auto plugin_key( //
+		const std::filesystem::path& plugin_path
+	) -> std::optional<std::string>;
+
+	/**
+	 * Cache key of running a plugin on a single package
+	 *
+	 * @param plugin_key see plugin_key()
+	 * @param package_files the package file followed by the files of every
+	 *        package it imports (directly or not)
+	 * @returns `std::nullopt` if a package file could not be read
+	 */
+	static auto key(
+		std::string_view                       plugin_key,
+		std::span<const std::filesystem::path> package_files
+	) -> std::optional<std::string>;
+
+	/**
+	 * @returns `std::nullopt` if nothing is cached for @p key
+	 */
+	auto restore(std::string_view key) const -> std::optional<entry>;
+
+	/**
+	 * Store @p e under @p key. Failures are not fatal and only mean the plugin
+	 * runs again next time.
+	 * @returns `false` if the entry could not be stored
+	 */
+	auto store(std::string_view key, const entry& e) const -> bool;
+
+private:
+	std::filesystem::path _dir;
+
+	auto entry_path(std::string_view key) const -> std::filesystem::path;
+};
+
+} // namespace ecsact::cli
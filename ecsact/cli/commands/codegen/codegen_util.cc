@@ -1,5 +1,7 @@
 #include "ecsact/cli/commands/codegen/codegen_util.hh"
 
+#include <map>
+#include <mutex>
 #include <unordered_set>
 #include <format>
 #include <boost/dll.hpp>
@@ -17,6 +19,17 @@ static auto is_maybe_default_plugin(std::string_view plugin_arg) -> bool {
 	return is_maybe_named_plugin;
 }
 
+struct loaded_plugin {
+	fs::file_time_type         write_time;
+	std::uintmax_t             size;
+	boost::dll::shared_library library;
+};
+
+static auto _loaded_plugins_mutex = std::mutex{};
+
+// key = plugin path
+static auto _loaded_plugins = std::map<std::string, loaded_plugin>{};
+
 auto ecsact::cli::get_default_plugins_dir() -> fs::path {
 	using executable_path::executable_path;
 
@@ -117,3 +130,46 @@ auto ecsact::cli::resolve_plugin_path( //
 
 	return plugin_path;
 }
+
+auto ecsact::cli::load_plugin( //
+	const fs::path&  plugin_path,
+	std::error_code& ec
+) -> boost::dll::shared_library {
+	auto lk = std::scoped_lock{_loaded_plugins_mutex};
+	auto key = fs::absolute(plugin_path).lexically_normal().string();
+
+	auto write_time = fs::last_write_time(plugin_path, ec);
+	if(ec) {
+		return {};
+	}
+	auto size = fs::file_size(plugin_path, ec);
+	if(ec) {
+		return {};
+	}
+
+	if(auto itr = _loaded_plugins.find(key); itr != _loaded_plugins.end()) {
+		if(itr->second.write_time == write_time && itr->second.size == size) {
+			return itr->second.library;
+		}
+
+		// The old library has to be unloaded first or loading the same path
+		// again gives back the old one
+		_loaded_plugins.erase(itr);
+	}
+
+	auto library = boost::dll::shared_library{};
+	library.load(plugin_path.string(), ec);
+	if(ec) {
+		return {};
+	}
+
+	_loaded_plugins.emplace(
+		key,
+		loaded_plugin{
+			.write_time = write_time,
+			.size = size,
+			.library = library,
+		}
+	);
+	return library;
+}
@@ -5,6 +5,8 @@
 #include <string>
 #include <filesystem>
 #include <optional>
+#include <system_error>
+#include <boost/dll/shared_library.hpp>
 
 namespace ecsact::cli {
 
@@ -29,4 +31,15 @@ auto get_default_plugins_dir() -> std::filesystem::path;
 
 auto is_default_plugin(std::string_view plugin_arg) -> bool;
 
+/**
+ * Load the codegen plugin at @p plugin_path. Plugins stay loaded for the rest
+ * of the process so codegen that runs again in the same process
+ * (`ecsact daemon`) doesn't load them again. A plugin that changed on disk
+ * since is loaded fresh.
+ */
+auto load_plugin( //
+	const std::filesystem::path& plugin_path,
+	std::error_code&             ec
+) -> boost::dll::shared_library;
+
 } // namespace ecsact::cli
@@ -0,0 +1,84 @@
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "ecsact/cli/commands/codegen/codegen_cache.hh"
+#include "ecsact/cli/commands/build/test/temp_dir_test.hh"
+
+namespace fs = std::filesystem;
+
+using ecsact::cli::codegen_cache;
+
+class CodegenCache : public TempDirTest {
+protected:
+	auto write(fs::path rel_path, std::string_view contents) -> fs::path {
+		auto path = test_dir / rel_path;
+		std::ofstream{path, std::ios_base::binary} << contents;
+		return path;
+	}
+};
+
+TEST_F(CodegenCache, KeyChangesWithImports) {
+	auto plugin = write("plugin.so", "plugin binary");
+	auto pkg = write("pkg.ecsact", "main package pkg; import dep;");
+	auto dep = write("dep.ecsact", "package dep; component A;");
+
+	auto plugin_key = codegen_cache::plugin_key(plugin);
+	ASSERT_TRUE(plugin_key);
+
+	auto files = std::vector<fs::path>{pkg, dep};
+	auto key = codegen_cache::key(*plugin_key, files);
+	ASSERT_TRUE(key);
+	EXPECT_EQ(key, codegen_cache::key(*plugin_key, files));
+
+	write("dep.ecsact", "package dep; component B;");
+	EXPECT_NE(key, codegen_cache::key(*plugin_key, files));
+}
+
+TEST_F(CodegenCache, KeyChangesWithPlugin) {
+	auto plugin = write("plugin.so", "plugin binary");
+	auto files = std::vector<fs::path>{write("pkg.ecsact", "package pkg;")};
+
+	auto key = codegen_cache::key(*codegen_cache::plugin_key(plugin), files);
+
+	write("plugin.so", "rebuilt plugin binary");
+	EXPECT_NE(key, codegen_cache::key(*codegen_cache::plugin_key(plugin), files));
+
+	auto other_plugin = write("other_plugin.so", "rebuilt plugin binary");
+	EXPECT_NE(
+		codegen_cache::plugin_key(plugin),
+		codegen_cache::plugin_key(other_plugin)
+	);
+}
+
+TEST_F(CodegenCache, MissingFiles) {
+	EXPECT_FALSE(codegen_cache::plugin_key(test_dir / "missing.so"));
+
+	auto files = std::vector<fs::path>{test_dir / "missing.ecsact"};
+	EXPECT_FALSE(codegen_cache::key("plugin", files));
+}
+
+TEST_F(CodegenCache, StoreAndRestore) {
+	auto cache = codegen_cache{test_dir / "cache"};
+	auto entry = codegen_cache::entry{
+		.plugin_name = "cpp_header",
+		.files = {
+			{.rel_path = "pkg.ecsact.hh", .contents = "#pragma once\r\n\n"},
+			{.rel_path = "gen/pkg.ecsact.cc", .contents = ""},
+		},
+	};
+
+	EXPECT_FALSE(cache.restore("0123abcd"));
+	ASSERT_TRUE(cache.store("0123abcd", entry));
+
+	auto restored = cache.restore("0123abcd");
+	ASSERT_TRUE(restored);
+	EXPECT_EQ(restored->plugin_name, "cpp_header");
+	ASSERT_EQ(restored->files.size(), 2);
+	EXPECT_EQ(restored->files[0].rel_path, "pkg.ecsact.hh");
+	EXPECT_EQ(restored->files[0].contents, "#pragma once\r\n\n");
+	EXPECT_EQ(restored->files[1].rel_path, "gen/pkg.ecsact.cc");
+	EXPECT_EQ(restored->files[1].contents, "");
+}
@@ -1,11 +1,17 @@
 #include "./config.hh"
+#include <algorithm>
+#include <array>
 #include <iostream>
 #include <filesystem>
 #include <map>
 #include <string>
+#include <string_view>
 #include "docopt.h"
 #include "nlohmann/json.hpp"
+#include "ecsact/cli/commands/build/cc_compiler.hh"
+#include "ecsact/cli/commands/build/cc_compiler_cache.hh"
 #include "ecsact/cli/detail/argv0.hh"
+#include "ecsact/cli/detail/cache_dir.hh"
 
 namespace fs = std::filesystem;
 
@@ -26,6 +32,11 @@ Options:
 			plugin_dir        directory containing built-in Ecsact codegen plugins 
 			builtin_plugins   list of built-in Ecsact codegen plugins available
 			recipe_bundles    directory containing runtime recipe bundles
+			compiler_config   compiler config file of the detected C++ compiler for
+			                  'ecsact build --compiler_config'. Only printed when
+			                  asked for. The compiler is probed once and cached in
+			                  the cache directory (ECSACT_CACHE_DIR or user cache
+			                  dir) until it changes.
 
 )";
 
@@ -51,6 +62,20 @@ constexpr auto CANNOT_FIND_RECIPES_DIR = R"(
 	https://github.com/ecsact-dev/ecsact_sdk/issues
 )";
 
+constexpr auto CANNOT_DETECT_COMPILER = R"(
+[ERROR] Cannot detect C++ compiler installed on your system.
+	Set the CXX environment variable to the path of your compiler or run
+	'ecsact build' to see why detection failed.
+)";
+
+/**
+ * Config keys that are only printed when asked for by name. Detecting the
+ * compiler may run it.
+ */
+constexpr auto explicit_only_keys = std::array{
+	std::string_view{"compiler_config"},
+};
+
 int ecsact::cli::detail::config_command(int argc, const char* argv[]) {
 	using namespace std::string_literals;
 
@@ -125,6 +150,30 @@ int ecsact::cli::detail::config_command(int argc, const char* argv[]) {
 				return 0;
 			},
 		},
+		{
+			"compiler_config",
+			[&] {
+				auto ec = std::error_code{};
+				auto compilers_cache_dir = default_cache_dir() / "compilers";
+				auto work_dir = fs::temp_directory_path() / "ecsact-config";
+				fs::create_directories(work_dir, ec);
+
+				auto compiler = detect_cc_compiler(work_dir, compilers_cache_dir);
+				auto config_path = compiler //
+					? cc_compiler_cache{compilers_cache_dir}.config_path(
+							compiler->compiler_path
+						)
+					: std::nullopt;
+
+				if(!config_path) {
+					std::cerr << CANNOT_DETECT_COMPILER;
+					return 1;
+				}
+
+				output["compiler_config"] = config_path->string();
+				return 0;
+			},
+		},
 		{
 			"recipe_bundles",
 			[&] {
@@ -155,7 +204,12 @@ int ecsact::cli::detail::config_command(int argc, const char* argv[]) {
 
 	auto keys = args.at("<keys>").asStringList();
 	if(keys.empty()) {
-		for(auto&& [_, key_handler] : key_handlers) {
+		for(auto&& [key, key_handler] : key_handlers) {
+			if(std::ranges::find(explicit_only_keys, key) !=
+				 explicit_only_keys.end()) {
+				continue;
+			}
+
 			int exit_code = key_handler();
 			if(exit_code != 0) {
 				return exit_code;
@@ -0,0 +1,333 @@
+#include "ecsact/cli/commands/daemon.hh"
+
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <boost/process/environment.hpp>
+#include "docopt.h"
+#include "ecsact/runtime/dynamic.h"
+#include "ecsact/runtime/meta.h"
+#include "ecsact/cli/report.hh"
+#include "ecsact/cli/commands/build.hh"
+#include "ecsact/cli/commands/codegen.hh"
+#include "ecsact/cli/commands/common.hh"
+#include "ecsact/cli/commands/daemon/daemon_protocol.hh"
+#include "ecsact/cli/commands/daemon/output_capture.hh"
+#include "ecsact/cli/detail/socket.hh"
+
+namespace fs = std::filesystem;
+
+using ecsact::cli::daemon::daemon_event_kind;
+using ecsact::cli::daemon::daemon_request;
+using ecsact::cli::daemon::output_capture;
+using ecsact::cli::daemon::output_stream;
+using ecsact::cli::detail::socket_connection;
+using ecsact::cli::detail::socket_endpoint;
+using ecsact::cli::detail::socket_listener;
+
+constexpr auto USAGE = R"docopt(Ecsact Daemon Command
+
+Usage:
+  ecsact daemon [--listen=<endpoint>] [--format=<type>] [--report_filter=<filter>]
+
+Options:
+  --listen=<endpoint>       Unix socket path to accept commands from. Defaults to 'daemon/daemon.sock' in the cache directory (ECSACT_CACHE_DIR or user cache dir)
+  -f --format=<type>        The format used to report progress of the daemon [default: text]
+  --report_filter=<filter>  Filtering out report logs [default: none]
+
+'ecsact build' and 'ecsact codegen' run in the daemon when the ECSACT_DAEMON
+environment variable is set to its endpoint, or to 1 for the default endpoint.
+They run in their own process like before when no daemon is listening. The
+daemon keeps detected compilers and loaded codegen plugins between commands.
+Commands run one at a time with the working directory and environment of the
+client, later ones wait for the one running. Only the user running the daemon
+can connect to its socket.
+)docopt";
+
+struct daemon_command_info {
+	ecsact::cli::detail::command_fn_t command_fn;
+	std::string_view (*usage_fn)();
+};
+
+static auto daemon_commands()
+	-> const std::unordered_map<std::string, daemon_command_info>& {
+	static const auto commands =
+		std::unordered_map<std::string, daemon_command_info>{
+			{
+				"build",
+				{
+					&ecsact::cli::detail::build_command,
+					&ecsact::cli::detail::build_usage,
+				},
+			},
+			{
+				"codegen",
+				{
+					&ecsact::cli::detail::codegen_command,
+					&ecsact::cli::detail::codegen_usage,
+				},
+			},
+		};
+	return commands;
+}
+
+/**
+ * docopt exits the process on `--help` and invalid arguments. Those commands
+ * run in the client instead where exiting is expected.
+ */
+static auto is_valid_command_line( //
+	const daemon_command_info&      info,
+	const std::vector<std::string>& args
+) -> bool {
+	try {
+		docopt::docopt_parse(
+			std::string{info.usage_fn()},
+			{args.begin() + 1, args.end()},
+			true,
+			false
+		);
+		return true;
+	} catch(const std::exception&) {
+		return false;
+	}
+}
+
+static auto current_environment() -> std::vector<std::string> {
+	auto environment = std::vector<std::string>{};
+	for(auto entry : boost::this_process::environment()) {
+		environment.emplace_back(entry.get_name() + "=" + entry.to_string());
+	}
+	return environment;
+}
+
+static auto set_environment( //
+	const std::vector<std::string>& environment
+) -> void {
+	auto env = boost::this_process::environment();
+
+	auto names = std::vector<std::string>{};
+	for(auto entry : env) {
+		names.emplace_back(entry.get_name());
+	}
+	for(auto& name : names) {
+		env.erase(name);
+	}
+
+	for(auto& entry : environment) {
+		// Windows has entries starting with '=' for per drive directories
+		auto separator = entry.find('=', 1);
+		if(separator == std::string::npos) {
+			continue;
+		}
+		env[entry.substr(0, separator)] = entry.substr(separator + 1);
+	}
+}
+
+/**
+ * Every command evaluates its own files into the process wide package
+ * registry
+ */
+static auto destroy_packages() -> void {
+	auto package_ids = std::vector<ecsact_package_id>{};
+	package_ids.resize(static_cast<std::size_t>(ecsact_meta_count_packages()));
+	ecsact_meta_get_package_ids(
+		static_cast<int32_t>(package_ids.size()),
+		package_ids.data(),
+		nullptr
+	);
+
+	for(auto package_id : package_ids) {
+		ecsact_destroy_package(package_id);
+	}
+}
+
+static auto run_command( //
+	const daemon_command_info&      info,
+	const std::vector<std::string>& args
+) -> int {
+	auto c_args = std::vector<const char*>{};
+	c_args.reserve(args.size());
+	for(auto& arg : args) {
+		c_args.emplace_back(arg.c_str());
+	}
+
+	try {
+		return info.command_fn(static_cast<int>(c_args.size()), c_args.data());
+	} catch(const std::exception& err) {
+		std::cerr << "Uncaught exception: " << err.what() << "\n";
+		return 1;
+	}
+}
+
+static auto serve_connection( //
+	socket_connection      conn,
+	const docopt::Options& daemon_args,
+	std::mutex&            command_mutex
+) -> void {
+	auto hello = ecsact::cli::daemon::daemon_hello{
+		.executable_id = ecsact::cli::daemon::daemon_executable_id(),
+	};
+	if(!ecsact::cli::daemon::send_daemon_hello(conn, hello)) {
+		return;
+	}
+
+	conn.set_receive_timeout(ecsact::cli::detail::HANDSHAKE_TIMEOUT);
+	auto request = ecsact::cli::daemon::receive_daemon_request(conn);
+	if(!request) {
+		return;
+	}
+
+	auto& commands = daemon_commands();
+	auto  command_itr = commands.end();
+	if(request->args.size() >= 2) {
+		command_itr = commands.find(request->args[1]);
+	}
+
+	if(command_itr == commands.end() ||
+		 !is_valid_command_line(command_itr->second, request->args)) {
+		ecsact::cli::daemon::send_daemon_run_locally(conn);
+		return;
+	}
+
+	// Commands share process wide state (working directory, environment,
+	// stdout and the package registry)
+	auto command_lock = std::scoped_lock{command_mutex};
+
+	auto ec = std::error_code{};
+	auto daemon_dir = fs::current_path(ec);
+	fs::current_path(request->working_directory, ec);
+	if(ec) {
+		ecsact::cli::daemon::send_daemon_run_locally(conn);
+		return;
+	}
+
+	auto daemon_environment = current_environment();
+	set_environment(request->environment);
+
+	// An ecsact process started by the command would wait for this one forever
+	boost::this_process::environment().erase(
+		ecsact::cli::daemon::DAEMON_ENV_VAR
+	);
+
+	auto client_connected = true;
+	auto exit_code = 0;
+	{
+		auto capture = output_capture{
+			[&](output_stream stream, std::span<const std::byte> output) {
+				if(!client_connected) {
+					return;
+				}
+				auto kind = stream == output_stream::stdout_stream
+					? daemon_event_kind::stdout_output
+					: daemon_event_kind::stderr_output;
+				client_connected =
+					ecsact::cli::daemon::send_daemon_output(conn, kind, output);
+			},
+		};
+
+		exit_code = run_command(command_itr->second, request->args);
+	}
+
+	set_environment(daemon_environment);
+	fs::current_path(daemon_dir, ec);
+	destroy_packages();
+
+	// Commands replace the report handler with their own
+	ecsact::cli::detail::process_common_args(daemon_args);
+
+	if(client_connected) {
+		ecsact::cli::daemon::send_daemon_exit(conn, exit_code);
+	}
+}
+
+auto ecsact::cli::detail::daemon_command( //
+	int         argc,
+	const char* argv[]
+) -> int {
+	auto args = docopt::docopt(USAGE, {argv + 1, argv + argc});
+
+	if(auto exit_code = process_common_args(args); exit_code != 0) {
+		return exit_code;
+	}
+
+	auto endpoint = args["--listen"].isString()
+		? ecsact::cli::daemon::parse_daemon_endpoint(args["--listen"].asString())
+		: ecsact::cli::daemon::default_daemon_endpoint();
+	if(!endpoint) {
+		ecsact::cli::report_error(
+			"Invalid --listen endpoint '{}'. The daemon only listens on unix "
+			"sockets.",
+			args["--listen"].asString()
+		);
+		return 1;
+	}
+
+	// Commands change the working directory while they run
+	endpoint->unix_path = fs::absolute(endpoint->unix_path);
+
+	auto ec = std::error_code{};
+	auto socket_dir = endpoint->unix_path.parent_path();
+	auto created_socket_dir = fs::create_directories(socket_dir, ec);
+	auto is_default_endpoint = !args["--listen"].isString();
+
+	// The socket itself is owner-only. Its directory is too when it's ours.
+	if(created_socket_dir || is_default_endpoint) {
+		fs::permissions(socket_dir, fs::perms::owner_all, ec);
+		if(ec) {
+			ecsact::cli::report_error(
+				"Failed to restrict {} to the current user: {}",
+				socket_dir.generic_string(),
+				ec.message()
+			);
+			return 1;
+		}
+	}
+
+	// Listening on a unix socket replaces the file of a running daemon
+	if(socket_connection::connect(*endpoint, ec); !ec) {
+		ecsact::cli::report_error(
+			"An ecsact daemon is already listening on {}",
+			endpoint->to_string()
+		);
+		return 1;
+	}
+
+	auto listener = socket_listener::listen(*endpoint, ec);
+	if(ec) {
+		ecsact::cli::report_error(
+			"Failed to listen on {}: {}",
+			endpoint->to_string(),
+			ec.message()
+		);
+		return 1;
+	}
+
+	ecsact::cli::report_info(
+		"Ecsact daemon listening on {}",
+		endpoint->to_string()
+	);
+
+	// Each connection gets its hello right away even while a command runs
+	auto command_mutex = std::mutex{};
+	for(;;) {
+		auto conn = listener.accept(ec);
+		if(ec) {
+			ecsact::cli::report_warning("Failed to accept: {}", ec.message());
+			continue;
+		}
+
+		std::thread{
+			serve_connection,
+			std::move(conn),
+			std::cref(args),
+			std::ref(command_mutex),
+		}.detach();
+	}
+}
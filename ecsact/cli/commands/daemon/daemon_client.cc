@@ -0,0 +1,115 @@
+#include "ecsact/cli/commands/daemon/daemon_client.hh"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string_view>
+#include <boost/process/environment.hpp>
+#include "ecsact/cli/commands/daemon/daemon_protocol.hh"
+
+namespace fs = std::filesystem;
+
+using ecsact::cli::daemon::daemon_event_kind;
+using ecsact::cli::detail::socket_connection;
+using ecsact::cli::detail::socket_endpoint;
+
+static auto current_environment() -> std::vector<std::string> {
+	auto environment = std::vector<std::string>{};
+	for(auto entry : boost::this_process::environment()) {
+		environment.emplace_back(entry.get_name() + "=" + entry.to_string());
+	}
+	return environment;
+}
+
+static auto write_output( //
+	std::FILE*                 file,
+	std::span<const std::byte> output
+) -> void {
+	std::fwrite(output.data(), 1, output.size(), file);
+	std::fflush(file);
+}
+
+auto ecsact::cli::daemon::daemon_endpoint_from_env()
+	-> std::optional<socket_endpoint> {
+	auto value = std::getenv(DAEMON_ENV_VAR);
+	if(value == nullptr || *value == '\0') {
+		return std::nullopt;
+	}
+
+	if(std::string_view{value} == "1") {
+		return default_daemon_endpoint();
+	}
+
+	return parse_daemon_endpoint(value);
+}
+
+auto ecsact::cli::daemon::run_in_daemon(
+	const socket_endpoint&       endpoint,
+	std::span<const std::string> args
+) -> std::optional<int> {
+	if(args.size() < 2 || !is_daemon_command(args[1])) {
+		return std::nullopt;
+	}
+
+	auto ec = std::error_code{};
+	auto conn = socket_connection::connect(endpoint, ec);
+	if(ec) {
+		return std::nullopt;
+	}
+
+	// A stuck daemon shouldn't keep the command from running locally. The
+	// daemon sends its hello as soon as it accepts a connection.
+	conn.set_receive_timeout(ecsact::cli::detail::HANDSHAKE_TIMEOUT);
+	auto hello = receive_daemon_hello(conn);
+	if(!hello || hello->protocol_version != DAEMON_PROTOCOL_VERSION ||
+		 hello->executable_id != daemon_executable_id()) {
+		return std::nullopt;
+	}
+
+	// Commands wait for the one running before them and may be quiet for long
+	conn.set_receive_timeout(std::chrono::milliseconds{0});
+
+	auto working_directory = fs::current_path(ec);
+	if(ec) {
+		return std::nullopt;
+	}
+
+	auto request = daemon_request{
+		.args = {args.begin(), args.end()},
+		.working_directory = working_directory.string(),
+		.environment = current_environment(),
+	};
+	if(!send_daemon_request(conn, request)) {
+		return std::nullopt;
+	}
+
+	auto received_output = false;
+	for(;;) {
+		auto event = receive_daemon_event(conn);
+		if(!event) {
+			// Running again locally would repeat output already written
+			if(!received_output) {
+				return std::nullopt;
+			}
+			std::cerr << "Lost connection to ecsact daemon\n";
+			return 1;
+		}
+
+		switch(event->kind) {
+			case daemon_event_kind::stdout_output:
+				received_output = true;
+				write_output(stdout, event->output);
+				break;
+			case daemon_event_kind::stderr_output:
+				received_output = true;
+				write_output(stderr, event->output);
+				break;
+			case daemon_event_kind::exit:
+				return event->exit_code;
+			case daemon_event_kind::run_locally:
+				return std::nullopt;
+		}
+	}
+}
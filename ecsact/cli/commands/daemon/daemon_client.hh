@@ -0,0 +1,29 @@
+#pragma once
+
+#include <optional>
+#include <span>
+#include <string>
+#include "ecsact/cli/detail/socket.hh"
+
+namespace ecsact::cli::daemon {
+
+/**
+ * Endpoint set with the `ECSACT_DAEMON` environment variable
+ * @returns `std::nullopt` if unset, invalid or not a unix socket
+ */
+auto daemon_endpoint_from_env()
+	-> std::optional<ecsact::cli::detail::socket_endpoint>;
+
+/**
+ * Run the command in @p args in the daemon at @p endpoint. Its stdout and
+ * stderr are written to this process' as they arrive.
+ * @returns exit code of the command or `std::nullopt` if the command should
+ * run in this process instead (no daemon, a different ecsact version or a
+ * command the daemon doesn't run)
+ */
+auto run_in_daemon(
+	const ecsact::cli::detail::socket_endpoint& endpoint,
+	std::span<const std::string>                args
+) -> std::optional<int>;
+
+} // namespace ecsact::cli::daemon
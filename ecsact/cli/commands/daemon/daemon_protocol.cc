@@ -0,0 +1,253 @@
+#include "ecsact/cli/commands/daemon/daemon_protocol.hh"
+
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <string_view>
+#include "nlohmann/json.hpp"
+#include "ecsact/cli/detail/cache_dir.hh"
+#include "ecsact/cli/detail/executable_path/executable_path.hh"
+
+namespace fs = std::filesystem;
+
+using ecsact::cli::daemon::daemon_event;
+using ecsact::cli::daemon::daemon_event_kind;
+using ecsact::cli::daemon::daemon_hello;
+using ecsact::cli::daemon::daemon_request;
+using ecsact::cli::detail::read_frame;
+using ecsact::cli::detail::socket_connection;
+using ecsact::cli::detail::socket_endpoint;
+using ecsact::cli::detail::write_frame;
+
+/**
+ * Headers are small. Frames larger than this are treated as a broken
+ * connection rather than allocated.
+ */
+constexpr auto MAX_HEADER_FRAME_SIZE = std::uint64_t{16} * 1024 * 1024;
+constexpr auto MAX_OUTPUT_FRAME_SIZE = std::uint64_t{64} * 1024 * 1024;
+
+static auto write_header(
+	socket_connection&    conn,
+	const nlohmann::json& header
+) -> bool {
+	auto str = header.dump();
+	return write_frame(conn, std::as_bytes(std::span{str}));
+}
+
+static auto read_header(socket_connection& conn)
+	-> std::optional<nlohmann::json> {
+	auto data = std::vector<std::byte>{};
+	if(!read_frame(conn, MAX_HEADER_FRAME_SIZE, data)) {
+		return std::nullopt;
+	}
+
+	auto str = std::string_view{
+		reinterpret_cast<const char*>(data.data()),
+		data.size(),
+	};
+	auto header = nlohmann::json::parse(str, nullptr, false);
+	if(header.is_discarded() || !header.is_object()) {
+		return std::nullopt;
+	}
+
+	return header;
+}
+
+static auto event_name(daemon_event_kind kind) -> std::string_view {
+	switch(kind) {
+		case daemon_event_kind::stdout_output:
+			return "stdout";
+		case daemon_event_kind::stderr_output:
+			return "stderr";
+		case daemon_event_kind::exit:
+			return "exit";
+		case daemon_event_kind::run_locally:
+			return "run_locally";
+	}
+
+	return "";
+}
+
+static auto event_kind_from_name( //
+	std::string_view name
+) -> std::optional<daemon_event_kind> {
+	for(auto kind : {
+				daemon_event_kind::stdout_output,
+				daemon_event_kind::stderr_output,
+				daemon_event_kind::exit,
+				daemon_event_kind::run_locally,
+			}) {
+		if(event_name(kind) == name) {
+			return kind;
+		}
+	}
+
+	return std::nullopt;
+}
+
+auto ecsact::cli::daemon::is_daemon_command( //
+	std::string_view subcommand
+) -> bool {
+	return subcommand == "build" || subcommand == "codegen";
+}
+
+auto ecsact::cli::daemon::default_daemon_endpoint() -> socket_endpoint {
+	return socket_endpoint{
+		.unix_path =
+			ecsact::cli::detail::default_cache_dir() / "daemon" / "daemon.sock",
+	};
+}
+
+auto ecsact::cli::daemon::parse_daemon_endpoint( //
+	std::string_view str
+) -> std::optional<socket_endpoint> {
+	auto endpoint = socket_endpoint::parse(str);
+	if(!endpoint || !endpoint->is_unix()) {
+		return std::nullopt;
+	}
+	return endpoint;
+}
+
+auto ecsact::cli::daemon::daemon_executable_id() -> std::string {
+	auto path = executable_path::executable_path();
+	auto ec = std::error_code{};
+	auto size = fs::file_size(path, ec);
+	auto write_time = fs::last_write_time(path, ec);
+
+	return std::format(
+		"{}:{}:{}",
+		path.generic_string(),
+		size,
+		write_time.time_since_epoch().count()
+	);
+}
+
+auto ecsact::cli::daemon::send_daemon_hello(
+	socket_connection&  conn,
+	const daemon_hello& hello
+) -> bool {
+	return write_header(
+		conn,
+		{
+			{"protocol_version", hello.protocol_version},
+			{"executable_id", hello.executable_id},
+		}
+	);
+}
+
+auto ecsact::cli::daemon::receive_daemon_hello( //
+	socket_connection& conn
+) -> std::optional<daemon_hello> {
+	auto header = read_header(conn);
+	if(!header) {
+		return std::nullopt;
+	}
+
+	try {
+		return daemon_hello{
+			.protocol_version = header->at("protocol_version").get<int>(),
+			.executable_id = header->at("executable_id").get<std::string>(),
+		};
+	} catch(const nlohmann::json::exception&) {
+		return std::nullopt;
+	}
+}
+
+auto ecsact::cli::daemon::send_daemon_request(
+	socket_connection&    conn,
+	const daemon_request& request
+) -> bool {
+	return write_header(
+		conn,
+		{
+			{"args", request.args},
+			{"working_directory", request.working_directory},
+			{"environment", request.environment},
+		}
+	);
+}
+
+auto ecsact::cli::daemon::receive_daemon_request( //
+	socket_connection& conn
+) -> std::optional<daemon_request> {
+	auto header = read_header(conn);
+	if(!header) {
+		return std::nullopt;
+	}
+
+	try {
+		return daemon_request{
+			.args = header->at("args").get<std::vector<std::string>>(),
+			.working_directory =
+				header->at("working_directory").get<std::string>(),
+			.environment =
+				header->at("environment").get<std::vector<std::string>>(),
+		};
+	} catch(const nlohmann::json::exception&) {
+		return std::nullopt;
+	}
+}
+
+auto ecsact::cli::daemon::send_daemon_output(
+	socket_connection&         conn,
+	daemon_event_kind          kind,
+	std::span<const std::byte> output
+) -> bool {
+	return write_header(conn, {{"event", event_name(kind)}}) &&
+		write_frame(conn, output);
+}
+
+auto ecsact::cli::daemon::send_daemon_exit(
+	socket_connection& conn,
+	int                exit_code
+) -> bool {
+	return write_header(
+		conn,
+		{
+			{"event", event_name(daemon_event_kind::exit)},
+			{"exit_code", exit_code},
+		}
+	);
+}
+
+auto ecsact::cli::daemon::send_daemon_run_locally( //
+	socket_connection& conn
+) -> bool {
+	return write_header(
+		conn,
+		{{"event", event_name(daemon_event_kind::run_locally)}}
+	);
+}
+
+auto ecsact::cli::daemon::receive_daemon_event( //
+	socket_connection& conn
+) -> std::optional<daemon_event> {
+	auto header = read_header(conn);
+	if(!header) {
+		return std::nullopt;
+	}
+
+	auto event = daemon_event{};
+	try {
+		auto kind = event_kind_from_name(header->at("event").get<std::string>());
+		if(!kind) {
+			return std::nullopt;
+		}
+		event.kind = *kind;
+
+		if(event.kind == daemon_event_kind::exit) {
+			event.exit_code = header->at("exit_code").get<int>();
+		}
+	} catch(const nlohmann::json::exception&) {
+		return std::nullopt;
+	}
+
+	if(event.kind == daemon_event_kind::stdout_output ||
+		 event.kind == daemon_event_kind::stderr_output) {
+		if(!read_frame(conn, MAX_OUTPUT_FRAME_SIZE, event.output)) {
+			return std::nullopt;
+		}
+	}
+
+	return event;
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ecsact/cli/detail/socket.hh"
+
+namespace ecsact::cli::daemon {
+
+/**
+ * Bumped whenever a message of the daemon protocol changes
+ */
+constexpr auto DAEMON_PROTOCOL_VERSION = 1;
+
+/**
+ * Environment variable that makes `ecsact build` and `ecsact codegen` run in
+ * an `ecsact daemon`. Either an endpoint or `1` for the default endpoint.
+ */
+constexpr auto DAEMON_ENV_VAR = "ECSACT_DAEMON";
+
+/**
+ * Subcommands an `ecsact daemon` runs. The client runs every other subcommand
+ * itself without connecting.
+ */
+auto is_daemon_command(std::string_view subcommand) -> bool;
+
+/**
+ * Endpoint `ecsact daemon` listens on when no `--listen` is given. A socket
+ * file in a `daemon` directory of the persistent cache directory that only
+ * the user running the daemon can access.
+ */
+auto default_daemon_endpoint() -> ecsact::cli::detail::socket_endpoint;
+
+/**
+ * Parse a daemon endpoint. Commands run with the client's working directory
+ * and environment and may load codegen plugins, so only unix sockets (which
+ * only the daemon user can connect to) are allowed.
+ * @returns `std::nullopt` if @p str is invalid or not a unix socket
+ */
+auto parse_daemon_endpoint( //
+	std::string_view str
+) -> std::optional<ecsact::cli::detail::socket_endpoint>;
+
+/**
+ * Identifies the running ecsact executable. A client only hands its command
+ * to a daemon with the same id so upgrading ecsact never runs old code.
+ */
+auto daemon_executable_id() -> std::string;
+
+/**
+ * Sent by the daemon as soon as a connection is accepted
+ */
+struct daemon_hello {
+	int         protocol_version = DAEMON_PROTOCOL_VERSION;
+	std::string executable_id;
+};
+
+/**
+ * A command the client would have run itself
+ */
+struct daemon_request {
+	/** Full command line including the executable and subcommand */
+	std::vector<std::string> args;
+	std::string              working_directory;
+
+	/** Client environment as `NAME=value` entries */
+	std::vector<std::string> environment;
+};
+
+enum class daemon_event_kind {
+	/** Bytes the command wrote to stdout */
+	stdout_output,
+
+	/** Bytes the command wrote to stderr */
+	stderr_output,
+
+	/** The command finished with `exit_code`. Always the last event. */
+	exit,
+
+	/**
+	 * The daemon won't run this command. The client runs it itself. Only ever
+	 * sent before any output.
+	 */
+	run_locally,
+};
+
+struct daemon_event {
+	daemon_event_kind      kind = daemon_event_kind::exit;
+	int                    exit_code = 0;
+	std::vector<std::byte> output;
+};
+
+// Each message is one JSON header frame, output events are followed by one
+// binary frame. See `ecsact::cli::detail::write_frame`.
+
+auto send_daemon_hello(
+	ecsact::cli::detail::socket_connection& conn,
+	const daemon_hello&                     hello
+) -> bool;
+
+auto receive_daemon_hello( //
+	ecsact::cli::detail::socket_connection& conn
+) -> std::optional<daemon_hello>;
+
+auto send_daemon_request(
+	ecsact::cli::detail::socket_connection& conn,
+	const daemon_request&                   request
+) -> bool;
+
+auto receive_daemon_request( //
+	ecsact::cli::detail::socket_connection& conn
+) -> std::optional<daemon_request>;
+
+auto send_daemon_output(
+	ecsact::cli::detail::socket_connection& conn,
+	daemon_event_kind                       kind,
+	std::span<const std::byte>              output
+) -> bool;
+
+auto send_daemon_exit(
+	ecsact::cli::detail::socket_connection& conn,
+	int                                     exit_code
+) -> bool;
+
+auto send_daemon_run_locally( //
+	ecsact::cli::detail::socket_connection& conn
+) -> bool;
+
+auto receive_daemon_event( //
+	ecsact::cli::detail::socket_connection& conn
+) -> std::optional<daemon_event>;
+
+} // namespace ecsact::cli::daemon
@@ -0,0 +1,158 @@
+#include "ecsact/cli/commands/daemon/output_capture.hh"
+
+#include <cstdio>
+#include <iostream>
+
+#ifdef _WIN32
+#	include <fcntl.h>
+#	include <io.h>
+#else
+#	include <errno.h>
+#	include <unistd.h>
+#endif
+
+using ecsact::cli::daemon::output_capture;
+using ecsact::cli::daemon::output_stream;
+
+constexpr auto PIPE_BUFFER_SIZE = 64 * 1024;
+
+#ifdef _WIN32
+static auto dup_fd(int fd) -> int {
+	return _dup(fd);
+}
+
+static auto dup2_fd(int fd, int target_fd) -> int {
+	return _dup2(fd, target_fd);
+}
+
+static auto close_fd(int fd) -> void {
+	_close(fd);
+}
+
+static auto open_pipe(int (&fds)[2]) -> bool {
+	return _pipe(fds, PIPE_BUFFER_SIZE, _O_BINARY) == 0;
+}
+
+static auto read_some(int fd, std::byte* buffer, std::size_t size) -> long {
+	return _read(fd, buffer, static_cast<unsigned>(size));
+}
+
+static auto file_fd(std::FILE* file) -> int {
+	return _fileno(file);
+}
+#else
+static auto dup_fd(int fd) -> int {
+	return ::dup(fd);
+}
+
+static auto dup2_fd(int fd, int target_fd) -> int {
+	return ::dup2(fd, target_fd);
+}
+
+static auto close_fd(int fd) -> void {
+	::close(fd);
+}
+
+static auto open_pipe(int (&fds)[2]) -> bool {
+	return ::pipe(fds) == 0;
+}
+
+static auto read_some(int fd, std::byte* buffer, std::size_t size) -> long {
+	for(;;) {
+		auto read_count = ::read(fd, buffer, size);
+		if(read_count != -1 || errno != EINTR) {
+			return static_cast<long>(read_count);
+		}
+	}
+}
+
+static auto file_fd(std::FILE* file) -> int {
+	return ::fileno(file);
+}
+#endif
+
+static auto stream_fd(output_stream stream) -> int {
+	return stream == output_stream::stdout_stream //
+		? file_fd(stdout)
+		: file_fd(stderr);
+}
+
+static auto flush_streams() -> void {
+	std::cout.flush();
+	std::cerr.flush();
+	std::fflush(stdout);
+	std::fflush(stderr);
+}
+
+output_capture::output_capture(output_callback_t on_output)
+	: _on_output(std::move(on_output)) {
+	flush_streams();
+
+	for(auto i = std::size_t{}; _captured.size() > i; ++i) {
+		auto  stream = static_cast<output_stream>(i);
+		auto& captured = _captured[i];
+
+		int fds[2];
+		if(!open_pipe(fds)) {
+			continue;
+		}
+
+		captured.saved_fd = dup_fd(stream_fd(stream));
+		if(captured.saved_fd == -1 || dup2_fd(fds[1], stream_fd(stream)) == -1) {
+			if(captured.saved_fd != -1) {
+				close_fd(captured.saved_fd);
+				captured.saved_fd = -1;
+			}
+			close_fd(fds[0]);
+			close_fd(fds[1]);
+			continue;
+		}
+
+		// Only the redirected stdout/stderr keeps the pipe open now so the reader
+		// sees the end once they're restored
+		close_fd(fds[1]);
+		captured.read_fd = fds[0];
+		captured.reader = std::thread{
+			&output_capture::read_until_closed,
+			this,
+			stream,
+			fds[0],
+		};
+	}
+}
+
+output_capture::~output_capture() {
+	flush_streams();
+
+	for(auto i = std::size_t{}; _captured.size() > i; ++i) {
+		auto  stream = static_cast<output_stream>(i);
+		auto& captured = _captured[i];
+		if(captured.saved_fd == -1) {
+			continue;
+		}
+
+		dup2_fd(captured.saved_fd, stream_fd(stream));
+		close_fd(captured.saved_fd);
+		captured.reader.join();
+		close_fd(captured.read_fd);
+	}
+}
+
+auto output_capture::read_until_closed( //
+	output_stream stream,
+	int           read_fd
+) -> void {
+	auto buffer = std::array<std::byte, PIPE_BUFFER_SIZE>{};
+	for(;;) {
+		auto read_count = read_some(read_fd, buffer.data(), buffer.size());
+		if(read_count <= 0) {
+			return;
+		}
+
+		auto lk = std::scoped_lock{_output_mutex};
+		_on_output(
+			stream,
+			std::span{buffer}.first(static_cast<std::size_t>(read_count))
+		);
+	}
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <thread>
+
+namespace ecsact::cli::daemon {
+
+enum class output_stream {
+	stdout_stream,
+	stderr_stream,
+};
+
+/**
+ * Redirects the process stdout and stderr to a callback until destroyed.
+ * Child processes that inherit them are captured too. Only one capture may
+ * exist at a time.
+ */
+class output_capture {
+public:
+	using output_callback_t =
+		std::function<void(output_stream, std::span<const std::byte>)>;
+
+	/**
+	 * @param on_output called with everything written. Never called from more
+	 * than one thread at a time.
+	 */
+	explicit output_capture(output_callback_t on_output);
+	output_capture(const output_capture&) = delete;
+	auto operator=(const output_capture&) -> output_capture& = delete;
+
+	/**
+	 * Restores stdout and stderr once everything written so far reached the
+	 * callback
+	 */
+	~output_capture();
+
+private:
+	struct captured_fd {
+		/** Original fd to restore. -1 if it couldn't be redirected. */
+		int         saved_fd = -1;
+		int         read_fd = -1;
+		std::thread reader;
+	};
+
+	auto read_until_closed(output_stream stream, int read_fd) -> void;
+
+	output_callback_t          _on_output;
+	std::mutex                 _output_mutex;
+	std::array<captured_fd, 2> _captured;
+};
+
+} // namespace ecsact::cli::daemon
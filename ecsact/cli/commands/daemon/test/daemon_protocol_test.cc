@@ -0,0 +1,159 @@
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <thread>
+#include "ecsact/cli/commands/daemon/daemon_protocol.hh"
+#include "ecsact/cli/commands/build/test/socket_test.hh"
+
+using ecsact::cli::daemon::DAEMON_PROTOCOL_VERSION;
+using ecsact::cli::daemon::daemon_event_kind;
+using ecsact::cli::daemon::daemon_executable_id;
+using ecsact::cli::daemon::daemon_hello;
+using ecsact::cli::daemon::daemon_request;
+using ecsact::cli::daemon::default_daemon_endpoint;
+using ecsact::cli::daemon::is_daemon_command;
+using ecsact::cli::daemon::parse_daemon_endpoint;
+using ecsact::cli::daemon::receive_daemon_event;
+using ecsact::cli::daemon::receive_daemon_hello;
+using ecsact::cli::daemon::receive_daemon_request;
+using ecsact::cli::daemon::send_daemon_exit;
+using ecsact::cli::daemon::send_daemon_hello;
+using ecsact::cli::daemon::send_daemon_output;
+using ecsact::cli::daemon::send_daemon_request;
+using ecsact::cli::daemon::send_daemon_run_locally;
+using ecsact::cli::detail::socket_connection;
+using ecsact::cli::detail::socket_listener;
+
+TEST(DaemonProtocol, ExecutableIdIsStable) {
+	EXPECT_FALSE(daemon_executable_id().empty());
+	EXPECT_EQ(daemon_executable_id(), daemon_executable_id());
+}
+
+TEST(DaemonProtocol, DaemonCommands) {
+	EXPECT_TRUE(is_daemon_command("build"));
+	EXPECT_TRUE(is_daemon_command("codegen"));
+	EXPECT_FALSE(is_daemon_command("config"));
+	EXPECT_FALSE(is_daemon_command("daemon"));
+	EXPECT_FALSE(is_daemon_command("--help"));
+}
+
+TEST(DaemonProtocol, OnlyUnixSocketEndpoints) {
+	auto unix_path = parse_daemon_endpoint("/tmp/ecsact/daemon.sock");
+	ASSERT_TRUE(unix_path);
+	EXPECT_TRUE(unix_path->is_unix());
+	EXPECT_TRUE(parse_daemon_endpoint("unix:daemon.sock"));
+
+	EXPECT_FALSE(parse_daemon_endpoint("localhost:9000"));
+	EXPECT_FALSE(parse_daemon_endpoint(":9000"));
+	EXPECT_FALSE(parse_daemon_endpoint(""));
+
+	auto default_endpoint = default_daemon_endpoint();
+	EXPECT_TRUE(default_endpoint.is_unix());
+	EXPECT_EQ(default_endpoint.unix_path.parent_path().filename(), "daemon");
+}
+
+TEST(DaemonProtocol, CommandRoundTrip) {
+	auto endpoint = test_socket_endpoint("round_trip");
+	auto ec = std::error_code{};
+	auto listener = socket_listener::listen(endpoint, ec);
+	ASSERT_FALSE(ec) << ec.message();
+
+	auto received_request = std::optional<daemon_request>{};
+	auto daemon = std::thread{[&] {
+		auto accept_ec = std::error_code{};
+		auto conn = listener.accept(accept_ec);
+		if(accept_ec) {
+			return;
+		}
+
+		send_daemon_hello(conn, {.executable_id = "ecsact:1"});
+		received_request = receive_daemon_request(conn);
+		send_daemon_output(
+			conn,
+			daemon_event_kind::stdout_output,
+			bytes("generated.hh\n")
+		);
+		send_daemon_output(
+			conn,
+			daemon_event_kind::stderr_output,
+			bytes("warning\n")
+		);
+		send_daemon_exit(conn, 3);
+	}};
+
+	auto conn = socket_connection::connect(endpoint, ec);
+	ASSERT_FALSE(ec) << ec.message();
+
+	auto hello = receive_daemon_hello(conn);
+	ASSERT_TRUE(hello);
+	EXPECT_EQ(hello->protocol_version, DAEMON_PROTOCOL_VERSION);
+	EXPECT_EQ(hello->executable_id, "ecsact:1");
+
+	auto request = daemon_request{
+		.args = {"ecsact", "codegen", "example.ecsact", "--plugin=cpp_header"},
+		.working_directory = "/work",
+		.environment = {"PATH=/usr/bin", "EMPTY="},
+	};
+	ASSERT_TRUE(send_daemon_request(conn, request));
+
+	auto stdout_event = receive_daemon_event(conn);
+	auto stderr_event = receive_daemon_event(conn);
+	auto exit_event = receive_daemon_event(conn);
+	daemon.join();
+
+	ASSERT_TRUE(received_request);
+	EXPECT_EQ(received_request->args, request.args);
+	EXPECT_EQ(received_request->working_directory, request.working_directory);
+	EXPECT_EQ(received_request->environment, request.environment);
+
+	ASSERT_TRUE(stdout_event);
+	EXPECT_EQ(stdout_event->kind, daemon_event_kind::stdout_output);
+	EXPECT_EQ(stdout_event->output, bytes("generated.hh\n"));
+
+	ASSERT_TRUE(stderr_event);
+	EXPECT_EQ(stderr_event->kind, daemon_event_kind::stderr_output);
+	EXPECT_EQ(stderr_event->output, bytes("warning\n"));
+
+	ASSERT_TRUE(exit_event);
+	EXPECT_EQ(exit_event->kind, daemon_event_kind::exit);
+	EXPECT_EQ(exit_event->exit_code, 3);
+}
+
+TEST(DaemonProtocol, RunLocally) {
+	auto endpoint = test_socket_endpoint("run_locally");
+	auto ec = std::error_code{};
+	auto listener = socket_listener::listen(endpoint, ec);
+	ASSERT_FALSE(ec) << ec.message();
+
+	auto daemon = std::thread{[&] {
+		auto accept_ec = std::error_code{};
+		auto conn = listener.accept(accept_ec);
+		send_daemon_run_locally(conn);
+	}};
+
+	auto conn = socket_connection::connect(endpoint, ec);
+	ASSERT_FALSE(ec) << ec.message();
+
+	auto event = receive_daemon_event(conn);
+	daemon.join();
+
+	ASSERT_TRUE(event);
+	EXPECT_EQ(event->kind, daemon_event_kind::run_locally);
+
+	// Nothing follows
+	EXPECT_FALSE(receive_daemon_event(conn));
+}
+
+TEST(DaemonProtocol, HelloTimeout) {
+	auto endpoint = test_socket_endpoint("hello_timeout");
+	auto ec = std::error_code{};
+	auto listener = socket_listener::listen(endpoint, ec);
+	ASSERT_FALSE(ec) << ec.message();
+
+	auto conn = socket_connection::connect(endpoint, ec);
+	ASSERT_FALSE(ec) << ec.message();
+
+	// The connection is never accepted so no hello arrives
+	conn.set_receive_timeout(std::chrono::milliseconds{100});
+	EXPECT_FALSE(receive_daemon_hello(conn));
+}
@@ -0,0 +1,74 @@
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include "ecsact/cli/commands/daemon/output_capture.hh"
+
+using ecsact::cli::daemon::output_capture;
+using ecsact::cli::daemon::output_stream;
+
+struct captured_output {
+	std::string stdout_str;
+	std::string stderr_str;
+};
+
+static auto capture(auto&& fn) -> captured_output {
+	auto result = captured_output{};
+	{
+		auto capture = output_capture{
+			[&](output_stream stream, std::span<const std::byte> output) {
+				auto& str = stream == output_stream::stdout_stream //
+					? result.stdout_str
+					: result.stderr_str;
+				str.append(
+					reinterpret_cast<const char*>(output.data()),
+					output.size()
+				);
+			},
+		};
+		fn();
+	}
+	return result;
+}
+
+TEST(OutputCapture, CapturesStreams) {
+	auto output = capture([] {
+		std::cout << "cout line\n";
+		std::printf("printf line\n");
+		std::cerr << "cerr line\n";
+		std::fprintf(stderr, "fprintf line\n");
+	});
+
+	EXPECT_EQ(output.stdout_str, "cout line\nprintf line\n");
+	EXPECT_EQ(output.stderr_str, "cerr line\nfprintf line\n");
+}
+
+TEST(OutputCapture, LargeOutput) {
+	// Larger than a pipe buffer so the writer has to wait for the reader
+	auto line = std::string(1000, 'x') + "\n";
+	auto output = capture([&] {
+		for(auto i = 0; 1000 > i; ++i) {
+			std::cout << line;
+		}
+	});
+
+	EXPECT_EQ(output.stdout_str.size(), line.size() * 1000);
+	EXPECT_TRUE(output.stderr_str.empty());
+}
+
+TEST(OutputCapture, RestoresStreams) {
+	capture([] { std::cout << "captured\n"; });
+
+	// Would deadlock or write into a closed pipe if stdout wasn't restored
+	std::cout << "restored" << std::endl;
+	auto output = capture([] { std::cout << "again\n"; });
+	EXPECT_EQ(output.stdout_str, "again\n");
+}
+
+TEST(OutputCapture, ChildProcesses) {
+	auto output = capture([] { std::system("echo from child"); });
+
+	// cmd.exe ends lines with \r\n
+	EXPECT_TRUE(output.stdout_str.starts_with("from child")) << output.stdout_str;
+}
@@ -243,6 +243,7 @@ auto ecsact::build_recipe_bundle::create( //
 			return build_recipe::source_path{
 				.path = archive_rel_path,
 				.outdir = src.outdir,
+				.unity = src.unity,
 			};
 		},
 		[&](build_recipe::source_codegen src) -> source_visitor_result_t {
@@ -315,6 +316,7 @@ auto ecsact::build_recipe_bundle::create( //
 			return build_recipe::source_path{
 				.path = archive_rel_path,
 				.outdir = src.outdir,
+				.unity = src.unity,
 			};
 		},
 	};
@@ -4,6 +4,8 @@
 #include <stdexcept>
 #include <format>
 #include <filesystem>
+#include <fstream>
+#include <vector>
 #ifdef __cpp_lib_stacktrace
 #	include <stacktrace>
 #endif
@@ -25,9 +27,22 @@ static auto archive_error_as_logic_error(archive* a) -> std::logic_error {
 	return std::logic_error{msg};
 }
 
-auto ecsact::cli::detail::read_archive( //
-	const std::span<const std::byte> archive_bytes,
-	read_archive_callback_t          read_callback
+static auto archive_read_chunk( //
+	archive*     a,
+	void*        client_data,
+	const void** out_buffer
+) -> la_ssize_t {
+	auto& read_chunk =
+		*static_cast<ecsact::cli::detail::archive_read_chunk_fn_t*>(client_data);
+
+	auto chunk = read_chunk();
+	*out_buffer = chunk.data();
+	return static_cast<la_ssize_t>(chunk.size());
+}
+
+auto ecsact::cli::detail::extract_archive(
+	archive_read_chunk_fn_t    read_chunk,
+	extract_archive_callback_t extract_callback
 ) -> void {
 	auto result = int{};
 	auto a = std::unique_ptr<archive, decltype(&archive_read_free)>{
@@ -44,20 +59,24 @@ auto ecsact::cli::detail::read_archive( //
 		throw archive_error_as_logic_error(a.get());
 	}
 
-	result = archive_read_open_memory(
+	result = archive_read_open(
 		a.get(),
-		archive_bytes.data(),
-		archive_bytes.size()
+		&read_chunk,
+		nullptr,
+		archive_read_chunk,
+		nullptr
 	);
 	if(result != ARCHIVE_OK) {
 		throw archive_error_as_logic_error(a.get());
 	}
 
-	auto entry = archive_entry_new2(a.get());
-	auto data = std::vector<std::byte>{};
+	auto entry = std::unique_ptr<archive_entry, decltype(&archive_entry_free)>{
+		archive_entry_new2(a.get()),
+		archive_entry_free,
+	};
 
 	for(;;) {
-		result = archive_read_next_header2(a.get(), entry);
+		result = archive_read_next_header2(a.get(), entry.get());
 		if(result == ARCHIVE_EOF) {
 			break;
 		}
@@ -66,26 +85,70 @@ auto ecsact::cli::detail::read_archive( //
 			throw archive_error_as_logic_error(a.get());
 		}
 
-		auto path = std::string_view{archive_entry_pathname(entry)};
-		auto size = archive_entry_size(entry);
+		// Directories are created as needed for the files inside them
+		if(archive_entry_filetype(entry.get()) != AE_IFREG) {
+			continue;
+		}
 
-		if(size == 0) {
-			throw std::logic_error{std::format("No size for {}", path)};
+		auto path = std::string_view{archive_entry_pathname(entry.get())};
+		if(path.starts_with("/")) {
+			path = path.substr(1);
 		}
 
-		data.resize(size);
-		auto read_size = archive_read_data(a.get(), data.data(), data.size());
+		auto out_paths = extract_callback(path);
+		if(out_paths.empty()) {
+			continue;
+		}
 
-		if(read_size != size) {
-			throw std::logic_error{std::format("Failed to read {}", path)};
+		auto out_files = std::vector<std::ofstream>{};
+		out_files.reserve(out_paths.size());
+		for(auto& out_path : out_paths) {
+			auto& out_file = out_files.emplace_back(
+				out_path,
+				std::ios_base::binary | std::ios_base::trunc
+			);
+			if(!out_file) {
+				throw std::logic_error{
+					std::format("Failed to open {}", out_path.string()),
+				};
+			}
 		}
 
-		if(path.starts_with("/")) {
-			path = path.substr(1);
+		for(;;) {
+			auto block = static_cast<const void*>(nullptr);
+			auto block_size = std::size_t{};
+			auto block_offset = la_int64_t{};
+			result = archive_read_data_block(
+				a.get(),
+				&block,
+				&block_size,
+				&block_offset
+			);
+			if(result == ARCHIVE_EOF) {
+				break;
+			}
+
+			if(result < ARCHIVE_OK) {
+				throw archive_error_as_logic_error(a.get());
+			}
+
+			for(auto& out_file : out_files) {
+				// Sparse entries skip over holes with the offset
+				out_file.seekp(static_cast<std::streamoff>(block_offset));
+				out_file.write(
+					static_cast<const char*>(block),
+					static_cast<std::streamsize>(block_size)
+				);
+			}
 		}
 
-		read_callback(path, std::span{data.data(), data.size()});
+		for(auto i = std::size_t{}; out_files.size() > i; ++i) {
+			out_files[i].close();
+			if(!out_files[i]) {
+				throw std::logic_error{
+					std::format("Failed to write {}", out_paths[i].string()),
+				};
+			}
+		}
 	}
-
-	archive_entry_free(entry);
 }
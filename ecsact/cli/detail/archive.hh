@@ -4,15 +4,33 @@
 #include <string_view>
 #include <span>
 #include <cstddef>
+#include <filesystem>
+#include <vector>
 
 namespace ecsact::cli::detail {
 
-using read_archive_callback_t =
-	std::function<void(std::string_view path, std::span<std::byte> data)>;
+/**
+ * Supplies the next chunk of archive data. An empty span means there is no
+ * more data. The span must stay valid until the next call.
+ */
+using archive_read_chunk_fn_t = std::function<std::span<const std::byte>()>;
 
-auto read_archive( //
-	const std::span<const std::byte> archive_bytes,
-	read_archive_callback_t          read_callback
+/**
+ * Called for every file in an archive with its path inside the archive
+ * @returns paths the file is written to. Empty to skip the file.
+ */
+using extract_archive_callback_t =
+	std::function<std::vector<std::filesystem::path>(std::string_view path)>;
+
+/**
+ * Decompress an archive while its data is still arriving. Files are written
+ * one block at a time so memory use does not grow with the archive size.
+ * @throws std::logic_error if the archive can't be read or a file can't be
+ *         written
+ */
+auto extract_archive(
+	archive_read_chunk_fn_t    read_chunk,
+	extract_archive_callback_t extract_callback
 ) -> void;
 
 } // namespace ecsact::cli::detail
@@ -0,0 +1,62 @@
+#include "ecsact/cli/detail/atomic_write.hh"
+
+#include <format>
+#include <fstream>
+#include <random>
+
+namespace fs = std::filesystem;
+
+auto ecsact::cli::detail::unique_tmp_path( //
+	const fs::path& path
+) -> fs::path {
+	auto tmp_path = path;
+	tmp_path += std::format(".tmp-{:x}", std::random_device{}());
+	return tmp_path;
+}
+
+auto ecsact::cli::detail::atomic_write_file(
+	const fs::path&                    path,
+	std::function<void(std::ostream&)> write_fn
+) -> bool {
+	auto ec = std::error_code{};
+	auto tmp_path = unique_tmp_path(path);
+
+	{
+		auto file = std::ofstream{tmp_path, std::ios_base::binary};
+		write_fn(file);
+
+		if(!file) {
+			file.close();
+			fs::remove(tmp_path, ec);
+			return false;
+		}
+	}
+
+	fs::rename(tmp_path, path, ec);
+	if(ec) {
+		fs::remove(tmp_path, ec);
+		return false;
+	}
+
+	return true;
+}
+
+auto ecsact::cli::detail::atomic_copy_file(
+	const fs::path& src,
+	const fs::path& dst
+) -> bool {
+	auto ec = std::error_code{};
+	auto tmp_path = unique_tmp_path(dst);
+
+	fs::copy_file(src, tmp_path, ec);
+	if(!ec) {
+		fs::rename(tmp_path, dst, ec);
+	}
+
+	if(ec) {
+		fs::remove(tmp_path, ec);
+		return false;
+	}
+
+	return true;
+}
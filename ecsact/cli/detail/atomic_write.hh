@@ -0,0 +1,36 @@
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <ostream>
+
+namespace ecsact::cli::detail {
+
+/**
+ * Unique path next to @p path. Cache entries are written there first and
+ * renamed to @p path once complete so concurrent builds never observe a
+ * partially written entry.
+ */
+auto unique_tmp_path( //
+	const std::filesystem::path& path
+) -> std::filesystem::path;
+
+/**
+ * Write the file at @p path with @p write_fn through a `unique_tmp_path`
+ * @returns `false` if the file could not be written. Nothing is left behind.
+ */
+auto atomic_write_file(
+	const std::filesystem::path&       path,
+	std::function<void(std::ostream&)> write_fn
+) -> bool;
+
+/**
+ * Copy @p src to @p dst through a `unique_tmp_path`
+ * @returns `false` if the file could not be copied. Nothing is left behind.
+ */
+auto atomic_copy_file(
+	const std::filesystem::path& src,
+	const std::filesystem::path& dst
+) -> bool;
+
+} // namespace ecsact::cli::detail
@@ -0,0 +1,40 @@
+#include "ecsact/cli/detail/cache_dir.hh"
+
+#include <cstdlib>
+
+namespace fs = std::filesystem;
+
+static auto env_path(const char* name) -> fs::path {
+	auto value = std::getenv(name);
+	if(value == nullptr || *value == '\0') {
+		return {};
+	}
+
+	return fs::path{value};
+}
+
+auto ecsact::cli::detail::default_cache_dir() -> fs::path {
+	if(auto dir = env_path("ECSACT_CACHE_DIR"); !dir.empty()) {
+		return dir;
+	}
+
+#if defined(_WIN32)
+	if(auto dir = env_path("LOCALAPPDATA"); !dir.empty()) {
+		return dir / "ecsact" / "cache";
+	}
+#elif defined(__APPLE__)
+	if(auto dir = env_path("HOME"); !dir.empty()) {
+		return dir / "Library" / "Caches" / "ecsact";
+	}
+#else
+	if(auto dir = env_path("XDG_CACHE_HOME"); !dir.empty()) {
+		return dir / "ecsact";
+	}
+
+	if(auto dir = env_path("HOME"); !dir.empty()) {
+		return dir / ".cache" / "ecsact";
+	}
+#endif
+
+	return fs::temp_directory_path() / "ecsact-cache";
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <filesystem>
+
+namespace ecsact::cli::detail {
+
+/**
+ * Directory the Ecsact CLI keeps persistent caches in. `ECSACT_CACHE_DIR` if
+ * set, otherwise the platforms user cache directory (`%LOCALAPPDATA%` on
+ * Windows, `~/Library/Caches` on macOS and `$XDG_CACHE_HOME` or `~/.cache`
+ * elsewhere) with an `ecsact` subdirectory. Falls back to the temp directory
+ * if none of those are available.
+ */
+auto default_cache_dir() -> std::filesystem::path;
+
+} // namespace ecsact::cli::detail
@@ -0,0 +1,66 @@
+#include "ecsact/cli/detail/content_hash.hh"
+
+#include <array>
+#include <format>
+#include <fstream>
+#include "xxhash.h"
+
+using ecsact::cli::detail::content_hasher;
+
+namespace fs = std::filesystem;
+
+static auto state(void* ptr) -> XXH3_state_t* {
+	return static_cast<XXH3_state_t*>(ptr);
+}
+
+content_hasher::content_hasher() : _state(XXH3_createState()) {
+	XXH3_128bits_reset(state(_state));
+}
+
+content_hasher::~content_hasher() {
+	XXH3_freeState(state(_state));
+}
+
+auto content_hasher::update(std::string_view str) -> content_hasher& {
+	XXH3_128bits_update(state(_state), str.data(), str.size());
+	XXH3_128bits_update(state(_state), "\0", 1);
+	return *this;
+}
+
+auto content_hasher::update_bytes( //
+	std::span<const std::byte> bytes
+) -> content_hasher& {
+	XXH3_128bits_update(state(_state), bytes.data(), bytes.size());
+	return *this;
+}
+
+auto content_hasher::update_file(const fs::path& path) -> bool {
+	auto file = std::ifstream{path, std::ios_base::binary};
+	if(!file) {
+		return false;
+	}
+
+	auto buf = std::array<char, 64 * 1024>{};
+	while(file) {
+		file.read(buf.data(), buf.size());
+		XXH3_128bits_update(state(_state), buf.data(), file.gcount());
+	}
+
+	return file.eof();
+}
+
+auto content_hasher::digest() const -> std::string {
+	auto hash = XXH3_128bits_digest(state(_state));
+	return std::format("{:016x}{:016x}", hash.high64, hash.low64);
+}
+
+auto ecsact::cli::detail::hash_file( //
+	const fs::path& path
+) -> std::optional<std::string> {
+	auto hasher = content_hasher{};
+	if(!hasher.update_file(path)) {
+		return std::nullopt;
+	}
+
+	return hasher.digest();
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+namespace ecsact::cli::detail {
+
+/**
+ * Incremental 128-bit non-cryptographic hash (XXH3) used for cache keys and
+ * change detection. Not suitable for integrity checks, see `integrity` for
+ * that.
+ */
+class content_hasher {
+public:
+	content_hasher();
+	content_hasher(content_hasher&&) = delete;
+	~content_hasher();
+
+	/**
+	 * Hash @p str followed by a separator so adjacent strings can't be confused
+	 * for each other (e.g. "ab","c" vs "a","bc")
+	 */
+	auto update(std::string_view str) -> content_hasher&;
+
+	/**
+	 * Hash raw bytes without a separator
+	 */
+	auto update_bytes(std::span<const std::byte> bytes) -> content_hasher&;
+
+	/**
+	 * Hash the contents of the file at @p path
+	 * @returns `false` if the file could not be read
+	 */
+	auto update_file(const std::filesystem::path& path) -> bool;
+
+	/**
+	 * @returns 32 character lowercase hex string
+	 */
+	auto digest() const -> std::string;
+
+private:
+	void* _state;
+};
+
+/**
+ * Hash the contents of the file at @p path
+ * @returns `std::nullopt` if the file could not be read
+ */
+auto hash_file(const std::filesystem::path& path) -> std::optional<std::string>;
+
+} // namespace ecsact::cli::detail
@@ -1,6 +1,7 @@
 #include "ecsact/cli/detail/download.hh"
 
 #include <span>
+#include <mutex>
 #include <cstddef>
 #include <vector>
 #include <string>
@@ -13,6 +14,7 @@
 
 using namespace std::string_literals;
 
+using ecsact::cli::detail::download_chunk_callback_t;
 using ecsact::cli::detail::download_file_buffer_t;
 using ecsact::cli::detail::download_file_result;
 
@@ -27,76 +29,99 @@ static auto _download_file_write_callback(
 	size_t      count,
 	void*       userdata
 ) -> size_t {
-	auto& out_data = *static_cast<download_file_buffer_t*>(userdata);
+	auto& on_chunk = *static_cast<download_chunk_callback_t*>(userdata);
 	auto  buffer_span = std::span{
     static_cast<const std::byte*>(buffer),
     size * count,
   };
 
-	out_data.insert(out_data.end(), buffer_span.begin(), buffer_span.end());
-	return size * count;
+	// Any other return value makes curl abort with CURLE_WRITE_ERROR
+	return on_chunk(buffer_span) ? size * count : 0;
 }
 
 [[maybe_unused]]
-static auto download_file_with_libcurl( //
-	boost::url url
-) -> download_file_result {
-	auto ret_out_data = download_file_buffer_t{};
+static auto download_file_with_libcurl(
+	boost::url                url,
+	download_chunk_callback_t on_chunk
+) -> std::optional<std::logic_error> {
+	// Global init/cleanup are not thread safe and fetches may run concurrently
+	static auto curl_init_flag = std::once_flag{};
+	std::call_once(curl_init_flag, [] { curl_global_init(CURL_GLOBAL_ALL); });
 
-	curl_global_init(CURL_GLOBAL_ALL);
 	auto curl = curl_easy_init();
 
 	curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
 
-	curl_easy_setopt(curl, CURLOPT_WRITEDATA, &ret_out_data);
+	curl_easy_setopt(curl, CURLOPT_WRITEDATA, &on_chunk);
 	curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, _download_file_write_callback);
 
 	auto res = curl_easy_perform(curl);
 
 	curl_easy_cleanup(curl);
-	curl_global_cleanup();
 
 	if(res != CURLE_OK) {
 		return std::logic_error{curl_error_message(static_cast<CURLcode>(res))};
 	}
 
-	return ret_out_data;
+	return std::nullopt;
 }
 
 [[maybe_unused]]
-static auto download_file_with_curl_cli( //
-	boost::url url
-) -> download_file_result {
+static auto download_file_with_curl_cli(
+	boost::url                url,
+	download_chunk_callback_t on_chunk
+) -> std::optional<std::logic_error> {
 	auto curl = ecsact::cli::detail::which("curl");
 
 	if(!curl) {
 		return std::logic_error{"Cannot find 'curl' in your PATH"};
 	}
 
-	auto file_bytes = ecsact::cli::detail::spawn_get_stdout_bytes(
+	auto exit_code = ecsact::cli::detail::spawn_read_stdout(
 		*curl,
 		std::vector{
 			std::string{url.c_str()},
 			"--silent"s,
-		}
+		},
+		std::move(on_chunk)
 	);
 
-	if(!file_bytes) {
+	if(exit_code != 0) {
 		return std::logic_error{"Failed to download file with curl cli"};
 	}
 
-	return *file_bytes;
+	return std::nullopt;
 }
 
-auto ecsact::cli::detail::download_file( //
-	std::string_view url_str
-) -> download_file_result {
+auto ecsact::cli::detail::download_file_chunks(
+	std::string_view          url_str,
+	download_chunk_callback_t on_chunk
+) -> std::optional<std::logic_error> {
 	auto url = boost::url{url_str};
 // NOTE: temporary until curl in the BCR supports SSL
 // SEE: https://github.com/bazelbuild/bazel-central-registry/pull/1666
 #if defined(_WIN32) && !defined(ECSACT_CLI_USE_CURL_CLI)
-	return download_file_with_libcurl(url);
+	return download_file_with_libcurl(url, std::move(on_chunk));
 #else
-	return download_file_with_curl_cli(url);
+	return download_file_with_curl_cli(url, std::move(on_chunk));
 #endif
 }
+
+auto ecsact::cli::detail::download_file( //
+	std::string_view url_str
+) -> download_file_result {
+	auto data = download_file_buffer_t{};
+	auto err = download_file_chunks(
+		url_str,
+		[&](std::span<const std::byte> chunk) {
+			data.insert(data.end(), chunk.begin(), chunk.end());
+			return true;
+		}
+	);
+
+	if(err) {
+		return *err;
+	}
+
+	return data;
+}
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <functional>
+#include <optional>
+#include <span>
+#include <string_view>
 #include <variant>
 #include <vector>
 #include <cstddef>
@@ -42,4 +46,20 @@ auto download_file( //
 	std::string_view url
 ) -> download_file_result;
 
+/**
+ * Called with each chunk of a download as it arrives. Return `false` to stop
+ * the download.
+ */
+using download_chunk_callback_t =
+	std::function<bool(std::span<const std::byte> chunk)>;
+
+/**
+ * Download @p url without buffering the whole response in memory
+ * @returns error if the download failed or was stopped by @p on_chunk
+ */
+auto download_file_chunks(
+	std::string_view          url,
+	download_chunk_callback_t on_chunk
+) -> std::optional<std::logic_error>;
+
 } // namespace ecsact::cli::detail
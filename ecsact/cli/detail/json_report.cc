@@ -17,8 +17,13 @@ NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(subcommand_start_message, id, executable, arg
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(subcommand_stdout_message, id, line)
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(subcommand_stderr_message, id, line)
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(subcommand_progress_message, id, description)
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(subcommand_end_message, id, exit_code)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(subcommand_usage, wall_ms, user_ms, sys_ms, peak_rss_bytes)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(subcommand_end_message, id, exit_code, usage)
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(output_path_message, output_path)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(time_trace_report_message::entry, name, duration_ms, count)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(time_trace_report_message, total_frontend_ms, total_backend_ms, sources, headers, templates, functions)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(build_steps_report_message::step, kind, name, usage)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(build_steps_report_message, total_steps, total_wall_ms, total_cpu_ms, slowest)
 // clang-format on
 } // namespace ecsact::cli
 
@@ -1,8 +1,17 @@
 #include "ecsact/cli/detail/proc_exec.hh"
 
+#include <chrono>
 #include <filesystem>
 #include <span>
 #include <boost/process.hpp>
+#ifdef _WIN32
+#	include <windows.h>
+#	include <psapi.h>
+#else
+#	include <cerrno>
+#	include <sys/resource.h>
+#	include <sys/wait.h>
+#endif
 #include "ecsact/cli/report.hh"
 
 namespace bp = boost::process;
@@ -11,6 +20,7 @@ namespace fs = std::filesystem;
 using ecsact::cli::subcommand_end_message;
 using ecsact::cli::subcommand_id_t;
 using ecsact::cli::subcommand_start_message;
+using ecsact::cli::subcommand_usage;
 
 auto ecsact::cli::detail::which(std::string_view prog)
 	-> std::optional<fs::path> {
@@ -23,12 +33,114 @@ auto ecsact::cli::detail::which(std::string_view prog)
 	}
 }
 
+#ifdef _WIN32
+static auto filetime_ms(const FILETIME& time) -> double {
+	auto ticks = ULARGE_INTEGER{};
+	ticks.LowPart = time.dwLowDateTime;
+	ticks.HighPart = time.dwHighDateTime;
+	// FILETIME counts 100ns intervals
+	return static_cast<double>(ticks.QuadPart) / 10'000.0;
+}
+#else
+static auto timeval_ms(const timeval& time) -> double {
+	return static_cast<double>(time.tv_sec) * 1000.0 +
+		static_cast<double>(time.tv_usec) / 1000.0;
+}
+#endif
+
+/**
+ * Wait for @p proc to exit and collect the time and memory it used
+ * @returns exit code
+ */
+static auto wait_with_usage(
+	bp::child&                            proc,
+	std::chrono::steady_clock::time_point start,
+	subcommand_usage&                     out_usage
+) -> int {
+#ifdef _WIN32
+	proc.wait();
+	auto exit_code = proc.exit_code();
+
+	auto creation_time = FILETIME{};
+	auto exit_time = FILETIME{};
+	auto kernel_time = FILETIME{};
+	auto user_time = FILETIME{};
+	if(GetProcessTimes(
+			 proc.native_handle(),
+			 &creation_time,
+			 &exit_time,
+			 &kernel_time,
+			 &user_time
+		 )) {
+		out_usage.user_ms = filetime_ms(user_time);
+		out_usage.sys_ms = filetime_ms(kernel_time);
+	}
+
+	auto memory_counters = PROCESS_MEMORY_COUNTERS{};
+	if(GetProcessMemoryInfo(
+			 proc.native_handle(),
+			 &memory_counters,
+			 sizeof(memory_counters)
+		 )) {
+		out_usage.peak_rss_bytes = memory_counters.PeakWorkingSetSize;
+	}
+#else
+	// The child is reaped here so its resource usage isn't lost. boost must not
+	// wait on it afterwards.
+	proc.detach();
+
+	auto status = int{};
+	auto usage = rusage{};
+	auto waited = pid_t{};
+	do {
+		waited = ::wait4(proc.id(), &status, 0, &usage);
+	} while(waited == -1 && errno == EINTR);
+
+	auto exit_code = -1;
+	if(waited != -1) {
+		if(WIFEXITED(status)) {
+			exit_code = WEXITSTATUS(status);
+		} else if(WIFSIGNALED(status)) {
+			exit_code = 128 + WTERMSIG(status);
+		}
+
+		out_usage.user_ms = timeval_ms(usage.ru_utime);
+		out_usage.sys_ms = timeval_ms(usage.ru_stime);
+#	ifdef __APPLE__
+		out_usage.peak_rss_bytes = static_cast<std::uint64_t>(usage.ru_maxrss);
+#	else
+		// Linux reports kilobytes
+		out_usage.peak_rss_bytes =
+			static_cast<std::uint64_t>(usage.ru_maxrss) * 1024;
+#	endif
+	}
+#endif
+
+	auto wall_time = std::chrono::steady_clock::now() - start;
+	out_usage.wall_ms =
+		std::chrono::duration<double, std::milli>{wall_time}.count();
+
+	return exit_code;
+}
+
 auto ecsact::cli::detail::spawn_and_report( //
 	std::filesystem::path    exe,
 	std::vector<std::string> args,
 	spawn_reporter&          reporter,
 	std::filesystem::path    start_dir
 ) -> int {
+	auto usage = subcommand_usage{};
+	return spawn_and_report(exe, args, reporter, start_dir, usage);
+}
+
+auto ecsact::cli::detail::spawn_and_report(
+	std::filesystem::path    exe,
+	std::vector<std::string> args,
+	spawn_reporter&          reporter,
+	std::filesystem::path    start_dir,
+	subcommand_usage&        out_usage
+) -> int {
+	auto start = std::chrono::steady_clock::now();
 	auto proc_stdout = bp::ipstream{};
 	auto proc_stderr = bp::ipstream{};
 
@@ -66,13 +178,12 @@ auto ecsact::cli::detail::spawn_and_report( //
 		ecsact::cli::report(msg);
 	}
 
-	proc.wait();
-
-	auto proc_exit_code = proc.exit_code();
+	auto proc_exit_code = wait_with_usage(proc, start, out_usage);
 
 	ecsact::cli::report(subcommand_end_message{
 		.id = subcommand_id,
 		.exit_code = proc_exit_code,
+		.usage = out_usage,
 	});
 
 	return proc_exit_code;
@@ -83,6 +194,17 @@ auto ecsact::cli::detail::spawn_and_report_output( //
 	std::vector<std::string> args,
 	std::filesystem::path    start_dir
 ) -> int {
+	auto usage = subcommand_usage{};
+	return spawn_and_report_output(exe, args, start_dir, usage);
+}
+
+auto ecsact::cli::detail::spawn_and_report_output(
+	std::filesystem::path    exe,
+	std::vector<std::string> args,
+	std::filesystem::path    start_dir,
+	subcommand_usage&        out_usage
+) -> int {
+	auto start = std::chrono::steady_clock::now();
 	auto proc_stdout = bp::ipstream{};
 	auto proc_stderr = bp::ipstream{};
 
@@ -105,13 +227,12 @@ auto ecsact::cli::detail::spawn_and_report_output( //
 	ecsact::cli::report_stdout(subcommand_id, proc_stdout);
 	ecsact::cli::report_stderr(subcommand_id, proc_stderr);
 
-	proc.wait();
-
-	auto proc_exit_code = proc.exit_code();
+	auto proc_exit_code = wait_with_usage(proc, start, out_usage);
 
 	ecsact::cli::report(subcommand_end_message{
 		.id = subcommand_id,
 		.exit_code = proc_exit_code,
+		.usage = out_usage,
 	});
 
 	return proc_exit_code;
@@ -152,6 +273,34 @@ auto ecsact::cli::detail::spawn_get_stdout_bytes( //
 	std::vector<std::string> args,
 	fs::path                 start_dir
 ) -> std::optional<std::vector<std::byte>> {
+	auto proc_stdout_bytes = std::vector<std::byte>{};
+	auto exit_code = spawn_read_stdout(
+		exe,
+		args,
+		[&](std::span<const std::byte> chunk) {
+			proc_stdout_bytes.insert(
+				proc_stdout_bytes.end(),
+				chunk.begin(),
+				chunk.end()
+			);
+			return true;
+		},
+		start_dir
+	);
+
+	if(exit_code != 0) {
+		return std::nullopt;
+	}
+
+	return proc_stdout_bytes;
+}
+
+auto ecsact::cli::detail::spawn_read_stdout(
+	std::filesystem::path                           exe,
+	std::vector<std::string>                        args,
+	std::function<bool(std::span<const std::byte>)> on_stdout,
+	fs::path                                        start_dir
+) -> int {
 	auto proc_stdout = bp::ipstream{};
 	auto proc = bp::child{
 		bp::exe(fs::absolute(exe)),
@@ -160,33 +309,52 @@ auto ecsact::cli::detail::spawn_get_stdout_bytes( //
 		bp::std_out > proc_stdout,
 	};
 
-	auto proc_stdout_bytes = std::vector<std::byte>{};
-	auto proc_stdout_bytes_buf = std::array<std::byte, 1024>{};
+	auto proc_stdout_buf = std::vector<std::byte>(64 * 1024);
 
 	while(proc_stdout) {
 		proc_stdout.read(
-			reinterpret_cast<char*>(proc_stdout_bytes_buf.data()),
-			proc_stdout_bytes_buf.size()
+			reinterpret_cast<char*>(proc_stdout_buf.data()),
+			static_cast<std::streamsize>(proc_stdout_buf.size())
 		);
 
-		auto read_amount = proc_stdout.gcount();
-		auto read_bytes = std::span{
-			proc_stdout_bytes_buf.data(),
-			static_cast<size_t>(read_amount),
-		};
+		auto read_amount = static_cast<std::size_t>(proc_stdout.gcount());
+		if(read_amount == 0) {
+			continue;
+		}
 
-		proc_stdout_bytes.insert(
-			proc_stdout_bytes.end(),
-			read_bytes.data(),
-			read_bytes.data() + read_bytes.size()
-		);
+		if(!on_stdout(std::span{proc_stdout_buf.data(), read_amount})) {
+			proc.terminate();
+			return -1;
+		}
 	}
 
 	proc.wait();
 
-	if(proc.exit_code() != 0) {
-		return std::nullopt;
+	return proc.exit_code();
+}
+
+auto ecsact::cli::detail::spawn_get_output( //
+	std::filesystem::path    exe,
+	std::vector<std::string> args,
+	fs::path                 start_dir
+) -> spawn_output {
+	auto proc_output = bp::ipstream{};
+	auto proc = bp::child{
+		bp::exe(fs::absolute(exe).string()),
+		bp::args(args),
+		bp::start_dir(start_dir.string()),
+		(bp::std_out & bp::std_err) > proc_output,
+	};
+
+	auto result = spawn_output{};
+	auto line = std::string{};
+	while(proc_output && std::getline(proc_output, line)) {
+		result.output += line;
+		result.output += "\n";
 	}
 
-	return proc_stdout_bytes;
+	proc.wait();
+	result.exit_code = proc.exit_code();
+
+	return result;
 }
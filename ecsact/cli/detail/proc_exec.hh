@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cstddef>
 #include <filesystem>
+#include <functional>
+#include <span>
 #include <vector>
 #include <string_view>
 #include <string>
@@ -47,6 +50,25 @@ auto spawn_and_report_output( //
 	std::filesystem::path    start_dir = std::filesystem::current_path()
 ) -> int;
 
+/**
+ * Same as above but also sets @p out_usage to the time and memory the process
+ * used
+ */
+auto spawn_and_report(
+	std::filesystem::path          exe,
+	std::vector<std::string>       args,
+	spawn_reporter&                reporter,
+	std::filesystem::path          start_dir,
+	ecsact::cli::subcommand_usage& out_usage
+) -> int;
+
+auto spawn_and_report_output(
+	std::filesystem::path          exe,
+	std::vector<std::string>       args,
+	std::filesystem::path          start_dir,
+	ecsact::cli::subcommand_usage& out_usage
+) -> int;
+
 /**
  * Spawn a process and return the stdout
  * @returns `std::nullopt` if spawn failed
@@ -62,4 +84,32 @@ auto spawn_get_stdout_bytes( //
 	std::vector<std::string> args,
 	std::filesystem::path    start_dir = std::filesystem::current_path()
 ) -> std::optional<std::vector<std::byte>>;
+
+/**
+ * Spawn a process and pass its stdout to @p on_stdout as it arrives instead of
+ * collecting it. The process is terminated if @p on_stdout returns `false`.
+ * @returns exit code
+ */
+auto spawn_read_stdout(
+	std::filesystem::path                           exe,
+	std::vector<std::string>                        args,
+	std::function<bool(std::span<const std::byte>)> on_stdout,
+	std::filesystem::path start_dir = std::filesystem::current_path()
+) -> int;
+
+struct spawn_output {
+	int exit_code;
+
+	/** stdout and stderr combined */
+	std::string output;
+};
+
+/**
+ * Spawn a process without reporting anything and collect its output
+ */
+auto spawn_get_output( //
+	std::filesystem::path    exe,
+	std::vector<std::string> args,
+	std::filesystem::path    start_dir = std::filesystem::current_path()
+) -> spawn_output;
 } // namespace ecsact::cli::detail
@@ -0,0 +1,562 @@
+#include "ecsact/cli/detail/socket.hh"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <format>
+#include <mutex>
+#include <utility>
+
+#ifdef _WIN32
+#	include <winsock2.h>
+#	include <ws2tcpip.h>
+#	include <afunix.h>
+#else
+#	include <errno.h>
+#	include <netdb.h>
+#	include <netinet/in.h>
+#	include <netinet/tcp.h>
+#	include <sys/socket.h>
+#	include <sys/time.h>
+#	include <sys/un.h>
+#	include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+using ecsact::cli::detail::socket_connection;
+using ecsact::cli::detail::socket_endpoint;
+using ecsact::cli::detail::socket_listener;
+
+#ifdef _WIN32
+using native_socket_t = SOCKET;
+constexpr auto INVALID_NATIVE_SOCKET = INVALID_SOCKET;
+
+static auto last_socket_error() -> std::error_code {
+	return {WSAGetLastError(), std::system_category()};
+}
+
+static auto close_native_socket(native_socket_t sock) -> void {
+	closesocket(sock);
+}
+
+static auto init_sockets() -> void {
+	static auto once = std::once_flag{};
+	std::call_once(once, [] {
+		auto wsa_data = WSADATA{};
+		WSAStartup(MAKEWORD(2, 2), &wsa_data);
+	});
+}
+#else
+using native_socket_t = int;
+constexpr auto INVALID_NATIVE_SOCKET = -1;
+
+static auto last_socket_error() -> std::error_code {
+	return {errno, std::system_category()};
+}
+
+static auto close_native_socket(native_socket_t sock) -> void {
+	::close(sock);
+}
+
+static auto init_sockets() -> void {
+}
+#endif
+
+/** Largest single send/recv so the size always fits the int length */
+constexpr auto MAX_IO_CHUNK = std::size_t{1} << 20;
+
+static auto interrupted() -> bool {
+#ifdef _WIN32
+	return false;
+#else
+	return errno == EINTR;
+#endif
+}
+
+#ifdef MSG_NOSIGNAL
+constexpr auto SEND_FLAGS = MSG_NOSIGNAL;
+#else
+constexpr auto SEND_FLAGS = 0;
+#endif
+
+static auto to_native(std::intptr_t handle) -> native_socket_t {
+	return static_cast<native_socket_t>(handle);
+}
+
+static auto from_native(native_socket_t sock) -> std::intptr_t {
+	if(sock == INVALID_NATIVE_SOCKET) {
+		return -1;
+	}
+	return static_cast<std::intptr_t>(sock);
+}
+
+static auto make_unix_address( //
+	const fs::path&  path,
+	sockaddr_un&     addr,
+	std::error_code& ec
+) -> bool {
+	auto path_str = path.string();
+	std::memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	if(path_str.size() >= sizeof(addr.sun_path)) {
+		ec = std::make_error_code(std::errc::filename_too_long);
+		return false;
+	}
+	std::memcpy(addr.sun_path, path_str.data(), path_str.size());
+	return true;
+}
+
+/**
+ * Disable the ~40ms Nagle delay. Requests and replies are small framed
+ * messages written back to back.
+ */
+static auto set_no_delay(native_socket_t sock) -> void {
+	auto enable = int{1};
+	setsockopt(
+		sock,
+		IPPROTO_TCP,
+		TCP_NODELAY,
+		reinterpret_cast<const char*>(&enable),
+		sizeof(enable)
+	);
+}
+
+/**
+ * Writing to a closed connection must fail instead of raising SIGPIPE. Linux
+ * uses MSG_NOSIGNAL for the same thing.
+ */
+static auto set_no_sigpipe([[maybe_unused]] native_socket_t sock) -> void {
+#ifdef SO_NOSIGPIPE
+	auto enable = int{1};
+	setsockopt(sock, SOL_SOCKET, SO_NOSIGPIPE, &enable, sizeof(enable));
+#endif
+}
+
+auto socket_endpoint::parse( //
+	std::string_view str
+) -> std::optional<socket_endpoint> {
+	if(str.empty()) {
+		return std::nullopt;
+	}
+
+	if(str.starts_with("unix:")) {
+		str.remove_prefix(5);
+		if(str.empty()) {
+			return std::nullopt;
+		}
+		return socket_endpoint{.unix_path = fs::path{str}};
+	}
+
+	// Anything that looks like a path is a unix socket
+	auto colon = str.rfind(':');
+	auto is_path = str.find_first_of("/\\") != std::string_view::npos;
+	if(is_path || colon == std::string_view::npos) {
+		return socket_endpoint{.unix_path = fs::path{str}};
+	}
+
+	auto port_str = str.substr(colon + 1);
+	auto port = std::uint16_t{};
+	auto [ptr, err] =
+		std::from_chars(port_str.data(), port_str.data() + port_str.size(), port);
+	if(err != std::errc{} || ptr != port_str.data() + port_str.size() ||
+		 port == 0) {
+		return std::nullopt;
+	}
+
+	auto host = std::string{str.substr(0, colon)};
+	if(host.empty()) {
+		host = "localhost";
+	} else if(host.starts_with('[') && host.ends_with(']')) {
+		// IPv6 [addr]:port
+		host = host.substr(1, host.size() - 2);
+	}
+
+	return socket_endpoint{.host = host, .port = port};
+}
+
+auto socket_endpoint::is_unix() const -> bool {
+	return !unix_path.empty();
+}
+
+auto socket_endpoint::to_string() const -> std::string {
+	if(is_unix()) {
+		return std::format("unix:{}", unix_path.generic_string());
+	}
+	return std::format("{}:{}", host, port);
+}
+
+socket_connection::socket_connection(std::intptr_t handle) : _handle(handle) {
+}
+
+socket_connection::socket_connection(socket_connection&& other) noexcept
+	: _handle(std::exchange(other._handle, -1)) {
+}
+
+auto socket_connection::operator=( //
+	socket_connection&& other
+) noexcept -> socket_connection& {
+	if(this != &other) {
+		close();
+		_handle = std::exchange(other._handle, -1);
+	}
+	return *this;
+}
+
+socket_connection::~socket_connection() {
+	close();
+}
+
+auto socket_connection::connect( //
+	const socket_endpoint& endpoint,
+	std::error_code&       ec
+) -> socket_connection {
+	init_sockets();
+	ec = {};
+
+	if(endpoint.is_unix()) {
+		auto addr = sockaddr_un{};
+		if(!make_unix_address(endpoint.unix_path, addr, ec)) {
+			return {};
+		}
+
+		auto sock = ::socket(AF_UNIX, SOCK_STREAM, 0);
+		if(sock == INVALID_NATIVE_SOCKET) {
+			ec = last_socket_error();
+			return {};
+		}
+
+		set_no_sigpipe(sock);
+
+		auto addr_ptr = reinterpret_cast<const sockaddr*>(&addr);
+		if(::connect(sock, addr_ptr, sizeof(addr)) != 0) {
+			ec = last_socket_error();
+			close_native_socket(sock);
+			return {};
+		}
+
+		return socket_connection{from_native(sock)};
+	}
+
+	auto hints = addrinfo{};
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+
+	auto port_str = std::to_string(endpoint.port);
+	auto addresses = static_cast<addrinfo*>(nullptr);
+	auto gai_result =
+		::getaddrinfo(endpoint.host.c_str(), port_str.c_str(), &hints, &addresses);
+	if(gai_result != 0) {
+		ec = std::make_error_code(std::errc::host_unreachable);
+		return {};
+	}
+
+	auto result = socket_connection{};
+	ec = std::make_error_code(std::errc::connection_refused);
+	for(auto addr = addresses; addr; addr = addr->ai_next) {
+		auto sock = ::socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+		if(sock == INVALID_NATIVE_SOCKET) {
+			ec = last_socket_error();
+			continue;
+		}
+
+		if(::connect(sock, addr->ai_addr, static_cast<int>(addr->ai_addrlen)) !=
+			 0) {
+			ec = last_socket_error();
+			close_native_socket(sock);
+			continue;
+		}
+
+		set_no_sigpipe(sock);
+		set_no_delay(sock);
+		result = socket_connection{from_native(sock)};
+		ec = {};
+		break;
+	}
+
+	::freeaddrinfo(addresses);
+	return result;
+}
+
+auto socket_connection::read_exact(std::span<std::byte> buffer) -> bool {
+	while(!buffer.empty()) {
+		auto chunk = static_cast<int>(std::min(buffer.size(), MAX_IO_CHUNK));
+		auto read_amount = ::recv(
+			to_native(_handle),
+			reinterpret_cast<char*>(buffer.data()),
+			chunk,
+			0
+		);
+		if(read_amount < 0 && interrupted()) {
+			continue;
+		}
+		if(read_amount <= 0) {
+			return false;
+		}
+		buffer = buffer.subspan(static_cast<std::size_t>(read_amount));
+	}
+	return true;
+}
+
+auto socket_connection::set_receive_timeout( //
+	std::chrono::milliseconds timeout
+) -> void {
+#ifdef _WIN32
+	auto timeout_value = static_cast<DWORD>(timeout.count());
+#else
+	auto timeout_value = timeval{};
+	timeout_value.tv_sec = static_cast<time_t>(timeout.count() / 1000);
+	timeout_value.tv_usec =
+		static_cast<suseconds_t>(timeout.count() % 1000 * 1000);
+#endif
+	setsockopt(
+		to_native(_handle),
+		SOL_SOCKET,
+		SO_RCVTIMEO,
+		reinterpret_cast<const char*>(&timeout_value),
+		sizeof(timeout_value)
+	);
+}
+
+auto socket_connection::write_all(std::span<const std::byte> data) -> bool {
+	while(!data.empty()) {
+		auto chunk = static_cast<int>(std::min(data.size(), MAX_IO_CHUNK));
+		auto written = ::send(
+			to_native(_handle),
+			reinterpret_cast<const char*>(data.data()),
+			chunk,
+			SEND_FLAGS
+		);
+		if(written < 0 && interrupted()) {
+			continue;
+		}
+		if(written <= 0) {
+			return false;
+		}
+		data = data.subspan(static_cast<std::size_t>(written));
+	}
+	return true;
+}
+
+auto socket_connection::close() -> void {
+	if(_handle != -1) {
+		close_native_socket(to_native(_handle));
+		_handle = -1;
+	}
+}
+
+socket_connection::operator bool() const {
+	return _handle != -1;
+}
+
+socket_listener::socket_listener(std::intptr_t handle, fs::path path)
+	: _handle(handle), _unix_path(std::move(path)) {
+}
+
+socket_listener::socket_listener(socket_listener&& other) noexcept
+	: _handle(std::exchange(other._handle, -1))
+	, _unix_path(std::exchange(other._unix_path, {})) {
+}
+
+auto socket_listener::operator=( //
+	socket_listener&& other
+) noexcept -> socket_listener& {
+	if(this != &other) {
+		close();
+		_handle = std::exchange(other._handle, -1);
+		_unix_path = std::exchange(other._unix_path, {});
+	}
+	return *this;
+}
+
+socket_listener::~socket_listener() {
+	close();
+}
+
+auto socket_listener::listen( //
+	const socket_endpoint& endpoint,
+	std::error_code&       ec
+) -> socket_listener {
+	init_sockets();
+	ec = {};
+
+	constexpr auto backlog = 64;
+
+	if(endpoint.is_unix()) {
+		auto addr = sockaddr_un{};
+		if(!make_unix_address(endpoint.unix_path, addr, ec)) {
+			return {};
+		}
+
+		// A socket file left behind by a previous listener would fail the bind.
+		// Anything else at the path is not ours to remove.
+		auto status_ec = std::error_code{};
+		auto status = fs::symlink_status(endpoint.unix_path, status_ec);
+		if(fs::is_socket(status)) {
+			fs::remove(endpoint.unix_path, status_ec);
+		} else if(fs::exists(status)) {
+			ec = std::make_error_code(std::errc::file_exists);
+			return {};
+		}
+
+		auto sock = ::socket(AF_UNIX, SOCK_STREAM, 0);
+		if(sock == INVALID_NATIVE_SOCKET) {
+			ec = last_socket_error();
+			return {};
+		}
+
+		auto addr_ptr = reinterpret_cast<const sockaddr*>(&addr);
+		if(::bind(sock, addr_ptr, sizeof(addr)) != 0) {
+			ec = last_socket_error();
+			close_native_socket(sock);
+			return {};
+		}
+
+		// Only the listening user may connect. Connecting fails until listen so
+		// the default permissions are never usable.
+		fs::permissions(
+			endpoint.unix_path,
+			fs::perms::owner_read | fs::perms::owner_write,
+			ec
+		);
+		if(!ec && ::listen(sock, backlog) != 0) {
+			ec = last_socket_error();
+		}
+
+		if(ec) {
+			close_native_socket(sock);
+			fs::remove(endpoint.unix_path, status_ec);
+			return {};
+		}
+
+		return socket_listener{from_native(sock), endpoint.unix_path};
+	}
+
+	auto hints = addrinfo{};
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	hints.ai_flags = AI_PASSIVE;
+
+	auto port_str = std::to_string(endpoint.port);
+	auto addresses = static_cast<addrinfo*>(nullptr);
+	auto gai_result =
+		::getaddrinfo(endpoint.host.c_str(), port_str.c_str(), &hints, &addresses);
+	if(gai_result != 0) {
+		ec = std::make_error_code(std::errc::address_not_available);
+		return {};
+	}
+
+	auto result = socket_listener{};
+	ec = std::make_error_code(std::errc::address_not_available);
+	for(auto addr = addresses; addr; addr = addr->ai_next) {
+		auto sock = ::socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+		if(sock == INVALID_NATIVE_SOCKET) {
+			ec = last_socket_error();
+			continue;
+		}
+
+		auto reuse = int{1};
+		setsockopt(
+			sock,
+			SOL_SOCKET,
+			SO_REUSEADDR,
+			reinterpret_cast<const char*>(&reuse),
+			sizeof(reuse)
+		);
+
+		if(::bind(sock, addr->ai_addr, static_cast<int>(addr->ai_addrlen)) != 0 ||
+			 ::listen(sock, backlog) != 0) {
+			ec = last_socket_error();
+			close_native_socket(sock);
+			continue;
+		}
+
+		result = socket_listener{from_native(sock), {}};
+		ec = {};
+		break;
+	}
+
+	::freeaddrinfo(addresses);
+	return result;
+}
+
+auto socket_listener::accept(std::error_code& ec) -> socket_connection {
+	ec = {};
+	auto sock = ::accept(to_native(_handle), nullptr, nullptr);
+	if(sock == INVALID_NATIVE_SOCKET) {
+		ec = last_socket_error();
+		return {};
+	}
+
+	set_no_sigpipe(sock);
+	if(_unix_path.empty()) {
+		set_no_delay(sock);
+	}
+
+	return socket_connection{from_native(sock)};
+}
+
+auto socket_listener::close() -> void {
+	if(_handle != -1) {
+		close_native_socket(to_native(_handle));
+		_handle = -1;
+	}
+
+	if(!_unix_path.empty()) {
+		auto ec = std::error_code{};
+		fs::remove(_unix_path, ec);
+		_unix_path.clear();
+	}
+}
+
+socket_listener::operator bool() const {
+	return _handle != -1;
+}
+
+auto ecsact::cli::detail::write_frame(
+	socket_connection&         conn,
+	std::span<const std::byte> data
+) -> bool {
+	auto size_bytes = std::array<std::byte, 8>{};
+	auto size = static_cast<std::uint64_t>(data.size());
+	for(auto i = 0; 8 > i; ++i) {
+		size_bytes[i] = static_cast<std::byte>((size >> (i * 8)) & 0xFF);
+	}
+
+	return conn.write_all(size_bytes) && conn.write_all(data);
+}
+
+auto ecsact::cli::detail::read_frame(
+	socket_connection&      conn,
+	std::uint64_t           max_size,
+	std::vector<std::byte>& out_data
+) -> bool {
+	auto size_bytes = std::array<std::byte, 8>{};
+	if(!conn.read_exact(size_bytes)) {
+		return false;
+	}
+
+	auto size = std::uint64_t{};
+	for(auto i = 0; 8 > i; ++i) {
+		size |= static_cast<std::uint64_t>(size_bytes[i]) << (i * 8);
+	}
+
+	if(size > max_size) {
+		return false;
+	}
+
+	// Grown as bytes arrive so a peer can't reserve memory by claiming a size
+	out_data.clear();
+	while(size > out_data.size()) {
+		auto offset = out_data.size();
+		auto chunk =
+			std::min(static_cast<std::size_t>(size) - offset, MAX_IO_CHUNK);
+		out_data.resize(offset + chunk);
+		if(!conn.read_exact(std::span{out_data}.subspan(offset))) {
+			return false;
+		}
+	}
+
+	return true;
+}
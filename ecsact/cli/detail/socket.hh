@@ -0,0 +1,144 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace ecsact::cli::detail {
+
+/**
+ * How long either end of a connection waits for its peer while the
+ * connection is set up. Peers that stay quiet longer are dropped instead of
+ * holding on to a thread. See `socket_connection::set_receive_timeout`.
+ */
+constexpr auto HANDSHAKE_TIMEOUT = std::chrono::milliseconds{5000};
+
+/**
+ * Address of a stream socket. Either a unix domain socket path or a TCP
+ * host and port.
+ */
+struct socket_endpoint {
+	/** Unix domain socket path. Empty for TCP endpoints. */
+	std::filesystem::path unix_path;
+
+	std::string   host;
+	std::uint16_t port = 0;
+
+	/**
+	 * Parse `host:port`, `unix:<path>` or a plain socket path
+	 * @returns `std::nullopt` if @p str is empty or has an invalid port
+	 */
+	static auto parse(std::string_view str) -> std::optional<socket_endpoint>;
+
+	auto is_unix() const -> bool;
+	auto to_string() const -> std::string;
+};
+
+/**
+ * Connected stream socket. Closed when destroyed.
+ */
+class socket_connection {
+public:
+	static auto connect( //
+		const socket_endpoint& endpoint,
+		std::error_code&       ec
+	) -> socket_connection;
+
+	socket_connection() = default;
+	socket_connection(socket_connection&&) noexcept;
+	auto operator=(socket_connection&&) noexcept -> socket_connection&;
+	~socket_connection();
+
+	/**
+	 * Read exactly `buffer.size()` bytes
+	 * @returns `false` if the connection closed or failed first
+	 */
+	auto read_exact(std::span<std::byte> buffer) -> bool;
+
+	/**
+	 * @returns `false` if the connection closed or failed before everything was
+	 * written
+	 */
+	auto write_all(std::span<const std::byte> data) -> bool;
+
+	/**
+	 * Make `read_exact` fail when no data arrives for @p timeout. Zero waits
+	 * forever.
+	 */
+	auto set_receive_timeout(std::chrono::milliseconds timeout) -> void;
+
+	auto close() -> void;
+
+	explicit operator bool() const;
+
+private:
+	friend class socket_listener;
+	explicit socket_connection(std::intptr_t handle);
+
+	std::intptr_t _handle = -1;
+};
+
+/**
+ * Listening stream socket. Unix socket files are only accessible by the
+ * listening user and are removed when destroyed.
+ */
+class socket_listener {
+public:
+	/**
+	 * Replaces a socket file left at a unix endpoint path. Fails with
+	 * `std::errc::file_exists` if anything else is there.
+	 */
+	static auto listen( //
+		const socket_endpoint& endpoint,
+		std::error_code&       ec
+	) -> socket_listener;
+
+	socket_listener() = default;
+	socket_listener(socket_listener&&) noexcept;
+	auto operator=(socket_listener&&) noexcept -> socket_listener&;
+	~socket_listener();
+
+	/**
+	 * Wait for the next connection
+	 */
+	auto accept(std::error_code& ec) -> socket_connection;
+
+	auto close() -> void;
+
+	explicit operator bool() const;
+
+private:
+	explicit socket_listener(std::intptr_t handle, std::filesystem::path path);
+
+	std::intptr_t         _handle = -1;
+	std::filesystem::path _unix_path;
+};
+
+/**
+ * Write @p data as one frame. A frame is a 64-bit little endian size followed
+ * by the bytes.
+ */
+auto write_frame(
+	socket_connection&         conn,
+	std::span<const std::byte> data
+) -> bool;
+
+/**
+ * Read one frame written by `write_frame`
+ * @returns `false` if the connection closed or the frame is larger than
+ * @p max_size. Memory is only allocated for bytes actually received.
+ */
+auto read_frame(
+	socket_connection&      conn,
+	std::uint64_t           max_size,
+	std::vector<std::byte>& out_data
+) -> bool;
+
+} // namespace ecsact::cli::detail
@@ -4,6 +4,7 @@
 #include <format>
 
 using ecsact::cli::alert_message;
+using ecsact::cli::build_steps_report_message;
 using ecsact::cli::ecsact_error_message;
 using ecsact::cli::error_message;
 using ecsact::cli::info_message;
@@ -14,7 +15,9 @@ using ecsact::cli::subcommand_progress_message;
 using ecsact::cli::subcommand_start_message;
 using ecsact::cli::subcommand_stderr_message;
 using ecsact::cli::subcommand_stdout_message;
+using ecsact::cli::subcommand_usage;
 using ecsact::cli::success_message;
+using ecsact::cli::time_trace_report_message;
 using ecsact::cli::warning_message;
 
 // TODO(zaucy): figure out colored output for windows
@@ -144,18 +147,99 @@ auto print_text_report(auto&& output, const subcommand_progress_message& msg)
 	);
 }
 
+auto format_usage(const subcommand_usage& usage) -> std::string {
+	return std::format(
+		"{:.1f}ms wall, {:.1f}ms user, {:.1f}ms sys, {:.1f} MiB peak",
+		usage.wall_ms,
+		usage.user_ms,
+		usage.sys_ms,
+		static_cast<double>(usage.peak_rss_bytes) / (1024.0 * 1024.0)
+	);
+}
+
 auto print_text_report(auto&& output, const subcommand_end_message& msg)
 	-> void {
-	get_outputstream(output, std::cout) << std::format( //
-		COLOR_BLU "SUBCOMMAND({})   END << " COLOR_RESET " exit code {}\n",
-		msg.id,
-		msg.exit_code
-	);
+	if(msg.usage.wall_ms > 0.0) {
+		get_outputstream(output, std::cout) << std::format( //
+			COLOR_BLU "SUBCOMMAND({})   END << " COLOR_RESET " exit code {} ({})\n",
+			msg.id,
+			msg.exit_code,
+			format_usage(msg.usage)
+		);
+	} else {
+		get_outputstream(output, std::cout) << std::format( //
+			COLOR_BLU "SUBCOMMAND({})   END << " COLOR_RESET " exit code {}\n",
+			msg.id,
+			msg.exit_code
+		);
+	}
 }
 
 auto print_text_report(auto&& output, const output_path_message& msg) -> void {
 	get_outputstream(output, std::cout) << msg.output_path << "\n";
 }
+
+auto print_time_trace_entries(
+	auto&&                                               output,
+	std::string_view                                     title,
+	const std::vector<time_trace_report_message::entry>& entries
+) -> void {
+	if(entries.empty()) {
+		return;
+	}
+
+	output << std::format("    {}:\n", title);
+	for(auto& entry : entries) {
+		if(entry.count > 1) {
+			output << std::format(
+				"    {:>10.1f}ms  {} (x{})\n",
+				entry.duration_ms,
+				entry.name,
+				entry.count
+			);
+		} else {
+			output << std::format(
+				"    {:>10.1f}ms  {}\n",
+				entry.duration_ms,
+				entry.name
+			);
+		}
+	}
+}
+
+auto print_text_report(auto&& output, const time_trace_report_message& msg)
+	-> void {
+	auto&& out = get_outputstream(output, std::cout);
+	out << std::format( //
+		COLOR_MAG "TIME TRACE:" COLOR_RESET " frontend {:.1f}ms backend {:.1f}ms\n",
+		msg.total_frontend_ms,
+		msg.total_backend_ms
+	);
+	print_time_trace_entries(out, "Slowest sources", msg.sources);
+	print_time_trace_entries(out, "Most expensive headers", msg.headers);
+	print_time_trace_entries(out, "Template instantiations", msg.templates);
+	print_time_trace_entries(out, "Code generation", msg.functions);
+}
+
+auto print_text_report(auto&& output, const build_steps_report_message& msg)
+	-> void {
+	auto&& out = get_outputstream(output, std::cout);
+	out << std::format( //
+		COLOR_MAG "BUILD STEPS:" COLOR_RESET " {} run, {:.1f}ms wall, {:.1f}ms cpu\n",
+		msg.total_steps,
+		msg.total_wall_ms,
+		msg.total_cpu_ms
+	);
+	for(auto& step : msg.slowest) {
+		out << std::format(
+			"    {:>10.1f}ms  {} {} ({})\n",
+			step.usage.wall_ms,
+			step.kind,
+			step.name,
+			format_usage(step.usage)
+		);
+	}
+}
 } // namespace
 
 auto ecsact::cli::detail::text_report::operator()( //
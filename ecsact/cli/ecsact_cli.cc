@@ -3,9 +3,14 @@
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 #include "ecsact/cli/bazel_stamp_header.hh"
+#include "ecsact/cli/commands/benchmark.hh"
 #include "ecsact/cli/commands/build.hh"
+#include "ecsact/cli/commands/build-worker.hh"
 #include "ecsact/cli/commands/codegen.hh"
+#include "ecsact/cli/commands/daemon.hh"
+#include "ecsact/cli/commands/daemon/daemon_client.hh"
 #include "ecsact/cli/commands/recipe-bundle.hh"
 #include "ecsact/cli/commands/command.hh"
 #include "ecsact/cli/commands/config.hh"
@@ -34,8 +39,10 @@ Usage:
 	ecsact (--version | -v)
 	ecsact benchmark ([<options>...] | --help)
 	ecsact build ([<options>...] | --help)
+	ecsact build-worker ([<options>...] | --help)
 	ecsact codegen ([<options>...] | --help)
 	ecsact config ([<options>...] | --help)
+	ecsact daemon ([<options>...] | --help)
 	ecsact recipe-bundle ([<options>...] | --help)
 )";
 
@@ -75,10 +82,12 @@ int main(int argc, const char* argv[]) {
 	using ecsact::cli::detail::command_fn_t;
 
 	const std::unordered_map<std::string, command_fn_t> commands{
-		// {"benchmark", &ecsact::cli::detail::benchmark_command},
+		{"benchmark", &ecsact::cli::detail::benchmark_command},
 		{"build", &ecsact::cli::detail::build_command},
+		{"build-worker", &ecsact::cli::detail::build_worker_command},
 		{"codegen", &ecsact::cli::detail::codegen_command},
 		{"config", &ecsact::cli::detail::config_command},
+		{"daemon", &ecsact::cli::detail::daemon_command},
 		{"recipe-bundle", &ecsact::cli::detail::recipe_bundle_command},
 	};
 
@@ -112,6 +121,15 @@ int main(int argc, const char* argv[]) {
 			return 2;
 		}
 
+		// The daemon tells the client to run commands it doesn't run itself
+		if(auto endpoint = ecsact::cli::daemon::daemon_endpoint_from_env()) {
+			auto args = std::vector<std::string>{argv, argv + argc};
+			auto exit_code = ecsact::cli::daemon::run_in_daemon(*endpoint, args);
+			if(exit_code) {
+				return *exit_code;
+			}
+		}
+
 		return commands.at(command)(argc, argv);
 	}
 
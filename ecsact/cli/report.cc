@@ -2,6 +2,7 @@
 #include "report_message.hh"
 
 #include <array>
+#include <mutex>
 
 using ecsact::cli::report_filter;
 
@@ -10,6 +11,9 @@ static auto _report_handler =
 
 static auto _report_filter = report_filter::none;
 
+// Compile jobs report from multiple threads at once
+static auto _report_mutex = std::mutex{};
+
 template<typename T>
 struct report_filter_category {
 	static constexpr auto filters = std::array{
@@ -76,6 +80,7 @@ auto ecsact::cli::report( //
 ) -> void {
 	if(_report_handler) {
 		if(should_report_message(message)) {
+			auto lk = std::scoped_lock{_report_mutex};
 			_report_handler(message);
 		}
 	}
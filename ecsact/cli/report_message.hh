@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string_view>
 #include <string>
 #include <variant>
@@ -95,10 +96,27 @@ struct subcommand_progress_message {
 	std::string           description;
 };
 
+/**
+ * Time and memory used by a finished subcommand. All zero if unknown.
+ */
+struct subcommand_usage {
+	double wall_ms = 0.0;
+
+	/** CPU time spent in the subcommand itself */
+	double user_ms = 0.0;
+
+	/** CPU time spent in the kernel on behalf of the subcommand */
+	double sys_ms = 0.0;
+
+	/** Peak resident set size (peak working set on Windows) */
+	std::uint64_t peak_rss_bytes = 0;
+};
+
 struct subcommand_end_message {
 	static constexpr auto type = std::string_view{"subcommand_end"};
 	subcommand_id_t       id;
 	int                   exit_code;
+	subcommand_usage      usage = {};
 };
 
 struct output_path_message {
@@ -106,6 +124,60 @@ struct output_path_message {
 	std::string           output_path;
 };
 
+/**
+ * Aggregated compiler time traces of every translation unit in a build
+ */
+struct time_trace_report_message {
+	static constexpr auto type = std::string_view{"time_trace_report"};
+
+	struct entry {
+		std::string name;
+
+		/** Total time in milliseconds. Nested entries are counted inclusively. */
+		double duration_ms;
+
+		/** Number of times this entry occurred across all translation units */
+		int count;
+	};
+
+	double total_frontend_ms;
+	double total_backend_ms;
+
+	/** Slowest translation units */
+	std::vector<entry> sources;
+
+	/** Headers by total time spent parsing them and their includes */
+	std::vector<entry> headers;
+
+	/** Most expensive template instantiations */
+	std::vector<entry> templates;
+
+	/** Functions that took the longest to optimize and generate code for */
+	std::vector<entry> functions;
+};
+
+/**
+ * Slowest compile and link subcommands of a build
+ */
+struct build_steps_report_message {
+	static constexpr auto type = std::string_view{"build_steps_report"};
+
+	struct step {
+		/** `compile` or `link` */
+		std::string      kind;
+		std::string      name;
+		subcommand_usage usage;
+	};
+
+	/** Number of subcommands run, including the ones not listed */
+	int    total_steps;
+	double total_wall_ms;
+	double total_cpu_ms;
+
+	/** Slowest steps by wall time */
+	std::vector<step> slowest;
+};
+
 using message_variant_t = std::variant<
 	alert_message,
 	info_message,
@@ -119,5 +191,7 @@ using message_variant_t = std::variant<
 	subcommand_stderr_message,
 	subcommand_progress_message,
 	subcommand_end_message,
-	output_path_message>;
+	output_path_message,
+	time_trace_report_message,
+	build_steps_report_message>;
 } // namespace ecsact::cli
@@ -0,0 +1,339 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <format>
+#include <ranges>
+#include <filesystem>
+#include <fstream>
+#include <boost/process.hpp>
+#include "nlohmann/json.hpp"
+
+using namespace std::string_literals;
+namespace fs = std::filesystem;
+namespace bp = boost::process;
+
+namespace {
+
+struct benchmark_run {
+	int                         exit_code = 0;
+	std::vector<nlohmann::json> messages;
+
+	auto of_type(std::string_view type) const -> std::vector<nlohmann::json> {
+		auto result = std::vector<nlohmann::json>{};
+		for(auto& message : messages) {
+			if(message.value("type", ""s) == type) {
+				result.push_back(message);
+			}
+		}
+		return result;
+	}
+};
+
+class Benchmark : public testing::Test {
+protected:
+	fs::path test_dir;
+	fs::path wasm_path;
+	fs::path seed_path;
+
+	void SetUp() override {
+		ASSERT_NE(std::getenv("TEST_ECSACT_CLI"), nullptr);
+		ASSERT_NE(std::getenv("TEST_FAKE_RUNTIME_PATH"), nullptr);
+
+		auto test_info = testing::UnitTest::GetInstance()->current_test_info();
+		test_dir = fs::path{testing::TempDir()} / "ecsact_benchmark_test" /
+			test_info->name();
+		fs::remove_all(test_dir);
+		fs::create_directories(test_dir);
+
+		// The fake runtime only checks that system impl files exist
+		wasm_path = test_dir / "systems.wasm";
+		std::ofstream{wasm_path, std::ios_base::binary} << "\0asm"s;
+
+		seed_path = test_dir / "seed";
+		std::ofstream{seed_path, std::ios_base::binary} << "seed";
+	}
+
+	void TearDown() override {
+		fs::remove_all(test_dir);
+	}
+
+	auto runtime_arg() const -> std::string {
+		auto runtime_path = fs::absolute(std::getenv("TEST_FAKE_RUNTIME_PATH"));
+		return std::format("--runtime={}", runtime_path.string());
+	}
+
+	auto seed_arg() const -> std::string {
+		return std::format("--seed={}", seed_path.string());
+	}
+
+	auto run_benchmark(
+		std::vector<std::string> args,
+		bp::environment          env = boost::this_process::environment()
+	) -> benchmark_run {
+		args.insert(args.begin(), "benchmark"s);
+
+		auto proc_stdout = bp::ipstream{};
+		auto proc = bp::child{
+			bp::exe(std::getenv("TEST_ECSACT_CLI")),
+			bp::args(args),
+			bp::std_out > proc_stdout,
+			env,
+		};
+
+		auto run = benchmark_run{};
+		auto line = std::string{};
+		while(std::getline(proc_stdout, line)) {
+			if(line.ends_with("\r")) {
+				line.pop_back();
+			}
+			run.messages.push_back(nlohmann::json::parse(line));
+		}
+
+		proc.wait();
+		run.exit_code = proc.exit_code();
+		return run;
+	}
+};
+
+} // namespace
+
+TEST_F(Benchmark, Execute) {
+	auto run = run_benchmark({
+		wasm_path.string(),
+		runtime_arg(),
+		seed_arg(),
+		"--iterations=50"s,
+	});
+	ASSERT_EQ(run.exit_code, 0);
+
+	ASSERT_EQ(run.of_type("wasm_load").size(), 1);
+	EXPECT_EQ(run.of_type("wasm_load")[0]["path"], wasm_path.string());
+
+	auto results = run.of_type("result");
+	ASSERT_EQ(results.size(), 1);
+	EXPECT_GE(results[0]["total_duration_ms"].get<float>(), 0.f);
+}
+
+TEST_F(Benchmark, ExecuteAsync) {
+	auto run = run_benchmark({
+		wasm_path.string(),
+		runtime_arg(),
+		seed_arg(),
+		"--async=fake"s,
+		"--iterations=50"s,
+	});
+	ASSERT_EQ(run.exit_code, 0);
+	EXPECT_EQ(run.of_type("error").size(), 0);
+	EXPECT_EQ(run.of_type("result").size(), 1);
+}
+
+TEST_F(Benchmark, InvalidMode) {
+	auto run = run_benchmark({
+		wasm_path.string(),
+		"--mode=invalid"s,
+		runtime_arg(),
+		seed_arg(),
+	});
+	EXPECT_NE(run.exit_code, 0);
+	EXPECT_TRUE(run.messages.empty());
+}
+
+TEST_F(Benchmark, WasmReload) {
+	auto run = run_benchmark({
+		"--mode=wasm-reload"s,
+		wasm_path.string(),
+		runtime_arg(),
+		"--iterations=20"s,
+	});
+	ASSERT_EQ(run.exit_code, 0);
+
+	auto results = run.of_type("wasm_reload_result");
+	ASSERT_EQ(results.size(), 1);
+	EXPECT_EQ(results[0]["path"], wasm_path.string());
+	EXPECT_EQ(results[0]["iterations"], 20);
+
+	auto& reload_latency = results[0]["reload_latency"];
+	for(auto key : {"min_ms", "mean_ms", "p50_ms", "p99_ms", "max_ms"}) {
+		ASSERT_TRUE(reload_latency.contains(key)) << key;
+	}
+	EXPECT_LE(
+		reload_latency["min_ms"].get<float>(),
+		reload_latency["max_ms"].get<float>()
+	);
+}
+
+TEST_F(Benchmark, Profile) {
+#ifdef _WIN32
+	GTEST_SKIP() << "CPU sampling is not available on Windows";
+#endif
+
+	auto profile_path = test_dir / "profile.folded";
+	bp::environment env = boost::this_process::environment();
+	env["FAKE_RUNTIME_BUSY_US"] = "1000";
+
+	auto run = run_benchmark(
+		{
+			wasm_path.string(),
+			runtime_arg(),
+			seed_arg(),
+			"--iterations=300"s,
+			std::format("--profile={}", profile_path.string()),
+		},
+		env
+	);
+	ASSERT_EQ(run.exit_code, 0);
+
+	auto profiles = run.of_type("profile");
+	ASSERT_EQ(profiles.size(), 1);
+	EXPECT_EQ(profiles[0]["path"], profile_path.string());
+	EXPECT_GT(profiles[0]["sample_count"].get<int>(), 0);
+
+	// Every folded line is `frame;frame;... count` and the busy loop lives in
+	// the runtime's ecsact_execute_systems
+	auto profile_file = std::ifstream{profile_path};
+	ASSERT_TRUE(profile_file);
+	auto found_execute_systems = false;
+	auto line = std::string{};
+	while(std::getline(profile_file, line)) {
+		ASSERT_NE(line.rfind(' '), std::string::npos) << line;
+		if(line.find("ecsact_execute_systems") != std::string::npos) {
+			found_execute_systems = true;
+		}
+	}
+	EXPECT_TRUE(found_execute_systems);
+}
+
+TEST_F(Benchmark, Serialize) {
+	auto run = run_benchmark({
+		"--mode=serialize"s,
+		runtime_arg(),
+		seed_arg(),
+		"--iterations=10"s,
+	});
+	ASSERT_EQ(run.exit_code, 0);
+
+	auto results = run.of_type("serialize_result");
+	ASSERT_EQ(results.size(), 1);
+	EXPECT_EQ(results[0]["entity_count"], 2);
+	EXPECT_GT(results[0]["dump_size_bytes"].get<int>(), 0);
+
+	// The fake runtime allocates its dump buffer through malloc
+	auto& dump = results[0]["dump"];
+#ifdef __linux__
+	EXPECT_EQ(dump["allocations"], 10);
+	EXPECT_EQ(dump["allocated_bytes"], 40);
+#else
+	EXPECT_TRUE(dump["allocations"].is_null());
+#endif
+
+	auto& components = results[0]["components"];
+	ASSERT_EQ(components.size(), 1);
+	EXPECT_EQ(components[0]["component_id"], 1);
+	EXPECT_EQ(components[0]["serialized_size"], 24);
+	EXPECT_GT(components[0]["count"].get<int>(), 0);
+}
+
+TEST_F(Benchmark, Soak) {
+	auto run = run_benchmark({
+		"--mode=soak"s,
+		wasm_path.string(),
+		runtime_arg(),
+		seed_arg(),
+		"--iterations=100"s,
+		"--window=20"s,
+	});
+	ASSERT_EQ(run.exit_code, 0);
+
+	auto windows = run.of_type("soak_window");
+	ASSERT_EQ(windows.size(), 5);
+	for(auto i = std::size_t{0}; windows.size() > i; ++i) {
+		EXPECT_EQ(windows[i]["window"], i);
+		EXPECT_EQ(windows[i]["start_tick"], i * 20);
+		EXPECT_EQ(windows[i]["ticks"], 20);
+	}
+
+	auto results = run.of_type("soak_result");
+	ASSERT_EQ(results.size(), 1);
+	EXPECT_EQ(results[0]["windows"], 5);
+	EXPECT_EQ(results[0]["ticks"], 100);
+
+	// The fake runtime doesn't allocate while executing and the benchmark's
+	// own allocations aren't counted
+#ifdef __linux__
+	for(auto& window : windows) {
+		EXPECT_EQ(window["allocations"], 0);
+		EXPECT_EQ(window["live_allocations"], 0);
+	}
+	EXPECT_FALSE(results[0]["live_allocation_growth"].get<bool>());
+#else
+	EXPECT_TRUE(results[0]["live_allocation_growth"].is_null());
+#endif
+}
+
+TEST_F(Benchmark, SoakLatencyGrowth) {
+	bp::environment env = boost::this_process::environment();
+	env["FAKE_RUNTIME_LATENCY_GROWTH"] = "1";
+
+	auto run = run_benchmark(
+		{
+			"--mode=soak"s,
+			wasm_path.string(),
+			runtime_arg(),
+			seed_arg(),
+			"--iterations=100"s,
+			"--window=20"s,
+		},
+		env
+	);
+	ASSERT_EQ(run.exit_code, 0);
+
+	auto results = run.of_type("soak_result");
+	ASSERT_EQ(results.size(), 1);
+	EXPECT_TRUE(results[0]["latency_growth"].get<bool>());
+}
+
+TEST_F(Benchmark, AsyncLoad) {
+	auto run = run_benchmark({
+		"--mode=async-load"s,
+		wasm_path.string(),
+		runtime_arg(),
+		seed_arg(),
+		"--async=fake"s,
+		"--rate=50,100"s,
+		"--step_duration=1"s,
+	});
+	ASSERT_EQ(run.exit_code, 0);
+
+	auto steps = run.of_type("async_load_step");
+	ASSERT_EQ(steps.size(), 2);
+	EXPECT_EQ(steps[0]["rate_per_second"], 50.f);
+	EXPECT_EQ(steps[1]["rate_per_second"], 100.f);
+	for(auto& step : steps) {
+		EXPECT_GT(step["enqueued"].get<int>(), 0);
+		EXPECT_EQ(step["completed"], step["enqueued"]);
+		EXPECT_FALSE(step["saturated"].get<bool>());
+	}
+
+	auto results = run.of_type("async_load_result");
+	ASSERT_EQ(results.size(), 1);
+	EXPECT_EQ(results[0]["steps"], 2);
+	EXPECT_EQ(results[0]["max_sustained_rate_per_second"], 100.f);
+}
+
+TEST_F(Benchmark, Profraw) {
+	auto profraw_path = test_dir / "runtime.profraw";
+
+	auto run = run_benchmark({
+		wasm_path.string(),
+		runtime_arg(),
+		seed_arg(),
+		"--iterations=10"s,
+		std::format("--profraw={}", profraw_path.string()),
+	});
+	ASSERT_EQ(run.exit_code, 0);
+
+	// The runtime is handed LLVM_PROFILE_FILE and writes it when unloaded
+	ASSERT_TRUE(fs::exists(profraw_path));
+	EXPECT_GT(fs::file_size(profraw_path), 0);
+}
@@ -0,0 +1,276 @@
+// A tiny runtime implementing just enough of the core, serialize, async and
+// si_wasm modules for `ecsact benchmark` to run every mode against it.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+#include "ecsact/runtime/core.h"
+#include "ecsact/runtime/serialize.h"
+#include "ecsact/runtime/async.h"
+#include "ecsact/si/wasm.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr auto test_component_id = static_cast<ecsact_component_id>(1);
+constexpr auto entity_count = 2;
+
+// Not a multiple of alignof(std::max_align_t) on purpose
+struct test_component {
+	std::int64_t value;
+	std::int32_t extra[3];
+};
+
+auto execute_count = std::int64_t{0};
+auto async_tick = std::int32_t{0};
+auto async_next_req_id = std::int32_t{0};
+auto async_started = false;
+auto async_pending = std::vector<ecsact_async_request_id>{};
+
+/**
+ * Writes a placeholder profile on unload like a runtime built with
+ * `ecsact build --pgo=instrument` would
+ */
+struct fake_profile_writer {
+	~fake_profile_writer() {
+		auto profile_file = std::getenv("LLVM_PROFILE_FILE");
+		if(profile_file != nullptr) {
+			auto file = std::ofstream{profile_file, std::ios_base::binary};
+			file << "fake profraw";
+		}
+	}
+} profile_writer;
+
+} // namespace
+
+ecsact_registry_id ecsact_create_registry(const char*) {
+	return static_cast<ecsact_registry_id>(0);
+}
+
+void ecsact_clear_registry(ecsact_registry_id) {
+}
+
+int32_t ecsact_count_entities(ecsact_registry_id) {
+	return entity_count;
+}
+
+void ecsact_get_entities(
+	ecsact_registry_id,
+	int32_t           max_entities_count,
+	ecsact_entity_id* out_entities,
+	int32_t*          out_entities_count
+) {
+	auto count = std::min(max_entities_count, entity_count);
+	for(auto i = 0; count > i; ++i) {
+		out_entities[i] = static_cast<ecsact_entity_id>(i);
+	}
+	if(out_entities_count != nullptr) {
+		*out_entities_count = count;
+	}
+}
+
+void ecsact_each_component(
+	ecsact_registry_id,
+	ecsact_entity_id               entity,
+	ecsact_each_component_callback callback,
+	void*                          callback_user_data
+) {
+	auto component = test_component{.value = static_cast<std::int64_t>(entity)};
+	callback(test_component_id, &component, callback_user_data);
+}
+
+ecsact_execute_systems_error ecsact_execute_systems(
+	ecsact_registry_id,
+	int execution_count,
+	const ecsact_execution_options*,
+	const ecsact_execution_events_collector*
+) {
+	// Burn CPU time so the sampling profiler has something to sample
+	if(auto busy_us = std::getenv("FAKE_RUNTIME_BUSY_US"); busy_us != nullptr) {
+		auto busy_end = std::chrono::steady_clock::now() +
+			std::chrono::microseconds{std::atoi(busy_us)};
+		while(std::chrono::steady_clock::now() < busy_end) {
+		}
+	}
+
+	// Latency that keeps climbing is what soak mode is expected to flag
+	if(std::getenv("FAKE_RUNTIME_LATENCY_GROWTH") != nullptr) {
+		auto sleep_us = 200 * (1 + execute_count / 20);
+		std::this_thread::sleep_for(std::chrono::microseconds{sleep_us});
+	}
+
+	execute_count += execution_count;
+	return ECSACT_EXEC_SYS_OK;
+}
+
+int32_t ecsact_serialize_component_size(ecsact_component_id) {
+	return sizeof(test_component);
+}
+
+int ecsact_serialize_component(
+	ecsact_component_id,
+	const void* in_component_data,
+	uint8_t*    out_bytes
+) {
+	std::memcpy(out_bytes, in_component_data, sizeof(test_component));
+	return sizeof(test_component);
+}
+
+int ecsact_deserialize_component(
+	ecsact_component_id,
+	const uint8_t* in_bytes,
+	void*          out_component_data
+) {
+	std::memcpy(out_component_data, in_bytes, sizeof(test_component));
+	return sizeof(test_component);
+}
+
+void ecsact_dump_entities(
+	ecsact_registry_id,
+	ecsact_dump_entities_callback callback,
+	void*                         callback_user_data
+) {
+	// Allocated like a real runtime's dump buffer so the benchmark has
+	// allocations to count
+	auto data = static_cast<char*>(std::malloc(4));
+	std::memcpy(data, "fake", 4);
+	callback(data, 4, callback_user_data);
+	std::free(data);
+}
+
+ecsact_restore_error ecsact_restore_entities(
+	ecsact_registry_id,
+	ecsact_restore_entities_read_callback read_callback,
+	ecsact_execution_events_collector*,
+	void* read_callback_user_data
+) {
+	auto buf = std::array<char, 64>{};
+	while(read_callback(
+					buf.data(),
+					static_cast<int32_t>(buf.size()),
+					read_callback_user_data
+				) > 0) {
+	}
+	return ECSACT_RESTORE_OK;
+}
+
+ecsact_restore_error ecsact_restore_as_execution_options(
+	ecsact_restore_entities_read_callback        read_callback,
+	void*                                        read_callback_user_data,
+	ecsact_restore_as_execution_options_callback callback,
+	void*                                        callback_user_data
+) {
+	auto buf = std::array<char, 64>{};
+	while(read_callback(
+					buf.data(),
+					static_cast<int32_t>(buf.size()),
+					read_callback_user_data
+				) > 0) {
+	}
+	callback(ecsact_execution_options{}, callback_user_data);
+	return ECSACT_RESTORE_OK;
+}
+
+ecsact_async_session_id ecsact_async_start(const void*, int32_t) {
+	async_started = false;
+	async_tick = 0;
+	async_pending.clear();
+	return static_cast<ecsact_async_session_id>(0);
+}
+
+void ecsact_async_stop(ecsact_async_session_id) {
+	async_pending.clear();
+}
+
+ecsact_async_request_id ecsact_async_enqueue_execution_options(
+	ecsact_async_session_id,
+	const ecsact_execution_options
+) {
+	auto req_id = static_cast<ecsact_async_request_id>(async_next_req_id++);
+	async_pending.push_back(req_id);
+	return req_id;
+}
+
+void ecsact_async_flush_events(
+	ecsact_async_session_id                  session_id,
+	const ecsact_execution_events_collector* evc,
+	const ecsact_async_events_collector*     async_evc
+) {
+	if(async_evc == nullptr) {
+		return;
+	}
+
+	if(!async_started) {
+		async_started = true;
+		if(async_evc->async_session_event_callback != nullptr) {
+			async_evc->async_session_event_callback(
+				session_id,
+				ECSACT_ASYNC_SESSION_START,
+				async_evc->async_session_event_callback_user_data
+			);
+		}
+		return;
+	}
+
+	async_tick += 1;
+
+	if(!async_pending.empty() &&
+		 async_evc->async_request_done_callback != nullptr) {
+		auto done = async_pending;
+		async_pending.clear();
+		async_evc->async_request_done_callback(
+			session_id,
+			static_cast<int>(done.size()),
+			done.data(),
+			async_evc->async_request_done_callback_user_data
+		);
+	}
+}
+
+int32_t ecsact_async_get_current_tick(ecsact_async_session_id) {
+	return async_tick;
+}
+
+ecsact_si_wasm_error ecsact_si_wasm_load_file(
+	const char* wasm_file_path,
+	int,
+	ecsact_system_like_id*,
+	const char**
+) {
+	if(!fs::exists(wasm_file_path)) {
+		return ECSACT_SI_WASM_ERR_FILE_OPEN_FAIL;
+	}
+	return ECSACT_SI_WASM_OK;
+}
+
+ecsact_si_wasm_error ecsact_si_wasm_load(
+	char*,
+	int,
+	int,
+	ecsact_system_like_id*,
+	const char**
+) {
+	return ECSACT_SI_WASM_OK;
+}
+
+void ecsact_si_wasm_unload(int, ecsact_system_like_id*) {
+}
+
+void ecsact_si_wasm_reset() {
+}
+
+int32_t ecsact_si_wasm_last_error_message_length() {
+	return 0;
+}
+
+int32_t ecsact_si_wasm_last_error_message(char*, int32_t) {
+	return 0;
+}
@@ -55,3 +55,124 @@ TEST(Build, Success) {
 
 	ASSERT_EQ(exit_code, 0);
 }
+
+TEST(Build, PrecompiledHeaderRebuild) {
+	auto test_ecsact_file_path = std::getenv("TEST_ECSACT_FILE_PATH");
+	ASSERT_NE(test_ecsact_file_path, nullptr);
+
+	auto recipe_dir = fs::absolute("_test_build_recipe_pch");
+	fs::remove_all(recipe_dir);
+	fs::remove_all("_test_build_recipe_pch_temp");
+	fs::remove_all("_test_build_recipe_pch_temp2");
+	fs::create_directories(recipe_dir);
+
+	auto recipe_path = recipe_dir / "pch-recipe.yml";
+	std::ofstream{recipe_path} << R"(
+name: Precompiled Header Recipe
+sources:
+  - pch_test.cc
+precompiled_headers:
+  - ecsact/runtime/dynamic.h
+exports:
+  - ecsact_system_execution_context_get
+  - ecsact_system_execution_context_action
+imports: []
+)";
+
+	// Changing the source between builds makes it compile again against the
+	// precompiled header from the previous build
+	auto write_source = [&](int revision) {
+		std::ofstream{recipe_dir / "pch_test.cc"} << std::format(
+			"#include \"ecsact/runtime/dynamic.h\"\n"
+			"void ecsact_system_execution_context_get("
+			"struct ecsact_system_execution_context*, ecsact_component_like_id, "
+			"void*, const void*) {{}}\n"
+			"void ecsact_system_execution_context_action("
+			"struct ecsact_system_execution_context*, void*) {{}}\n"
+			"int pch_test_revision() {{ return {}; }}\n",
+			revision
+		);
+	};
+
+	auto build = [&](std::string temp_dir) {
+		return build_command(std::vector{
+			"ecsact"s,
+			"build"s,
+			std::string{test_ecsact_file_path},
+			std::format("--recipe={}", recipe_path.string()),
+			"--output=test_ecsact_runtime_pch"s,
+			std::format("--temp_dir={}", temp_dir),
+			std::format("--cache_dir={}", (recipe_dir / "cache").string()),
+		});
+	};
+
+	write_source(1);
+	ASSERT_EQ(build("_test_build_recipe_pch_temp"), 0);
+
+	// Same work directory: the precompiled header is up to date
+	write_source(2);
+	ASSERT_EQ(build("_test_build_recipe_pch_temp"), 0);
+
+	// New work directory: the precompiled header is restored from the cache
+	write_source(3);
+	ASSERT_EQ(build("_test_build_recipe_pch_temp2"), 0);
+}
+
+TEST(Build, NoCacheRebuild) {
+	auto test_ecsact_file_path = std::getenv("TEST_ECSACT_FILE_PATH");
+	auto test_build_merge_recipe_path =
+		std::getenv("TEST_ECSACT_BUILD_MERGE_RECIPE_PATH");
+	ASSERT_NE(test_ecsact_file_path, nullptr);
+	ASSERT_NE(test_build_merge_recipe_path, nullptr);
+
+	fs::remove_all("_test_build_recipe_no_cache_temp");
+
+	// Without a cache the runfiles (including TracyClient.cpp) are staged in
+	// the work directory. The second build must not pick them up as sources.
+	for(auto i = 0; 2 > i; ++i) {
+		auto exit_code = build_command(std::vector{
+			"ecsact"s,
+			"build"s,
+			std::string{test_ecsact_file_path},
+			std::format("--recipe={}", test_build_merge_recipe_path),
+			"--output=test_ecsact_runtime_no_cache"s,
+			"--temp_dir=_test_build_recipe_no_cache_temp"s,
+			"--tracy"s,
+			"--no_cache"s,
+		});
+
+		ASSERT_EQ(exit_code, 0) << "build " << i;
+	}
+}
+
+TEST(Build, InvalidFetchUrl) {
+	auto test_ecsact_file_path = std::getenv("TEST_ECSACT_FILE_PATH");
+	ASSERT_NE(test_ecsact_file_path, nullptr);
+
+	auto recipe_dir = fs::absolute("_test_build_recipe_invalid_url");
+	fs::remove_all(recipe_dir);
+	fs::create_directories(recipe_dir);
+
+	// Not a url at all so the download fails and the url can't be parsed
+	auto recipe_path = recipe_dir / "invalid-url-recipe.yml";
+	std::ofstream{recipe_path} << R"(
+name: Invalid Url Recipe
+sources:
+  - fetch: not a valid url
+exports:
+  - ecsact_system_execution_context_get
+imports: []
+)";
+
+	auto exit_code = build_command(std::vector{
+		"ecsact"s,
+		"build"s,
+		std::string{test_ecsact_file_path},
+		std::format("--recipe={}", recipe_path.string()),
+		"--output=test_ecsact_runtime_invalid_url"s,
+		"--temp_dir=_test_build_recipe_invalid_url_temp"s,
+		"--no_cache"s,
+	});
+
+	ASSERT_NE(exit_code, 0);
+}